@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Serialization.h"
+#include "Result.h"
+
+#include <unordered_map>
+#include <cstring>
+
+namespace ts
+{
+namespace sz
+{
+
+//Compact tag-length-value encoding of a value, for channels where the json text is too big or too slow to build.
+//Numbers keep their exact type and are varint encoded, object member names are sent once per message
+// and referenced by index after that.
+//Unlike to_json, to_binary appends to dst so the caller can put a header in front.
+
+std::string to_binary(Value const& value);
+std::string& to_binary(std::string& dst, Value const& value);
+
+Result<Value> from_binary(std::string const& value);
+Result<Value> from_binary(void const* data, size_t size);
+
+//A member name that doesn't own its characters. They are in the message being read or in a string literal
+struct Name_View
+{
+    Name_View() = default;
+    Name_View(char const* data, size_t size) : data(data), size(size) {}
+
+    bool operator==(Name_View const& other) const { return size == other.size && memcmp(data, other.data, size) == 0; }
+    bool operator==(char const* str) const { return strlen(str) == size && memcmp(data, str, size) == 0; }
+    bool operator!=(char const* str) const { return !operator==(str); }
+
+    char const* data = nullptr;
+    size_t size = 0;
+};
+
+//Writes the binary encoding piece by piece, without building a Value first.
+//The generated streaming serializers use this. Use one writer per message, it remembers the member names sent so far.
+class Binary_Writer
+{
+public:
+    //appends to dst
+    explicit Binary_Writer(std::string& dst);
+
+    void write_empty();
+    void write(bool value);
+    void write(int8_t value);
+    void write(uint8_t value);
+    void write(int16_t value);
+    void write(uint16_t value);
+    void write(int32_t value);
+    void write(uint32_t value);
+    void write(int64_t value);
+    void write(uint64_t value);
+    void write(float value);
+    void write(double value);
+    void write(char const* value);
+    void write(std::string const& value);
+    void write(Value const& value);
+
+    //follow with member_count pairs of write_member_name + value
+    //The names are not copied, they have to outlive the writer
+    void begin_object(size_t member_count);
+    void write_member_name(std::string const& name);
+    void write_member_name(char const* name);
+
+    //follow with element_count values
+    void begin_array(size_t element_count);
+
+private:
+    void write_name_ref(Name_View name);
+
+    struct Name_View_Hash
+    {
+        size_t operator()(Name_View const& name) const;
+    };
+
+    std::string& m_dst;
+    std::unordered_map<Name_View, uint64_t, Name_View_Hash> m_names;
+};
+
+//Reads the binary encoding piece by piece, the counterpart of Binary_Writer.
+//Numbers are read by kind and converted, the same way the generated deserializers treat a Value.
+class Binary_Reader
+{
+public:
+    Binary_Reader(void const* data, size_t size);
+
+    //true when all the data was consumed
+    auto is_done() const -> bool;
+
+    //consumes an empty value if that's what follows
+    auto read_empty() -> bool;
+    Result<void> read(bool& value);
+    Result<void> read_integral(int64_t& value);
+    Result<void> read_real(double& value);
+    Result<void> read(std::string& value);
+    Result<void> read(Value& value);
+
+    Result<void> begin_object(size_t& member_count);
+    //the name points in the data so it's valid as long as the data is
+    Result<void> read_member_name(Name_View& name);
+
+    Result<void> begin_array(size_t& element_count);
+
+private:
+    Result<uint8_t> read_tag();
+    Result<uint64_t> read_varint();
+    Result<uint64_t> read_fixed(size_t size);
+    Result<void> read_string(std::string& value);
+    Result<void> read_string(Name_View& value);
+    Result<size_t> read_count();
+    Result<void> read_value(Value& value, size_t depth);
+
+    uint8_t const* m_ptr = nullptr;
+    uint8_t const* m_end = nullptr;
+    std::vector<Name_View> m_names;
+};
+
+}
+}
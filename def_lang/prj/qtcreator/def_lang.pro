@@ -128,6 +128,7 @@ HEADERS += \
     ../../include/def_lang/Mapper.h \
     ../../include/def_lang/impl/Mapper.inl \
     ../../include/def_lang/JSON_Serializer.h \
+    ../../include/def_lang/Binary_Serializer.h \
     ../../include/def_lang/Serialization.h \
     ../../include/def_lang/impl/Serialization.inl \
     ../../include/def_lang/IPoly_Type.h \
@@ -189,6 +190,7 @@ SOURCES += \
     ../../src/ts/ep/Member_Def_Container_EP.cpp \
     ../../src/ts/Value_Selector.cpp \
     ../../src/ts/JSON_Serializer.cpp \
+    ../../src/ts/Binary_Serializer.cpp \
     ../../src/ts/Serialization.cpp \
     ../../src/ts/ep/Symbol_EP.cpp \
     ../../src/ts/Poly_Type.cpp \
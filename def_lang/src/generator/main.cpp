@@ -25,6 +25,7 @@
 #include "MurmurHash2.h"
 
 #include <chrono>
+#include <cstdio>
 #include <set>
 
 #include <boost/program_options.hpp>
@@ -56,6 +57,7 @@ static ts::Symbol_Path s_namespace;
 static std::string s_extra_include;
 static bool s_enum_hashes = false;
 static bool s_generate_ast_json = false;
+static bool s_stream_sz = false;
 
 
 int main(int argc, char **argv)
@@ -74,6 +76,7 @@ int main(int argc, char **argv)
         ("ast", po::value<bool>(), "Generate an AST json string")
         ("xheader", po::value<std::string>(), "A custom support header that will be included in the generated code files")
         ("enum-hashes", po::value<bool>(), "Serialize enums as hashes instead of strings")
+        ("stream-sz", po::value<bool>(), "Generate streaming binary serializers that don't build a ts::sz::Value")
         ("def", po::value<std::string>(&def_filename), "Definition file")
         ("out", po::value<std::string>(&out_filename), "Output file");
 
@@ -119,6 +122,7 @@ int main(int argc, char **argv)
     s_generate_ast_json = vm.count("ast") ? vm["ast"].as<bool>() : false;
     s_extra_include = vm.count("xheader") ? vm["xheader"].as<std::string>() : std::string();
     s_enum_hashes = vm.count("enum-hashes") ? vm["enum-hashes"].as<bool>() : false;
+    s_stream_sz = vm.count("stream-sz") ? vm["stream-sz"].as<bool>() : false;
 
     ts::ast::Builder builder;
 
@@ -177,6 +181,21 @@ static void generate_ast_code(Context& context, std::string const& ast_json)
     context.cpp_file += context.ident_str + "}\n\n";
 }
 
+static void generate_schema_hash_code(Context& context, std::string const& ast_json)
+{
+    uint64_t hash = MurmurHash64A(ast_json.data(), static_cast<int>(ast_json.size()), 0);
+    char hash_str[32];
+    snprintf(hash_str, sizeof(hash_str), "0x%016llXULL", static_cast<unsigned long long>(hash));
+
+    context.h_file += context.ident_str + "// Returns a hash of the definitions. Both ends of a binary channel have to agree on it\n";
+    context.h_file += context.ident_str + "uint64_t get_schema_hash();\n";
+
+    context.cpp_file += context.ident_str + "uint64_t get_schema_hash()\n";
+    context.cpp_file += context.ident_str + "{\n";
+    context.cpp_file += context.ident_str + "  return " + hash_str + ";\n";
+    context.cpp_file += context.ident_str + "}\n\n";
+}
+
 static void generate_aux_functions(Context& context)
 {
     context.cpp_file += context.ident_str + "template <typename T>\n";
@@ -621,6 +640,71 @@ static ts::Result<void> generate_struct_type_sz_code(Context& context, ts::IStru
     context.sz_section_cpp += "  return sz_value;\n"
                                          "}\n";
 
+    if (s_stream_sz)
+    {
+        size_t member_count = type.get_member_def_count();
+
+        //members can come in any order and unknown ones are skipped, same as when deserializing from a value
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  size_t member_count = 0;\n"
+                                  "  {\n"
+                                  "    auto result = reader.begin_object(member_count);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "  }\n";
+        if (member_count > 0)
+        {
+            context.sz_section_cpp += "  bool found[" + std::to_string(member_count) + "] = {};\n";
+        }
+        context.sz_section_cpp += "  for (size_t i = 0; i < member_count; i++)\n"
+                                  "  {\n"
+                                  "    ts::sz::Name_View name;\n"
+                                  "    {\n"
+                                  "      auto result = reader.read_member_name(name);\n"
+                                  "      if (result != ts::success) { return result; }\n"
+                                  "    }\n"
+                                  "    if (false) {} //this is here just to have the next items with 'else if'\n";
+        for (size_t i = 0; i < member_count; i++)
+        {
+            ts::IMember_Def const& member_def = *type.get_member_def(i);
+            context.sz_section_cpp += "    else if (name == \"" + member_def.get_name() + "\")\n"
+                                      "    {\n"
+                                      "      std::remove_cv<std::remove_reference<decltype(value.get_" + member_def.get_name() + "())>::type>::type v;\n"
+                                      "      auto result = deserialize(v, reader);\n"
+                                      "      if (result != ts::success) { return result; }\n"
+                                      "      value.set_" + member_def.get_name() + "(std::move(v));\n"
+                                      "      found[" + std::to_string(i) + "] = true;\n"
+                                      "    }\n";
+        }
+        context.sz_section_cpp += "    else\n"
+                                  "    {\n"
+                                  "      ts::sz::Value v;\n"
+                                  "      auto result = reader.read(v);\n"
+                                  "      if (result != ts::success) { return result; }\n"
+                                  "    }\n"
+                                  "  }\n";
+        for (size_t i = 0; i < member_count; i++)
+        {
+            ts::IMember_Def const& member_def = *type.get_member_def(i);
+            context.sz_section_cpp += "  if (!found[" + std::to_string(i) + "]) { return ts::Error(\"Cannot find member value '" + member_def.get_name() + "'\"); }\n";
+        }
+        context.sz_section_cpp += "  return ts::success;\n"
+                                  "}\n";
+
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.begin_object(" + std::to_string(member_count) + ");\n";
+        for (size_t i = 0; i < member_count; i++)
+        {
+            ts::IMember_Def const& member_def = *type.get_member_def(i);
+            context.sz_section_cpp += "  writer.write_member_name(\"" + member_def.get_name() + "\");\n"
+                                      "  serialize(writer, value.get_" + member_def.get_name() + "());\n";
+        }
+        context.sz_section_cpp += "}\n";
+    }
+
     return ts::success;
 }
 
@@ -741,6 +825,46 @@ static ts::Result<void> generate_enum_type_sz_code(Context& context, ts::IEnum_T
                                              "  if (it == s_map.end()) { TS_ASSERT(false); return ts::sz::Value(); }\n"
                                              "  return ts::sz::Value(it->second);\n"
                                              "}\n";
+
+        if (s_stream_sz)
+        {
+            context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+            context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                      "{\n"
+                                      "  int64_t v = 0;\n"
+                                      "  auto result = reader.read_integral(v);\n"
+                                      "  if (result != ts::success) { return result; }\n"
+                                      "  uint32_t key = static_cast<uint32_t>(v);\n"
+                                      "  typedef " + native_type_str + " _etype;\n"
+                                      "  static std::map<uint32_t, _etype> s_map = {\n";
+            for (size_t i = 0; i < type.get_item_count(); i++)
+            {
+                std::string const& item_str = type.get_item(i)->get_name();
+                context.sz_section_cpp += "    { " + std::to_string(hashes[i]) + ", _etype::" + item_str + " },\n";
+            }
+            context.sz_section_cpp += "  };\n"
+                                      "  auto it = s_map.find(key);\n"
+                                      "  if (it == s_map.end()) { return ts::Error(\"Cannot find item \" + std::to_string(key) + \" when deserializing\"); }\n"
+                                      "  value = it->second;\n"
+                                      "  return ts::success;\n"
+                                      "}\n";
+
+            context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+            context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                      "{\n"
+                                      "  typedef " + native_type_str + " _etype;\n"
+                                      "  static std::map<_etype, uint32_t> s_map = {\n";
+            for (size_t i = 0; i < type.get_item_count(); i++)
+            {
+                std::string const& item_str = type.get_item(i)->get_name();
+                context.sz_section_cpp += "    { _etype::" + item_str + ", " + std::to_string(hashes[i]) + " },\n";
+            }
+            context.sz_section_cpp += "  };\n"
+                                      "  auto it = s_map.find(value);\n"
+                                      "  if (it == s_map.end()) { TS_ASSERT(false); writer.write_empty(); return; }\n"
+                                      "  writer.write(it->second);\n"
+                                      "}\n";
+        }
     }
     else
     {
@@ -778,6 +902,45 @@ static ts::Result<void> generate_enum_type_sz_code(Context& context, ts::IEnum_T
                                              "  if (it == s_map.end()) { TS_ASSERT(false); return ts::sz::Value(); }\n"
                                              "  return ts::sz::Value(it->second);\n"
                                              "}\n";
+
+        if (s_stream_sz)
+        {
+            context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+            context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                      "{\n"
+                                      "  std::string key;\n"
+                                      "  auto result = reader.read(key);\n"
+                                      "  if (result != ts::success) { return result; }\n"
+                                      "  typedef " + native_type_str + " _etype;\n"
+                                      "  static std::map<std::string, _etype> s_map = {\n";
+            for (size_t i = 0; i < type.get_item_count(); i++)
+            {
+                std::string const& item_str = type.get_item(i)->get_name();
+                context.sz_section_cpp += "    { \"" + item_str + "\", _etype::" + item_str + " },\n";
+            }
+            context.sz_section_cpp += "  };\n"
+                                      "  auto it = s_map.find(key);\n"
+                                      "  if (it == s_map.end()) { return ts::Error(\"Cannot find item \" + key + \" when deserializing\"); }\n"
+                                      "  value = it->second;\n"
+                                      "  return ts::success;\n"
+                                      "}\n";
+
+            context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+            context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                      "{\n"
+                                      "  typedef " + native_type_str + " _etype;\n"
+                                      "  static std::map<_etype, char const*> s_map = {\n";
+            for (size_t i = 0; i < type.get_item_count(); i++)
+            {
+                std::string const& item_str = type.get_item(i)->get_name();
+                context.sz_section_cpp += "    { _etype::" + item_str + ", \"" +  item_str + "\" },\n";
+            }
+            context.sz_section_cpp += "  };\n"
+                                      "  auto it = s_map.find(value);\n"
+                                      "  if (it == s_map.end()) { TS_ASSERT(false); writer.write_empty(); return; }\n"
+                                      "  writer.write(it->second);\n"
+                                      "}\n";
+        }
     }
     return ts::success;
 }
@@ -860,6 +1023,62 @@ static ts::Result<void> generate_poly_type_code(Context& context, ts::IPoly_Type
     }
     context.sz_section_cpp += "  else { TS_ASSERT(false); return ts::sz::Value(); }\n"
                                      "}\n";
+
+    if (s_stream_sz)
+    {
+        //the type has to come before the value, that's how both serializers write it
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  if (reader.read_empty()) { value = " + native_type_str + "(); return ts::success; }\n"
+                                  "  std::string path;\n"
+                                  "  {\n"
+                                  "    size_t member_count = 0;\n"
+                                  "    auto result = reader.begin_object(member_count);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (member_count != 2) { return ts::Error(\"Expected 'type' and 'value' when deserializing\"); }\n"
+                                  "    ts::sz::Name_View name;\n"
+                                  "    result = reader.read_member_name(name);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (name != \"type\") { return ts::Error(\"Expected 'type' string value when deserializing\"); }\n"
+                                  "    result = reader.read(path);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    result = reader.read_member_name(name);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (name != \"value\") { return ts::Error(\"Expected 'value' when deserializing\"); }\n"
+                                  "  }\n"
+                                  "  if (false) { return ts::Error(\"\"); } //this is here just to have the next items with 'else if'\n";
+        for (std::shared_ptr<const ts::Qualified_Type> inner_type: inner_types)
+        {
+            std::string native_inner_type_str = get_native_type(context.parent_scope, *inner_type->get_type()).to_string();
+            context.sz_section_cpp += "  else if (path == \"" + inner_type->get_type()->get_symbol_path().to_string() + "\")\n"
+                                      "  {\n"
+                                      "    value = " + native_type_str + "(new " + native_inner_type_str + "());\n"
+                                      "    return deserialize((" + native_inner_type_str + "&)*value, reader);\n"
+                                      "  }\n";
+        }
+        context.sz_section_cpp += "  else { return ts::Error(\"Cannot find type '\" + path + \"' when deserializing\"); }\n"
+                                  "}\n";
+
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  if (!value) { writer.write_empty(); }\n";
+        for (std::shared_ptr<const ts::Qualified_Type> inner_type: inner_types)
+        {
+            std::string native_inner_type_str = get_native_type(context.parent_scope, *inner_type->get_type()).to_string();
+            context.sz_section_cpp += "  else if (typeid(*value) == typeid(" + native_inner_type_str + "))\n"
+                                      "  {\n"
+                                      "    writer.begin_object(2);\n"
+                                      "    writer.write_member_name(\"type\");\n"
+                                      "    writer.write(\"" + inner_type->get_type()->get_symbol_path().to_string() + "\");\n"
+                                      "    writer.write_member_name(\"value\");\n"
+                                      "    serialize(writer, (" + native_inner_type_str + "&)*value);\n"
+                                      "  }\n";
+        }
+        context.sz_section_cpp += "  else { TS_ASSERT(false); writer.write_empty(); }\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_bool_type_code(Context& context, ts::IBool_Type const& type)
@@ -885,6 +1104,20 @@ static ts::Result<void> generate_bool_type_code(Context& context, ts::IBool_Type
                                            "{\n"
                                            "  return ts::sz::Value(value);\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  return reader.read(value);\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.write(value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_string_type_code(Context& context, ts::IString_Type const& type)
@@ -910,6 +1143,20 @@ static ts::Result<void> generate_string_type_code(Context& context, ts::IString_
                                            "{\n"
                                            "  return ts::sz::Value(value);\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  return reader.read(value);\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.write(value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_variant_type_code(Context& context, ts::IVariant_Type const& type)
@@ -967,6 +1214,61 @@ static ts::Result<void> generate_variant_type_code(Context& context, ts::IVarian
     }
     context.sz_section_cpp += "  else { TS_ASSERT(false); return ts::sz::Value(); }\n"
                                          "}\n";
+
+    if (s_stream_sz)
+    {
+        //same layout as the poly, the type before the value
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  std::string path;\n"
+                                  "  {\n"
+                                  "    size_t member_count = 0;\n"
+                                  "    auto result = reader.begin_object(member_count);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (member_count != 2) { return ts::Error(\"Expected 'type' and 'value' when deserializing\"); }\n"
+                                  "    ts::sz::Name_View name;\n"
+                                  "    result = reader.read_member_name(name);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (name != \"type\") { return ts::Error(\"Expected 'type' string value when deserializing\"); }\n"
+                                  "    result = reader.read(path);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    result = reader.read_member_name(name);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "    if (name != \"value\") { return ts::Error(\"Expected 'value' when deserializing\"); }\n"
+                                  "  }\n"
+                                  "  if (false) { return ts::Error(\"\"); } //this is here just to have the next items with 'else if'\n";
+        for (size_t i = 0; i < type.get_inner_qualified_type_count(); i++)
+        {
+            std::string native_inner_type_str = get_native_type(context.parent_scope, *type.get_inner_qualified_type(i)->get_type()).to_string();
+            context.sz_section_cpp += "  else if (path == \"" + type.get_inner_qualified_type(i)->get_type()->get_symbol_path().to_string() + "\")\n"
+                                      "  {\n"
+                                      "    value = " + native_inner_type_str + "();\n"
+                                      "    return deserialize(boost::get<" + native_inner_type_str + ">(value), reader);\n"
+                                      "  }\n";
+        }
+        context.sz_section_cpp += "  else { return ts::Error(\"Cannot find type '\" + path + \"' when deserializing\"); }\n"
+                                  "}\n";
+
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  if (false) {} //this is here just to have the next items with 'else if'\n";
+        for (size_t i = 0; i < type.get_inner_qualified_type_count(); i++)
+        {
+            std::string native_inner_type_str = get_native_type(context.parent_scope, *type.get_inner_qualified_type(i)->get_type()).to_string();
+            context.sz_section_cpp += "  else if (auto* v = boost::get<" + native_inner_type_str + ">(&value))\n"
+                                      "  {\n"
+                                      "    writer.begin_object(2);\n"
+                                      "    writer.write_member_name(\"type\");\n"
+                                      "    writer.write(\"" + type.get_inner_qualified_type(i)->get_type()->get_symbol_path().to_string() + "\");\n"
+                                      "    writer.write_member_name(\"value\");\n"
+                                      "    serialize(writer, *v);\n"
+                                      "  }\n";
+        }
+        context.sz_section_cpp += "  else { TS_ASSERT(false); writer.write_empty(); }\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_optional_type_code(Context& context, ts::IOptional_Type const& type)
@@ -996,6 +1298,23 @@ static ts::Result<void> generate_optional_type_code(Context& context, ts::IOptio
                                          "  if (!value) { return ts::sz::Value(); }\n"
                                          "  return serialize(*value);\n"
                                          "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  if (reader.read_empty()) { value = boost::none; return ts::success; }\n"
+                                  "  value = " + native_inner_type_str + "();\n"
+                                  "  return deserialize(*value, reader);\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  if (!value) { writer.write_empty(); return; }\n"
+                                  "  serialize(writer, *value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_vector_type_code(Context& context, ts::IVector_Type const& type)
@@ -1033,6 +1352,36 @@ static ts::Result<void> generate_vector_type_code(Context& context, ts::IVector_
                                            "  }\n"
                                            "  return sz_value;\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  value.clear();\n"
+                                  "  size_t count = 0;\n"
+                                  "  {\n"
+                                  "    auto result = reader.begin_array(count);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "  }\n"
+                                  "  value.resize(count);\n"
+                                  "  for (size_t i = 0; i < value.size(); i++)\n"
+                                  "  {\n"
+                                  "    auto result = deserialize(value[i], reader);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "  }\n"
+                                  "  return ts::success;\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.begin_array(value.size());\n"
+                                  "  for (size_t i = 0; i < value.size(); i++)\n"
+                                  "  {\n"
+                                  "    serialize(writer, value[i]);\n"
+                                  "  }\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_int_type_code(Context& context, ts::IInt_Type const& type)
@@ -1058,6 +1407,24 @@ static ts::Result<void> generate_int_type_code(Context& context, ts::IInt_Type c
                                            "{\n"
                                            "  return ts::sz::Value(value);\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  int64_t v = 0;\n"
+                                  "  auto result = reader.read_integral(v);\n"
+                                  "  if (result != ts::success) { return result; }\n"
+                                  "  value = v;\n"
+                                  "  return ts::success;\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.write(value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_float_type_code(Context& context, ts::IFloat_Type const& type)
@@ -1083,6 +1450,24 @@ static ts::Result<void> generate_float_type_code(Context& context, ts::IFloat_Ty
                                            "{\n"
                                            "  return ts::sz::Value(value);\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  double v = 0;\n"
+                                  "  auto result = reader.read_real(v);\n"
+                                  "  if (result != ts::success) { return result; }\n"
+                                  "  value = (float)v;\n"
+                                  "  return ts::success;\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.write(value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 static ts::Result<void> generate_double_type_code(Context& context, ts::IDouble_Type const& type)
@@ -1108,6 +1493,22 @@ static ts::Result<void> generate_double_type_code(Context& context, ts::IDouble_
                                            "{\n"
                                            "  return ts::sz::Value(value);\n"
                                            "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  auto result = reader.read_real(value);\n"
+                                  "  if (result != ts::success) { return result; }\n"
+                                  "  return ts::success;\n"
+                                  "}\n";
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.write(value);\n"
+                                  "}\n";
+    }
     return ts::success;
 }
 
@@ -1146,6 +1547,61 @@ static ts::Result<void> generate_vecXY_type_code(Context& context, std::string c
     }
     context.sz_section_cpp += "  return sz_value;\n"
                                          "}\n";
+
+    if (s_stream_sz)
+    {
+        context.sz_section_h += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader);\n";
+        context.sz_section_cpp += "ts::Result<void> deserialize(" + native_type_str + "& value, ts::sz::Binary_Reader& reader)\n"
+                                  "{\n"
+                                  "  size_t member_count = 0;\n"
+                                  "  {\n"
+                                  "    auto result = reader.begin_object(member_count);\n"
+                                  "    if (result != ts::success) { return result; }\n"
+                                  "  }\n"
+                                  "  bool found[" + std::to_string(component_names.size()) + "] = {};\n"
+                                  "  for (size_t i = 0; i < member_count; i++)\n"
+                                  "  {\n"
+                                  "    ts::sz::Name_View name;\n"
+                                  "    {\n"
+                                  "      auto result = reader.read_member_name(name);\n"
+                                  "      if (result != ts::success) { return result; }\n"
+                                  "    }\n"
+                                  "    if (false) {} //this is here just to have the next items with 'else if'\n";
+        for (size_t i = 0; i < component_names.size(); i++)
+        {
+            std::string const& component_name = component_names[i];
+            context.sz_section_cpp += "    else if (name == \"" + component_name + "\")\n"
+                                      "    {\n"
+                                      "      auto result = deserialize(value." + component_name + ", reader);\n"
+                                      "      if (result != ts::success) { return result; }\n"
+                                      "      found[" + std::to_string(i) + "] = true;\n"
+                                      "    }\n";
+        }
+        context.sz_section_cpp += "    else\n"
+                                  "    {\n"
+                                  "      ts::sz::Value v;\n"
+                                  "      auto result = reader.read(v);\n"
+                                  "      if (result != ts::success) { return result; }\n"
+                                  "    }\n"
+                                  "  }\n";
+        for (size_t i = 0; i < component_names.size(); i++)
+        {
+            context.sz_section_cpp += "  if (!found[" + std::to_string(i) + "]) { return ts::Error(\"Cannot find component '" + component_names[i] + "'\"); }\n";
+        }
+        context.sz_section_cpp += "  return ts::success;\n"
+                                  "}\n";
+
+        context.sz_section_h += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value);\n";
+        context.sz_section_cpp += "void serialize(ts::sz::Binary_Writer& writer, " + native_type_str + " const& value)\n"
+                                  "{\n"
+                                  "  writer.begin_object(" + std::to_string(component_names.size()) + ");\n";
+        for (std::string const& component_name: component_names)
+        {
+            context.sz_section_cpp += "  writer.write_member_name(\"" + component_name + "\");\n"
+                                      "  serialize(writer, value." + component_name + ");\n";
+        }
+        context.sz_section_cpp += "}\n";
+    }
     return ts::success;
 }
 
@@ -1377,6 +1833,10 @@ static ts::Result<void> generate_code(Context& context, ts::ast::Node const& ast
     context.h_file += "#include <boost/variant.hpp>\n";
     context.h_file += "#include <def_lang/Result.h>\n";
     context.h_file += "#include <def_lang/Serialization.h>\n";
+    if (s_stream_sz)
+    {
+        context.h_file += "#include <def_lang/Binary_Serializer.h>\n";
+    }
     if (!s_extra_include.empty())
     {
         context.h_file += "#include \"" + s_extra_include + "\"\n";
@@ -1400,9 +1860,10 @@ static ts::Result<void> generate_code(Context& context, ts::ast::Node const& ast
 
     generate_aux_functions(context);
 
+    std::string ast_json = ts::sz::to_json(serialize_result.payload(), false);
+    generate_schema_hash_code(context, ast_json);
     if (s_generate_ast_json)
     {
-        std::string ast_json = ts::sz::to_json(serialize_result.payload(), false);
         generate_ast_code(context, ast_json);
     }
 
@@ -0,0 +1,717 @@
+#include "def_lang/Binary_Serializer.h"
+#include "def_lang/ts_assert.h"
+#include "def_lang/Result.h"
+
+#include <memory.h>
+
+namespace ts
+{
+namespace sz
+{
+
+//These go on the wire, don't reorder them
+enum class Tag : uint8_t
+{
+    EMPTY = 0,
+    FALSE_VALUE,
+    TRUE_VALUE,
+    INT8,
+    UINT8,
+    INT16,
+    UINT16,
+    INT32,
+    UINT32,
+    INT64,
+    UINT64,
+    FLOAT,
+    DOUBLE,
+    STRING,
+    OBJECT,
+    ARRAY
+};
+
+static const size_t MAX_DEPTH = 256;
+
+static void write_tag(std::string& dst, Tag tag)
+{
+    dst.push_back(static_cast<char>(tag));
+}
+
+static void write_varint(std::string& dst, uint64_t v)
+{
+    while (v >= 0x80)
+    {
+        dst.push_back(static_cast<char>((v & 0x7F) | 0x80));
+        v >>= 7;
+    }
+    dst.push_back(static_cast<char>(v));
+}
+
+static uint64_t zigzag(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+static int64_t unzigzag(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+//little endian regardless of the host
+static void write_fixed(std::string& dst, uint64_t v, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+    {
+        dst.push_back(static_cast<char>(v >> (i * 8)));
+    }
+}
+
+static void write_string(std::string& dst, char const* str, size_t size)
+{
+    write_varint(dst, size);
+    dst.append(str, size);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+Binary_Writer::Binary_Writer(std::string& dst)
+    : m_dst(dst)
+{
+}
+
+void Binary_Writer::write_empty()
+{
+    write_tag(m_dst, Tag::EMPTY);
+}
+void Binary_Writer::write(bool value)
+{
+    write_tag(m_dst, value ? Tag::TRUE_VALUE : Tag::FALSE_VALUE);
+}
+void Binary_Writer::write(int8_t value)
+{
+    write_tag(m_dst, Tag::INT8);
+    m_dst.push_back(static_cast<char>(value));
+}
+void Binary_Writer::write(uint8_t value)
+{
+    write_tag(m_dst, Tag::UINT8);
+    m_dst.push_back(static_cast<char>(value));
+}
+void Binary_Writer::write(int16_t value)
+{
+    write_tag(m_dst, Tag::INT16);
+    write_varint(m_dst, zigzag(value));
+}
+void Binary_Writer::write(uint16_t value)
+{
+    write_tag(m_dst, Tag::UINT16);
+    write_varint(m_dst, value);
+}
+void Binary_Writer::write(int32_t value)
+{
+    write_tag(m_dst, Tag::INT32);
+    write_varint(m_dst, zigzag(value));
+}
+void Binary_Writer::write(uint32_t value)
+{
+    write_tag(m_dst, Tag::UINT32);
+    write_varint(m_dst, value);
+}
+void Binary_Writer::write(int64_t value)
+{
+    write_tag(m_dst, Tag::INT64);
+    write_varint(m_dst, zigzag(value));
+}
+void Binary_Writer::write(uint64_t value)
+{
+    write_tag(m_dst, Tag::UINT64);
+    write_varint(m_dst, value);
+}
+void Binary_Writer::write(float value)
+{
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    write_tag(m_dst, Tag::FLOAT);
+    write_fixed(m_dst, bits, sizeof(bits));
+}
+void Binary_Writer::write(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    write_tag(m_dst, Tag::DOUBLE);
+    write_fixed(m_dst, bits, sizeof(bits));
+}
+void Binary_Writer::write(char const* value)
+{
+    write_tag(m_dst, Tag::STRING);
+    write_string(m_dst, value, strlen(value));
+}
+void Binary_Writer::write(std::string const& value)
+{
+    write_tag(m_dst, Tag::STRING);
+    write_string(m_dst, value.data(), value.size());
+}
+
+void Binary_Writer::write(Value const& value)
+{
+    switch (value.get_type())
+    {
+    case Value::Type::EMPTY: write_empty(); break;
+    case Value::Type::BOOL: write(value.get_as_bool()); break;
+    case Value::Type::INT8: write(value.get_as_int8()); break;
+    case Value::Type::UINT8: write(value.get_as_uint8()); break;
+    case Value::Type::INT16: write(value.get_as_int16()); break;
+    case Value::Type::UINT16: write(value.get_as_uint16()); break;
+    case Value::Type::INT32: write(value.get_as_int32()); break;
+    case Value::Type::UINT32: write(value.get_as_uint32()); break;
+    case Value::Type::INT64: write(value.get_as_int64()); break;
+    case Value::Type::UINT64: write(value.get_as_uint64()); break;
+    case Value::Type::FLOAT: write(value.get_as_float()); break;
+    case Value::Type::DOUBLE: write(value.get_as_double()); break;
+    case Value::Type::STRING: write(value.get_as_string()); break;
+    case Value::Type::OBJECT:
+    {
+        size_t count = value.get_object_member_count();
+        begin_object(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            write_member_name(value.get_object_member_name(i));
+            write(value.get_object_member_value(i));
+        }
+        break;
+    }
+    case Value::Type::ARRAY:
+    {
+        size_t count = value.get_array_element_count();
+        begin_array(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            write(value.get_array_element_value(i));
+        }
+        break;
+    }
+    default: TS_ASSERT(false); break;
+    }
+}
+
+void Binary_Writer::begin_object(size_t member_count)
+{
+    write_tag(m_dst, Tag::OBJECT);
+    write_varint(m_dst, member_count);
+}
+
+size_t Binary_Writer::Name_View_Hash::operator()(Name_View const& name) const
+{
+    //FNV-1a, the names are short
+    size_t hash = 2166136261u;
+    for (size_t i = 0; i < name.size; i++)
+    {
+        hash = (hash ^ static_cast<uint8_t>(name.data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+void Binary_Writer::write_name_ref(Name_View name)
+{
+    //0 is followed by a new name, anything else is the index + 1 of a name already sent
+    auto it = m_names.find(name);
+    if (it != m_names.end())
+    {
+        write_varint(m_dst, it->second + 1);
+    }
+    else
+    {
+        uint64_t index = m_names.size();
+        m_names.emplace(name, index);
+        write_varint(m_dst, 0);
+        write_string(m_dst, name.data, name.size);
+    }
+}
+
+void Binary_Writer::write_member_name(std::string const& name)
+{
+    write_name_ref(Name_View(name.data(), name.size()));
+}
+
+void Binary_Writer::write_member_name(char const* name)
+{
+    write_name_ref(Name_View(name, strlen(name)));
+}
+
+void Binary_Writer::begin_array(size_t element_count)
+{
+    write_tag(m_dst, Tag::ARRAY);
+    write_varint(m_dst, element_count);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+Binary_Reader::Binary_Reader(void const* data, size_t size)
+    : m_ptr(reinterpret_cast<uint8_t const*>(data))
+    , m_end(reinterpret_cast<uint8_t const*>(data) + size)
+{
+}
+
+auto Binary_Reader::is_done() const -> bool
+{
+    return m_ptr >= m_end;
+}
+
+Result<uint8_t> Binary_Reader::read_tag()
+{
+    if (m_ptr >= m_end)
+    {
+        return Error("Unexpected end of data");
+    }
+    return *m_ptr++;
+}
+
+Result<uint64_t> Binary_Reader::read_varint()
+{
+    uint64_t v = 0;
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        if (m_ptr >= m_end)
+        {
+            return Error("Unexpected end of data while parsing varint");
+        }
+        uint8_t byte = *m_ptr++;
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return v;
+        }
+    }
+    return Error("Varint too long");
+}
+
+Result<uint64_t> Binary_Reader::read_fixed(size_t size)
+{
+    if (static_cast<size_t>(m_end - m_ptr) < size)
+    {
+        return Error("Unexpected end of data while parsing number");
+    }
+    uint64_t v = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        v |= static_cast<uint64_t>(*m_ptr++) << (i * 8);
+    }
+    return v;
+}
+
+Result<void> Binary_Reader::read_string(std::string& value)
+{
+    Name_View view;
+    auto result = read_string(view);
+    if (result != success)
+    {
+        return result;
+    }
+    value.assign(view.data, view.size);
+    return success;
+}
+
+Result<void> Binary_Reader::read_string(Name_View& value)
+{
+    auto size_result = read_varint();
+    if (size_result != success)
+    {
+        return size_result.error();
+    }
+    uint64_t size = size_result.payload();
+    if (static_cast<uint64_t>(m_end - m_ptr) < size)
+    {
+        return Error("Unexpected end of data while parsing string");
+    }
+    value = Name_View(reinterpret_cast<char const*>(m_ptr), static_cast<size_t>(size));
+    m_ptr += size;
+    return success;
+}
+
+//every element takes at least one byte so a count bigger than what's left is garbage.
+//Checked before reserving anything
+Result<size_t> Binary_Reader::read_count()
+{
+    auto result = read_varint();
+    if (result != success)
+    {
+        return result.error();
+    }
+    if (result.payload() > static_cast<uint64_t>(m_end - m_ptr))
+    {
+        return Error("Invalid element count " + std::to_string(result.payload()));
+    }
+    return static_cast<size_t>(result.payload());
+}
+
+auto Binary_Reader::read_empty() -> bool
+{
+    if (m_ptr < m_end && *m_ptr == static_cast<uint8_t>(Tag::EMPTY))
+    {
+        m_ptr++;
+        return true;
+    }
+    return false;
+}
+
+Result<void> Binary_Reader::read(bool& value)
+{
+    auto result = read_tag();
+    if (result != success)
+    {
+        return result.error();
+    }
+    Tag tag = static_cast<Tag>(result.payload());
+    if (tag != Tag::FALSE_VALUE && tag != Tag::TRUE_VALUE)
+    {
+        return Error("Expected bool value");
+    }
+    value = tag == Tag::TRUE_VALUE;
+    return success;
+}
+
+Result<void> Binary_Reader::read_integral(int64_t& value)
+{
+    auto tag_result = read_tag();
+    if (tag_result != success)
+    {
+        return tag_result.error();
+    }
+    Tag tag = static_cast<Tag>(tag_result.payload());
+    if (tag == Tag::INT8 || tag == Tag::UINT8)
+    {
+        auto result = read_fixed(1);
+        if (result != success)
+        {
+            return result.error();
+        }
+        value = tag == Tag::INT8 ? static_cast<int8_t>(result.payload()) : static_cast<uint8_t>(result.payload());
+        return success;
+    }
+    if (tag != Tag::INT16 && tag != Tag::INT32 && tag != Tag::INT64 &&
+        tag != Tag::UINT16 && tag != Tag::UINT32 && tag != Tag::UINT64)
+    {
+        return Error("Expected integral number value");
+    }
+
+    auto result = read_varint();
+    if (result != success)
+    {
+        return result.error();
+    }
+    bool is_signed = tag == Tag::INT16 || tag == Tag::INT32 || tag == Tag::INT64;
+    value = is_signed ? unzigzag(result.payload()) : static_cast<int64_t>(result.payload());
+    return success;
+}
+
+Result<void> Binary_Reader::read_real(double& value)
+{
+    auto tag_result = read_tag();
+    if (tag_result != success)
+    {
+        return tag_result.error();
+    }
+    Tag tag = static_cast<Tag>(tag_result.payload());
+    if (tag == Tag::FLOAT)
+    {
+        auto result = read_fixed(sizeof(float));
+        if (result != success)
+        {
+            return result.error();
+        }
+        uint32_t bits = static_cast<uint32_t>(result.payload());
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        value = v;
+        return success;
+    }
+    if (tag == Tag::DOUBLE)
+    {
+        auto result = read_fixed(sizeof(double));
+        if (result != success)
+        {
+            return result.error();
+        }
+        uint64_t bits = result.payload();
+        memcpy(&value, &bits, sizeof(value));
+        return success;
+    }
+    return Error("Expected real number value");
+}
+
+Result<void> Binary_Reader::read(std::string& value)
+{
+    auto result = read_tag();
+    if (result != success)
+    {
+        return result.error();
+    }
+    if (static_cast<Tag>(result.payload()) != Tag::STRING)
+    {
+        return Error("Expected string value");
+    }
+    return read_string(value);
+}
+
+Result<void> Binary_Reader::begin_object(size_t& member_count)
+{
+    auto result = read_tag();
+    if (result != success)
+    {
+        return result.error();
+    }
+    if (static_cast<Tag>(result.payload()) != Tag::OBJECT)
+    {
+        return Error("Expected object value");
+    }
+    auto count_result = read_count();
+    if (count_result != success)
+    {
+        return count_result.error();
+    }
+    member_count = count_result.payload();
+    return success;
+}
+
+Result<void> Binary_Reader::read_member_name(Name_View& name)
+{
+    auto key_result = read_varint();
+    if (key_result != success)
+    {
+        return key_result.error();
+    }
+
+    uint64_t key = key_result.payload();
+    if (key == 0)
+    {
+        auto result = read_string(name);
+        if (result != success)
+        {
+            return result;
+        }
+        m_names.push_back(name);
+        return success;
+    }
+    if (key - 1 < m_names.size())
+    {
+        name = m_names[static_cast<size_t>(key - 1)];
+        return success;
+    }
+    return Error("Invalid member name reference " + std::to_string(key));
+}
+
+Result<void> Binary_Reader::begin_array(size_t& element_count)
+{
+    auto result = read_tag();
+    if (result != success)
+    {
+        return result.error();
+    }
+    if (static_cast<Tag>(result.payload()) != Tag::ARRAY)
+    {
+        return Error("Expected array value");
+    }
+    auto count_result = read_count();
+    if (count_result != success)
+    {
+        return count_result.error();
+    }
+    element_count = count_result.payload();
+    return success;
+}
+
+Result<void> Binary_Reader::read(Value& value)
+{
+    return read_value(value, 0);
+}
+
+Result<void> Binary_Reader::read_value(Value& value, size_t depth)
+{
+    if (depth > MAX_DEPTH)
+    {
+        return Error("Values nested too deep");
+    }
+
+    auto tag_result = read_tag();
+    if (tag_result != success)
+    {
+        return tag_result.error();
+    }
+    Tag tag = static_cast<Tag>(tag_result.payload());
+    switch (tag)
+    {
+    case Tag::EMPTY: value = Value(); return success;
+    case Tag::FALSE_VALUE: value = Value(false); return success;
+    case Tag::TRUE_VALUE: value = Value(true); return success;
+    case Tag::INT8:
+    case Tag::UINT8:
+    {
+        auto result = read_fixed(1);
+        if (result != success)
+        {
+            return result.error();
+        }
+        value = tag == Tag::INT8 ? Value(static_cast<int8_t>(result.payload())) : Value(static_cast<uint8_t>(result.payload()));
+        return success;
+    }
+    case Tag::INT16:
+    case Tag::INT32:
+    case Tag::INT64:
+    case Tag::UINT16:
+    case Tag::UINT32:
+    case Tag::UINT64:
+    {
+        auto result = read_varint();
+        if (result != success)
+        {
+            return result.error();
+        }
+        uint64_t v = result.payload();
+        switch (tag)
+        {
+        case Tag::INT16: value = Value(static_cast<int16_t>(unzigzag(v))); break;
+        case Tag::INT32: value = Value(static_cast<int32_t>(unzigzag(v))); break;
+        case Tag::INT64: value = Value(unzigzag(v)); break;
+        case Tag::UINT16: value = Value(static_cast<uint16_t>(v)); break;
+        case Tag::UINT32: value = Value(static_cast<uint32_t>(v)); break;
+        default: value = Value(v); break;
+        }
+        return success;
+    }
+    case Tag::FLOAT:
+    {
+        auto result = read_fixed(sizeof(float));
+        if (result != success)
+        {
+            return result.error();
+        }
+        uint32_t bits = static_cast<uint32_t>(result.payload());
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        value = Value(v);
+        return success;
+    }
+    case Tag::DOUBLE:
+    {
+        auto result = read_fixed(sizeof(double));
+        if (result != success)
+        {
+            return result.error();
+        }
+        uint64_t bits = result.payload();
+        double v;
+        memcpy(&v, &bits, sizeof(v));
+        value = Value(v);
+        return success;
+    }
+    case Tag::STRING:
+    {
+        std::string str;
+        auto result = read_string(str);
+        if (result != success)
+        {
+            return result;
+        }
+        value = Value(std::move(str));
+        return success;
+    }
+    case Tag::OBJECT:
+    {
+        auto count_result = read_count();
+        if (count_result != success)
+        {
+            return count_result.error();
+        }
+        size_t count = count_result.payload();
+
+        value = Value(Value::Type::OBJECT);
+        value.reserve_object_members(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            Name_View name;
+            auto result = read_member_name(name);
+            if (result != success)
+            {
+                return result;
+            }
+            Value member;
+            result = read_value(member, depth + 1);
+            if (result != success)
+            {
+                return result;
+            }
+            value.add_object_member(std::string(name.data, name.size), std::move(member));
+        }
+        return success;
+    }
+    case Tag::ARRAY:
+    {
+        auto count_result = read_count();
+        if (count_result != success)
+        {
+            return count_result.error();
+        }
+        size_t count = count_result.payload();
+
+        value = Value(Value::Type::ARRAY);
+        value.reserve_array_members(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            Value element;
+            auto result = read_value(element, depth + 1);
+            if (result != success)
+            {
+                return result;
+            }
+            value.add_array_element(std::move(element));
+        }
+        return success;
+    }
+    default: return Error("Unknown tag " + std::to_string(static_cast<int>(tag)));
+    }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+std::string to_binary(Value const& value)
+{
+    std::string data;
+    to_binary(data, value);
+    return data;
+}
+
+std::string& to_binary(std::string& dst, Value const& value)
+{
+    Binary_Writer writer(dst);
+    writer.write(value);
+    return dst;
+}
+
+Result<Value> from_binary(std::string const& data)
+{
+    return from_binary(data.data(), data.size());
+}
+
+Result<Value> from_binary(void const* data, size_t size)
+{
+    TS_ASSERT(data && size > 0);
+    if (!data || size == 0)
+    {
+        return ts::Error("Cannot parse empty data");
+    }
+
+    Binary_Reader reader(data, size);
+    Value value;
+    auto result = reader.read(value);
+    if (result != success)
+    {
+        return result.error();
+    }
+    if (!reader.is_done())
+    {
+        return Error("Trailing data after value");
+    }
+    return std::move(value);
+}
+
+}
+}
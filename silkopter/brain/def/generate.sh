@@ -1,3 +1,3 @@
 #!/bin/bash
 
-../../../def_lang/bin/pc/debug/generator --def hal.def --namespace silk::hal --xheader gen_support.h --ast true
+../../../def_lang/bin/pc/debug/generator --def hal.def --namespace silk::hal --xheader gen_support.h --ast true --stream-sz true
@@ -8,6 +8,7 @@
 #include <boost/variant.hpp>
 #include <def_lang/Result.h>
 #include <def_lang/Serialization.h>
+#include <def_lang/Binary_Serializer.h>
 #include "gen_support.h"
 namespace silk
 {
@@ -39,6 +40,8 @@ private:
   template<class U> friend class Poly;
   std::shared_ptr<T> ptr;
 };
+// Returns a hash of the definitions. Both ends of a binary channel have to agree on it
+uint64_t get_schema_hash();
 // Returns the ast json from which a ast root node can be serialized
 std::string const& get_ast_json();
 typedef int8_t int8_t;
@@ -1309,6 +1312,8 @@ public:
     _250 = 250,
     _500 = 500,
     _1000 = 1000,
+    _4000 = 4000,
+    _8000 = 8000,
   };
 
   enum class acceleration_range_t
@@ -2529,6 +2534,7 @@ public:
   public:
     typedef vec2i resolution_t;
     typedef uint32_t bitrate_t;
+    typedef uint32_t gop_t;
     virtual ~Quality() = default;
     void set_resolution(resolution_t const& value);
     void set_resolution(resolution_t&& value);
@@ -2538,9 +2544,14 @@ public:
     void set_bitrate(bitrate_t&& value);
     auto get_bitrate() const -> bitrate_t const&;
 
+    void set_gop(gop_t const& value);
+    void set_gop(gop_t&& value);
+    auto get_gop() const -> gop_t const&;
+
   private:
     resolution_t m_resolution = {8, 8};
     bitrate_t m_bitrate = {10000};
+    gop_t m_gop = {30};
   };
 
   typedef int32_t fps_t;
@@ -2549,6 +2560,11 @@ public:
   void set_fps(fps_t&& value);
   auto get_fps() const -> fps_t const&;
 
+  void set_streaming_emergency(Quality const& value);
+  void set_streaming_emergency(Quality&& value);
+  auto get_streaming_emergency() const -> Quality const&;
+  auto get_streaming_emergency() -> Quality&;
+
   void set_streaming_low(Quality const& value);
   void set_streaming_low(Quality&& value);
   auto get_streaming_low() const -> Quality const&;
@@ -2566,6 +2582,7 @@ public:
 
 private:
   fps_t m_fps = {10};
+  Quality m_streaming_emergency;
   Quality m_streaming_low;
   Quality m_streaming_high;
   Quality m_recording;
@@ -3085,341 +3102,679 @@ private:
 
 ts::Result<void> deserialize(std::string& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::string const& value);
+ts::Result<void> deserialize(std::string& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::string const& value);
 ts::Result<void> deserialize(bool& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(bool const& value);
+ts::Result<void> deserialize(bool& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, bool const& value);
 ts::Result<void> deserialize(int64_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int64_t const& value);
+ts::Result<void> deserialize(int64_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int64_t const& value);
 ts::Result<void> deserialize(float& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(float const& value);
+ts::Result<void> deserialize(float& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, float const& value);
 ts::Result<void> deserialize(double& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(double const& value);
+ts::Result<void> deserialize(double& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, double const& value);
 ts::Result<void> deserialize(vec2f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2f const& value);
+ts::Result<void> deserialize(vec2f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2f const& value);
 ts::Result<void> deserialize(vec2d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2d const& value);
+ts::Result<void> deserialize(vec2d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2d const& value);
 ts::Result<void> deserialize(vec2i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2i const& value);
+ts::Result<void> deserialize(vec2i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2i const& value);
 ts::Result<void> deserialize(vec3f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3f const& value);
+ts::Result<void> deserialize(vec3f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3f const& value);
 ts::Result<void> deserialize(vec3d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3d const& value);
+ts::Result<void> deserialize(vec3d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3d const& value);
 ts::Result<void> deserialize(vec3i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3i const& value);
+ts::Result<void> deserialize(vec3i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3i const& value);
 ts::Result<void> deserialize(vec4f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4f const& value);
+ts::Result<void> deserialize(vec4f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4f const& value);
 ts::Result<void> deserialize(vec4d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4d const& value);
+ts::Result<void> deserialize(vec4d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4d const& value);
 ts::Result<void> deserialize(vec4i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4i const& value);
+ts::Result<void> deserialize(vec4i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4i const& value);
 ts::Result<void> deserialize(int8_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int8_t const& value);
+ts::Result<void> deserialize(int8_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int8_t const& value);
 ts::Result<void> deserialize(uint8_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint8_t const& value);
+ts::Result<void> deserialize(uint8_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint8_t const& value);
 ts::Result<void> deserialize(int16_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int16_t const& value);
+ts::Result<void> deserialize(int16_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int16_t const& value);
 ts::Result<void> deserialize(uint16_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint16_t const& value);
+ts::Result<void> deserialize(uint16_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint16_t const& value);
 ts::Result<void> deserialize(int32_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int32_t const& value);
+ts::Result<void> deserialize(int32_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int32_t const& value);
 ts::Result<void> deserialize(uint32_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint32_t const& value);
+ts::Result<void> deserialize(uint32_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint32_t const& value);
 ts::Result<void> deserialize(IUAV_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(IUAV_Descriptor const& value);
+ts::Result<void> deserialize(IUAV_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, IUAV_Descriptor const& value);
 ts::Result<void> deserialize(Poly<IUAV_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<IUAV_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<IUAV_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<IUAV_Descriptor> const& value);
 ts::Result<void> deserialize(IBus_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(IBus_Descriptor const& value);
+ts::Result<void> deserialize(IBus_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, IBus_Descriptor const& value);
 ts::Result<void> deserialize(Poly<IBus_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<IBus_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<IBus_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<IBus_Descriptor> const& value);
 ts::Result<void> deserialize(INode_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(INode_Descriptor const& value);
+ts::Result<void> deserialize(INode_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, INode_Descriptor const& value);
 ts::Result<void> deserialize(Poly<INode_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<INode_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<INode_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<INode_Descriptor> const& value);
 ts::Result<void> deserialize(INode_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(INode_Config const& value);
+ts::Result<void> deserialize(INode_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, INode_Config const& value);
 ts::Result<void> deserialize(Poly<INode_Config>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<INode_Config> const& value);
+ts::Result<void> deserialize(Poly<INode_Config>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<INode_Config> const& value);
 ts::Result<void> deserialize(Settings::Bus_Data& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Settings::Bus_Data const& value);
+ts::Result<void> deserialize(Settings::Bus_Data& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Settings::Bus_Data const& value);
 ts::Result<void> deserialize(Settings::Node_Data& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Settings::Node_Data const& value);
+ts::Result<void> deserialize(Settings::Node_Data& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Settings::Node_Data const& value);
 ts::Result<void> deserialize(Settings& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Settings const& value);
+ts::Result<void> deserialize(Settings& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Settings const& value);
 ts::Result<void> deserialize(Poly<const IBus_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<const IBus_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<const IBus_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<const IBus_Descriptor> const& value);
 ts::Result<void> deserialize(Poly<const INode_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<const INode_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<const INode_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<const INode_Descriptor> const& value);
 ts::Result<void> deserialize(Poly<const INode_Config>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<const INode_Config> const& value);
+ts::Result<void> deserialize(Poly<const INode_Config>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<const INode_Config> const& value);
 ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<std::string> const& value);
+ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<std::string> const& value);
 ts::Result<void> deserialize(Poly<const IUAV_Descriptor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<const IUAV_Descriptor> const& value);
+ts::Result<void> deserialize(Poly<const IUAV_Descriptor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<const IUAV_Descriptor> const& value);
 ts::Result<void> deserialize(std::vector<Settings::Bus_Data>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Settings::Bus_Data> const& value);
+ts::Result<void> deserialize(std::vector<Settings::Bus_Data>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Settings::Bus_Data> const& value);
 ts::Result<void> deserialize(std::vector<Settings::Node_Data>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Settings::Node_Data> const& value);
+ts::Result<void> deserialize(std::vector<Settings::Node_Data>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Settings::Node_Data> const& value);
 ts::Result<void> deserialize(Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Tri_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Tri_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Tri_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Tri_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Quad_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Quad_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Quad_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Quad_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Hexa_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Hexa_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Hexa_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Hexa_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Hexatri_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Hexatri_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Hexatri_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Hexatri_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Octo_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Octo_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Octo_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Octo_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Octaquad_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Octaquad_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Octaquad_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Octaquad_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(Custom_Multirotor_Descriptor::Motor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Custom_Multirotor_Descriptor::Motor const& value);
+ts::Result<void> deserialize(Custom_Multirotor_Descriptor::Motor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Custom_Multirotor_Descriptor::Motor const& value);
 ts::Result<void> deserialize(Custom_Multirotor_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Custom_Multirotor_Descriptor const& value);
+ts::Result<void> deserialize(Custom_Multirotor_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Custom_Multirotor_Descriptor const& value);
 ts::Result<void> deserialize(std::vector<Custom_Multirotor_Descriptor::Motor>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Custom_Multirotor_Descriptor::Motor> const& value);
+ts::Result<void> deserialize(std::vector<Custom_Multirotor_Descriptor::Motor>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Custom_Multirotor_Descriptor::Motor> const& value);
 ts::Result<void> deserialize(UART_Linux_Descriptor::baud_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(UART_Linux_Descriptor::baud_t const& value);
+ts::Result<void> deserialize(UART_Linux_Descriptor::baud_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, UART_Linux_Descriptor::baud_t const& value);
 ts::Result<void> deserialize(UART_Linux_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(UART_Linux_Descriptor const& value);
+ts::Result<void> deserialize(UART_Linux_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, UART_Linux_Descriptor const& value);
 ts::Result<void> deserialize(UART_BBang_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(UART_BBang_Descriptor const& value);
+ts::Result<void> deserialize(UART_BBang_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, UART_BBang_Descriptor const& value);
 ts::Result<void> deserialize(I2C_BCM_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(I2C_BCM_Descriptor const& value);
+ts::Result<void> deserialize(I2C_BCM_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, I2C_BCM_Descriptor const& value);
 ts::Result<void> deserialize(I2C_Linux_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(I2C_Linux_Descriptor const& value);
+ts::Result<void> deserialize(I2C_Linux_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, I2C_Linux_Descriptor const& value);
 ts::Result<void> deserialize(SPI_BCM_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SPI_BCM_Descriptor const& value);
+ts::Result<void> deserialize(SPI_BCM_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SPI_BCM_Descriptor const& value);
 ts::Result<void> deserialize(SPI_Linux_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SPI_Linux_Descriptor const& value);
+ts::Result<void> deserialize(SPI_Linux_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SPI_Linux_Descriptor const& value);
 ts::Result<void> deserialize(P_Controller_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(P_Controller_Descriptor const& value);
+ts::Result<void> deserialize(P_Controller_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, P_Controller_Descriptor const& value);
 ts::Result<void> deserialize(PI_Controller_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PI_Controller_Descriptor const& value);
+ts::Result<void> deserialize(PI_Controller_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PI_Controller_Descriptor const& value);
 ts::Result<void> deserialize(PD_Controller_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PD_Controller_Descriptor const& value);
+ts::Result<void> deserialize(PD_Controller_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PD_Controller_Descriptor const& value);
 ts::Result<void> deserialize(PID_Controller_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PID_Controller_Descriptor const& value);
+ts::Result<void> deserialize(PID_Controller_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PID_Controller_Descriptor const& value);
 ts::Result<void> deserialize(ADC_Ammeter_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADC_Ammeter_Descriptor const& value);
+ts::Result<void> deserialize(ADC_Ammeter_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADC_Ammeter_Descriptor const& value);
 ts::Result<void> deserialize(ADC_Ammeter_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADC_Ammeter_Config const& value);
+ts::Result<void> deserialize(ADC_Ammeter_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADC_Ammeter_Config const& value);
 ts::Result<void> deserialize(ADC_Voltmeter_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADC_Voltmeter_Descriptor const& value);
+ts::Result<void> deserialize(ADC_Voltmeter_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADC_Voltmeter_Descriptor const& value);
 ts::Result<void> deserialize(ADC_Voltmeter_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADC_Voltmeter_Config const& value);
+ts::Result<void> deserialize(ADC_Voltmeter_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADC_Voltmeter_Config const& value);
 ts::Result<void> deserialize(ADS1115_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADS1115_Descriptor const& value);
+ts::Result<void> deserialize(ADS1115_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADS1115_Descriptor const& value);
 ts::Result<void> deserialize(ADS1115_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ADS1115_Config const& value);
+ts::Result<void> deserialize(ADS1115_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ADS1115_Config const& value);
 ts::Result<void> deserialize(AVRADC_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(AVRADC_Descriptor const& value);
+ts::Result<void> deserialize(AVRADC_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, AVRADC_Descriptor const& value);
 ts::Result<void> deserialize(AVRADC_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(AVRADC_Config const& value);
+ts::Result<void> deserialize(AVRADC_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, AVRADC_Config const& value);
 ts::Result<void> deserialize(Comp_AHRS_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Comp_AHRS_Descriptor const& value);
+ts::Result<void> deserialize(Comp_AHRS_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Comp_AHRS_Descriptor const& value);
 ts::Result<void> deserialize(Comp_AHRS_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Comp_AHRS_Config const& value);
+ts::Result<void> deserialize(Comp_AHRS_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Comp_AHRS_Config const& value);
 ts::Result<void> deserialize(Combiner_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Combiner_Descriptor const& value);
+ts::Result<void> deserialize(Combiner_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Combiner_Descriptor const& value);
 ts::Result<void> deserialize(Combiner_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Combiner_Config const& value);
+ts::Result<void> deserialize(Combiner_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Combiner_Config const& value);
 ts::Result<void> deserialize(Gravity_Filter_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Gravity_Filter_Descriptor const& value);
+ts::Result<void> deserialize(Gravity_Filter_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Gravity_Filter_Descriptor const& value);
 ts::Result<void> deserialize(Gravity_Filter_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Gravity_Filter_Config const& value);
+ts::Result<void> deserialize(Gravity_Filter_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Gravity_Filter_Config const& value);
 ts::Result<void> deserialize(KF_ECEF_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(KF_ECEF_Descriptor const& value);
+ts::Result<void> deserialize(KF_ECEF_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, KF_ECEF_Descriptor const& value);
 ts::Result<void> deserialize(KF_ECEF_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(KF_ECEF_Config const& value);
+ts::Result<void> deserialize(KF_ECEF_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, KF_ECEF_Config const& value);
 ts::Result<void> deserialize(ENU_Frame_System_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ENU_Frame_System_Descriptor const& value);
+ts::Result<void> deserialize(ENU_Frame_System_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ENU_Frame_System_Descriptor const& value);
 ts::Result<void> deserialize(ENU_Frame_System_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(ENU_Frame_System_Config const& value);
+ts::Result<void> deserialize(ENU_Frame_System_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, ENU_Frame_System_Config const& value);
 ts::Result<void> deserialize(LPF_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(LPF_Descriptor const& value);
+ts::Result<void> deserialize(LPF_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, LPF_Descriptor const& value);
 ts::Result<void> deserialize(LPF_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(LPF_Config const& value);
+ts::Result<void> deserialize(LPF_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, LPF_Config const& value);
 ts::Result<void> deserialize(MaxSonar_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MaxSonar_Descriptor const& value);
+ts::Result<void> deserialize(MaxSonar_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MaxSonar_Descriptor const& value);
 ts::Result<void> deserialize(MaxSonar_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MaxSonar_Config const& value);
+ts::Result<void> deserialize(MaxSonar_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MaxSonar_Config const& value);
 ts::Result<void> deserialize(Motor_Mixer_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Motor_Mixer_Descriptor const& value);
+ts::Result<void> deserialize(Motor_Mixer_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Motor_Mixer_Descriptor const& value);
 ts::Result<void> deserialize(Motor_Mixer_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Motor_Mixer_Config const& value);
+ts::Result<void> deserialize(Motor_Mixer_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Motor_Mixer_Config const& value);
 ts::Result<void> deserialize(Acceleration_Calibration_Point& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Acceleration_Calibration_Point const& value);
+ts::Result<void> deserialize(Acceleration_Calibration_Point& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Acceleration_Calibration_Point const& value);
 ts::Result<void> deserialize(Angular_Velocity_Calibration_Point& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Angular_Velocity_Calibration_Point const& value);
+ts::Result<void> deserialize(Angular_Velocity_Calibration_Point& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Angular_Velocity_Calibration_Point const& value);
 ts::Result<void> deserialize(Magnetic_Field_Calibration_Point& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Magnetic_Field_Calibration_Point const& value);
+ts::Result<void> deserialize(Magnetic_Field_Calibration_Point& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Magnetic_Field_Calibration_Point const& value);
 ts::Result<void> deserialize(MPU9250_Descriptor::imu_rate_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Descriptor::imu_rate_t const& value);
+ts::Result<void> deserialize(MPU9250_Descriptor::imu_rate_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Descriptor::imu_rate_t const& value);
 ts::Result<void> deserialize(MPU9250_Descriptor::acceleration_range_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Descriptor::acceleration_range_t const& value);
+ts::Result<void> deserialize(MPU9250_Descriptor::acceleration_range_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Descriptor::acceleration_range_t const& value);
 ts::Result<void> deserialize(MPU9250_Descriptor::angular_velocity_range_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Descriptor::angular_velocity_range_t const& value);
+ts::Result<void> deserialize(MPU9250_Descriptor::angular_velocity_range_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Descriptor::angular_velocity_range_t const& value);
 ts::Result<void> deserialize(MPU9250_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Descriptor const& value);
+ts::Result<void> deserialize(MPU9250_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Descriptor const& value);
 ts::Result<void> deserialize(MPU9250_Config::Calibration& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Config::Calibration const& value);
+ts::Result<void> deserialize(MPU9250_Config::Calibration& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Config::Calibration const& value);
 ts::Result<void> deserialize(MPU9250_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MPU9250_Config const& value);
+ts::Result<void> deserialize(MPU9250_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MPU9250_Config const& value);
 ts::Result<void> deserialize(std::vector<Acceleration_Calibration_Point>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Acceleration_Calibration_Point> const& value);
+ts::Result<void> deserialize(std::vector<Acceleration_Calibration_Point>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Acceleration_Calibration_Point> const& value);
 ts::Result<void> deserialize(std::vector<Angular_Velocity_Calibration_Point>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Angular_Velocity_Calibration_Point> const& value);
+ts::Result<void> deserialize(std::vector<Angular_Velocity_Calibration_Point>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Angular_Velocity_Calibration_Point> const& value);
 ts::Result<void> deserialize(std::vector<Magnetic_Field_Calibration_Point>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Magnetic_Field_Calibration_Point> const& value);
+ts::Result<void> deserialize(std::vector<Magnetic_Field_Calibration_Point>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Magnetic_Field_Calibration_Point> const& value);
 ts::Result<void> deserialize(MS5611_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MS5611_Descriptor const& value);
+ts::Result<void> deserialize(MS5611_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MS5611_Descriptor const& value);
 ts::Result<void> deserialize(MS5611_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(MS5611_Config const& value);
+ts::Result<void> deserialize(MS5611_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, MS5611_Config const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Descriptor const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Descriptor const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Config::Horizontal& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Config::Horizontal const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Config::Horizontal& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Config::Horizontal const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Config::Yaw& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Config::Yaw const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Config::Yaw& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Config::Yaw const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Config::Vertical& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Config::Vertical const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Config::Vertical& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Config::Vertical const& value);
 ts::Result<void> deserialize(Multirotor_Brain_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Brain_Config const& value);
+ts::Result<void> deserialize(Multirotor_Brain_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Brain_Config const& value);
 ts::Result<void> deserialize(boost::variant<Multirotor_Brain_Config::Horizontal::Combined_Rate_PIDs,Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(boost::variant<Multirotor_Brain_Config::Horizontal::Combined_Rate_PIDs,Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs> const& value);
+ts::Result<void> deserialize(boost::variant<Multirotor_Brain_Config::Horizontal::Combined_Rate_PIDs,Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, boost::variant<Multirotor_Brain_Config::Horizontal::Combined_Rate_PIDs,Multirotor_Brain_Config::Horizontal::Separate_Rate_PIDs> const& value);
 ts::Result<void> deserialize(Multirotor_Pilot_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Pilot_Descriptor const& value);
+ts::Result<void> deserialize(Multirotor_Pilot_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Pilot_Descriptor const& value);
 ts::Result<void> deserialize(Multirotor_Pilot_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Pilot_Config const& value);
+ts::Result<void> deserialize(Multirotor_Pilot_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Pilot_Config const& value);
 ts::Result<void> deserialize(Multirotor_Simulator_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Simulator_Descriptor const& value);
+ts::Result<void> deserialize(Multirotor_Simulator_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Simulator_Descriptor const& value);
 ts::Result<void> deserialize(Multirotor_Simulator_Config::Noise& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Simulator_Config::Noise const& value);
+ts::Result<void> deserialize(Multirotor_Simulator_Config::Noise& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Simulator_Config::Noise const& value);
 ts::Result<void> deserialize(Multirotor_Simulator_Config::Calibration& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Simulator_Config::Calibration const& value);
+ts::Result<void> deserialize(Multirotor_Simulator_Config::Calibration& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Simulator_Config::Calibration const& value);
 ts::Result<void> deserialize(Multirotor_Simulator_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Multirotor_Simulator_Config const& value);
+ts::Result<void> deserialize(Multirotor_Simulator_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Multirotor_Simulator_Config const& value);
 ts::Result<void> deserialize(Oscillator_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Oscillator_Descriptor const& value);
+ts::Result<void> deserialize(Oscillator_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Oscillator_Descriptor const& value);
 ts::Result<void> deserialize(Oscillator_Config::Component& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Oscillator_Config::Component const& value);
+ts::Result<void> deserialize(Oscillator_Config::Component& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Oscillator_Config::Component const& value);
 ts::Result<void> deserialize(Oscillator_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Oscillator_Config const& value);
+ts::Result<void> deserialize(Oscillator_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Oscillator_Config const& value);
 ts::Result<void> deserialize(std::vector<Oscillator_Config::Component>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Oscillator_Config::Component> const& value);
+ts::Result<void> deserialize(std::vector<Oscillator_Config::Component>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Oscillator_Config::Component> const& value);
 ts::Result<void> deserialize(PCA9685_Descriptor::Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Descriptor::Channel const& value);
+ts::Result<void> deserialize(PCA9685_Descriptor::Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Descriptor::Channel const& value);
 ts::Result<void> deserialize(PCA9685_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Descriptor const& value);
+ts::Result<void> deserialize(PCA9685_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Descriptor const& value);
 ts::Result<void> deserialize(std::vector<PCA9685_Descriptor::Channel>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<PCA9685_Descriptor::Channel> const& value);
+ts::Result<void> deserialize(std::vector<PCA9685_Descriptor::Channel>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<PCA9685_Descriptor::Channel> const& value);
 ts::Result<void> deserialize(PCA9685_Config::IChannel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Config::IChannel const& value);
+ts::Result<void> deserialize(PCA9685_Config::IChannel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Config::IChannel const& value);
 ts::Result<void> deserialize(PCA9685_Config::Servo_Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Config::Servo_Channel const& value);
+ts::Result<void> deserialize(PCA9685_Config::Servo_Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Config::Servo_Channel const& value);
 ts::Result<void> deserialize(PCA9685_Config::PWM_Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Config::PWM_Channel const& value);
+ts::Result<void> deserialize(PCA9685_Config::PWM_Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Config::PWM_Channel const& value);
 ts::Result<void> deserialize(PCA9685_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PCA9685_Config const& value);
+ts::Result<void> deserialize(PCA9685_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PCA9685_Config const& value);
 ts::Result<void> deserialize(Poly<PCA9685_Config::IChannel>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<PCA9685_Config::IChannel> const& value);
+ts::Result<void> deserialize(Poly<PCA9685_Config::IChannel>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<PCA9685_Config::IChannel> const& value);
 ts::Result<void> deserialize(std::vector<Poly<PCA9685_Config::IChannel>>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<Poly<PCA9685_Config::IChannel>> const& value);
+ts::Result<void> deserialize(std::vector<Poly<PCA9685_Config::IChannel>>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<Poly<PCA9685_Config::IChannel>> const& value);
 ts::Result<void> deserialize(PIGPIO_Descriptor::Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Descriptor::Channel const& value);
+ts::Result<void> deserialize(PIGPIO_Descriptor::Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Descriptor::Channel const& value);
 ts::Result<void> deserialize(PIGPIO_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Descriptor const& value);
+ts::Result<void> deserialize(PIGPIO_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Descriptor const& value);
 ts::Result<void> deserialize(PIGPIO_Config::IChannel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Config::IChannel const& value);
+ts::Result<void> deserialize(PIGPIO_Config::IChannel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Config::IChannel const& value);
 ts::Result<void> deserialize(PIGPIO_Config::Servo_Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Config::Servo_Channel const& value);
+ts::Result<void> deserialize(PIGPIO_Config::Servo_Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Config::Servo_Channel const& value);
 ts::Result<void> deserialize(PIGPIO_Config::PWM_Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Config::PWM_Channel const& value);
+ts::Result<void> deserialize(PIGPIO_Config::PWM_Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Config::PWM_Channel const& value);
 ts::Result<void> deserialize(PIGPIO_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(PIGPIO_Config const& value);
+ts::Result<void> deserialize(PIGPIO_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, PIGPIO_Config const& value);
 ts::Result<void> deserialize(Poly<PIGPIO_Config::IChannel>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Poly<PIGPIO_Config::IChannel> const& value);
+ts::Result<void> deserialize(Poly<PIGPIO_Config::IChannel>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Poly<PIGPIO_Config::IChannel> const& value);
 ts::Result<void> deserialize(Pressure_Velocity_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Pressure_Velocity_Descriptor const& value);
+ts::Result<void> deserialize(Pressure_Velocity_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Pressure_Velocity_Descriptor const& value);
 ts::Result<void> deserialize(Pressure_Velocity_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Pressure_Velocity_Config const& value);
+ts::Result<void> deserialize(Pressure_Velocity_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Pressure_Velocity_Config const& value);
 ts::Result<void> deserialize(Proximity_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Proximity_Descriptor const& value);
+ts::Result<void> deserialize(Proximity_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Proximity_Descriptor const& value);
 ts::Result<void> deserialize(Proximity_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Proximity_Config const& value);
+ts::Result<void> deserialize(Proximity_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Proximity_Config const& value);
 ts::Result<void> deserialize(Rate_Controller_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Rate_Controller_Descriptor const& value);
+ts::Result<void> deserialize(Rate_Controller_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Rate_Controller_Descriptor const& value);
 ts::Result<void> deserialize(Rate_Controller_Config::Feedback::Separate_XY_PIDs& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Rate_Controller_Config::Feedback::Separate_XY_PIDs const& value);
+ts::Result<void> deserialize(Rate_Controller_Config::Feedback::Separate_XY_PIDs& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Rate_Controller_Config::Feedback::Separate_XY_PIDs const& value);
 ts::Result<void> deserialize(Rate_Controller_Config::Feedback& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Rate_Controller_Config::Feedback const& value);
+ts::Result<void> deserialize(Rate_Controller_Config::Feedback& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Rate_Controller_Config::Feedback const& value);
 ts::Result<void> deserialize(Rate_Controller_Config::Feedforward& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Rate_Controller_Config::Feedforward const& value);
+ts::Result<void> deserialize(Rate_Controller_Config::Feedforward& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Rate_Controller_Config::Feedforward const& value);
 ts::Result<void> deserialize(Rate_Controller_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Rate_Controller_Config const& value);
+ts::Result<void> deserialize(Rate_Controller_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Rate_Controller_Config const& value);
 ts::Result<void> deserialize(boost::variant<Rate_Controller_Config::Feedback::Combined_XY_PIDs,Rate_Controller_Config::Feedback::Separate_XY_PIDs>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(boost::variant<Rate_Controller_Config::Feedback::Combined_XY_PIDs,Rate_Controller_Config::Feedback::Separate_XY_PIDs> const& value);
+ts::Result<void> deserialize(boost::variant<Rate_Controller_Config::Feedback::Combined_XY_PIDs,Rate_Controller_Config::Feedback::Separate_XY_PIDs>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, boost::variant<Rate_Controller_Config::Feedback::Combined_XY_PIDs,Rate_Controller_Config::Feedback::Separate_XY_PIDs> const& value);
 ts::Result<void> deserialize(Raspicam_Descriptor::Quality& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Raspicam_Descriptor::Quality const& value);
+ts::Result<void> deserialize(Raspicam_Descriptor::Quality& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Raspicam_Descriptor::Quality const& value);
 ts::Result<void> deserialize(Raspicam_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Raspicam_Descriptor const& value);
+ts::Result<void> deserialize(Raspicam_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Raspicam_Descriptor const& value);
 ts::Result<void> deserialize(Raspicam_Config::quality_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Raspicam_Config::quality_t const& value);
+ts::Result<void> deserialize(Raspicam_Config::quality_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Raspicam_Config::quality_t const& value);
 ts::Result<void> deserialize(Raspicam_Config::awb_mode_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Raspicam_Config::awb_mode_t const& value);
+ts::Result<void> deserialize(Raspicam_Config::awb_mode_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Raspicam_Config::awb_mode_t const& value);
 ts::Result<void> deserialize(Raspicam_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Raspicam_Config const& value);
+ts::Result<void> deserialize(Raspicam_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Raspicam_Config const& value);
 ts::Result<void> deserialize(RC5T619_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(RC5T619_Descriptor const& value);
+ts::Result<void> deserialize(RC5T619_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, RC5T619_Descriptor const& value);
 ts::Result<void> deserialize(RC5T619_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(RC5T619_Config const& value);
+ts::Result<void> deserialize(RC5T619_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, RC5T619_Config const& value);
 ts::Result<void> deserialize(Resampler_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Resampler_Descriptor const& value);
+ts::Result<void> deserialize(Resampler_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Resampler_Descriptor const& value);
 ts::Result<void> deserialize(Resampler_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Resampler_Config const& value);
+ts::Result<void> deserialize(Resampler_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Resampler_Config const& value);
 ts::Result<void> deserialize(Scalar_Generator_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Scalar_Generator_Descriptor const& value);
+ts::Result<void> deserialize(Scalar_Generator_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Scalar_Generator_Descriptor const& value);
 ts::Result<void> deserialize(Scalar_Generator_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Scalar_Generator_Config const& value);
+ts::Result<void> deserialize(Scalar_Generator_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Scalar_Generator_Config const& value);
 ts::Result<void> deserialize(Servo_Gimbal_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Servo_Gimbal_Descriptor const& value);
+ts::Result<void> deserialize(Servo_Gimbal_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Servo_Gimbal_Descriptor const& value);
 ts::Result<void> deserialize(Servo_Gimbal_Config::Channel& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Servo_Gimbal_Config::Channel const& value);
+ts::Result<void> deserialize(Servo_Gimbal_Config::Channel& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Servo_Gimbal_Config::Channel const& value);
 ts::Result<void> deserialize(Servo_Gimbal_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Servo_Gimbal_Config const& value);
+ts::Result<void> deserialize(Servo_Gimbal_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Servo_Gimbal_Config const& value);
 ts::Result<void> deserialize(SRF01_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SRF01_Descriptor const& value);
+ts::Result<void> deserialize(SRF01_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SRF01_Descriptor const& value);
 ts::Result<void> deserialize(SRF01_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SRF01_Config const& value);
+ts::Result<void> deserialize(SRF01_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SRF01_Config const& value);
 ts::Result<void> deserialize(SRF02_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SRF02_Descriptor const& value);
+ts::Result<void> deserialize(SRF02_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SRF02_Descriptor const& value);
 ts::Result<void> deserialize(SRF02_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(SRF02_Config const& value);
+ts::Result<void> deserialize(SRF02_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, SRF02_Config const& value);
 ts::Result<void> deserialize(Throttle_To_PWM_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Throttle_To_PWM_Descriptor const& value);
+ts::Result<void> deserialize(Throttle_To_PWM_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Throttle_To_PWM_Descriptor const& value);
 ts::Result<void> deserialize(Throttle_To_PWM_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Throttle_To_PWM_Config const& value);
+ts::Result<void> deserialize(Throttle_To_PWM_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Throttle_To_PWM_Config const& value);
 ts::Result<void> deserialize(Transformer_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Transformer_Descriptor const& value);
+ts::Result<void> deserialize(Transformer_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Transformer_Descriptor const& value);
 ts::Result<void> deserialize(Transformer_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Transformer_Config const& value);
+ts::Result<void> deserialize(Transformer_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Transformer_Config const& value);
 ts::Result<void> deserialize(UBLOX_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(UBLOX_Descriptor const& value);
+ts::Result<void> deserialize(UBLOX_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, UBLOX_Descriptor const& value);
 ts::Result<void> deserialize(UBLOX_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(UBLOX_Config const& value);
+ts::Result<void> deserialize(UBLOX_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, UBLOX_Config const& value);
 ts::Result<void> deserialize(Vec3_Generator_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Vec3_Generator_Descriptor const& value);
+ts::Result<void> deserialize(Vec3_Generator_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Vec3_Generator_Descriptor const& value);
 ts::Result<void> deserialize(Vec3_Generator_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(Vec3_Generator_Config const& value);
+ts::Result<void> deserialize(Vec3_Generator_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, Vec3_Generator_Config const& value);
 ts::Result<void> deserialize(CPPM_Receiver_Descriptor::gpio_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(CPPM_Receiver_Descriptor::gpio_t const& value);
+ts::Result<void> deserialize(CPPM_Receiver_Descriptor::gpio_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, CPPM_Receiver_Descriptor::gpio_t const& value);
 ts::Result<void> deserialize(CPPM_Receiver_Descriptor& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(CPPM_Receiver_Descriptor const& value);
+ts::Result<void> deserialize(CPPM_Receiver_Descriptor& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, CPPM_Receiver_Descriptor const& value);
 ts::Result<void> deserialize(CPPM_Receiver_Config& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(CPPM_Receiver_Config const& value);
+ts::Result<void> deserialize(CPPM_Receiver_Config& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, CPPM_Receiver_Config const& value);
 }
 }
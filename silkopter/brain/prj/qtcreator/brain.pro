@@ -19,6 +19,9 @@ CONFIG *= precompile_header
 
 rpi {
     DEFINES+=RASPBERRY_PI
+    #the Pi 2/3 have neon, the fec kernels use it
+    QMAKE_CXXFLAGS += -mfpu=neon-vfpv4
+    QMAKE_CFLAGS += -mfpu=neon-vfpv4
     QMAKE_MAKEFILE = "Makefile.rpi"
     MAKEFILE = "Makefile.rpi"
     CONFIG(debug, debug|release) {
@@ -120,6 +123,7 @@ SOURCES += \
     ../../src/simulator/Multirotor_Simulator.cpp \
     ../../src/processor/Servo_Gimbal.cpp \
     ../../src/processor/Motor_Mixer.cpp \
+    ../../src/processor/Motor_Allocation.cpp \
     ../../src/source/ADS1115.cpp \
     ../../src/sink/PCA9685.cpp \
     ../../src/generator/Oscillator.cpp \
@@ -144,10 +148,12 @@ SOURCES += \
     ../../src/pilot/Multirotor_Pilot.cpp \
     ../../def/hal.def.cpp \
     ../../../libs/common/comms/def/gs_comms.def.cpp \
+    ../../../libs/common/comms/Setup_Codec.cpp \
     ../../src/uav_properties/IMultirotor_Properties.cpp \
     ../../src/HAL.cpp \
     ../../src/RC_Comms.cpp \
     ../../src/GS_Comms.cpp \
+    ../../src/Tick_Timer.cpp \
     ../../src/uav_properties/Hexa_Multirotor_Properties.cpp \
     ../../src/uav_properties/Hexatri_Multirotor_Properties.cpp \
     ../../src/uav_properties/Octo_Multirotor_Properties.cpp \
@@ -183,6 +189,7 @@ HEADERS += \
     ../../../libs/common/Manual_Clock.h \
     ../../src/bus/I2C_Linux.h \
     ../../src/bus/SPI_Linux.h \
+    ../../src/bus/Async_Bus_Queue.h \
     ../../src/bus/UART_Linux.h \ 
     ../../../libs/common/node/source/IInertial.h \
     ../../src/sink/PIGPIO.h \
@@ -197,6 +204,8 @@ HEADERS += \
     ../../src/processor/EKF_AHRS.h \
     ../../src/processor/Comp_AHRS.h \
     ../../../libs/utils/Butterworth.h \
+    ../../../libs/utils/Polyphase_Resampler.h \
+    ../../../libs/utils/Kalman_Filter.h \
     ../../../libs/common/node/INode.h \
     ../../../libs/common/node/ISink.h \
     ../../../libs/common/node/ISource.h \
@@ -222,6 +231,7 @@ HEADERS += \
     ../../../libs/common/node/IConfig.h \
     ../../src/processor/Servo_Gimbal.h \
     ../../src/processor/Motor_Mixer.h \
+    ../../src/processor/Motor_Allocation.h \
     ../../src/source/ADS1115.h \
     ../../src/sink/PCA9685.h \
     ../../src/generator/Oscillator.h \
@@ -263,6 +273,8 @@ HEADERS += \
     ../../../libs/common/stream/IVelocity.h \
     ../../../libs/common/stream/IVideo.h \
     ../../../libs/common/stream/IVoltage.h \
+    ../../../libs/common/stream/Telemetry_Codec.h \
+    ../../../libs/common/stream/Stream_Type_Map.h \
     ../../../libs/common/stream/Stream_Base.h \
     ../../../libs/common/bus/IBus.h \
     ../../../libs/common/bus/II2C.h \
@@ -296,11 +308,14 @@ HEADERS += \
     ../../def/gen_support.h \
     ../../def/hal.def.h \
     ../../../libs/common/comms/def/gs_comms.def.h \
+    ../../../libs/common/comms/Setup_Codec.h \
     ../../src/uav_properties/IMultirotor_Properties.h \
     ../../src/uav_properties/IUAV_Properties.h \
     ../../src/HAL.h \
     ../../src/RC_Comms.h \
     ../../src/GS_Comms.h \
+    ../../src/Tick_Timer.h \
+    ../../src/Sample_Latency.h \
     ../../src/uav_properties/Hexa_Multirotor_Properties.h \
     ../../src/uav_properties/Hexatri_Multirotor_Properties.h \
     ../../src/uav_properties/Octo_Multirotor_Properties.h \
@@ -326,7 +341,15 @@ HEADERS += \
     ../../../libs/utils/hw/Si4463.h \
     ../../../libs/utils/hw/SPI_Dev.h \
     ../../../libs/utils/comms/Video_Streamer.h \
+    ../../../libs/utils/comms/Video_Link_Controller.h \
     ../../../libs/utils/Pool.h \
+    ../../../libs/utils/Ring_Buffer.h \
+    ../../../libs/utils/MPSC_Queue.h \
+    ../../../libs/utils/MPMC_Queue.h \
+    ../../../libs/utils/Column_Codec.h \
+    ../../../libs/utils/Latency_Histogram.h \
+    ../../../libs/utils/Simd.h \
+    ../../../libs/utils/Int16_Convert.h \
     ../../../libs/utils/comms/fec.h \
     ../../../libs/utils/hw/RFM22B.h \
     ../../../libs/utils/comms/RC_Phy.h \
@@ -6,7 +6,7 @@ rpi {
     MKFL = "Makefile"
 }
 
-SUBDIRS += qmath qdata qbase def_lang brain
+SUBDIRS += qmath qdata qbase def_lang brain brain_test
 
 def_lang.file = ../../../../def_lang/prj/qtcreator/def_lang.pro
 def_lang.makefile = $${MKFL}
@@ -20,3 +20,7 @@ qmath.makefile = $${MKFL}
 brain.file = brain.pro
 brain.depends = def_lang qbase qdata qmath
 
+brain_test.file = brain_test.pro
+brain_test.makefile = $${MKFL}
+brain_test.depends = def_lang qbase qdata qmath
+
@@ -0,0 +1,87 @@
+TEMPLATE = app
+CONFIG += console
+CONFIG -= qt
+CONFIG += c++11
+
+TARGET = brain_test
+target.path = /root
+INSTALLS = target
+
+PRECOMPILED_HEADER = ../../src/BrainStdAfx.h
+CONFIG *= precompile_header
+
+rpi {
+    DEFINES+=RASPBERRY_PI
+    #the Pi 2/3 have neon, the fec kernels use it
+    QMAKE_CXXFLAGS += -mfpu=neon-vfpv4
+    QMAKE_CFLAGS += -mfpu=neon-vfpv4
+    QMAKE_MAKEFILE = "Makefile.rpi"
+    MAKEFILE = "Makefile.rpi"
+    CONFIG(debug, debug|release) {
+        DEST_FOLDER = rpi/debug
+    }
+    CONFIG(release, debug|release) {
+        DEST_FOLDER = rpi/release
+        DEFINES += NDEBUG
+    }
+} else {
+    QMAKE_MAKEFILE = "Makefile"
+    CONFIG(debug, debug|release) {
+        DEST_FOLDER = pc/debug
+    }
+    CONFIG(release, debug|release) {
+        DEST_FOLDER = pc/release
+        DEFINES += NDEBUG
+    }
+}
+
+OBJECTS_DIR = ./.obj/test/$${DEST_FOLDER}
+MOC_DIR = ./.moc/test/$${DEST_FOLDER}
+RCC_DIR = ./.rcc/test/$${DEST_FOLDER}
+UI_DIR = ./.ui/test/$${DEST_FOLDER}
+DESTDIR = ../../bin/$${DEST_FOLDER}
+
+QMAKE_CXXFLAGS += -Wno-unused-variable -Wno-unused-parameter
+QMAKE_CFLAGS += -Wno-unused-variable -Wno-unused-parameter
+
+INCLUDEPATH += ../../src
+INCLUDEPATH += ../../def
+INCLUDEPATH += ../../../libs
+INCLUDEPATH += ../../../libs/common/comms/def
+INCLUDEPATH += ../../../../def_lang/include
+INCLUDEPATH += ../../../../qbase/include
+INCLUDEPATH += ../../../../qdata/include
+INCLUDEPATH += ../../../../qmath/include
+INCLUDEPATH += ../../../../eigen
+
+ROOT_LIBS_PATH = ../../../..
+
+LIBS += -L$${ROOT_LIBS_PATH}/def_lang/lib/$${DEST_FOLDER} -ldef_lang
+LIBS += -L$${ROOT_LIBS_PATH}/qdata/lib/$${DEST_FOLDER} -lqdata
+LIBS += -L$${ROOT_LIBS_PATH}/qmath/lib/$${DEST_FOLDER} -lqmath
+LIBS += -L$${ROOT_LIBS_PATH}/qbase/lib/$${DEST_FOLDER} -lqbase
+
+LIBS += -lpthread
+LIBS += -lboost_system
+LIBS += -lboost_thread
+LIBS += -lz
+LIBS += -lpcap
+
+SOURCES += \
+    ../../test/main.cpp \
+    ../../test/bench_kalman_filter.cpp \
+    ../../test/bench_motor_allocation.cpp \
+    ../../test/bench_rcp.cpp \
+    ../../test/bench_fec.cpp \
+    ../../test/bench_resampler.cpp \
+    ../../test/bench_serialization.cpp \
+    ../../test/bench_telemetry_codec.cpp \
+    ../../test/bench_video_streamer.cpp \
+    ../../../libs/utils/comms/fec.cpp \
+    ../../../libs/utils/comms/RCP.cpp \
+    ../../../libs/utils/comms/Video_Streamer.cpp \
+    ../../../libs/lz4/lz4.c \
+    ../../src/processor/Motor_Allocation.cpp \
+    ../../def/hal.def.cpp \
+    ../../../libs/common/comms/def/gs_comms.def.cpp \
+    ../../../libs/common/comms/Setup_Codec.cpp
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <type_traits>
+#include "Sample_Latency.h"
 
 
 
@@ -18,7 +19,7 @@ public:
     Basic_Output_Stream() = default;
 
     Sample const& get_last_sample() const { return m_last_sample; }
-    std::vector<Sample> const& get_samples() const { return m_samples; }
+    util::Ring_Buffer<Sample> const& get_samples() const { return m_samples; }
     uint32_t get_rate() const { return m_rate; }
 
     void set_rate(uint32_t rate)
@@ -31,6 +32,11 @@ public:
         {
             m_dt = std::chrono::microseconds(0);
         }
+        if (m_rate != rate)
+        {
+            //room for 200ms worth of samples so slow consumers don't lose any
+            m_samples.set_capacity(std::max<size_t>(rate / 5, 16));
+        }
         m_rate = rate;
     }
     void set_tp(q::Clock::time_point tp)
@@ -38,6 +44,15 @@ public:
         m_tp = tp;
     }
 
+    void set_group_delay(q::Clock::duration delay)
+    {
+        m_group_delay = delay;
+    }
+    auto get_group_delay() const -> q::Clock::duration override
+    {
+        return m_group_delay;
+    }
+
     q::Clock::duration get_dt() const
     {
         return m_dt;
@@ -64,17 +79,15 @@ public:
     void push_sample(Value const& value, bool is_healthy)
     {
         m_tp += m_dt;
+        push(value, is_healthy);
+    }
 
-        auto future = q::Clock::now() + m_dt * 5;
-        if (m_tp > future && !m_future_warning)
-        {
-            m_future_warning = true;
-            QLOGW("Samples from the future: {}", m_tp - q::Clock::now());
-        }
-
-        m_last_sample.value = value;
-        m_last_sample.is_healthy = is_healthy;
-        m_samples.push_back(m_last_sample);
+    //For sources that know when each sample was taken (like the sensor FIFOs).
+    //The following samples pushed without a tp continue from this one.
+    void push_sample(Value const& value, q::Clock::time_point tp, bool is_healthy)
+    {
+        m_tp = tp;
+        push(value, is_healthy);
     }
 
     void clear()
@@ -91,15 +104,30 @@ public:
             return 0;
         }
         size_t samples_needed = dt / m_dt;
-        m_samples.reserve(samples_needed);
         return samples_needed;
     }
 
 private:
+    void push(Value const& value, bool is_healthy)
+    {
+        auto future = q::Clock::now() + m_dt * 5;
+        if (m_tp > future && !m_future_warning)
+        {
+            m_future_warning = true;
+            QLOGW("Samples from the future: {}", m_tp - q::Clock::now());
+        }
+
+        m_last_sample.value = value;
+        m_last_sample.is_healthy = is_healthy;
+        m_last_sample.tp = get_sample_origin(m_tp);
+        m_samples.push_back(m_last_sample);
+    }
+
     q::Clock::duration m_dt;
     q::Clock::time_point m_tp = q::Clock::now();
     uint32_t m_rate = 0;
-    std::vector<Sample> m_samples;
+    q::Clock::duration m_group_delay = q::Clock::duration(0);
+    util::Ring_Buffer<Sample> m_samples;
     Sample m_last_sample;
     bool m_future_warning = false;
 };
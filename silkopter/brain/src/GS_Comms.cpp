@@ -27,6 +27,8 @@
 #include "common/stream/IProximity.h"
 #include "common/stream/IMultirotor_State.h"
 #include "common/stream/IMultirotor_Commands.h"
+#include "common/stream/Telemetry_Codec.h"
+#include "common/stream/Stream_Type_Map.h"
 
 #include "common/node/IBrain.h"
 
@@ -37,6 +39,7 @@
 #include "hal.def.h"
 #include "gs_comms.def.h"
 #include "def_lang/JSON_Serializer.h"
+#include "def_lang/Binary_Serializer.h"
 
 #include <boost/asio.hpp>
 
@@ -128,97 +131,70 @@ auto GS_Comms::is_connected() const -> bool
     return m_is_connected;
 }
 
-template<class Stream> auto GS_Comms::gather_telemetry_stream(Stream_Telemetry_Data& ts, stream::IStream const& _stream) -> bool
+template<class Stream>
+struct GS_Comms::Telemetry_Samples : public GS_Comms::ITelemetry_Samples
 {
-    if (_stream.get_type() == Stream::TYPE)
+    std::vector<typename Stream::Sample> samples;
+    stream::Telemetry_Codec<Stream> codec;
+
+    void gather(stream::IStream const& _stream, std::string const& stream_path) override
     {
+        QASSERT(_stream.get_type() == Stream::TYPE);
         auto const& stream = static_cast<Stream const&>(_stream);
-        auto const& samples = stream.get_samples();
 
-        if (ts.sample_count < 1000000)
+        //the samples are kept as they are until packing, the codec needs all of them to build the columns.
+        //The gs doesn't decode more than MAX_BOOL_COLUMN_SIZE in one packet
+        auto frame = stream.get_samples().get_frame();
+        if (samples.size() + frame.size() <= util::column_codec::MAX_BOOL_COLUMN_SIZE)
         {
-            ts.sample_count += static_cast<uint32_t>(samples.size());
-            size_t off = ts.data.size();
-
-            for (auto const& s: samples)
+            for (auto const& s: frame)
             {
-                util::serialization::serialize(ts.data, s, off);
+                samples.push_back(s);
             }
         }
         else
         {
-            QLOGW("Too many samples accumulated in the telemetry buffer for stream {}: {}", ts.stream_path, ts.sample_count);
+            QLOGW("Too many samples accumulated in the telemetry buffer for stream {}: {}", stream_path, samples.size());
         }
-        return true;
     }
-    return false;
+    auto get_count() const -> size_t override
+    {
+        return samples.size();
+    }
+    void encode(std::vector<uint8_t>& data) override
+    {
+        size_t off = data.size();
+        codec.encode(data, samples, off);
+        samples.clear();
+    }
+};
+
+struct GS_Comms::Telemetry_Samples_Factory
+{
+    template<class Stream> auto create() -> Create_Telemetry_Samples
+    {
+        return []() -> std::shared_ptr<ITelemetry_Samples> { return std::make_shared<Telemetry_Samples<Stream>>(); };
+    }
+};
+
+auto GS_Comms::create_telemetry_samples(stream::Type type) -> std::shared_ptr<ITelemetry_Samples>
+{
+    static const stream::Stream_Type_Map<Create_Telemetry_Samples> s_factories((Telemetry_Samples_Factory()));
+    Create_Telemetry_Samples const* create = s_factories.find(type);
+    return create ? (*create)() : nullptr;
 }
 
 void GS_Comms::gather_telemetry_data()
 {
+    std::lock_guard<std::mutex> lg(m_telemetry_mutex);
+
     //first we gather samples and we send them at 30Hz. This improves bandwidth by reducing header overhead and allowing for better compression
     for (auto& ts: m_stream_telemetry_data)
     {
         auto stream = ts.stream.lock();
         if (stream)
         {
-            if (gather_telemetry_stream<stream::IAcceleration>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Acceleration>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Acceleration>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IAngular_Velocity>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Angular_Velocity>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Angular_Velocity>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IMagnetic_Field>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Magnetic_Field>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Magnetic_Field>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::ILinear_Acceleration>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Linear_Acceleration>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Linear_Acceleration>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IECEF_Position>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IVelocity>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Velocity>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Velocity>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IGimbal_Frame>(ts, *stream) ||
-                gather_telemetry_stream<stream::IFrame>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Frame>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IForce>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Force>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Force>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::ITorque>(ts, *stream) ||
-                gather_telemetry_stream<stream::IENU_Torque>(ts, *stream) ||
-                gather_telemetry_stream<stream::IECEF_Torque>(ts, *stream) ||
-
-                gather_telemetry_stream<stream::IPressure>(ts, *stream) ||
-                gather_telemetry_stream<stream::IBattery_State>(ts, *stream) ||
-                gather_telemetry_stream<stream::ICurrent>(ts, *stream) ||
-                gather_telemetry_stream<stream::IVoltage>(ts, *stream) ||
-                gather_telemetry_stream<stream::IDistance>(ts, *stream) ||
-                gather_telemetry_stream<stream::IPWM>(ts, *stream) ||
-                gather_telemetry_stream<stream::IGPS_Info>(ts, *stream) ||
-                gather_telemetry_stream<stream::ITemperature>(ts, *stream) ||
-                gather_telemetry_stream<stream::IADC>(ts, *stream) ||
-                gather_telemetry_stream<stream::IFloat>(ts, *stream) ||
-                gather_telemetry_stream<stream::IBool>(ts, *stream) ||
-                gather_telemetry_stream<stream::IThrottle>(ts, *stream) ||
-                gather_telemetry_stream<stream::IMultirotor_Commands>(ts, *stream) ||
-                gather_telemetry_stream<stream::IMultirotor_State>(ts, *stream) ||
-                gather_telemetry_stream<stream::IProximity>(ts, *stream) ||
-                gather_telemetry_stream<stream::IVideo>(ts, *stream))
-            {
-                ;//nothing
-            }
-            else
-            {
-                QLOGE("Unrecognized stream type: {} / {}:{}", ts.stream_path, static_cast<int>(stream->get_type().get_semantic()), static_cast<int>(stream->get_type().get_space()));
-            }
+            ts.samples->gather(*stream, ts.stream_path);
         }
     }
 
@@ -231,12 +207,27 @@ void GS_Comms::gather_telemetry_data()
         m_internal_telemetry_data.sample_count++;
         size_t off = m_internal_telemetry_data.data.size();
 
+        auto serialize_percentiles = [this, &off](HAL::Telemetry_Data::Percentiles const& percentiles)
+        {
+            auto dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(percentiles.p50).count());
+            util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
+            dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(percentiles.p99).count());
+            util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
+            dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(percentiles.p999).count());
+            util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
+        };
+
+        //The #hal layout has no version: the end to end latency sits before the node count and each node carries its
+        // call rate and percentiles, so a GS built before they were added misreads it. Update the brain and GS together.
+        //Keep in sync with Comms::handle_internal_telemetry_stream in the GS.
         auto dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(telemetry_data.total_duration).count());
         util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
 
         dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(telemetry_data.max_total_duration).count());
         util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
 
+        serialize_percentiles(telemetry_data.end_to_end_latency);
+
         util::serialization::serialize(m_internal_telemetry_data.data, static_cast<uint32_t>(telemetry_data.nodes.size()), off);
 
         for (auto const& nt: telemetry_data.nodes)
@@ -251,25 +242,33 @@ void GS_Comms::gather_telemetry_data()
 
             dt = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(node_telemetry_data.max_process_duration).count());
             util::serialization::serialize(m_internal_telemetry_data.data, dt, off);
+
+            util::serialization::serialize(m_internal_telemetry_data.data, node_telemetry_data.call_rate, off);
+            serialize_percentiles(node_telemetry_data.process_percentiles);
+            serialize_percentiles(node_telemetry_data.sample_age_percentiles);
         }
     }
 }
 
 void GS_Comms::pack_telemetry_data()
 {
+    std::lock_guard<std::mutex> lg(m_telemetry_mutex);
+
     for (auto& ts: m_stream_telemetry_data)
     {
-        if (!ts.data.empty() && ts.sample_count > 0)
+        if (ts.samples && ts.samples->get_count() > 0)
         {
+            uint32_t sample_count = static_cast<uint32_t>(ts.samples->get_count());
+            m_stream_telemetry_buffer.clear();
+            ts.samples->encode(m_stream_telemetry_buffer);
+
             m_telemetry_channel.begin_pack();
             m_telemetry_channel.pack_param(ts.stream_path);
             m_telemetry_channel.pack_param(ts.stream_type);
-            m_telemetry_channel.pack_param(ts.sample_count);
-            m_telemetry_channel.pack_data(ts.data.data(), ts.data.size());
+            m_telemetry_channel.pack_param(sample_count);
+            m_telemetry_channel.pack_data(m_stream_telemetry_buffer.data(), m_stream_telemetry_buffer.size());
             m_telemetry_channel.end_pack();
         }
-        ts.data.clear();
-        ts.sample_count = 0;
     }
 
     if (m_internal_telemetry_data.is_enabled)
@@ -294,9 +293,8 @@ void GS_Comms::serialize_and_send(size_t channel_idx, T const& message)
     TIMED_FUNCTION();
     if (m_rcp->is_connected())
     {
-        ts::sz::Value sz_value = silk::gs_comms::serialize(message);
-        ts::sz::to_json(m_json_buffer, sz_value, false);
-        if (!m_rcp->send(channel_idx, m_json_buffer.data(), m_json_buffer.size()))
+        std::string const& data = m_setup_codec.encode_message(message);
+        if (!m_rcp->send(channel_idx, data.data(), data.size()))
         {
             QLOGE("Failed to send message");
             return;
@@ -304,29 +302,6 @@ void GS_Comms::serialize_and_send(size_t channel_idx, T const& message)
     }
 }
 
-std::string const& GS_Comms::decode_json(std::string const& json_base64)
-{
-    m_base64_buffer.resize(q::util::compute_base64_max_decoded_size(json_base64.size()));
-    auto last_it = q::util::decode_base64(json_base64.data(), json_base64.data() + json_base64.size(), m_base64_buffer.begin());
-    m_base64_buffer.erase(last_it, m_base64_buffer.end());
-    return m_base64_buffer;
-}
-std::string const& GS_Comms::encode_json(std::string const& json)
-{
-    m_base64_buffer.resize(q::util::compute_base64_encoded_size(json.size()));
-    q::util::encode_base64(reinterpret_cast<uint8_t const*>(json.data()), json.size(), &m_base64_buffer[0]);
-
-    {
-        std::string buf;
-        buf.resize(q::util::compute_base64_max_decoded_size(m_base64_buffer.size()));
-        auto last_it = q::util::decode_base64(m_base64_buffer.data(), m_base64_buffer.data() + m_base64_buffer.size(), buf.begin());
-        buf.erase(last_it, buf.end());
-        QASSERT(json == buf);
-    }
-
-    return m_base64_buffer;
-}
-
 
 boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> GS_Comms::get_node_data(std::string const& name, node::INode const& node)
 {
@@ -356,11 +331,15 @@ boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> GS_Comms::get
         node_data.get_outputs().push_back(std::move(node_data_output));
     }
 
-    ts::sz::Value sz_value = hal::serialize(hal::Poly<const hal::INode_Descriptor>(node.get_descriptor()));
-    node_data.set_descriptor_data(encode_json(ts::sz::to_json(m_json_buffer, sz_value, false)));
+    node_data.set_descriptor_data(m_setup_codec.encode_value(hal::Poly<const hal::INode_Descriptor>(node.get_descriptor())));
+    node_data.set_config_data(m_setup_codec.encode_value(hal::Poly<const hal::INode_Config>(node.get_config())));
 
-    sz_value = hal::serialize(hal::Poly<const hal::INode_Config>(node.get_config()));
-    node_data.set_config_data(encode_json((ts::sz::to_json(m_json_buffer, sz_value, false))));
+    m_node_hash_buffer.clear();
+    {
+        ts::sz::Binary_Writer writer(m_node_hash_buffer);
+        gs_comms::serialize(writer, node_data);
+    }
+    node_data.set_hash(q::util::compute_murmur_hash32(m_node_hash_buffer));
 
     return std::move(node_data);
 }
@@ -383,8 +362,21 @@ void GS_Comms::handle_req(gs_comms::setup::Get_AST_Req const& req)
     gs_comms::setup::Brain_Res response = gs_comms::setup::Get_AST_Res();
     gs_comms::setup::Get_AST_Res& res = boost::get<gs_comms::setup::Get_AST_Res>(response);
 
+    //parsed once, it's big and it never changes
+    if (m_ast_value.is_empty())
+    {
+        auto result = ts::sz::from_json(hal::get_ast_json());
+        if (result != ts::success)
+        {
+            response = make_error_response(req.get_req_id(), "Cannot parse the ast json: {}", result.error().what());
+            serialize_and_send(SETUP_CHANNEL, response);
+            return;
+        }
+        m_ast_value = result.extract_payload();
+    }
+
     res.set_req_id(req.get_req_id());
-    res.set_data(encode_json(hal::get_ast_json()));
+    res.set_data(m_setup_codec.encode_value(m_ast_value));
 
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -430,24 +422,18 @@ void GS_Comms::handle_req(gs_comms::setup::Set_UAV_Descriptor_Req const& req)
 
     gs_comms::setup::Brain_Res response;
 
-    std::string const& json = decode_json(req.get_data());
-    auto json_result = ts::sz::from_json(json);
-    if (json_result != ts::success)
-    {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize uav descriptor data: {}", json_result.error().what());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
-    }
     hal::Poly<const hal::IUAV_Descriptor> uav_descriptor;
-    auto deserialize_result = hal::deserialize(uav_descriptor, json_result.payload());
+    auto deserialize_result = m_setup_codec.decode_value(uav_descriptor, req.get_data());
     if (deserialize_result != ts::success)
     {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize uav descriptor json: {}", deserialize_result.error().what());
+        response = make_error_response(req.get_req_id(), "Cannot deserialize uav descriptor data: {}", deserialize_result.error().what());
         serialize_and_send(SETUP_CHANNEL, response);
         return;
     }
 
+    std::shared_ptr<const hal::IUAV_Descriptor> new_descriptor;
     {
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
         auto result = m_hal.set_uav_descriptor(uav_descriptor.get_shared_ptr());
         if (result != ts::success)
         {
@@ -455,16 +441,15 @@ void GS_Comms::handle_req(gs_comms::setup::Set_UAV_Descriptor_Req const& req)
             serialize_and_send(SETUP_CHANNEL, response);
             return;
         }
-    }
 
-    m_hal.save_settings();
-
-    ts::sz::Value sz_value = hal::serialize(hal::Poly<const hal::IUAV_Descriptor>(m_hal.get_uav_descriptor()));
+        m_hal.save_settings();
+        new_descriptor = m_hal.get_uav_descriptor();
+    }
 
     response = gs_comms::setup::Set_UAV_Descriptor_Res();
     gs_comms::setup::Set_UAV_Descriptor_Res& res = boost::get<gs_comms::setup::Set_UAV_Descriptor_Res>(response);
     res.set_req_id(req.get_req_id());
-    res.set_data(encode_json(ts::sz::to_json(m_json_buffer, sz_value, false)));
+    res.set_data(m_setup_codec.encode_value(hal::Poly<const hal::IUAV_Descriptor>(new_descriptor)));
 
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -477,9 +462,14 @@ void GS_Comms::handle_req(gs_comms::setup::Get_UAV_Descriptor_Req const& req)
     gs_comms::setup::Brain_Res response = gs_comms::setup::Get_UAV_Descriptor_Res();
     gs_comms::setup::Get_UAV_Descriptor_Res& res = boost::get<gs_comms::setup::Get_UAV_Descriptor_Res>(response);
 
-    ts::sz::Value sz_value = hal::serialize(hal::Poly<const hal::IUAV_Descriptor>(m_hal.get_uav_descriptor()));
+    std::shared_ptr<const hal::IUAV_Descriptor> descriptor;
+    {
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+        descriptor = m_hal.get_uav_descriptor();
+    }
+
     res.set_req_id(req.get_req_id());
-    res.set_data(encode_json(ts::sz::to_json(m_json_buffer, sz_value, false)));
+    res.set_data(m_setup_codec.encode_value(hal::Poly<const hal::IUAV_Descriptor>(descriptor)));
 
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -496,7 +486,12 @@ void GS_Comms::handle_req(gs_comms::setup::Get_Node_Defs_Req const& req)
 //    m_stream_telemetry_data.clear();
 //    m_internal_telemetry_data.is_enabled = false;
 
-    std::vector<HAL::Node_Factory::Info> nodes = m_hal.get_node_factory().create_all();
+    //the created nodes are private copies, only the factory needs the lock
+    std::vector<HAL::Node_Factory::Info> nodes;
+    {
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+        nodes = m_hal.get_node_factory().create_all();
+    }
 
     res.set_req_id(req.get_req_id());
 
@@ -536,8 +531,7 @@ void GS_Comms::handle_req(gs_comms::setup::Get_Node_Defs_Req const& req)
         }
 
         std::shared_ptr<const hal::INode_Descriptor> descriptor = n.ptr->get_descriptor();
-        ts::sz::Value sz_value = hal::serialize(hal::Poly<const hal::INode_Descriptor>(descriptor));
-        node_data.set_descriptor_data(encode_json(ts::sz::to_json(m_json_buffer, sz_value, false)));
+        node_data.set_descriptor_data(m_setup_codec.encode_value(hal::Poly<const hal::INode_Descriptor>(descriptor)));
     }
 
     serialize_and_send(SETUP_CHANNEL, response);
@@ -550,19 +544,23 @@ void GS_Comms::handle_req(gs_comms::setup::Remove_Node_Req const& req)
 
     gs_comms::setup::Brain_Res response;
 
-    std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(req.get_name());
-    if (!node)
     {
-        response = make_error_response(req.get_req_id(), "Cannot find node '{}'", req.get_name());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
-    }
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+        std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(req.get_name());
+        if (!node)
+        {
+            response = make_error_response(req.get_req_id(), "Cannot find node '{}'", req.get_name());
+            serialize_and_send(SETUP_CHANNEL, response);
+            return;
+        }
 
-    m_hal.remove_node(node);
-    m_hal.save_settings();
+        m_hal.remove_node(node);
+        m_hal.save_settings();
+    }
 
     gs_comms::setup::Remove_Node_Res res;
     res.set_req_id(req.get_req_id());
+    res.set_name(req.get_name());
     response = res;
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -574,36 +572,33 @@ void GS_Comms::handle_req(gs_comms::setup::Add_Node_Req const& req)
 
     gs_comms::setup::Brain_Res response;
 
-    std::string const& json = decode_json(req.get_descriptor_data());
-    auto json_result = ts::sz::from_json(json);
-    if (json_result != ts::success)
-    {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize node {} descriptor data: {}", req.get_def_name(), json_result.error().what());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
-    }
     hal::Poly<const hal::INode_Descriptor> descriptor;
-    auto deserialize_result = hal::deserialize(descriptor, json_result.payload());
+    auto deserialize_result = m_setup_codec.decode_value(descriptor, req.get_descriptor_data());
     if (deserialize_result != ts::success)
     {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize node {} descriptor json: {}", req.get_def_name(), deserialize_result.error().what());
+        response = make_error_response(req.get_req_id(), "Cannot deserialize node {} descriptor data: {}", req.get_def_name(), deserialize_result.error().what());
         serialize_and_send(SETUP_CHANNEL, response);
         return;
     }
 
-    auto create_node_result = m_hal.create_node(req.get_def_name(), req.get_name(), *descriptor);
-    if (create_node_result != ts::success)
+    boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result;
     {
-        response = make_error_response(req.get_req_id(), "Cannot create node {}: {}", req.get_def_name(), create_node_result.error().what());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+        auto create_node_result = m_hal.create_node(req.get_def_name(), req.get_name(), *descriptor);
+        if (create_node_result != ts::success)
+        {
+            response = make_error_response(req.get_req_id(), "Cannot create node {}: {}", req.get_def_name(), create_node_result.error().what());
+            serialize_and_send(SETUP_CHANNEL, response);
+            return;
+        }
+        m_hal.save_settings();
+
+        result = get_node_data(req.get_name(), *create_node_result.payload());
     }
-    m_hal.save_settings();
 
     gs_comms::setup::Add_Node_Res res;
     res.set_req_id(req.get_req_id());
 
-    boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result = get_node_data(req.get_name(), *create_node_result.payload());
     if (auto* error = boost::get<gs_comms::setup::Error>(&result))
     {
         response = std::move(*error);
@@ -626,10 +621,37 @@ void GS_Comms::handle_req(gs_comms::setup::Get_Nodes_Req const& req)
     gs_comms::setup::Get_Nodes_Res res;
     res.set_req_id(req.get_req_id());
 
-    std::string const& name = req.get_name();
-    if (name.empty())
+    //the gs already has these, send them only if they changed
+    std::unordered_map<std::string, uint32_t> known_hashes;
+    for (gs_comms::setup::Get_Nodes_Req::Known_Node const& known: req.get_known_nodes())
     {
-        std::vector<HAL::Node_Registry::Item> const& nodes = m_hal.get_node_registry().get_all();
+        known_hashes[known.get_name()] = known.get_hash();
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+
+        std::vector<HAL::Node_Registry::Item> nodes;
+
+        std::string const& name = req.get_name();
+        if (name.empty())
+        {
+            nodes = m_hal.get_node_registry().get_all();
+        }
+        else
+        {
+            std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(name);
+            if (!node)
+            {
+                response = make_error_response(req.get_req_id(), "Cannot find node '{}'", name);
+                serialize_and_send(SETUP_CHANNEL, response);
+                return;
+            }
+            HAL::Node_Registry::Item item;
+            item.name = name;
+            item.ptr = node;
+            nodes.push_back(std::move(item));
+        }
 
         for (HAL::Node_Registry::Item const& item: nodes)
         {
@@ -640,29 +662,20 @@ void GS_Comms::handle_req(gs_comms::setup::Get_Nodes_Req const& req)
                 serialize_and_send(SETUP_CHANNEL, response);
                 return;
             }
-            res.get_node_datas().push_back(std::move(boost::get<gs_comms::setup::Node_Data>(result)));
-        }
-    }
-    else
-    {
-        std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(name);
-        if (!node)
-        {
-            response = make_error_response(req.get_req_id(), "Cannot find node '{}'", name);
-            serialize_and_send(SETUP_CHANNEL, response);
-            return;
-        }
 
-        boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result = get_node_data(name, *node);
-        if (auto* error = boost::get<gs_comms::setup::Error>(&result))
-        {
-            response = std::move(*error);
-            serialize_and_send(SETUP_CHANNEL, response);
-            return;
+            gs_comms::setup::Node_Data& node_data = boost::get<gs_comms::setup::Node_Data>(result);
+            res.get_node_names().push_back(item.name);
+
+            auto it = known_hashes.find(item.name);
+            if (it == known_hashes.end() || it->second != node_data.get_hash())
+            {
+                res.get_node_datas().push_back(std::move(node_data));
+            }
         }
-        res.get_node_datas().push_back(std::move(boost::get<gs_comms::setup::Node_Data>(result)));
     }
 
+    QLOGI("Sending {} changed nodes out of {}", res.get_node_datas().size(), res.get_node_names().size());
+
     response = std::move(res);
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -679,9 +692,12 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Node_Input_Stream_Path_Req const&
     std::string const& node_name = req.get_node_name();
     std::string const& input_name = req.get_input_name();
 
+    std::unique_lock<std::mutex> lock(m_hal.get_mutex());
+
     std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(node_name);
     if (!node)
     {
+        lock.unlock();
         response = make_error_response(req.get_req_id(), "Cannot find node '{}'", node_name);
         serialize_and_send(SETUP_CHANNEL, response);
         return;
@@ -696,13 +712,17 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Node_Input_Stream_Path_Req const&
             auto set_input_result = node->set_input_stream_path(idx, req.get_stream_path());
             if (set_input_result != ts::success)
             {
+                lock.unlock();
                 response = make_error_response(req.get_req_id(), set_input_result.error().what());
                 serialize_and_send(SETUP_CHANNEL, response);
                 return;
             }
+            m_hal.invalidate_node_schedule();
             m_hal.save_settings();
 
             boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result = get_node_data(node_name, *node);
+            lock.unlock();
+
             if (auto* error = boost::get<gs_comms::setup::Error>(&result))
             {
                 response = std::move(*error);
@@ -718,6 +738,7 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Node_Input_Stream_Path_Req const&
         }
     }
 
+    lock.unlock();
     response = make_error_response(req.get_req_id(), "Cannot find node '{}', input '{}'", node_name, input_name);
     serialize_and_send(SETUP_CHANNEL, response);
 }
@@ -736,11 +757,16 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Stream_Telemetry_Enabled_Req cons
 
     if (stream_path == "#hal")
     {
+        std::lock_guard<std::mutex> lg(m_telemetry_mutex);
         m_internal_telemetry_data.is_enabled = wants_enabled;
     }
     else
     {
-        std::shared_ptr<stream::IStream> stream = m_hal.get_stream_registry().find_by_name<stream::IStream>(stream_path);
+        std::shared_ptr<stream::IStream> stream;
+        {
+            std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+            stream = m_hal.get_stream_registry().find_by_name<stream::IStream>(stream_path);
+        }
         if (!stream)
         {
             response = make_error_response(req.get_req_id(), "Cannot find stream '{}'", stream_path);
@@ -758,10 +784,20 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Stream_Telemetry_Enabled_Req cons
                 std.stream_path = stream_path;
                 std.stream_type = stream->get_type();
                 std.stream = stream;
+                std.samples = create_telemetry_samples(std.stream_type);
+                if (!std.samples)
+                {
+                    response = make_error_response(req.get_req_id(), "Stream '{}' of type {} cannot be sent as telemetry", stream_path, stream::get_as_string(std.stream_type, false));
+                    serialize_and_send(SETUP_CHANNEL, response);
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lg(m_telemetry_mutex);
                 m_stream_telemetry_data.push_back(std);
             }
             else
             {
+                std::lock_guard<std::mutex> lg(m_telemetry_mutex);
                 m_stream_telemetry_data.erase(it);
             }
         }
@@ -783,41 +819,39 @@ void GS_Comms::handle_req(gs_comms::setup::Set_Node_Config_Req const& req)
 
     std::string const& node_name = req.get_name();
 
-    std::string const& json = decode_json(req.get_config_data());
-    auto json_result = ts::sz::from_json(json);
-    if (json_result != ts::success)
-    {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize node '{}'' config data: {}", node_name, json_result.error().what());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
-    }
     hal::Poly<const hal::INode_Config> config;
-    auto deserialize_result = hal::deserialize(config, json_result.payload());
+    auto deserialize_result = m_setup_codec.decode_value(config, req.get_config_data());
     if (deserialize_result != ts::success)
     {
-        response = make_error_response(req.get_req_id(), "Cannot deserialize node '{}'' config json: {}", node_name, deserialize_result.error().what());
+        response = make_error_response(req.get_req_id(), "Cannot deserialize node '{}'' config data: {}", node_name, deserialize_result.error().what());
         serialize_and_send(SETUP_CHANNEL, response);
         return;
     }
 
-    std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(node_name);
-    if (!node)
+    boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result;
     {
-        response = make_error_response(req.get_req_id(), "Cannot find node '{}'", node_name);
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
-    }
+        std::lock_guard<std::mutex> lg(m_hal.get_mutex());
+        std::shared_ptr<node::INode> node = m_hal.get_node_registry().find_by_name<node::INode>(node_name);
+        if (!node)
+        {
+            response = make_error_response(req.get_req_id(), "Cannot find node '{}'", node_name);
+            serialize_and_send(SETUP_CHANNEL, response);
+            return;
+        }
 
-    auto set_config_result = node->set_config(*config);
-    if (set_config_result != ts::success)
-    {
-        response = make_error_response(req.get_req_id(), "Cannot set config for node '{}': {}", node_name, set_config_result.error().what());
-        serialize_and_send(SETUP_CHANNEL, response);
-        return;
+        auto set_config_result = node->set_config(*config);
+        if (set_config_result != ts::success)
+        {
+            response = make_error_response(req.get_req_id(), "Cannot set config for node '{}': {}", node_name, set_config_result.error().what());
+            serialize_and_send(SETUP_CHANNEL, response);
+            return;
+        }
+        m_hal.invalidate_node_schedule(); //the config can change the inputs
+        m_hal.save_settings();
+
+        result = get_node_data(node_name, *node);
     }
-    m_hal.save_settings();
 
-    boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> result = get_node_data(node_name, *node);
     if (auto* error = boost::get<gs_comms::setup::Error>(&result))
     {
         response = std::move(*error);
@@ -846,28 +880,33 @@ void GS_Comms::process()
     }
 
     Dispatch_Req_Visitor dispatcher(*this);
-    while (m_rcp->receive(SETUP_CHANNEL, m_setup_buffer))
+    util::comms::RCP::Received_Data received;
+    while (m_rcp->receive(SETUP_CHANNEL, received))
     {
-        auto parse_result = ts::sz::from_json(m_setup_buffer.data(), m_setup_buffer.size());
-        if (parse_result != ts::success)
+        //the handlers lock the hal only around the node changes so the control thread doesn't wait on the parsing
+        //answer in whatever the gs talks. If it's binary from a different gs_comms.def, tell it to use json
+        if (!gs_comms::Setup_Codec::is_message_schema_compatible(received.data, received.size))
         {
-            QLOGE("Cannot parse setup req: {}", parse_result.error().what());
+            QLOGW("Setup req schema mismatch, switching to json");
+            m_setup_codec.set_format(gs_comms::Setup_Format::JSON);
+            gs_comms::setup::Brain_Res response = make_error_response(0, "Setup schema mismatch, use json");
+            serialize_and_send(SETUP_CHANNEL, response);
+            continue;
+        }
+        m_setup_codec.set_format(gs_comms::Setup_Codec::get_message_format(received.data, received.size));
+
+        silk::gs_comms::setup::Brain_Req req;
+        auto result = m_setup_codec.decode_message(req, received.data, received.size);
+        if (result != ts::success)
+        {
+            QLOGE("Cannot deserialize setup req: {}", result.error().what());
         }
         else
         {
-            silk::gs_comms::setup::Brain_Req req;
-            auto result = silk::gs_comms::deserialize(req, parse_result.payload());
-            if (result != ts::success)
-            {
-                QLOGE("Cannot deserialize setup req: {}", result.error().what());
-            }
             boost::apply_visitor(dispatcher, req);
         }
-        m_setup_buffer.clear();
     }
 
-    gather_telemetry_data();
-
     auto result = m_socket->process();
     if (result != util::comms::ISocket::Result::OK)
     {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/Comm_Data.h"
+#include "common/comms/Setup_Codec.h"
 #include "HAL.h"
 
 #include "common/Manual_Clock.h"
@@ -56,20 +57,41 @@ public:
 
     auto is_connected() const -> bool;
 
+    //Called from the comms thread. Handles the setup requests and sends the telemetry
     void process();
 
+    //Called from the control thread after every HAL::process, with the HAL mutex locked
+    // so no stream sample is missed
+    void gather_telemetry_data();
+
 private:
     void configure_channels();
 
+    //the samples of a stream gathered since the last telemetry packet
+    struct ITelemetry_Samples
+    {
+        virtual ~ITelemetry_Samples() = default;
+        //the stream has to be of the type this was created for
+        virtual void gather(stream::IStream const& stream, std::string const& stream_path) = 0;
+        virtual auto get_count() const -> size_t = 0;
+        //appends the encoded samples to data and clears them
+        virtual void encode(std::vector<uint8_t>& data) = 0;
+    };
+    template<class Stream> struct Telemetry_Samples;
+    struct Telemetry_Samples_Factory;
+    typedef std::shared_ptr<ITelemetry_Samples> (*Create_Telemetry_Samples)();
+    //nullptr if the stream type cannot be sent as telemetry
+    static auto create_telemetry_samples(stream::Type type) -> std::shared_ptr<ITelemetry_Samples>;
+
     struct Stream_Telemetry_Data
     {
         std::string stream_path;
         stream::Type stream_type;
         std::weak_ptr<stream::IStream> stream;
-        uint32_t sample_count = 0;
-        std::vector<uint8_t> data;
+        std::shared_ptr<ITelemetry_Samples> samples;
     };
     std::vector<Stream_Telemetry_Data> m_stream_telemetry_data;
+    std::vector<uint8_t> m_stream_telemetry_buffer;
 
     struct Telemetry
     {
@@ -80,21 +102,20 @@ private:
     } m_internal_telemetry_data;
 
 
-    template<class Stream> auto gather_telemetry_stream(Stream_Telemetry_Data& ts, stream::IStream const& _stream) -> bool;
-    void gather_telemetry_data();
+    //protects the telemetry data gathered on the control thread and packed on the comms thread
+    std::mutex m_telemetry_mutex;
+
     void pack_telemetry_data();
 
-    std::vector<uint8_t> m_setup_buffer;
-    std::string m_json_buffer;
-    std::string m_base64_buffer;
+    gs_comms::Setup_Codec m_setup_codec;
+    std::string m_node_hash_buffer;
+    ts::sz::Value m_ast_value;
 
     template<typename T>
     void serialize_and_send(size_t channel_idx, T const& res);
     template<class Format_String, typename... Params>
     gs_comms::setup::Error make_error_response(uint32_t req_id, Format_String const& fmt, Params&&... params);
 
-    std::string const& decode_json(std::string const& json_base64);
-    std::string const& encode_json(std::string const& json);
     boost::variant<gs_comms::setup::Node_Data, gs_comms::setup::Error> get_node_data(std::string const& name, node::INode const& node);
 
     class Dispatch_Req_Visitor;
@@ -150,6 +150,14 @@ namespace silk
 
 static const q::Path k_settings_path("settings.json");
 
+thread_local Sample_Latency_Context t_sample_latency_context;
+
+constexpr uint32_t MIN_PROCESS_RATE = 50;
+constexpr uint32_t MAX_PROCESS_RATE = 4000;
+
+//the percentiles need more samples than the averages
+constexpr std::chrono::seconds TELEMETRY_HISTOGRAM_LATCH_PERIOD(1);
+
 //wrapper to keep all nodes in the same container
 struct INode_Wrapper : q::util::Noncopyable
 {
@@ -171,6 +179,7 @@ HAL::HAL()
 
 HAL::~HAL()
 {
+    stop_node_workers();
 }
 
 void HAL::save_settings()
@@ -451,6 +460,7 @@ auto HAL::get_uav_properties() const -> std::shared_ptr<const IUAV_Properties>
 
 auto HAL::remove_node(std::shared_ptr<node::INode> node) -> bool
 {
+    invalidate_node_schedule();
     m_nodes.remove(node);
     std::vector<node::INode::Output> outputs = node->get_outputs();
     for (node::INode::Output const& output: outputs)
@@ -519,6 +529,7 @@ ts::Result<std::shared_ptr<node::INode>> HAL::create_node(std::string const& typ
 
     bool res = m_nodes.add(name, type, node); //this has to succeed since we already tested for duplicate names
     QASSERT(res);
+    invalidate_node_schedule();
     std::vector<node::INode::Output> outputs = node->get_outputs();
     for (node::INode::Output const& x: outputs)
     {
@@ -654,89 +665,360 @@ ts::Result<std::shared_ptr<node::INode>> HAL::create_node(std::string const& typ
 //    return true;
 //}
 
-void HAL::sort_nodes(std::shared_ptr<node::INode> first_node)
+void HAL::invalidate_node_schedule()
+{
+    m_node_schedule.is_dirty = true;
+}
+
+auto HAL::get_process_period() const -> q::Clock::duration
+{
+    return m_node_schedule.process_period;
+}
+
+auto HAL::get_mutex() -> std::mutex&
+{
+    return m_mutex;
+}
+
+void HAL::build_node_schedule()
 {
-    QASSERT(first_node);
-    if (!first_node)
+    TIMED_FUNCTION();
+
+    typedef Node_Schedule::Item Item;
+
+    m_node_schedule.is_dirty = false;
+    m_node_schedule.items.clear();
+
+    auto const& nodes = m_nodes.get_all();
+    size_t count = nodes.size();
+
+    std::map<std::string, size_t> node_indices;
+    for (size_t i = 0; i < count; i++)
     {
-        return;
+        node_indices[nodes[i].name] = i;
     }
 
-//    typedef Registry<node::INode>::Item Item;
+    //the edges of the graph. A node depends on all the nodes that produce its input streams
+    std::vector<std::vector<size_t>> producers(count);
+    std::vector<std::vector<size_t>> consumers(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        for (node::INode::Input const& input: nodes[i].ptr->get_inputs())
+        {
+            if (input.stream_path.empty())
+            {
+                continue;
+            }
+            //stream paths are in the "node/output" format
+            std::string node_name = input.stream_path.substr(0, input.stream_path.find('/'));
+            auto it = node_indices.find(node_name);
+            if (it == node_indices.end() || it->second == i)
+            {
+                continue;
+            }
+            size_t producer = it->second;
+            if (std::find(producers[i].begin(), producers[i].end(), producer) == producers[i].end())
+            {
+                producers[i].push_back(producer);
+                consumers[producer].push_back(i);
+            }
+        }
+    }
 
-//    std::vector<Item> items = m_nodes.get_all();
-//    auto it = std::find_if(items.begin(), items.end(), [first_node](const Item& item) { return item.ptr == first_node; });
-//    QASSERT(it != items.end());
-//    if (it == items.end())
-//    {
-//        return;
-//    }
+    //topological sort. When only cycles are left, the first registered node of one of them is scheduled first
+    std::vector<size_t> pending(count);
+    std::vector<bool> is_scheduled(count, false);
+    std::vector<size_t> ready;
+    ready.reserve(count * 2);
+    for (size_t i = 0; i < count; i++)
+    {
+        pending[i] = producers[i].size();
+        if (pending[i] == 0)
+        {
+            ready.push_back(i);
+        }
+    }
 
-//    std::vector<Item> sorted;
-//    sorted.reserve(items.size() * 2); //to avoid allocations
+    std::vector<size_t> order;
+    order.reserve(count);
+    size_t ready_idx = 0;
+    while (order.size() < count)
+    {
+        if (ready_idx == ready.size())
+        {
+            //The first unscheduled node might only be downstream of a cycle. All the unscheduled nodes wait for
+            // an unscheduled producer so walking back through them has to end up going around a cycle.
+            auto first_unscheduled_producer = [&](size_t i)
+            {
+                return *std::find_if(producers[i].begin(), producers[i].end(), [&](size_t p) { return !is_scheduled[p]; });
+            };
+            std::vector<bool> is_visited(count, false);
+            size_t idx = std::distance(is_scheduled.begin(), std::find(is_scheduled.begin(), is_scheduled.end(), false));
+            while (!is_visited[idx])
+            {
+                is_visited[idx] = true;
+                idx = first_unscheduled_producer(idx);
+            }
+            size_t cycle_start = idx;
+            for (size_t i = first_unscheduled_producer(cycle_start); i != cycle_start; i = first_unscheduled_producer(i))
+            {
+                idx = std::min(idx, i);
+            }
+            QLOGI("Node '{}' is part of a feedback loop. Some of its inputs will be one frame late.", nodes[idx].name);
+            pending[idx] = 0;
+            ready.push_back(idx);
+        }
+        size_t idx = ready[ready_idx++];
+        if (is_scheduled[idx])
+        {
+            continue;
+        }
+        is_scheduled[idx] = true;
+        order.push_back(idx);
+        for (size_t c: consumers[idx])
+        {
+            if (!is_scheduled[c] && pending[c] > 0 && --pending[c] == 0)
+            {
+                ready.push_back(c);
+            }
+        }
+    }
 
-//    Item first_item = *it;
-//    items.erase(it);
+    std::vector<size_t> positions(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        positions[order[i]] = i;
+    }
 
-//    sorted.push_back(first_item);
-//    for (auto it = sorted.begin(); it != sorted.end(); ++it)
-//    {
-//        const std::string& node_name = it->name;
+    //Two nodes sharing a stream never run at the same time, whichever way the stream goes, so the consumers can
+    // read the samples in place. Across a feedback loop the producer waits for its consumer of the previous frame
+    // to finish instead of writing over the samples it reads.
+    m_node_schedule.items.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        size_t idx = order[i];
+        Item& item = m_node_schedule.items[i];
+        item.name = nodes[idx].name;
+        item.node = nodes[idx].ptr;
+        item.telemetry = &m_telemetry_data.nodes[item.name];
+
+        std::vector<size_t> neighbours = producers[idx];
+        for (size_t c: consumers[idx])
+        {
+            if (std::find(neighbours.begin(), neighbours.end(), c) == neighbours.end())
+            {
+                neighbours.push_back(c);
+            }
+        }
+        item.dependency_count = std::count_if(neighbours.begin(), neighbours.end(), [&](size_t n) { return positions[n] < i; });
+        for (size_t n: neighbours)
+        {
+            if (positions[n] > i)
+            {
+                item.dependants.push_back(positions[n]);
+            }
+        }
+    }
 
-//        //now find all the nodes that this node uses as input
-//        if (it->ptr != first_node)
-//        {
-//            std::vector<node::INode::Input> inputs = it->ptr->get_inputs();
-//            for (const node::INode::Input& input : inputs)
-//            {
-//                if (input.stream_path.empty())
-//                {
-//                    continue;
-//                }
-//                for (auto nit = items.begin(); nit != items.end();)
-//                {
-//                    if (input.stream_path[0] == nit->name)
-//                    {
-//                        sorted.push_back(*nit);
-//                        items.erase(nit);
-//                    }
-//                    else
-//                    {
-//                        ++nit;
-//                    }
-//                }
-//            }
-//        }
+    m_node_schedule.ready.resize(count);
 
-//        //now find all the nodes that use this node as an input
-//        for (auto nit = items.begin(); nit != items.end();)
-//        {
-//            bool found = false;
-//            std::vector<node::INode::Input> inputs = nit->ptr->get_inputs();
-//            for (const node::INode::Input& input : inputs)
-//            {
-//                if (!input.stream_path.empty() && input.stream_path[0] == node_name)
-//                {
-//                    sorted.push_back(*nit);
-//                    items.erase(nit);
-//                    found = true;
-//                    break;
-//                }
-//            }
-//            if (!found)
-//            {
-//                ++nit;
-//            }
-//        }
-//    }
+    //process at the rate of the fastest stream so no node waits for its samples more than it has to
+    uint32_t max_rate = 0;
+    for (auto const& s: m_streams.get_all())
+    {
+        max_rate = std::max(max_rate, s.ptr->get_rate());
+    }
+    max_rate = math::clamp(max_rate, MIN_PROCESS_RATE, MAX_PROCESS_RATE);
+    m_node_schedule.process_period = std::chrono::duration_cast<q::Clock::duration>(std::chrono::nanoseconds(1000000000 / max_rate));
+}
 
-//    //add all the remainding nodes
-//    for (Item const& item: items)
-//    {
-//        sorted.push_back(item);
-//    }
+void HAL::start_node_workers()
+{
+    //the calling thread also processes nodes, so leave a core for it
+    size_t worker_count = std::min<size_t>(std::thread::hardware_concurrency(), 4);
+    worker_count = worker_count > 0 ? worker_count - 1 : 0;
+
+    m_node_schedule.exit = false;
+    for (size_t i = 0; i < worker_count; i++)
+    {
+        m_node_schedule.workers.emplace_back([this]() { node_worker_thread_proc(); });
+
+#if defined RASPBERRY_PI
+        {
+            int policy = SCHED_FIFO;
+            struct sched_param param;
+            param.sched_priority = sched_get_priority_max(policy);
+            if (pthread_setschedparam(m_node_schedule.workers.back().native_handle(), policy, &param) != 0)
+            {
+                perror("Failed to set priority for node worker thread");
+            }
+        }
+#endif
+    }
+
+    QLOGI("Processing nodes on {} worker threads", worker_count + 1);
+}
+
+void HAL::stop_node_workers()
+{
+    {
+        std::lock_guard<std::mutex> lg(m_node_schedule.mutex);
+        m_node_schedule.exit = true;
+    }
+    m_node_schedule.cv.notify_all();
+
+    for (std::thread& t: m_node_schedule.workers)
+    {
+        if (t.joinable())
+        {
+            t.join();
+        }
+    }
+    m_node_schedule.workers.clear();
+}
+
+void HAL::node_worker_thread_proc()
+{
+    Node_Schedule& schedule = m_node_schedule;
+
+    std::unique_lock<std::mutex> lock(schedule.mutex);
+    while (true)
+    {
+        schedule.cv.wait(lock, [&schedule]() { return schedule.exit || schedule.ready_begin < schedule.ready_end; });
+        if (schedule.exit)
+        {
+            break;
+        }
 
-//    m_nodes.set_all(sorted);
+        size_t idx = schedule.ready[schedule.ready_begin++];
+        lock.unlock();
+        process_scheduled_node(idx);
+        lock.lock();
+    }
+}
+
+void HAL::process_scheduled_node(size_t idx)
+{
+    Node_Schedule& schedule = m_node_schedule;
+
+    //keep processing down the chain on the same thread while there is a single dependant that got ready.
+    //This keeps the imu->ahrs->brain->mixer path on the same core
+    while (idx < schedule.items.size())
+    {
+        Node_Schedule::Item& item = schedule.items[idx];
+        process_node(item);
+
+        size_t next_idx = std::numeric_limits<size_t>::max();
+        bool notify = false;
+        {
+            std::lock_guard<std::mutex> lg(schedule.mutex);
+            for (size_t d: item.dependants)
+            {
+                Node_Schedule::Item& dependant = schedule.items[d];
+                QASSERT(dependant.pending_dependencies > 0);
+                if (--dependant.pending_dependencies == 0)
+                {
+                    if (next_idx >= schedule.items.size())
+                    {
+                        next_idx = d;
+                    }
+                    else
+                    {
+                        schedule.ready[schedule.ready_end++] = d;
+                        notify = true;
+                    }
+                }
+            }
+            QASSERT(schedule.remaining > 0);
+            schedule.remaining--;
+            notify |= schedule.remaining == 0;
+        }
+        if (notify)
+        {
+            schedule.cv.notify_all();
+        }
+
+        idx = next_idx;
+    }
+}
+
+void HAL::process_node(Node_Schedule::Item& item)
+{
+    reset_sample_latency_context();
+
+    auto start = q::Clock::now();
+    item.node->process();
+    auto now = q::Clock::now();
+    auto dt = now - start;
+
+    Telemetry_Data::Node& telemetry = *item.telemetry;
+    telemetry.crt_process_duration += dt;
+    telemetry.crt_max_process_duration = std::max(telemetry.crt_max_process_duration, dt);
+    telemetry.crt_call_count++;
+    telemetry.process_histogram.record(dt);
+
+    Sample_Latency_Context const& context = t_sample_latency_context;
+    if (context.has_consumed)
+    {
+        telemetry.sample_age_histogram.record(now - context.oldest_consumed_tp);
+    }
+    if (context.has_actuated)
+    {
+        telemetry.end_to_end_histogram.record(now - context.oldest_actuated_tp);
+    }
+}
+
+void HAL::process_node_schedule()
+{
+    Node_Schedule& schedule = m_node_schedule;
+    if (schedule.items.empty())
+    {
+        return;
+    }
+
+    //no workers - the schedule is already in a valid order
+    if (schedule.workers.empty())
+    {
+        for (Node_Schedule::Item& item: schedule.items)
+        {
+            process_node(item);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lg(schedule.mutex);
+        schedule.ready_begin = 0;
+        schedule.ready_end = 0;
+        for (size_t i = 0; i < schedule.items.size(); i++)
+        {
+            Node_Schedule::Item& item = schedule.items[i];
+            item.pending_dependencies = item.dependency_count;
+            if (item.dependency_count == 0)
+            {
+                schedule.ready[schedule.ready_end++] = i;
+            }
+        }
+        schedule.remaining = schedule.items.size();
+    }
+    schedule.cv.notify_all();
+
+    //this thread helps with the processing until the frame is done
+    std::unique_lock<std::mutex> lock(schedule.mutex);
+    while (schedule.remaining > 0)
+    {
+        if (schedule.ready_begin < schedule.ready_end)
+        {
+            size_t idx = schedule.ready[schedule.ready_begin++];
+            lock.unlock();
+            process_scheduled_node(idx);
+            lock.lock();
+        }
+        else
+        {
+            schedule.cv.wait(lock);
+        }
+    }
 }
 
 
@@ -777,7 +1059,7 @@ auto HAL::init(RC_Comms& rc_comms, GS_Comms& gs_comms) -> bool
     m_node_factory.add<SRF01>("SRF01", *this);
     m_node_factory.add<SRF02>("SRF02", *this);
     m_node_factory.add<MaxSonar>("MaxSonar", *this);
-    m_node_factory.add<Raspicam>("Raspicam", *this);
+    m_node_factory.add<Raspicam>("Raspicam", *this, rc_comms);
     m_node_factory.add<RC5T619>("RC5T619", *this);
     m_node_factory.add<ADS1115>("ADS1115", *this);
     m_node_factory.add<AVRADC>("AVRADC", *this);
@@ -1090,6 +1372,9 @@ auto HAL::init(RC_Comms& rc_comms, GS_Comms& gs_comms) -> bool
         }
     }
 
+    build_node_schedule();
+    start_node_workers();
+
     save_settings();
 
     return true;
@@ -1097,6 +1382,8 @@ auto HAL::init(RC_Comms& rc_comms, GS_Comms& gs_comms) -> bool
 
 void HAL::shutdown()
 {
+    stop_node_workers();
+
 #if defined (RASPBERRY_PI)
     shutdown_bcm();
     shutdown_pigpio();
@@ -1105,6 +1392,7 @@ void HAL::shutdown()
 
 void HAL::remove_add_nodes()
 {
+    invalidate_node_schedule();
     m_streams.remove_all();
     m_nodes.remove_all();
 }
@@ -1201,22 +1489,15 @@ void HAL::process()
 //        n->process();
 //    }
 
-    auto now = q::Clock::now();
-
-    auto total_start = now;
-    auto node_start = total_start;
-
-    for (auto const& n: m_nodes.get_all())
+    if (m_node_schedule.is_dirty)
     {
-        n.ptr->process();
-
-        auto now = q::Clock::now();
-        Telemetry_Data::Node& node_telemetry = m_telemetry_data.nodes[n.name];
-        node_telemetry.crt_process_duration += now - node_start;
-        node_telemetry.crt_max_process_duration = std::max(node_telemetry.crt_max_process_duration, now - node_start);
-        node_start = now;
+        build_node_schedule();
     }
 
+    auto total_start = q::Clock::now();
+
+    process_node_schedule();
+
     {
         auto dt = q::Clock::now() - total_start;
         m_telemetry_data.crt_total_duration += dt;
@@ -1244,10 +1525,40 @@ void HAL::process()
                 Telemetry_Data::Node& node = pair.second;
                 node.process_duration = std::chrono::duration_cast<q::Clock::duration>(node.crt_process_duration * mu);
                 node.max_process_duration = std::chrono::duration_cast<q::Clock::duration>(node.crt_max_process_duration);
+                node.call_rate = node.crt_call_count * mu;
 
                 node.crt_process_duration = q::Clock::duration(0);
                 node.crt_max_process_duration = q::Clock::duration(0);
+                node.crt_call_count = 0;
+            }
+        }
+
+        if (now - m_last_telemetry_histogram_latch_tp >= TELEMETRY_HISTOGRAM_LATCH_PERIOD)
+        {
+            m_last_telemetry_histogram_latch_tp = now;
+
+            auto get_percentiles = [](util::Latency_Histogram const& histogram)
+            {
+                Telemetry_Data::Percentiles percentiles;
+                percentiles.p50 = histogram.get_percentile(0.5f);
+                percentiles.p99 = histogram.get_percentile(0.99f);
+                percentiles.p999 = histogram.get_percentile(0.999f);
+                return percentiles;
+            };
+
+            util::Latency_Histogram end_to_end_histogram;
+            for (auto& pair: m_telemetry_data.nodes)
+            {
+                Telemetry_Data::Node& node = pair.second;
+                node.process_percentiles = get_percentiles(node.process_histogram);
+                node.sample_age_percentiles = get_percentiles(node.sample_age_histogram);
+                end_to_end_histogram.merge(node.end_to_end_histogram);
+
+                node.process_histogram.clear();
+                node.sample_age_histogram.clear();
+                node.end_to_end_histogram.clear();
             }
+            m_telemetry_data.end_to_end_latency = get_percentiles(end_to_end_histogram);
         }
     }
 }
@@ -1,13 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 #include "uav_properties/IUAV_Properties.h"
 #include "common/bus/IBus.h"
 #include "common/node/INode.h"
 #include "common/stream/IStream.h"
 
+#include "utils/Latency_Histogram.h"
+
 #include "MPL_Helper.h"
+#include "Sample_Latency.h"
 
 namespace silk
 {
@@ -110,6 +116,17 @@ public:
 
     void remove_add_nodes();
 
+    //Call this when the connections between nodes have changed (input stream paths, added/removed nodes)
+    //The schedule will be rebuilt before the next process call
+    void invalidate_node_schedule();
+
+    //The period of the fastest output stream. This is how often process should be called.
+    auto get_process_period() const -> q::Clock::duration;
+
+    //The nodes are processed on the control thread and changed by the comms from their own thread.
+    //Hold this while calling process or while accessing the nodes and streams
+    auto get_mutex() -> std::mutex&;
+
 protected:
 
     struct Telemetry_Data
@@ -121,13 +138,33 @@ protected:
         q::Clock::duration total_duration;
         q::Clock::duration max_total_duration;
         float rate = 0;
+
+        struct Percentiles
+        {
+            q::Clock::duration p50 = q::Clock::duration(0);
+            q::Clock::duration p99 = q::Clock::duration(0);
+            q::Clock::duration p999 = q::Clock::duration(0);
+        };
+
+        //from the sensor sample timestamp to the actuator write, over all the actuating nodes
+        Percentiles end_to_end_latency;
+
         struct Node
         {
             q::Clock::duration crt_process_duration;
             q::Clock::duration crt_max_process_duration;
+            size_t crt_call_count = 0;
+
+            //the histograms cover a longer period than the averages so the p999 is meaningful
+            util::Latency_Histogram process_histogram;
+            util::Latency_Histogram sample_age_histogram; //the age of the oldest sample consumed in each process call
+            util::Latency_Histogram end_to_end_histogram; //only for nodes writing to actuators
 
             q::Clock::duration process_duration;
             q::Clock::duration max_process_duration;
+            float call_rate = 0; //calls per second
+            Percentiles process_percentiles;
+            Percentiles sample_age_percentiles;
         };
         std::map<std::string, Node> nodes;
     };
@@ -142,8 +179,6 @@ private:
 
     bool remove_node(std::shared_ptr<node::INode> node);
 
-    void sort_nodes(std::shared_ptr<node::INode> first_node);
-
     std::shared_ptr<IUAV_Properties> m_uav_properties;
     std::shared_ptr<const hal::IUAV_Descriptor> m_uav_descriptor;
 
@@ -156,7 +191,48 @@ private:
 
     q::Clock::time_point m_last_process_tp = q::Clock::now();
 
+    std::mutex m_mutex;
+
+    struct Node_Schedule
+    {
+        struct Item
+        {
+            std::string name;
+            std::shared_ptr<node::INode> node;
+            Telemetry_Data::Node* telemetry = nullptr;
+            std::vector<size_t> dependants; //the items sharing a stream with this item, either way. Always after this item in the schedule
+            size_t dependency_count = 0;
+            size_t pending_dependencies = 0;
+        };
+
+        bool is_dirty = true;
+        std::vector<Item> items; //in topological order
+        q::Clock::duration process_period = std::chrono::milliseconds(5);
+
+        //processing state for the current frame. Protected by the mutex
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::vector<size_t> ready; //preallocated to items.size(). Every item is pushed exactly once per frame
+        size_t ready_begin = 0;
+        size_t ready_end = 0;
+        size_t remaining = 0;
+        bool exit = false;
+
+        std::vector<std::thread> workers;
+    } m_node_schedule;
+
+    //Builds the dependency graph out of the node input stream paths and orders it topologically.
+    //Feedback loops (like the simulator) are broken at the node registered first, and their consumers see the data next frame.
+    void build_node_schedule();
+    void process_node_schedule();
+    void process_scheduled_node(size_t idx);
+    void process_node(Node_Schedule::Item& item);
+    void start_node_workers();
+    void stop_node_workers();
+    void node_worker_thread_proc();
+
     q::Clock::time_point m_last_telemetry_data_latch_tp = q::Clock::now();
+    q::Clock::time_point m_last_telemetry_histogram_latch_tp = q::Clock::now();
     Telemetry_Data m_telemetry_data;
 };
 
@@ -29,8 +29,13 @@ auto RC_Comms::start(std::string const& interface, uint8_t id) -> bool
         descriptor.coding_k = 12;
         descriptor.coding_n = 20;
 
+        util::comms::Video_Link_Controller::Descriptor controller_descriptor;
+        controller_descriptor.coding_k = descriptor.coding_k;
+        controller_descriptor.coding_n = descriptor.coding_n;
+
         m_is_connected = m_rc_phy.init(SPI_DEVICE, SPEED, SDN_GPIO, NIRQ_GPIO)
-                        && m_video_streamer.init_tx(descriptor);
+                        && m_video_streamer.init_tx(descriptor)
+                        && m_video_link_controller.init(controller_descriptor);
     }
     catch(std::exception e)
     {
@@ -92,6 +97,21 @@ void RC_Comms::process_rx_packet(util::comms::RC_Protocol::RX_Packet const& pack
             QLOGW("Cannot deserialize incoming multirotor state value");
         }
     }
+    else if (packet.packet_type == static_cast<uint8_t>(rc_comms::Packet_Type::VIDEO_LINK_STATS))
+    {
+        size_t off = 0;
+        util::comms::Video_Streamer::RX_Stats stats;
+        if (util::serialization::deserialize(packet.payload, stats, off))
+        {
+            std::lock_guard<std::mutex> lg(m_samples_mutex);
+            m_video_link_controller.process_rx_stats(stats);
+            apply_video_link_output();
+        }
+        else
+        {
+            QLOGW("Cannot deserialize incoming video link stats");
+        }
+    }
     else
     {
         QLOGW("Unknown incoming packet type: {}", static_cast<int>(packet.packet_type));
@@ -100,7 +120,7 @@ void RC_Comms::process_rx_packet(util::comms::RC_Protocol::RX_Packet const& pack
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-boost::optional<stream::IMultirotor_Commands::Value> const& RC_Comms::get_multirotor_commands() const
+boost::optional<stream::IMultirotor_Commands::Value> RC_Comms::get_multirotor_commands() const
 {
     std::lock_guard<std::mutex> lg(m_samples_mutex);
     return m_multirotor_commands;
@@ -123,6 +143,23 @@ void RC_Comms::add_video_data(stream::IVideo::Value const& value)
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+auto RC_Comms::get_video_link_output() const -> util::comms::Video_Link_Controller::Output
+{
+    std::lock_guard<std::mutex> lg(m_samples_mutex);
+    return m_video_link_controller.get_output();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void RC_Comms::apply_video_link_output()
+{
+    //the streamer latches it at the next block so it's cheap to call every time
+    util::comms::Video_Link_Controller::Output const& output = m_video_link_controller.get_output();
+    m_video_streamer.set_coding(output.coding_k, output.coding_n);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void RC_Comms::process()
 {
     if (!is_connected())
@@ -130,7 +167,11 @@ void RC_Comms::process()
         return;
     }
 
+    std::lock_guard<std::mutex> lg(m_samples_mutex);
     m_multirotor_commands = boost::none;
+
+    m_video_link_controller.process();
+    apply_video_link_output();
 }
 
 }
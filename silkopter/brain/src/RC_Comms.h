@@ -11,6 +11,7 @@
 #include "utils/comms/RC_Phy.h"
 #include "utils/comms/RC_Protocol.h"
 #include "utils/comms/Video_Streamer.h"
+#include "utils/comms/Video_Link_Controller.h"
 
 
 namespace util
@@ -34,16 +35,22 @@ public:
 
     auto is_connected() const -> bool;
 
+    //Called from the comms thread
     void process();
 
-    boost::optional<stream::IMultirotor_Commands::Value> const& get_multirotor_commands() const;
+    //These are called by the nodes from the control thread
+    boost::optional<stream::IMultirotor_Commands::Value> get_multirotor_commands() const;
     void set_multirotor_state(stream::IMultirotor_State::Value const& value);
     void add_video_data(stream::IVideo::Value const& value);
 
+    //What the video source should do to fit the link. Called from the control thread
+    auto get_video_link_output() const -> util::comms::Video_Link_Controller::Output;
+
     struct Impl; //this needs to be public...
 private:
     size_t compute_multirotor_state_packet(uint8_t* data, uint8_t& packet_type);
     void process_rx_packet(util::comms::RC_Protocol::RX_Packet const& packet);
+    void apply_video_link_output();
 
     HAL& m_hal;
     q::Clock::time_point m_uav_sent_tp = q::Clock::now();
@@ -57,6 +64,7 @@ private:
     util::comms::RC_Protocol m_rc_protocol;
     util::comms::RC_Protocol::RX_Packet m_rx_packet;
     util::comms::Video_Streamer m_video_streamer;
+    util::comms::Video_Link_Controller m_video_link_controller;
     std::vector<uint8_t> m_serialization_buffer;
 
     bool m_is_connected = false;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "MPL_Helper.h"
+#include "Sample_Latency.h"
 
 namespace silk
 {
@@ -55,6 +56,9 @@ public:
     {
         return std::make_tuple();
     }
+    void track_latency(size_t)
+    {
+    }
 };
 
 template<class Stream, class... Streams>
@@ -63,6 +67,8 @@ class Storage<Stream, Streams...> : public Storage<Streams...>
 public:
     typedef Storage<Streams...> Parent_t;
     typedef typename Stream::Sample Sample_t;
+    typedef typename util::Ring_Buffer<Sample_t>::Cursor Cursor_t;
+    typedef typename util::Ring_Buffer<Sample_t>::Span Span_t;
     typedef std::tuple<Sample_t const&, typename Streams::Sample const&...> Params_t;
 
     void clear_streams()
@@ -83,6 +89,7 @@ public:
     {
         QASSERT(!m_locked_stream);
         m_stream = stream;
+        m_cursor = Cursor_t();
     }
 
     template<size_t N, class T>
@@ -104,6 +111,7 @@ public:
         {
             m_stream_path.clear();
             m_stream.reset();
+            m_cursor = Cursor_t();
 
             if (!path.empty())
             {
@@ -155,45 +163,58 @@ public:
     auto collect() -> size_t
     {
         QASSERT(m_locked_stream);
-        auto const& samples = m_locked_stream->get_samples();
-        m_samples.reserve(m_samples.size() + samples.size());
-        std::copy(samples.begin(), samples.end(), std::back_inserter(m_samples));
+        //read in place, the HAL never runs a node at the same time as the producers of its inputs
+        m_samples = m_locked_stream->get_samples().read(m_cursor);
         Parent_t::collect();
         return m_samples.size();
     }
     auto consume(size_t count) -> size_t
     {
         QASSERT(count <= m_samples.size());
-        m_samples.erase(m_samples.begin(), m_samples.begin() + count);
+        auto const& ring = m_locked_stream->get_samples();
+        ring.consume(m_cursor, count);
+        size_t pending = m_samples.size() - count;
 
         auto parent_count = Parent_t::consume(count);
-        if (m_samples.size() > 30)
+        if (pending > 30)
         {
             //crop to parent count
-            size_t crop = math::min(parent_count, m_samples.size());
-            auto begin = m_samples.begin();
-            auto end = m_samples.end() - crop;
-            QLOGW("Stream is out of sync: {} samples pending. Cropping {} samples", m_samples.size(), std::distance(begin, end));
-            m_samples.erase(begin, end);
+            size_t crop = pending - math::min(parent_count, pending);
+            QLOGW("Stream is out of sync: {} samples pending. Cropping {} samples", pending, crop);
+            ring.consume(m_cursor, crop);
+            pending -= crop;
         }
 
-        return m_samples.size();
+        return pending;
     }
     auto get_sample_count() -> size_t
     {
         return math::min(m_samples.size(), Parent_t::get_sample_count());
     }
 
+    auto get_samples() const -> Span_t const&
+    {
+        return m_samples;
+    }
+
     auto get_params(size_t idx) -> Params_t
     {
         return std::tuple_cat(std::tuple<Sample_t const&>(m_samples[idx]), Parent_t::get_params(idx));
     }
+    void track_latency(size_t idx)
+    {
+        Sample_t const& sample = m_samples[idx];
+        mark_sample_consumed(sample);
+        add_sample_origin(sample);
+        Parent_t::track_latency(idx);
+    }
 
 private:
     std::shared_ptr<Stream> m_locked_stream;
     std::weak_ptr<Stream> m_stream;
     std::string m_stream_path;
-    std::vector<Sample_t> m_samples;
+    Cursor_t m_cursor;
+    Span_t m_samples; //valid between collect and consume
 
 };
 
@@ -254,6 +275,10 @@ public:
 
         for (size_t i = 0; i < count; i++)
         {
+            //the outputs pushed by the callback inherit the origin of the oldest input
+            clear_sample_origin();
+            m_storage.track_latency(i);
+
             auto params = m_storage.get_params(i);
             detail::call(func, params);
         }
@@ -262,6 +287,31 @@ public:
         m_storage.unlock();
         return true;
     }
+
+    //For nodes with a single input that work on blocks of samples. The samples are passed in place, as one span.
+    //The callback sets the origin of its outputs itself
+    auto process_block(std::function<void(typename Storage_t::Span_t const&)> const& func) -> bool
+    {
+        static_assert(sizeof...(Streams) == 1, "Only single stream accumulators can process blocks");
+        if (!m_storage.lock())
+        {
+            m_storage.unlock();
+            return false;
+        }
+        auto count = m_storage.collect();
+
+        for (size_t i = 0; i < count; i++)
+        {
+            m_storage.track_latency(i);
+        }
+        clear_sample_origin();
+
+        func(m_storage.get_samples());
+
+        m_storage.consume(count);
+        m_storage.unlock();
+        return true;
+    }
 };
 
 
@@ -0,0 +1,105 @@
+#pragma once
+
+namespace silk
+{
+
+//Tracks how old the samples are compared to the sensor reading they were computed from.
+//
+//Every sample carries the timestamp of its origin (stream::Sample::tp) and each thread has a context that the HAL resets
+// before processing a node:
+// - the Sample_Accumulator sets the origin to the oldest input sample passed to the node callback
+// - the output streams stamp new samples with this origin or, in source nodes, with their own timestamp
+// - the nodes report the samples they consume so the HAL can compute the sample age at consume and,
+//      for the nodes writing to actuators, the end-to-end latency
+struct Sample_Latency_Context
+{
+    q::Clock::time_point origin_tp;
+    bool has_origin = false;
+
+    q::Clock::time_point oldest_consumed_tp;
+    bool has_consumed = false;
+
+    q::Clock::time_point oldest_actuated_tp;
+    bool has_actuated = false;
+};
+
+extern thread_local Sample_Latency_Context t_sample_latency_context;
+
+inline void reset_sample_latency_context()
+{
+    t_sample_latency_context = Sample_Latency_Context();
+}
+
+inline void clear_sample_origin()
+{
+    t_sample_latency_context.has_origin = false;
+}
+
+//Keeps the oldest origin. Samples without a timestamp (from streams that don't track latency) are ignored
+template<class Sample> void add_sample_origin(Sample const& sample)
+{
+    if (sample.tp != q::Clock::time_point())
+    {
+        Sample_Latency_Context& context = t_sample_latency_context;
+        if (!context.has_origin || sample.tp < context.origin_tp)
+        {
+            context.origin_tp = sample.tp;
+            context.has_origin = true;
+        }
+    }
+}
+
+//For nodes that buffer their input samples and push the outputs later
+template<class Sample> void set_sample_origin(Sample const& sample)
+{
+    clear_sample_origin();
+    add_sample_origin(sample);
+}
+
+//For sources that stamp repeated readings with the time the reading was taken
+inline void set_sample_origin(q::Clock::time_point tp)
+{
+    clear_sample_origin();
+    if (tp != q::Clock::time_point())
+    {
+        t_sample_latency_context.origin_tp = tp;
+        t_sample_latency_context.has_origin = true;
+    }
+}
+
+//Returns the timestamp to stamp the new samples with
+inline auto get_sample_origin(q::Clock::time_point default_tp) -> q::Clock::time_point
+{
+    Sample_Latency_Context const& context = t_sample_latency_context;
+    return context.has_origin ? context.origin_tp : default_tp;
+}
+
+template<class Sample> void mark_sample_consumed(Sample const& sample)
+{
+    if (sample.tp != q::Clock::time_point())
+    {
+        Sample_Latency_Context& context = t_sample_latency_context;
+        if (!context.has_consumed || sample.tp < context.oldest_consumed_tp)
+        {
+            context.oldest_consumed_tp = sample.tp;
+            context.has_consumed = true;
+        }
+    }
+}
+
+//For samples written to actuators (PWM, motors)
+template<class Sample> void mark_sample_actuated(Sample const& sample)
+{
+    mark_sample_consumed(sample);
+    if (sample.tp != q::Clock::time_point())
+    {
+        Sample_Latency_Context& context = t_sample_latency_context;
+        if (!context.has_actuated || sample.tp < context.oldest_actuated_tp)
+        {
+            context.oldest_actuated_tp = sample.tp;
+            context.has_actuated = true;
+        }
+    }
+}
+
+}
@@ -0,0 +1,124 @@
+#include "BrainStdAfx.h"
+#include "Tick_Timer.h"
+
+namespace silk
+{
+
+constexpr size_t Tick_Timer::Stats::BUCKET_COUNT;
+
+static const std::array<q::Clock::duration, Tick_Timer::Stats::BUCKET_COUNT - 1> k_bucket_limits =
+{{
+    std::chrono::microseconds(5),
+    std::chrono::microseconds(10),
+    std::chrono::microseconds(20),
+    std::chrono::microseconds(50),
+    std::chrono::microseconds(100),
+    std::chrono::microseconds(200),
+    std::chrono::microseconds(500),
+    std::chrono::milliseconds(1),
+    std::chrono::milliseconds(5),
+}};
+
+static void add_to_timespec(timespec& ts, q::Clock::duration d)
+{
+    int64_t ns = ts.tv_nsec + std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    ts.tv_sec += static_cast<time_t>(ns / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000LL);
+}
+
+static q::Clock::duration diff_timespec(timespec const& a, timespec const& b)
+{
+    int64_t ns = (static_cast<int64_t>(a.tv_sec) - static_cast<int64_t>(b.tv_sec)) * 1000000000LL + (a.tv_nsec - b.tv_nsec);
+    return std::chrono::duration_cast<q::Clock::duration>(std::chrono::nanoseconds(ns));
+}
+
+Tick_Timer::Tick_Timer()
+{
+    m_deadline = {0, 0};
+    m_last_wake_up = {0, 0};
+}
+
+void Tick_Timer::set_period(q::Clock::duration period)
+{
+    QASSERT(period > q::Clock::duration(0));
+    if (m_period != period)
+    {
+        QLOGI("Tick period changed from {} to {}", m_period, period);
+        m_period = period;
+    }
+}
+
+auto Tick_Timer::get_period() const -> q::Clock::duration
+{
+    return m_period;
+}
+
+auto Tick_Timer::get_stats() const -> Stats const&
+{
+    return m_stats;
+}
+
+void Tick_Timer::wait()
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    if (!m_is_started)
+    {
+        m_is_started = true;
+        m_deadline = now;
+        m_last_wake_up = now;
+    }
+
+    m_crt_stats.max_work_duration = std::max(m_crt_stats.max_work_duration, diff_timespec(now, m_last_wake_up));
+
+    add_to_timespec(m_deadline, m_period);
+
+    //the work took longer than a period. Skip the missed deadlines instead of bursting to catch up
+    if (diff_timespec(now, m_deadline) > q::Clock::duration(0))
+    {
+        m_crt_stats.overrun_count++;
+        q::Clock::duration late = diff_timespec(now, m_deadline);
+        add_to_timespec(m_deadline, m_period * (late / m_period + 1));
+    }
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &m_deadline, nullptr) == EINTR)
+    {
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &m_last_wake_up);
+    add_jitter(diff_timespec(m_last_wake_up, m_deadline));
+
+    m_crt_stats.tick_count++;
+
+    latch_stats();
+}
+
+void Tick_Timer::add_jitter(q::Clock::duration jitter)
+{
+    jitter = std::max(jitter, q::Clock::duration(0));
+    m_crt_stats.max_jitter = std::max(m_crt_stats.max_jitter, jitter);
+
+    auto it = std::lower_bound(k_bucket_limits.begin(), k_bucket_limits.end(), jitter);
+    m_crt_stats.jitter_histogram[std::distance(k_bucket_limits.begin(), it)]++;
+}
+
+void Tick_Timer::latch_stats()
+{
+    auto now = q::Clock::now();
+    if (now - m_last_stats_tp < std::chrono::seconds(1))
+    {
+        return;
+    }
+    m_last_stats_tp = now;
+
+    m_stats = m_crt_stats;
+    m_crt_stats = Stats();
+
+    auto const& h = m_stats.jitter_histogram;
+    QLOGI("Ticks {}, overruns {}, max work {}, max jitter {}, jitter histogram <5us:{} <10us:{} <20us:{} <50us:{} <100us:{} <200us:{} <500us:{} <1ms:{} <5ms:{} >5ms:{}",
+          m_stats.tick_count, m_stats.overrun_count, m_stats.max_work_duration, m_stats.max_jitter,
+          h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], h[8], h[9]);
+}
+
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <time.h>
+#include <array>
+
+namespace silk
+{
+
+//Wakes up the calling thread at fixed deadlines using an absolute clock_nanosleep on CLOCK_MONOTONIC.
+//Deadlines that are missed are counted as overruns and skipped - there is no catching up with a burst of ticks.
+//Every second it logs the wake-up jitter histogram, the overruns and the max work duration.
+class Tick_Timer : q::util::Noncopyable
+{
+public:
+    Tick_Timer();
+
+    void set_period(q::Clock::duration period);
+    auto get_period() const -> q::Clock::duration;
+
+    //Sleeps until the next deadline.
+    void wait();
+
+    struct Stats
+    {
+        //the upper bounds are: 5us, 10us, 20us, 50us, 100us, 200us, 500us, 1ms, 5ms and everything above
+        static constexpr size_t BUCKET_COUNT = 10;
+
+        size_t tick_count = 0;
+        size_t overrun_count = 0;
+        std::array<size_t, BUCKET_COUNT> jitter_histogram = {{}};
+        q::Clock::duration max_jitter = q::Clock::duration(0);
+        q::Clock::duration max_work_duration = q::Clock::duration(0);
+    };
+
+    auto get_stats() const -> Stats const&;
+
+private:
+    void add_jitter(q::Clock::duration jitter);
+    void latch_stats();
+
+    q::Clock::duration m_period = std::chrono::milliseconds(1);
+    timespec m_deadline;
+    timespec m_last_wake_up;
+    bool m_is_started = false;
+
+    Stats m_crt_stats;
+    Stats m_stats;
+    q::Clock::time_point m_last_stats_tp = q::Clock::now();
+};
+
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace silk
+{
+namespace bus
+{
+
+//Runs the asynchronous transactions of a bus on a thread owned by the bus.
+//All the transactions queued while the thread was busy are handed to the executor as one batch so the bus can merge them
+// in as few kernel calls as possible.
+template<class Transaction>
+class Async_Bus_Queue : q::util::Noncopyable
+{
+public:
+    typedef std::vector<std::shared_ptr<Transaction>> Batch;
+
+    //executes the batch and sets is_ok for each transaction
+    typedef std::function<void(Batch const&)> Executor;
+
+    Async_Bus_Queue() = default;
+    ~Async_Bus_Queue()
+    {
+        stop();
+    }
+
+    void start(std::string const& name, Executor const& executor)
+    {
+        stop();
+
+        m_name = name;
+        m_executor = executor;
+        m_exit = false;
+        m_thread = std::thread([this]() { thread_proc(); });
+
+#if defined RASPBERRY_PI
+        {
+            //just under the control loop
+            int policy = SCHED_FIFO;
+            struct sched_param param;
+            param.sched_priority = sched_get_priority_max(policy) - 1;
+            if (pthread_setschedparam(m_thread.native_handle(), policy, &param) != 0)
+            {
+                perror("Failed to set priority for bus thread");
+            }
+        }
+#endif
+    }
+
+    //the queued transactions are executed before the thread exits
+    void stop()
+    {
+        if (!m_thread.joinable())
+        {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_exit = true;
+        }
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    auto submit(std::shared_ptr<Transaction> const& transaction) -> bool
+    {
+        QASSERT(transaction);
+        if (!m_thread.joinable())
+        {
+            QLOGW("{}: the bus thread is not running", m_name);
+            return false;
+        }
+        if (transaction->is_pending.exchange(true, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+
+        {
+            std::lock_guard<std::mutex> lg(m_mutex);
+            m_queue.push_back(transaction);
+        }
+        m_cv.notify_all();
+        return true;
+    }
+
+private:
+    void thread_proc()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this]() { return m_exit || !m_queue.empty(); });
+                if (m_queue.empty())
+                {
+                    break;
+                }
+                //the batch keeps its capacity, so no allocations after the first frames
+                std::swap(m_queue, m_batch);
+            }
+
+            m_executor(m_batch);
+
+            auto now = q::Clock::now();
+            for (std::shared_ptr<Transaction> const& transaction: m_batch)
+            {
+                transaction->completion_tp = now;
+                transaction->is_pending.store(false, std::memory_order_release);
+                if (transaction->callback)
+                {
+                    transaction->callback();
+                }
+            }
+            m_batch.clear();
+        }
+    }
+
+    std::string m_name;
+    Executor m_executor;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    Batch m_queue;
+    Batch m_batch;
+    bool m_exit = false;
+    std::thread m_thread;
+};
+
+}
+}
@@ -28,6 +28,7 @@ I2C_BCM::I2C_BCM()
 
 I2C_BCM::~I2C_BCM()
 {
+    m_async_queue.stop();
 }
 
 ts::Result<void> I2C_BCM::init(hal::IBus_Descriptor const& descriptor)
@@ -61,6 +62,7 @@ ts::Result<void> I2C_BCM::init(uint32_t dev, uint32_t baud)
 
 #endif
 
+    m_async_queue.start("i2c bcm " + std::to_string(dev), [this](Async_Queue::Batch const& batch) { execute_transactions(batch); });
     return ts::success;
 }
 
@@ -160,5 +162,53 @@ auto I2C_BCM::write_register(uint8_t address, uint8_t reg, uint8_t const* data,
     return true;
 }
 
+auto I2C_BCM::submit(std::shared_ptr<Transaction> const& transaction) -> bool
+{
+    return m_async_queue.submit(transaction);
+}
+
+auto I2C_BCM::execute_transaction(Transaction& transaction) -> bool
+{
+    for (size_t i = 0; i < transaction.message_count; i++)
+    {
+        Transaction::Message& m = transaction.messages[i];
+
+        //a register write followed by a read needs a repeated start
+        if (!m.is_read && m.data.size() == 1 && i + 1 < transaction.message_count)
+        {
+            Transaction::Message& next = transaction.messages[i + 1];
+            if (next.is_read && next.address == m.address)
+            {
+                if (!read_register(m.address, m.data[0], next.data.data(), next.data.size()))
+                {
+                    return false;
+                }
+                i++;
+                continue;
+            }
+        }
+
+        bool res = m.is_read ? read(m.address, m.data.data(), m.data.size()) : write(m.address, m.data.data(), m.data.size());
+        if (!res)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//runs on the bus thread. The BCM controller has no message queue so the transactions are executed one by one,
+// but at least not on the control thread.
+void I2C_BCM::execute_transactions(Async_Queue::Batch const& batch)
+{
+    QLOG_TOPIC("i2c_bcm::execute_transactions");
+
+    std::lock_guard<I2C_BCM> lg(*this);
+    for (std::shared_ptr<Transaction> const& transaction: batch)
+    {
+        transaction->is_ok = execute_transaction(*transaction);
+    }
+}
+
 }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/bus/II2C.h"
+#include "bus/Async_Bus_Queue.h"
 
 namespace silk
 {
@@ -34,10 +35,17 @@ public:
     auto read_register(uint8_t address, uint8_t reg, uint8_t* data, size_t size) -> bool;
     auto write_register(uint8_t address, uint8_t reg, uint8_t const* data, size_t size) -> bool;
 
+    auto submit(std::shared_ptr<Transaction> const& transaction) -> bool;
+
 private:
     ts::Result<void> init(uint32_t dev, uint32_t baud);
 
+    typedef Async_Bus_Queue<Transaction> Async_Queue;
+    void execute_transactions(Async_Queue::Batch const& batch);
+    auto execute_transaction(Transaction& transaction) -> bool;
+
     std::shared_ptr<hal::I2C_BCM_Descriptor> m_descriptor;
+    Async_Queue m_async_queue;
 
     std::recursive_mutex m_mutex;
     std::vector<uint8_t> m_buffer;
@@ -33,6 +33,9 @@ namespace silk
 namespace bus
 {
 
+//the kernel limit for the number of messages in an I2C_RDWR call (I2C_RDWR_IOCTL_MAX_MSGS)
+constexpr size_t MAX_BATCH_MESSAGE_COUNT = 42;
+
 I2C_Linux::I2C_Linux()
     : m_descriptor(new hal::I2C_Linux_Descriptor())
 {
@@ -40,6 +43,7 @@ I2C_Linux::I2C_Linux()
 
 I2C_Linux::~I2C_Linux()
 {
+    m_async_queue.stop();
     close();
 }
 
@@ -71,6 +75,8 @@ ts::Result<void> I2C_Linux::init(std::string const& dev)
     {
         return make_error("can't open " + dev + ": " + strerror(errno));
     }
+
+    m_async_queue.start("i2c " + dev, [this](Async_Queue::Batch const& batch) { execute_transactions(batch); });
     return ts::success;
 }
 
@@ -222,6 +228,94 @@ auto I2C_Linux::write_register(uint8_t address, uint8_t reg, uint8_t const* data
     return true;
 }
 
+auto I2C_Linux::submit(std::shared_ptr<Transaction> const& transaction) -> bool
+{
+    return m_async_queue.submit(transaction);
+}
+
+void I2C_Linux::add_batch_messages(Transaction& transaction)
+{
+    m_batch_messages.resize((m_batch_message_count + transaction.message_count) * sizeof(i2c_msg));
+    i2c_msg* msgs = reinterpret_cast<i2c_msg*>(m_batch_messages.data());
+
+    for (size_t i = 0; i < transaction.message_count; i++)
+    {
+        Transaction::Message& m = transaction.messages[i];
+        i2c_msg& msg = msgs[m_batch_message_count++];
+        msg.addr = m.address;
+        msg.flags = m.is_read ? I2C_M_RD : 0;
+        msg.len = m.data.size();
+        msg.buf = m.data.data();
+    }
+}
+
+auto I2C_Linux::execute_messages(size_t count) -> bool
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    struct i2c_rdwr_ioctl_data io;
+    memset(&io, 0, sizeof(i2c_rdwr_ioctl_data));
+    io.msgs = reinterpret_cast<decltype(io.msgs)>(m_batch_messages.data());
+    io.nmsgs = count;
+    if (ioctl(m_fd, I2C_RDWR, &io) < 0)
+    {
+        QLOGW("batch of {} messages failed: {}", count, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+//runs on the bus thread
+void I2C_Linux::execute_transactions(Async_Queue::Batch const& batch)
+{
+    QLOG_TOPIC("i2c_linux::execute_transactions");
+    QASSERT(m_fd >= 0);
+
+    std::lock_guard<I2C_Linux> lg(*this);
+
+    size_t begin = 0;
+    while (begin < batch.size())
+    {
+        //merge as many transactions as the kernel accepts in a call
+        m_batch_message_count = 0;
+        size_t end = begin;
+        while (end < batch.size())
+        {
+            Transaction& transaction = *batch[end];
+            if (end > begin && m_batch_message_count + transaction.message_count > MAX_BATCH_MESSAGE_COUNT)
+            {
+                break;
+            }
+            add_batch_messages(transaction);
+            end++;
+        }
+
+        bool is_ok = execute_messages(m_batch_message_count);
+        if (!is_ok && end - begin > 1)
+        {
+            //retry one by one to find out which transaction failed (a device not acking for example)
+            for (size_t i = begin; i < end; i++)
+            {
+                Transaction& transaction = *batch[i];
+                m_batch_message_count = 0;
+                add_batch_messages(transaction);
+                transaction.is_ok = execute_messages(m_batch_message_count);
+            }
+        }
+        else
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                batch[i]->is_ok = is_ok;
+            }
+        }
+        begin = end;
+    }
+}
+
 
 }
 }
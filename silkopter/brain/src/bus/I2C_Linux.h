@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/bus/II2C.h"
+#include "bus/Async_Bus_Queue.h"
 
 namespace silk
 {
@@ -36,14 +37,25 @@ public:
     auto read_register(uint8_t address, uint8_t reg, uint8_t* data, size_t size) -> bool;
     auto write_register(uint8_t address, uint8_t reg, uint8_t const* data, size_t size) -> bool;
 
+    auto submit(std::shared_ptr<Transaction> const& transaction) -> bool;
+
 private:
     ts::Result<void> init(std::string const& dev);
 
+    typedef Async_Bus_Queue<Transaction> Async_Queue;
+    void execute_transactions(Async_Queue::Batch const& batch);
+    auto execute_messages(size_t count) -> bool;
+    void add_batch_messages(Transaction& transaction);
+
     std::shared_ptr<hal::I2C_Linux_Descriptor> m_descriptor;
 
     int m_fd = -1;
     std::recursive_mutex m_mutex;
     std::vector<uint8_t> m_buffer;
+
+    std::vector<uint8_t> m_batch_messages; //storage for the i2c_msg array, the type is not visible in the header
+    size_t m_batch_message_count = 0;
+    Async_Queue m_async_queue;
 };
 
 }
@@ -29,6 +29,7 @@ SPI_BCM::SPI_BCM()
 
 SPI_BCM::~SPI_BCM()
 {
+    m_async_queue.stop();
 }
 
 ts::Result<void> SPI_BCM::init(hal::IBus_Descriptor const& descriptor)
@@ -71,6 +72,7 @@ ts::Result<void> SPI_BCM::open(uint32_t dev, uint32_t speed, uint32_t mode)
 
 #endif
 
+    m_async_queue.start("spi bcm " + std::to_string(dev), [this](Async_Queue::Batch const& batch) { execute_transactions(batch); });
     return ts::success;
 }
 
@@ -169,6 +171,30 @@ auto SPI_BCM::transfer_register(uint8_t reg, uint8_t const* tx_data, uint8_t* rx
     return true;
 }
 
+auto SPI_BCM::submit(std::shared_ptr<Transaction> const& transaction) -> bool
+{
+    return m_async_queue.submit(transaction);
+}
+
+//runs on the bus thread. The transfers are polled by the bcm2835 library one by one so there is nothing to merge,
+// but at least they don't stall the control thread.
+void SPI_BCM::execute_transactions(Async_Queue::Batch const& batch)
+{
+    QLOG_TOPIC("spi_bcm::execute_transactions");
+
+    std::lock_guard<SPI_BCM> lg(*this);
+    for (std::shared_ptr<Transaction> const& transaction: batch)
+    {
+        bool is_ok = true;
+        for (size_t i = 0; i < transaction->transfer_count && is_ok; i++)
+        {
+            Transaction::Transfer& t = transaction->transfers[i];
+            is_ok &= do_transfer(t.tx_data.data(), t.rx_data.data(), t.tx_data.size(), t.speed);
+        }
+        transaction->is_ok = is_ok;
+    }
+}
+
 
 }
 }
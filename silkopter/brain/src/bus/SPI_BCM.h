@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/bus/ISPI.h"
+#include "bus/Async_Bus_Queue.h"
 
 namespace silk
 {
@@ -31,9 +32,15 @@ public:
     virtual auto transfer(uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool override;
     virtual auto transfer_register(uint8_t reg, uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool override;
 
+    virtual auto submit(std::shared_ptr<Transaction> const& transaction) -> bool override;
+
 private:
     ts::Result<void> open(uint32_t dev, uint32_t speed, uint32_t mode);
 
+    typedef Async_Bus_Queue<Transaction> Async_Queue;
+    void execute_transactions(Async_Queue::Batch const& batch);
+    Async_Queue m_async_queue;
+
     auto get_divider(uint32_t speed) const -> uint32_t;
 
     auto do_transfer(uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed) -> bool;
@@ -8,6 +8,10 @@ namespace silk
 namespace bus
 {
 
+//limits for merging transactions in a single SPI_IOC_MESSAGE. The default spidev buffer is 4096 bytes
+constexpr size_t MAX_BATCH_TRANSFER_COUNT = 32;
+constexpr size_t MAX_BATCH_SIZE = 4096;
+
 SPI_Linux::SPI_Linux()
     : m_descriptor(new hal::SPI_Linux_Descriptor())
 {
@@ -15,6 +19,7 @@ SPI_Linux::SPI_Linux()
 
 SPI_Linux::~SPI_Linux()
 {
+    m_async_queue.stop();
 }
 
 ts::Result<void> SPI_Linux::init(hal::IBus_Descriptor const& descriptor)
@@ -38,33 +43,140 @@ ts::Result<void> SPI_Linux::init(std::string const& dev, uint32_t speed)
 {
     QLOG_TOPIC("spi_linux::init");
 
-    return m_spi_dev.init(dev, speed);
+    auto result = m_spi_dev.init(dev, speed);
+    if (result != ts::success)
+    {
+        return result;
+    }
+
+    m_async_queue.start("spi " + dev, [this](Async_Queue::Batch const& batch) { execute_transactions(batch); });
+    return ts::success;
 }
 
 void SPI_Linux::lock()
 {
+    m_mutex.lock();
 }
 
 auto SPI_Linux::try_lock() -> bool
 {
-    return true;
+    return m_mutex.try_lock();
 }
 
 void SPI_Linux::unlock()
 {
+    m_mutex.unlock();
 }
 
 bool SPI_Linux::transfer(uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed)
 {
     QLOG_TOPIC("SPI_Linux::transfer");
+    std::lock_guard<SPI_Linux> lg(*this);
     return m_spi_dev.transfer(tx_data, rx_data, size, speed);
 }
 
 bool SPI_Linux::transfer_register(uint8_t reg, uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed)
 {
     QLOG_TOPIC("SPI_Linux::transfer_register");
+    std::lock_guard<SPI_Linux> lg(*this);
     return m_spi_dev.transfer_register(reg, tx_data, rx_data, size, speed);
 }
 
+auto SPI_Linux::submit(std::shared_ptr<Transaction> const& transaction) -> bool
+{
+    return m_async_queue.submit(transaction);
+}
+
+void SPI_Linux::add_batch_transfers(Transaction& transaction)
+{
+    for (size_t i = 0; i < transaction.transfer_count; i++)
+    {
+        Transaction::Transfer& t = transaction.transfers[i];
+        util::hw::SPI_Dev::Transfer transfer;
+        transfer.tx_data = t.tx_data.data();
+        transfer.rx_data = t.rx_data.data();
+        transfer.size = t.tx_data.size();
+        transfer.speed = t.speed;
+        transfer.cs_change = true; //every transfer is a separate command for the device
+        m_batch_transfers.push_back(transfer);
+    }
+}
+
+//runs on the bus thread
+void SPI_Linux::execute_transactions(Async_Queue::Batch const& batch)
+{
+    QLOG_TOPIC("SPI_Linux::execute_transactions");
+
+    std::lock_guard<SPI_Linux> lg(*this);
+
+    size_t begin = 0;
+    while (begin < batch.size())
+    {
+        //merge as many transactions as the kernel accepts in a message
+        m_batch_transfers.clear();
+        size_t batch_size = 0;
+        size_t end = begin;
+        while (end < batch.size())
+        {
+            Transaction& transaction = *batch[end];
+            size_t size = 0;
+            for (size_t i = 0; i < transaction.transfer_count; i++)
+            {
+                size += transaction.transfers[i].tx_data.size();
+            }
+            if (end > begin &&
+                (m_batch_transfers.size() + transaction.transfer_count > MAX_BATCH_TRANSFER_COUNT || batch_size + size > MAX_BATCH_SIZE))
+            {
+                break;
+            }
+            add_batch_transfers(transaction);
+            batch_size += size;
+            end++;
+        }
+
+        if (m_batch_transfers.empty())
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                batch[i]->is_ok = true;
+            }
+            begin = end;
+            continue;
+        }
+
+        //a cs_change on the last transfer would keep the device selected
+        m_batch_transfers.back().cs_change = false;
+
+        bool is_ok = m_spi_dev.transfer(m_batch_transfers.data(), m_batch_transfers.size());
+        if (!is_ok && end - begin > 1)
+        {
+            //retry one by one to find out which transaction failed
+            for (size_t i = begin; i < end; i++)
+            {
+                Transaction& transaction = *batch[i];
+                m_batch_transfers.clear();
+                add_batch_transfers(transaction);
+                if (!m_batch_transfers.empty())
+                {
+                    m_batch_transfers.back().cs_change = false;
+                    transaction.is_ok = m_spi_dev.transfer(m_batch_transfers.data(), m_batch_transfers.size());
+                }
+                else
+                {
+                    transaction.is_ok = true;
+                }
+            }
+        }
+        else
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                batch[i]->is_ok = is_ok;
+            }
+        }
+        begin = end;
+    }
+}
+
 }
 }
@@ -2,6 +2,7 @@
 
 #include "common/bus/ISPI.h"
 #include "utils/hw/SPI_Dev.h"
+#include "bus/Async_Bus_Queue.h"
 
 namespace silk
 {
@@ -32,11 +33,23 @@ public:
     virtual auto transfer(uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool override;
     virtual auto transfer_register(uint8_t reg, uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool override;
 
+    virtual auto submit(std::shared_ptr<Transaction> const& transaction) -> bool override;
+
 private:
     ts::Result<void> init(std::string const& dev, uint32_t speed);
 
+    typedef Async_Bus_Queue<Transaction> Async_Queue;
+    void execute_transactions(Async_Queue::Batch const& batch);
+    void add_batch_transfers(Transaction& transaction);
+
     std::shared_ptr<hal::SPI_Linux_Descriptor> m_descriptor;
     util::hw::SPI_Dev m_spi_dev;
+
+    std::vector<util::hw::SPI_Dev::Transfer> m_batch_transfers;
+    Async_Queue m_async_queue;
+
+    //the synchronous transfers from the nodes and the bus thread both use the device
+    std::recursive_mutex m_mutex;
 };
 
 }
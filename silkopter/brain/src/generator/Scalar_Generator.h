@@ -167,7 +167,7 @@ void Scalar_Generator<Stream_t>::process()
     auto modulation_stream = m_modulation_stream.lock();
     if (modulation_stream)
     {
-        auto const& samples = modulation_stream->get_samples();
+        auto samples = modulation_stream->get_samples().get_frame();
         for (auto const& s: samples)
         {
             if (s.is_healthy)
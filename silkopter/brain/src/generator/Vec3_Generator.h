@@ -184,7 +184,7 @@ void Vec3_Generator<Stream_t>::process()
         auto stream = m_modulation_streams[s].lock();
         if (stream)
         {
-            auto const& samples = stream->get_samples();
+            auto samples = stream->get_samples().get_frame();
             m_modulation_samples[s].reserve(m_modulation_samples[s].size() + samples.size());
             std::copy(samples.begin(), samples.end(), std::back_inserter(m_modulation_samples[s]));
             count = std::min(count, m_modulation_samples[s].size());
@@ -48,6 +48,9 @@ private:
 
     util::Butterworth<typename Stream_t::Value> m_dsp;
 
+    //the samples of a frame are filtered as a block
+    std::vector<typename Stream_t::Value> m_block;
+
     typedef Basic_Output_Stream<Stream_t> Output_Stream;
     mutable std::shared_ptr<Output_Stream> m_output_stream;
 };
@@ -177,19 +180,35 @@ void LPF<Stream_t>::process()
         return;
     }
 
-    m_accumulator.process([this](typename Stream_t::Sample const& i_sample)
+    m_accumulator.process_block([this](typename util::Ring_Buffer<typename Stream_t::Sample>::Span const& input_samples)
     {
-        if (i_sample.is_healthy)
-        {
-            auto value = i_sample.value;
-            QASSERT(math::is_finite(value));
-            m_dsp.process(value);
-            QASSERT(math::is_finite(value));
-            m_output_stream->push_sample(value, true);
-        }
-        else
+        size_t i = 0;
+        while (i < input_samples.size())
         {
-            m_output_stream->push_last_sample(false);
+            if (!input_samples[i].is_healthy)
+            {
+                set_sample_origin(input_samples[i]);
+                m_output_stream->push_last_sample(false);
+                i++;
+                continue;
+            }
+
+            //filter the run of healthy samples in one go
+            m_block.clear();
+            for (size_t j = i; j < input_samples.size() && input_samples[j].is_healthy; j++)
+            {
+                QASSERT(math::is_finite(input_samples[j].value));
+                m_block.push_back(input_samples[j].value);
+            }
+            m_dsp.process(m_block.data(), m_block.size());
+
+            for (auto const& value: m_block)
+            {
+                QASSERT(math::is_finite(value));
+                set_sample_origin(input_samples[i]);
+                m_output_stream->push_sample(value, true);
+                i++;
+            }
         }
     });
 }
@@ -2,6 +2,7 @@
 #include "HAL.h"
 #include "RC_Comms.h"
 #include "GS_Comms.h"
+#include "Tick_Timer.h"
 
 #include <boost/asio.hpp>
 #include <boost/thread.hpp>
@@ -15,7 +16,7 @@
 #include <malloc.h>
 
 size_t s_test = 0;
-bool s_exit = false;
+std::atomic_bool s_exit{false};
 boost::asio::io_service s_async_io_service;
 
 struct Memory
@@ -62,6 +63,8 @@ void execute_async_call(std::function<void()> f)
 //}
 
 
+constexpr std::chrono::milliseconds COMMS_PERIOD(5);
+
 // Define the function to be called when ctrl-c (SIGINT) signal is sent to process
 void signal_handler(int signum)
 {
@@ -183,56 +186,71 @@ int main(int argc, char const* argv[])
         QLOGI("All systems up. Ready to fly...");
 
         {
-            constexpr std::chrono::microseconds PERIOD(5000);
-            auto last = q::Clock::now();
-            while (!s_exit)
+            //the comms run on their own thread with a normal priority so the control path never waits for them
+            std::thread comms_thread([&rc_comms, &gs_comms]()
             {
-                auto start = q::Clock::now();
-                auto dt = start - last;
-                last = start;
-#ifdef NDEBUG
-                if (dt > std::chrono::milliseconds(5))
-#else
-                if (dt > std::chrono::milliseconds(50))
-#endif
+                while (!s_exit)
                 {
-                    QLOGW("Process Latency of {}!!!!!", dt);
+                    gs_comms.process();
+                    rc_comms.process();
+                    std::this_thread::sleep_for(COMMS_PERIOD);
                 }
-                gs_comms.process();
-                rc_comms.process();
-                hal.process();
-
-                //No sleeping here!!! process as fast as possible as the nodes are not always in the ideal order
-                // and out of order nodes will be processes next 'frame'. So the quicker the frames, the smaller the lag between nodes
-#ifndef RASPBERRY_PI
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-#endif
+            });
 
+#if defined RASPBERRY_PI
+            {
+                //the thread inherits the FIFO priority of main, put it back with the normal ones
+                int policy = SCHED_OTHER;
+                struct sched_param param;
+                param.sched_priority = sched_get_priority_min(policy);
+                if (pthread_setschedparam(comms_thread.native_handle(), policy, &param) != 0)
                 {
-                    static q::Clock::time_point last_timestamp = q::Clock::now();
-                    auto now = q::Clock::now();
-                    auto dt = now - last_timestamp;
-                    last_timestamp = now;
-                    static q::Clock::duration min_dt, max_dt, avg_dt;
-                    static int xxx = 0;
-                    min_dt = std::min(min_dt, dt);
-                    max_dt = std::max(max_dt, dt);
-                    avg_dt += dt;
-                    xxx++;
-                    static q::Clock::time_point xxx_timestamp = q::Clock::now();
-                    if (now - xxx_timestamp >= std::chrono::milliseconds(1000))
+                    perror("Failed to set priority for comms thread");
+                }
+            }
+            {
+                //keep the control thread on its own core, away from the comms
+                size_t cpu_count = std::thread::hardware_concurrency();
+                if (cpu_count > 1)
+                {
+                    cpu_set_t cpuset;
+                    CPU_ZERO(&cpuset);
+                    CPU_SET(cpu_count - 1, &cpuset);
+                    if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
                     {
-                        xxx_timestamp = now;
-
-                        QLOGI("min {}, max {}, avg {}", min_dt, max_dt, avg_dt/ xxx);
-                        min_dt = dt;
-                        max_dt = dt;
-                        avg_dt = std::chrono::milliseconds(0);
+                        perror("Failed to set affinity for main thread");
+                    }
 
-                        xxx = 0;
+                    CPU_ZERO(&cpuset);
+                    for (size_t i = 0; i < cpu_count - 1; i++)
+                    {
+                        CPU_SET(i, &cpuset);
+                    }
+                    if (pthread_setaffinity_np(comms_thread.native_handle(), sizeof(cpu_set_t), &cpuset) != 0)
+                    {
+                        perror("Failed to set affinity for comms thread");
                     }
                 }
             }
+#endif
+
+            //The nodes are processed in dependency order so a sample goes from the sensors to the PWM sinks in one frame.
+            //The frames are timed at the rate of the fastest stream
+            silk::Tick_Timer tick_timer;
+            while (!s_exit)
+            {
+                tick_timer.set_period(hal.get_process_period());
+                tick_timer.wait();
+
+                std::lock_guard<std::mutex> lg(hal.get_mutex());
+                hal.process();
+                gs_comms.gather_telemetry_data();
+            }
+
+            if (comms_thread.joinable())
+            {
+                comms_thread.join();
+            }
         }
 
 exit:
@@ -72,7 +72,7 @@ void Multirotor_Pilot::process()
 
     //process commandss
     {
-        auto const& commandsOpt = m_rc_comms.get_multirotor_commands();
+        auto commandsOpt = m_rc_comms.get_multirotor_commands();
 
         auto now = q::Clock::now();
 
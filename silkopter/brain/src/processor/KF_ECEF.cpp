@@ -4,94 +4,50 @@
 #include "hal.def.h"
 //#include "sz_KF_ECEF.hpp"
 
-#include "Eigen/Dense"
 
 namespace silk
 {
 namespace node
 {
 
-template<size_t St, size_t Me>
-KF_ECEF::KF<St, Me>::KF()
-{
-    A.setIdentity();
-    x.setZero();
-
-    B.setIdentity();
-    u.setZero();
-
-    H.setIdentity();
-    z.setZero();
-
-    //error
-    P.setIdentity();
-    Q.setIdentity();
-
-    K.setIdentity();
-    R.setIdentity();
-
-    I.setIdentity();
-
-    I.setIdentity();
-    B.setIdentity();
-    H.setIdentity();
-    P.setIdentity();
-    K.setIdentity();
-}
-
-template<size_t St, size_t Me>
-__attribute__((optimize("O3"))) void KF_ECEF::KF<St, Me>::predict()
-{
-    x = A * x + B * u; //state prediction
-    P = A * P * A.transpose() + Q; //covariance prediction
-}
-
-template<size_t St, size_t Me>
-__attribute__((optimize("O3"))) void KF_ECEF::KF<St, Me>::update()
-{
-    auto HT = H.transpose();
-
-    Measurement_Vector y = z - H * x; //innovation
-
-    auto S = H * P * HT + R; //innovation covariance
-
-    K = P * HT * S.inverse(); //gain
-    x = x + K * y; // state
-    P = (I - K * H) * P; //covariance
-}
-
-template<size_t St, size_t Me>
-void KF_ECEF::KF<St, Me>::process()
-{
-    predict();
-    update();
-}
-
 ///////////////////////////////////////////////////////////////////////
 
 template<class Value>
 void KF_ECEF::Delayer<Value>::init(float dt, float lag)
 {
     QASSERT(dt > 0.f && lag >= 0.f);
-    min_value_count = math::max(static_cast<size_t>(math::round(lag / dt)), size_t(1));
+    size_t size = math::max(static_cast<size_t>(math::round(lag / dt)), size_t(1));
     values.clear();
+    values.resize(size);
+    is_new_values.clear();
+    is_new_values.resize(size, false);
+    index = 0;
+    count = 0;
 }
 
 template<class Value>
-auto KF_ECEF::Delayer<Value>::get_value() -> Value const&
+auto KF_ECEF::Delayer<Value>::get_value() const -> Value const&
 {
-    QASSERT(!values.empty());
-    return values.front();
+    QASSERT(count > 0);
+    //the oldest one
+    return values[count < values.size() ? 0 : index];
 }
 
 template<class Value>
-void KF_ECEF::Delayer<Value>::push_back(Value const& value)
+auto KF_ECEF::Delayer<Value>::is_new() const -> bool
 {
-    values.push_back(value);
-    while (values.size() > min_value_count)
-    {
-        values.pop_front();
-    }
+    QASSERT(count > 0);
+    return is_new_values[count < values.size() ? 0 : index];
+}
+
+template<class Value>
+void KF_ECEF::Delayer<Value>::push_back(Value const& value, bool is_new)
+{
+    QASSERT(!values.empty());
+    values[index] = value;
+    is_new_values[index] = is_new;
+    index = (index + 1) % values.size();
+    count = math::min(count + 1, values.size());
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -195,6 +151,9 @@ void KF_ECEF::process()
                                   stream::IECEF_Velocity::Sample const& gps_vel_sample,
                                   stream::IENU_Linear_Acceleration::Sample const& la_sample)
     {
+        //the GPS samples carry the time of their fix so they would make the outputs look as old as the last fix
+        set_sample_origin(la_sample);
+
         if (gps_pos_sample.is_healthy & gps_vel_sample.is_healthy & la_sample.is_healthy)
         {
             util::coordinates::LLA lla_position = util::coordinates::ecef_to_lla(gps_pos_sample.value);
@@ -212,25 +171,33 @@ void KF_ECEF::process()
                 m_kf_z.x(0) = gps_pos_sample.value.z;
             }
 
+            //The GPS is much slower than the filter and its streams repeat the last fix in between.
+            //Only new fixes are used, otherwise the same reading would be fused over and over.
+            //They are told apart by timestamp as a stationary GPS can report the same value twice in a row.
             {
-                m_gps_position_delayer.push_back(gps_pos_sample.value);
+                bool is_new = gps_pos_sample.tp != m_last_gps_position_tp;
+                m_last_gps_position_tp = gps_pos_sample.tp;
+                m_gps_position_delayer.push_back(gps_pos_sample.value, is_new);
                 stream::IECEF_Position::Value const& pos = m_gps_position_delayer.get_value();
                 m_kf_x.z(0) = pos.x;
                 m_kf_y.z(0) = pos.y;
                 m_kf_z.z(0) = pos.z;
+                m_kf_x.has_z[0] = m_kf_y.has_z[0] = m_kf_z.has_z[0] = m_gps_position_delayer.is_new();
             }
 
-
             {
-                m_gps_velocity_delayer.push_back(gps_vel_sample.value);
+                bool is_new = gps_vel_sample.tp != m_last_gps_velocity_tp;
+                m_last_gps_velocity_tp = gps_vel_sample.tp;
+                m_gps_velocity_delayer.push_back(gps_vel_sample.value, is_new);
                 stream::IECEF_Velocity::Value const& vel = m_gps_velocity_delayer.get_value();
                 m_kf_x.z(1) = vel.x;
                 m_kf_y.z(1) = vel.y;
                 m_kf_z.z(1) = vel.z;
+                m_kf_x.has_z[1] = m_kf_y.has_z[1] = m_kf_z.has_z[1] = m_gps_velocity_delayer.is_new();
             }
 
             {
-                m_linear_acceleration_delayer.push_back(ecef_la);
+                m_linear_acceleration_delayer.push_back(ecef_la, true);
                 stream::IECEF_Linear_Acceleration::Value const& acc = m_linear_acceleration_delayer.get_value();
                 m_kf_x.z(2) = acc.x;
                 m_kf_y.z(2) = acc.y;
@@ -274,9 +241,7 @@ ts::Result<void> KF_ECEF::set_config(hal::INode_Config const& config)
     double gps_vel_acu = math::square(m_config->get_gps_velocity_accuracy());
     double acc_acu = math::square(m_config->get_acceleration_accuracy());
 
-    m_kf_x.R << gps_pos_acu,    0,              0,
-                0,              gps_vel_acu,    0,
-                0,              0,              acc_acu;
+    m_kf_x.R << gps_pos_acu, gps_vel_acu, acc_acu;
 
     m_kf_y.R = m_kf_x.R;
     m_kf_z.R = m_kf_x.R;
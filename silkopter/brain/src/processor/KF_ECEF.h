@@ -12,7 +12,7 @@
 #include "Sample_Accumulator.h"
 #include "Basic_Output_Stream.h"
 
-#include "Eigen/Core"
+#include "utils/Kalman_Filter.h"
 
 
 namespace silk
@@ -74,62 +74,37 @@ private:
     typedef Basic_Output_Stream<stream::IECEF_Linear_Acceleration> Linear_Acceleration_Output_Stream;
     mutable std::shared_ptr<Linear_Acceleration_Output_Stream> m_linear_acceleration_output_stream;
 
-    template<size_t St, size_t Me>
-    class KF
-    {
-    public:
-        KF();
-
-        //state
-        Eigen::Matrix<double, St, St> A; //State transition matrix.
-        typedef Eigen::Matrix<double, St, 1> State_Vector;
-        State_Vector x; //State estimate
-
-        //input
-        Eigen::Matrix<double, St, St> B; //Control matrix. This is used to define linear equations for any control factors.
-        typedef Eigen::Matrix<double, St, 1> Input_Vector;
-        Input_Vector u;
-
-        Eigen::Matrix<double, Me, St> H; //Observation matrix. Multiply a state vector by H to translate it to a measurement vector.
-
-        typedef Eigen::Matrix<double, Me, 1> Measurement_Vector;
-        Measurement_Vector z; //measurement data
-
-        //error
-        Eigen::Matrix<double, St, St> P; //state error
-        Eigen::Matrix<double, St, St> Q; //estimated process error covariance
-
-        Eigen::Matrix<double, St, Me> K; //kalman gain
-        Eigen::Matrix<double, Me, Me> R; //measurement error covariance
-
-        Eigen::Matrix<double, St, St> I; //identity
-
-        void predict();
-        void update();
-
-        void process();
-    };
-
-    KF<3, 3> m_kf_x;
-    KF<3, 3> m_kf_y;
-    KF<3, 3> m_kf_z;
+    //one filter per axis, the state is position, velocity, acceleration
+    typedef util::Kalman_Filter<3, 3> KF;
+    KF m_kf_x;
+    KF m_kf_y;
+    KF m_kf_z;
 
     float m_dts = 0;
 
+    //Delays the measurements by a fixed number of samples. It remembers if each of them was a new reading
+    // so the filter doesn't use the same GPS fix again while the GPS streams hold it.
     template<class Value>
     struct Delayer
     {
         void init(float dt, float lag);
-        void push_back(Value const& value);
-        auto get_value() -> Value const&;
-
-        std::deque<Value> values;
-        size_t min_value_count = 0;
+        void push_back(Value const& value, bool is_new);
+        auto get_value() const -> Value const&;
+        auto is_new() const -> bool;
+
+        std::vector<Value> values;
+        std::vector<bool> is_new_values;
+        size_t index = 0;
+        size_t count = 0;
     };
 
     Delayer<stream::IECEF_Position::Value> m_gps_position_delayer;
     Delayer<stream::IECEF_Velocity::Value> m_gps_velocity_delayer;
     Delayer<stream::IECEF_Linear_Acceleration::Value> m_linear_acceleration_delayer;
+
+    //the GPS stamps all the samples of a fix with the time it got the fix
+    q::Clock::time_point m_last_gps_position_tp;
+    q::Clock::time_point m_last_gps_velocity_tp;
 };
 
 
@@ -0,0 +1,126 @@
+#include "BrainStdAfx.h"
+#include "Motor_Allocation.h"
+
+namespace silk
+{
+namespace node
+{
+
+//The collective thrust row is scaled down so when the motors saturate the torque wins and the collective thrust gets what's left.
+//When nothing saturates the solution is exact and the weight doesn't matter.
+constexpr float COLLECTIVE_THRUST_WEIGHT = 0.1f;
+
+//Relative to the trace of the gram matrix. A pivot under this means the free motors don't span the 4 axes
+// (fewer than 4 left, or all on a line) and only then a ridge this big is added to keep the solve defined.
+constexpr float RANK_EPSILON = 1e-6f;
+
+static auto decompose_gram(Eigen::Matrix4f gram) -> Eigen::LDLT<Eigen::Matrix4f>
+{
+    float ridge = gram.trace() * RANK_EPSILON;
+    Eigen::LDLT<Eigen::Matrix4f> ldlt(gram);
+    if (ldlt.vectorD().minCoeff() <= ridge)
+    {
+        gram.diagonal().array() += math::max(ridge, math::epsilon<float>());
+        ldlt.compute(gram);
+    }
+    return ldlt;
+}
+
+void Motor_Allocation::set_motor_torques(std::vector<math::vec3f> const& torques)
+{
+    size_t count = torques.size();
+    bool changed = static_cast<size_t>(m_allocation.cols()) != count;
+    if (changed)
+    {
+        m_allocation.resize(4, count);
+        m_mixer.resize(count, 4);
+        m_thrusts.resize(count);
+        m_is_free.reserve(count);
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        math::vec3f const& torque = torques[i];
+        Eigen::Vector4f column(torque.x, torque.y, torque.z, COLLECTIVE_THRUST_WEIGHT);
+        if (column != m_allocation.col(i))
+        {
+            m_allocation.col(i) = column;
+            changed = true;
+        }
+    }
+
+    if (changed)
+    {
+        //minimum norm pseudo-inverse: A' * (A * A')^-1
+        m_mixer = decompose_gram(m_allocation * m_allocation.transpose()).solve(m_allocation).transpose();
+    }
+}
+
+auto Motor_Allocation::get_motor_count() const -> size_t
+{
+    return static_cast<size_t>(m_allocation.cols());
+}
+
+auto Motor_Allocation::compute(math::vec3f const& torque, float thrust, float min_thrust, float max_thrust) -> Eigen::VectorXf const&
+{
+    size_t count = get_motor_count();
+
+    m_thrusts.setConstant(thrust);
+    if (max_thrust > min_thrust)
+    {
+        Eigen::Vector4f weighted_target(torque.x, torque.y, torque.z, COLLECTIVE_THRUST_WEIGHT * thrust * float(count));
+
+        //unconstrained solution, starting from equal thrusts
+        Eigen::Vector4f error = weighted_target - m_allocation * m_thrusts;
+        m_thrusts.noalias() += m_mixer * error;
+
+        //Saturation. Clamp the motors that went out of range and give what they couldn't do to the others.
+        //Each iteration clamps at least one more motor so this ends in at most 'count' small (4x4) solves.
+        m_is_free.assign(count, true);
+        for (size_t iteration = 0; iteration < count; iteration++)
+        {
+            bool saturated = false;
+            for (size_t i = 0; i < count; i++)
+            {
+                float& t = m_thrusts(i);
+                if (m_is_free[i] && (t < min_thrust || t > max_thrust))
+                {
+                    t = math::clamp(t, min_thrust, max_thrust);
+                    m_is_free[i] = false;
+                    saturated = true;
+                }
+            }
+            if (!saturated)
+            {
+                break;
+            }
+
+            Eigen::Matrix4f gram = Eigen::Matrix4f::Zero();
+            for (size_t i = 0; i < count; i++)
+            {
+                if (m_is_free[i])
+                {
+                    gram.noalias() += m_allocation.col(i) * m_allocation.col(i).transpose();
+                }
+            }
+            error = weighted_target - m_allocation * m_thrusts;
+            Eigen::Vector4f correction = decompose_gram(gram).solve(error);
+            for (size_t i = 0; i < count; i++)
+            {
+                if (m_is_free[i])
+                {
+                    m_thrusts(i) += m_allocation.col(i).dot(correction);
+                }
+            }
+        }
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        m_thrusts(i) = math::clamp(m_thrusts(i), min_thrust, max_thrust);
+    }
+    return m_thrusts;
+}
+
+}
+}
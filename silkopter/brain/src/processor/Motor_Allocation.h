@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Eigen/Core"
+#include "Eigen/Cholesky"
+
+namespace silk
+{
+namespace node
+{
+
+//Distributes a torque and a collective thrust over the motors of a multirotor.
+//Without saturation the thrusts are the minimum norm exact solution (through the pseudo-inverse of the allocation matrix).
+//Motors that go out of range are clamped and what they couldn't do is given to the others, the torque first.
+class Motor_Allocation
+{
+public:
+    //What each motor does per newton of thrust. The pseudo-inverse is recomputed only when these change
+    void set_motor_torques(std::vector<math::vec3f> const& torques);
+    auto get_motor_count() const -> size_t;
+
+    //Starts from all motors at 'thrust' and returns thrusts within [min_thrust, max_thrust] that produce the torque
+    // and a collective thrust of thrust * motor count, or as close as the range allows
+    auto compute(math::vec3f const& torque, float thrust, float min_thrust, float max_thrust) -> Eigen::VectorXf const&;
+
+private:
+    //Column i is what motor i does per newton of thrust: torque (x, y, z) and the (weighted) collective thrust
+    Eigen::Matrix<float, 4, Eigen::Dynamic> m_allocation;
+    //Pseudo-inverse of the allocation matrix. Maps a torque/thrust error to motor thrust changes
+    Eigen::Matrix<float, Eigen::Dynamic, 4> m_mixer;
+
+    Eigen::VectorXf m_thrusts;
+    std::vector<bool> m_is_free;
+};
+
+}
+}
@@ -68,6 +68,8 @@ ts::Result<void> Motor_Mixer::init()
         os->rate = m_descriptor->get_rate();
     }
 
+    update_allocation(*multirotor_properties);
+
     //m_config->output_streams.throttles.resize(multirotor_descriptor->motors.size());
 
     return ts::success;
@@ -134,6 +136,7 @@ void Motor_Mixer::process()
             auto& sample = m_outputs[mi]->last_sample;
             sample.value = m_outputs[mi]->throttle;
             sample.is_healthy = true;
+            sample.tp = get_sample_origin(q::Clock::now());
             m_outputs[mi]->samples.push_back(sample);
         }
     });
@@ -160,115 +163,59 @@ static float compute_throttle_from_thrust(float max_thrust, float thrust)
 constexpr float MIN_THRUST = 0.f;
 constexpr float DYN_RANGE_FACTOR = 1.1f;//allow a bit more dyn range than normal to get better torque resolution at the expense of collective force
 
-
-void Motor_Mixer::compute_throttles(IMultirotor_Properties const& multirotor_properties, stream::IFloat::Value const& collective_thrust, stream::ITorque::Value const& _target)
+void Motor_Mixer::update_allocation(IMultirotor_Properties const& multirotor_properties)
 {
-    auto target = _target;
+    size_t count = m_outputs.size();
+    float motor_thrust = multirotor_properties.get_motor_thrust();
 
-    //precalculate some data
-    for (size_t i = 0; i < m_outputs.size(); i++)
+    m_motor_torques.resize(count);
+    for (size_t i = 0; i < count; i++)
     {
         auto const& mc = multirotor_properties.get_motors()[i];
         auto& out = m_outputs[i];
         out->config.position = mc.position;
 
-        out->config.max_torque = math::cross(out->config.position, mc.thrust_vector * multirotor_properties.get_motor_thrust());
+        out->config.max_torque = math::cross(out->config.position, mc.thrust_vector * motor_thrust);
         out->config.max_torque += mc.thrust_vector * (multirotor_properties.get_motor_z_torque() * (mc.clockwise ? 1 : -1));
-        out->config.torque_vector = math::normalized<float, math::safe>(out->config.max_torque);
 
-        out->thrust = MIN_THRUST;
+        m_motor_torques[i] = math::is_zero(motor_thrust, math::epsilon<float>()) ? math::vec3f::zero : out->config.max_torque / motor_thrust;
     }
+    m_allocation.set_motor_torques(m_motor_torques);
+}
 
+void Motor_Mixer::compute_throttles(IMultirotor_Properties const& multirotor_properties, stream::IFloat::Value const& collective_thrust, stream::ITorque::Value const& target)
+{
+    update_allocation(multirotor_properties);
+
+    size_t count = m_outputs.size();
+    float motor_thrust = multirotor_properties.get_motor_thrust();
 
     //apply the desired thrust
+    float th = MIN_THRUST;
     float min_thrust = MIN_THRUST;
     float max_thrust = MIN_THRUST;
     float target_thrust = collective_thrust;
     if (target_thrust >= 0.01f)
     {
-        auto th = math::clamp(target_thrust / float(m_outputs.size()), m_config->get_armed_thrust(), multirotor_properties.get_motor_thrust());
-        for (auto& out: m_outputs)
-        {
-            out->thrust = th; //take into account only motors that produce useful thrust
-        }
+        th = math::clamp(target_thrust / float(count), m_config->get_armed_thrust(), motor_thrust);
 
-        float dyn_range = math::min(th - m_config->get_armed_thrust(), multirotor_properties.get_motor_thrust() - th);
+        float dyn_range = math::min(th - m_config->get_armed_thrust(), motor_thrust - th);
         dyn_range *= DYN_RANGE_FACTOR;
         min_thrust = math::max(th - dyn_range, m_config->get_armed_thrust());
-        max_thrust = math::min(th + dyn_range, multirotor_properties.get_motor_thrust());
+        max_thrust = math::min(th + dyn_range, motor_thrust);
     }
 
+    Eigen::VectorXf const& thrusts = m_allocation.compute(target, th, min_thrust, max_thrust);
 
-    //compute thrusts for the target torque
-    float STEP = 0.9f;
-    size_t iteration = 0;
-    math::vec3f old_crt;
-    while (true)
+    for (size_t i = 0; i < count; i++)
     {
-        //calculate motor torques
-        math::vec3f crt;
-        for (auto& out: m_outputs)
-        {
-            float ratio = out->thrust / multirotor_properties.get_motor_thrust();
-            out->torque = out->config.max_torque * ratio;
-            crt += out->torque;
-        }
-
-        if (iteration > 0)
-        {
-            if (math::equals(crt, old_crt, math::epsilon<float>()))
-            {
-//                QLOGI("{}: Stabilized in {} iterations: {} - {}", STEP, iteration, crt, target);
-                break;
-            }
-        }
-        old_crt = crt;
-
-        //check if we're done
-        if (math::equals(crt, target, 0.01f))
-        {
-//            QLOGI("{}: Done in {} iterations", STEP, iteration);
-            break;
-        }
-
-        //how far are we for the target?
-        //divide by motor count because I want to distribute the difference to all motors
-        auto diff = (target - crt) / float(m_outputs.size());
-
-        //distribute the diff to all motors
-        for (auto& out: m_outputs)
-        {
-            //figure out how much each motor can influence the target torque
-            //  by doing a dot product with the normalized torque vector
-            auto f = math::dot(out->config.torque_vector, diff) * STEP; //go toqards the difference in small steps so we can converge
-//            auto th = math::cross(diff, out->config.position);
-//            auto f = math::dot(th, THRUST_VECTOR) * STEP; //go toqards the difference in small steps so we can converge
-            out->thrust = math::clamp(out->thrust + f, min_thrust, max_thrust);
-        }
-
-        iteration++;
-        if (iteration > 5000)
-        {
-//            QLOGW("Too many iterations!!! {}", iteration);
-        }
-        if (iteration > 50000)
-        {
-            QLOGW("Too many iterations!!! {}", iteration);
-            break;
-        }
-    }
-
-    for (auto& out: m_outputs)
-    {
-        out->thrust = math::clamp(out->thrust, min_thrust, max_thrust);
-    }
+        auto& out = m_outputs[i];
+        out->thrust = thrusts(i);
+        out->torque = math::is_zero(motor_thrust, math::epsilon<float>()) ? math::vec3f::zero : out->config.max_torque * (out->thrust / motor_thrust);
 
-    //convert thrust to throttle and clip
-    for (auto& out: m_outputs)
-    {
-        out->throttle = compute_throttle_from_thrust(multirotor_properties.get_motor_thrust(), out->thrust);
+        //convert thrust to throttle
+        out->throttle = compute_throttle_from_thrust(motor_thrust, out->thrust);
     }
-
 }
 //void Motor_Mixer::compute_throttles(config::Multirotor const& multirotor_properties, stream::IFloat::Value const& collective_thrust, stream::ITorque::Value const& _target)
 //{
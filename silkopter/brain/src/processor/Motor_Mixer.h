@@ -9,6 +9,7 @@
 #include "HAL.h"
 
 #include "Sample_Accumulator.h"
+#include "Motor_Allocation.h"
 
 
 namespace silk
@@ -52,6 +53,7 @@ public:
 private:
     ts::Result<void> init();
 
+    void update_allocation(IMultirotor_Properties const& multirotor_properties);
     void compute_throttles(IMultirotor_Properties const& multirotor_properties, stream::IFloat::Value const& collective_thrust, stream::ITorque::Value const& torque);
 
 
@@ -64,18 +66,17 @@ private:
 
     struct Stream : public stream::IThrottle
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
 
         uint32_t rate = 0;
         Sample last_sample;
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
 
         struct Config
         {
             math::vec3f position;
             math::vec3f max_torque;
-            math::vec3f torque_vector;
         } config;
 
         float throttle = 0;
@@ -84,6 +85,10 @@ private:
     };
 
     mutable std::vector<std::shared_ptr<Stream>> m_outputs;
+
+    //Rebuilt only when the multirotor properties change
+    Motor_Allocation m_allocation;
+    std::vector<math::vec3f> m_motor_torques;
 };
 
 
@@ -3,6 +3,7 @@
 #include "HAL.h"
 #include "common/node/IResampler.h"
 #include "utils/Butterworth.h"
+#include "utils/Polyphase_Resampler.h"
 #include <deque>
 
 #include "Sample_Accumulator.h"
@@ -41,6 +42,9 @@ public:
 
 private:
     ts::Result<void> init();
+
+    void process(std::true_type);
+    void process(std::false_type);
     void resample();
 
     HAL& m_hal;
@@ -55,44 +59,63 @@ private:
 
     typename Stream_t::Sample m_last_input_sample;
 
+    //sample & hold for the streams that cannot be filtered
     std::deque<typename Stream_t::Sample> m_input_samples;
 
+    //The Butterworth does the anti aliasing (or anti imaging) at the higher rate, with a few ms of delay.
+    //A linear phase FIR that steep would need tens of ms so the polyphase FIR only interpolates between the
+    // input samples, with the taps that fit in one period of the higher rate.
     template<class T, bool>
-    struct Butterworth
+    struct Filters
     {
-        auto setup(size_t, float, float) -> bool
+        auto setup(size_t, uint32_t, uint32_t, float) -> bool
         {
             return true;
         }
-        void reset(typename T::Value const&) {}
-        void reset() {}
-        void process(typename T::Value&) {}
+        auto get_group_delay() const -> float { return 0.f; }
+        auto get_taps_per_phase() const -> size_t { return 0; }
     };
 
     template<class T>
-    struct Butterworth<T, true>
+    struct Filters<T, true>
     {
-        util::Butterworth<typename T::Value> dsp;
+        util::Butterworth<typename T::Value> iir;
+        util::Polyphase_Resampler<typename T::Value> fir;
 
-        auto setup(size_t order, float rate, float cutoff_frequency) -> bool
+        auto setup(size_t order, uint32_t input_rate, uint32_t output_rate, float cutoff_frequency) -> bool
         {
-            return dsp.setup(order, rate, cutoff_frequency);
+            uint32_t max_rate = math::max(input_rate, output_rate);
+            return iir.setup(order, max_rate, cutoff_frequency) &&
+                    fir.setup(input_rate, output_rate, 1.f / max_rate);
         }
-        void reset(typename T::Value const& t)
+        void reset(typename T::Value const& value)
         {
-            dsp.reset(t);
+            iir.reset(value);
+            fir.reset(value);
         }
-        void reset()
+        auto get_group_delay() const -> float
         {
-            dsp.reset();
+            return iir.get_group_delay() + fir.get_group_delay();
         }
-        void process(typename T::Value& t)
+        auto get_taps_per_phase() const -> size_t
         {
-            dsp.process(t);
+            return fir.get_taps_per_phase();
         }
     };
 
-    Butterworth<Stream_t, Stream_t::can_be_filtered_t::value> m_dsp;
+    Filters<Stream_t, Stream_t::can_be_filtered_t::value> m_dsp;
+    bool m_has_healthy_input = false;
+    size_t m_unhealthy_countdown = 0; //the outputs are unhealthy while an unhealthy input is in the fir window
+
+    //the samples of a frame are filtered as a block
+    struct Output_Info
+    {
+        q::Clock::time_point tp;
+        bool is_healthy = false;
+    };
+    std::vector<typename Stream_t::Value> m_block;
+    std::vector<typename Stream_t::Value> m_output_values;
+    std::vector<Output_Info> m_output_infos;
 
     typedef Basic_Output_Stream<Stream_t> Output_Stream;
 //    struct Stream : public Stream_t
@@ -174,9 +197,9 @@ ts::Result<void> Resampler<Stream_t>::set_config(hal::INode_Config const& config
     uint32_t input_rate = m_descriptor->get_input_rate();
     uint32_t output_rate = m_descriptor->get_output_rate();
     uint32_t min_rate = math::min(output_rate, input_rate);
-    uint32_t max_rate = math::max(output_rate, input_rate);
     float max_cutoff = min_rate / 2.f - min_rate / 100.f;
 
+    //The poles trade the steepness of the Butterworth for delay
     hal::LPF_Config& lpf_config = m_config->get_lpf();
 
     if (math::is_zero(lpf_config.get_cutoff_frequency()))
@@ -184,11 +207,17 @@ ts::Result<void> Resampler<Stream_t>::set_config(hal::INode_Config const& config
         lpf_config.set_cutoff_frequency(max_cutoff);
     }
     lpf_config.set_cutoff_frequency(math::clamp(lpf_config.get_cutoff_frequency(), 0.1f, max_cutoff));
-    if (!m_dsp.setup(lpf_config.get_poles(), max_rate, lpf_config.get_cutoff_frequency()))
+    if (!m_dsp.setup(lpf_config.get_poles(), input_rate, output_rate, lpf_config.get_cutoff_frequency()))
     {
         return make_error("Cannot setup dsp filter.");
     }
-    m_dsp.reset();
+    //the filters restart from the next healthy input
+    m_has_healthy_input = false;
+    m_unhealthy_countdown = 0;
+
+    auto group_delay = std::chrono::duration_cast<q::Clock::duration>(std::chrono::duration<float>(m_dsp.get_group_delay()));
+    m_output_stream->set_group_delay(group_delay);
+    QLOGI("Resampling {}Hz to {}Hz with {} poles and {} taps per phase, group delay {}", input_rate, output_rate, lpf_config.get_poles(), m_dsp.get_taps_per_phase(), group_delay);
 
     return ts::success;
 }
@@ -239,12 +268,99 @@ void Resampler<Stream_t>::process()
         return;
     }
 
+    process(typename Stream_t::can_be_filtered_t());
+}
+
+template<class Stream_t>
+void Resampler<Stream_t>::process(std::true_type)
+{
+    //downsampling runs the Butterworth on the inputs, upsampling on the outputs. Either way it's at the higher rate
+    bool is_downsampling = m_descriptor->get_input_rate() >= m_descriptor->get_output_rate();
+
+    m_accumulator.process_block([this, is_downsampling](typename util::Ring_Buffer<typename Stream_t::Sample>::Span const& input_samples)
+    {
+        //The unhealthy inputs are not filtered, the last healthy value is held instead.
+        //Nothing is filtered before the first healthy input and the filters start from its value.
+        size_t count = input_samples.size();
+        size_t filter_begin = count;
+        m_block.resize(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto const& sample = input_samples[i];
+            if (sample.is_healthy)
+            {
+                if (!m_has_healthy_input)
+                {
+                    m_has_healthy_input = true;
+                    m_dsp.reset(sample.value);
+                }
+                m_last_input_sample = sample;
+            }
+            if (m_has_healthy_input && filter_begin == count)
+            {
+                filter_begin = i;
+            }
+            m_block[i] = m_last_input_sample.value;
+        }
+
+        if (is_downsampling)
+        {
+            m_dsp.iir.process(m_block.data() + filter_begin, count - filter_begin);
+        }
+
+        m_output_values.clear();
+        m_output_infos.clear();
+        size_t output_filter_begin = std::numeric_limits<size_t>::max();
+        for (size_t i = 0; i < count; i++)
+        {
+            auto const& sample = input_samples[i];
+            m_unhealthy_countdown = sample.is_healthy ? (m_unhealthy_countdown > 0 ? m_unhealthy_countdown - 1 : 0)
+                                                      : m_dsp.get_taps_per_phase();
+
+            Output_Info info;
+            info.is_healthy = i >= filter_begin && m_unhealthy_countdown == 0;
+
+            //the outputs lag the inputs by the group delay of the filters so their origin is that much older
+            info.tp = sample.tp;
+            if (info.tp != q::Clock::time_point())
+            {
+                info.tp -= m_output_stream->get_group_delay();
+            }
+
+            if (i == filter_begin)
+            {
+                output_filter_begin = m_output_values.size();
+            }
+            //the fir was reset to the first healthy value so the inputs before it don't go in its history
+            typename Stream_t::Value const& value = m_block[filter_begin < count ? math::max(i, filter_begin) : i];
+            m_dsp.fir.process(value, [this, &info](typename Stream_t::Value const& output)
+            {
+                m_output_values.push_back(output);
+                m_output_infos.push_back(info);
+            });
+        }
+
+        if (!is_downsampling && output_filter_begin < m_output_values.size())
+        {
+            m_dsp.iir.process(m_output_values.data() + output_filter_begin, m_output_values.size() - output_filter_begin);
+        }
+
+        for (size_t i = 0; i < m_output_values.size(); i++)
+        {
+            set_sample_origin(m_output_infos[i].tp);
+            m_output_stream->push_sample(m_output_values[i], m_output_infos[i].is_healthy);
+        }
+    });
+}
+
+template<class Stream_t>
+void Resampler<Stream_t>::process(std::false_type)
+{
     m_accumulator.process([this](typename Stream_t::Sample const& i_sample)
     {
         m_input_samples.push_back(i_sample);
     });
 
-
     resample();
 }
 
@@ -275,8 +391,6 @@ void Resampler<Stream_t>::resample()
 //        }
 //    }
 
-    bool is_downsampling = m_descriptor->get_output_rate() <= m_descriptor->get_input_rate();
-
     auto dt = m_output_stream->get_dt();
     size_t samples_needed = m_output_stream->compute_samples_needed();
     for (size_t i = 0; i < samples_needed; i++)
@@ -287,25 +401,13 @@ void Resampler<Stream_t>::resample()
         {
             m_processed_dt -= m_input_stream_dt;
             m_last_input_sample = m_input_samples.front();
-
-            if (is_downsampling && m_last_input_sample.is_healthy)
-            {
-                //upsampling, filter at the input stream sample rate
-                m_dsp.process(m_input_samples.back().value);
-            }
             m_input_samples.pop_front();
         }
 
+        set_sample_origin(m_last_input_sample);
         if (m_last_input_sample.is_healthy)
         {
-            auto value = m_last_input_sample.value;
-            if (!is_downsampling)
-            {
-                //upsampling, filter at the output stream sample rate
-                m_dsp.process(value);
-            }
-
-            m_output_stream->push_sample(value, true);
+            m_output_stream->push_sample(m_last_input_sample.value, true);
         }
         else
         {
@@ -147,9 +147,11 @@ void Multirotor_Simulator::process()
         auto throttle = m_input_throttle_streams[i].lock();
         if (throttle)
         {
-            auto const& samples = throttle->get_samples();
+            auto samples = throttle->get_samples().get_frame();
             if (!samples.empty())
             {
+                //the simulated motors are the actuators
+                mark_sample_actuated(samples.back());
                 m_simulation.set_motor_throttle(i, samples.back().value);
             }
         }
@@ -167,7 +169,7 @@ void Multirotor_Simulator::process()
     auto enu_to_ecef_trans = util::coordinates::enu_to_ecef_transform(origin_lla);
     auto enu_to_ecef_rotation = util::coordinates::enu_to_ecef_rotation(origin_lla);
 
-    m_simulation.process(dt, [this, &enu_to_ecef_trans, &enu_to_ecef_rotation](Multirotor_Simulation& simulation, q::Clock::duration simulation_dt)
+    m_simulation.process(dt, [this, now, &enu_to_ecef_trans, &enu_to_ecef_rotation](Multirotor_Simulation& simulation, q::Clock::duration simulation_dt)
     {
         auto const& uav_state = simulation.get_uav_state();
         {
@@ -179,6 +181,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = uav_state.angular_velocity + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -191,6 +194,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = uav_state.acceleration + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -205,6 +209,7 @@ void Multirotor_Simulator::process()
                 QASSERT(!math::is_zero(uav_state.magnetic_field, math::epsilon<float>()));
                 stream.last_sample.value = uav_state.magnetic_field + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -217,6 +222,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = uav_state.pressure + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -229,6 +235,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = uav_state.temperature + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -241,6 +248,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = uav_state.proximity_distance + noise;
                 stream.last_sample.is_healthy = !math::is_zero(uav_state.proximity_distance, std::numeric_limits<float>::epsilon());
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -257,6 +265,7 @@ void Multirotor_Simulator::process()
                 stream.last_sample.value.pacc = m_noise.gps_pacc(m_noise.generator);
                 stream.last_sample.value.vacc = m_noise.gps_vacc(m_noise.generator);
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -269,6 +278,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = math::transform(enu_to_ecef_trans, math::vec3d(uav_state.enu_position)) + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
@@ -281,6 +291,7 @@ void Multirotor_Simulator::process()
                 stream.accumulated_dt -= stream.dt;
                 stream.last_sample.value = math::vec3f(math::transform(enu_to_ecef_rotation, math::vec3d(uav_state.enu_velocity))) + noise;
                 stream.last_sample.is_healthy = true;
+                stream.last_sample.tp = now;
                 stream.samples.push_back(stream.last_sample);
             }
         }
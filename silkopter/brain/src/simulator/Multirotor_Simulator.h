@@ -81,92 +81,92 @@ private:
 
     struct Angular_Velocity : public stream::IAngular_Velocity
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct Acceleration : public stream::IAcceleration
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct Magnetic_Field : public stream::IMagnetic_Field
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct Pressure : public stream::IPressure
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct Temperature : public stream::ITemperature
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct Distance : public stream::IDistance
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct GPS_Info : public stream::IGPS_Info
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct ECEF_Position : public stream::IECEF_Position
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
     struct ECEF_Velocity : public stream::IECEF_Velocity
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
         uint32_t rate = 0;
         q::Clock::duration accumulated_dt = q::Clock::duration{0};
         q::Clock::duration dt = q::Clock::duration{0};
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         Sample last_sample;
     };
 
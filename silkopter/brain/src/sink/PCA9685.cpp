@@ -295,9 +295,10 @@ void PCA9685::process()
         auto stream = ch.stream.lock();
         if (stream)
         {
-            auto const& samples = stream->get_samples();
+            auto samples = stream->get_samples().get_frame();
             if (!samples.empty())
             {
+                mark_sample_actuated(samples.back());
                 set_pwm_value(*i2c, i, samples.back().value);
             }
         }
@@ -245,7 +245,7 @@ void PIGPIO::process()
         auto stream = ch->stream.lock();
         if (stream)
         {
-            auto const& samples = stream->get_samples();
+            auto samples = stream->get_samples().get_frame();
             if (!samples.empty())
             {
 //                if (samples.size() > 20)
@@ -253,6 +253,7 @@ void PIGPIO::process()
 //                    QLOGW("channel {} on GPIO {} is too slow. {} samples are queued", i, ch.gpio, samples.size());
 //                }
 
+                mark_sample_actuated(samples.back());
                 set_pwm_value(i, samples.back().value);
             }
         }
@@ -2,6 +2,7 @@
 #include "MPU9250.h"
 #include "physics/constants.h"
 #include "utils/Timed_Scope.h"
+#include "utils/Int16_Convert.h"
 
 #include "hal.def.h"
 //#include "sz_Calibration_Data.hpp"
@@ -302,9 +303,15 @@ constexpr uint8_t READ_FLAG = 0x80;
 constexpr size_t CONFIG_REGISTER_SPEED = 100000;
 constexpr size_t MISC_REGISTER_SPEED = 1000000;
 constexpr size_t SENSOR_REGISTER_SPEED = 1000000;
+constexpr size_t FIFO_REGISTER_SPEED = 10000000; //the datasheet allows 20Mhz for the sensor registers. Half of that to have some margin with long wires
 
 constexpr uint8_t FIFO_STREAMS = MPU_BIT_GYRO_XO_UT | MPU_BIT_GYRO_YO_UT | MPU_BIT_GYRO_ZO_UT | MPU_BIT_ACCEL;
 constexpr uint8_t FIFO_SAMPLE_SIZE = 12;
+constexpr size_t FIFO_SIZE = 4096;
+constexpr size_t FIFO_MAX_SAMPLE_COUNT = FIFO_SIZE / FIFO_SAMPLE_SIZE;
+
+//above 1Khz the gyro runs at 8Khz with no sample rate divider so lower rates are decimated in software
+constexpr size_t HIGH_RATE_FIFO_RATE = 8000;
 
 
 MPU9250::MPU9250(HAL& hal)
@@ -316,6 +323,7 @@ MPU9250::MPU9250(HAL& hal)
     m_angular_velocity = std::make_shared<Angular_Velocity_Stream>();
     m_magnetic_field = std::make_shared<Magnetic_Field_Stream>();
     m_temperature = std::make_shared<Temperature_Stream>();
+    m_akm_transaction = std::make_shared<bus::II2C::Transaction>();
 }
 
 MPU9250::~MPU9250()
@@ -642,18 +650,31 @@ ts::Result<void> MPU9250::init()
     uint8_t g_dlpf = 0;
     uint8_t a_dlpf = 0;
     uint8_t div = 0;
+    size_t imu_rate = (size_t)m_descriptor->get_imu_rate();
     if (m_descriptor->get_imu_rate() <= hal::MPU9250_Descriptor::imu_rate_t::_1000)
     {
         g_dlpf = MPU_BIT_DLPF_CFG_184_1;
         a_dlpf = MPU_BIT_A_DLPF_CFG_460_1;
-        div = 1000 / (int)m_descriptor->get_imu_rate() - 1;
+        div = 1000 / imu_rate - 1;
+        m_fifo_rate = imu_rate;
     }
     else
     {
         g_dlpf = MPU_BIT_DLPF_CFG_3600_8;
         a_dlpf = MPU_BIT_ACCEL_FCHOICE_B; //disable lpf - resulting in a 4KHz sample rate. This is unaffected by the sample_rate_div
-        div = 0;//8000 / m_descriptor->acceleration_angular_velocity_rate - 1;
+        div = 0;
+        m_fifo_rate = HIGH_RATE_FIFO_RATE;
     }
+    m_fifo_decimation = m_fifo_rate / imu_rate;
+    m_fifo_sample_dt = std::chrono::nanoseconds(1000000000 / m_fifo_rate);
+    m_fifo_clock = Fifo_Clock();
+    m_decimation = Decimation();
+    QLOGI("FIFO rate {}Hz, decimation {}", m_fifo_rate, m_fifo_decimation);
+
+    //no allocations when draining the fifo
+    m_fifo_buffer.reserve(FIFO_SIZE);
+    m_fifo_values.reserve(FIFO_SIZE / 2);
+    m_dummy_tx_data.reserve(FIFO_SIZE);
 
     res &= mpu_write_u8(buses, MPU_REG_CONFIG, g_dlpf | MPU_BIT_CONFIG_FIFO_MODE, CONFIG_REGISTER_SPEED);
     std::this_thread::sleep_for(std::chrono::milliseconds(5));
@@ -982,144 +1003,180 @@ math::vec3f get_calibration_bias(Calibration_Data const& points, float temperatu
     return math::lerp(prev.get_bias(), next.get_bias(), mu);
 }
 
-void MPU9250::process()
+void MPU9250::process_fifo(Buses& buses)
 {
-    QLOG_TOPIC("mpu9250::process");
+    //the newest sample in the fifo was written sometime in the last sample period before reading the count
+    q::Clock::time_point count_tp = q::Clock::now();
 
-    m_acceleration->clear();
-    m_angular_velocity->clear();
-    m_magnetic_field->clear();
-    m_temperature->clear();
-
-    Buses buses = { m_i2c.lock(), m_spi.lock() };
-    if (!buses.i2c && !buses.spi)
+    uint16_t fifo_count;
+    if (!mpu_read_u16(buses, MPU_REG_FIFO_COUNTH, fifo_count, MISC_REGISTER_SPEED))
     {
+        m_stats.bus_failures++;
         return;
     }
-
-    lock(buses);
-    At_Exit at_exit([this, &buses]()
+    if (fifo_count < FIFO_SAMPLE_SIZE)
     {
-        unlock(buses);
-    });
-
-    //TODO - add health indication
-
-    //auto now = q::Clock::now();
-    //static q::Clock::time_point last_timestamp = q::Clock::now();
-   // auto dt = now - last_timestamp;
-   // last_timestamp = now;
+        return;
+    }
+    if (fifo_count > FIFO_SIZE - FIFO_SAMPLE_SIZE)
+    {
+        //it might have overflowed so the samples are not aligned anymore
+        QLOGW("Resetting FIFO: {}", fifo_count);
+        m_stats.acc.skipped += fifo_count / FIFO_SAMPLE_SIZE;
+        m_stats.av.skipped += fifo_count / FIFO_SAMPLE_SIZE;
+        reset_fifo(buses);
+        m_fifo_clock = Fifo_Clock();
+        m_decimation = Decimation();
+        return;
+    }
 
-    uint16_t fifo_count;
-    bool res = mpu_read_u16(buses, MPU_REG_FIFO_COUNTH, fifo_count, MISC_REGISTER_SPEED);
-    if (!res)
+    //drain all the whole samples in one burst
+    size_t sample_count = std::min<size_t>(fifo_count / FIFO_SAMPLE_SIZE, FIFO_MAX_SAMPLE_COUNT);
+    m_fifo_buffer.resize(sample_count * FIFO_SAMPLE_SIZE);
+    if (!mpu_read(buses, MPU_REG_FIFO_R_W, m_fifo_buffer.data(), m_fifo_buffer.size(), FIFO_REGISTER_SPEED))
     {
         m_stats.bus_failures++;
+        return;
     }
 
-   // float xxx = (float(fifo_count) / std::chrono::duration_cast<std::chrono::microseconds>(dt).count()) * 1000.f;
-   // LOG_INFO("{.2}b/ms", xxx);
+    static_assert(FIFO_SAMPLE_SIZE % 2 == 0, "The fifo should contain only int16 values");
+    constexpr size_t k_values_per_sample = FIFO_SAMPLE_SIZE / 2;
+    m_fifo_values.resize(sample_count * k_values_per_sample);
+    util::convert_int16_be_to_float(m_fifo_buffer.data(), m_fifo_values.data(), m_fifo_values.size());
 
-    //uint16_t fc2 = 0;
-    if (res && fifo_count >= FIFO_SAMPLE_SIZE)
+    //The sensor clock drifts relative to ours so the sample period is measured over a few seconds.
+    //Samples left in the fifo are counted with the next drain so there is no bias.
     {
-        if (fifo_count > 4000)
+        constexpr std::chrono::seconds k_measurement_period(2);
+        constexpr float k_max_drift = 0.05f;
+        if (!m_fifo_clock.is_started)
         {
-            QLOGW("Resetting FIFO: {}", fifo_count);
-            reset_fifo(buses);
-            fifo_count = 0;
+            m_fifo_clock.is_started = true;
+            m_fifo_clock.start_tp = count_tp;
+            m_fifo_clock.sample_count = 0;
         }
         else
         {
-            size_t sample_count = fifo_count / FIFO_SAMPLE_SIZE;
-            size_t to_read = sample_count * FIFO_SAMPLE_SIZE;
-            QASSERT(sample_count >= 1);
-
-            m_fifo_buffer.resize(to_read);
-            if (mpu_read(buses, MPU_REG_FIFO_R_W, m_fifo_buffer.data(), m_fifo_buffer.size(), MISC_REGISTER_SPEED))
+            m_fifo_clock.sample_count += sample_count;
+            auto elapsed = count_tp - m_fifo_clock.start_tp;
+            if (elapsed >= k_measurement_period && m_fifo_clock.sample_count > 0)
             {
-//                static q::Clock::time_point s_last_stat_tp = q::Clock::now();
-//                static size_t s_sample_count = 0;
-//                s_sample_count += sample_count;
-//                if (now - s_last_stat_tp >= std::chrono::seconds(1))
-//                {
-//                    QLOGI("SPS: {}", s_sample_count);
-//                    s_sample_count = 0;
-//                    s_last_stat_tp = now;
-//                }
-
-//                m_angular_velocity->samples.resize(sample_count);
-//                m_acceleration->samples.resize(sample_count);
-
-                constexpr size_t k_max_sample_difference = 3;
-                q::Clock::time_point now = q::Clock::now();
-                q::Clock::duration acc_dt = m_acceleration->get_dt();
-                q::Clock::duration av_dt = m_angular_velocity->get_dt();
-
-                uint8_t const* data = m_fifo_buffer.data();
-                for (size_t i = 0; i < sample_count; i++)
+                auto nominal_dt = std::chrono::nanoseconds(1000000000 / m_fifo_rate);
+                auto measured_dt = elapsed / m_fifo_clock.sample_count;
+                if (math::abs(float((measured_dt - nominal_dt).count())) <= float(nominal_dt.count()) * k_max_drift)
                 {
-                    if (FIFO_STREAMS & MPU_BIT_ACCEL)
-                    {
-                        int16_t x = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-                        int16_t y = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-                        int16_t z = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-
-                        if (m_acceleration->get_tp() > now + acc_dt*k_max_sample_difference)
-                        {
-                            m_stats.acc.skipped++;
-                        }
-                        else
-                        {
-                            math::vec3f value(x, y, z);
-                            value = math::transform(m_imu_rotation, value);
-                            value = value * m_acceleration_scale - m_acceleration_bias;
-                            m_acceleration->push_sample(value, true);
-                        }
-                    }
-
-                    if (FIFO_STREAMS & MPU_BIT_TEMP_FIFO_EN)
-                    {
-                        data += 2;
-                    }
-
-                    if (FIFO_STREAMS & MPU_BIT_GYRO_XO_UT)
-                    {
-                        int16_t x = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-                        int16_t y = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-                        int16_t z = static_cast<int16_t>((data[0] << 8) | data[1]); data += 2;
-
-                        if (m_angular_velocity->get_tp() > now + av_dt*k_max_sample_difference)
-                        {
-                            m_stats.av.skipped++;
-                        }
-                        else
-                        {
-                            math::vec3f value(x, y, z);
-                            value = value * m_angular_velocity_sensor_scale;
-                            value = math::transform(m_imu_rotation, value);
-                            value = value - m_angular_velocity_bias;
-                            m_angular_velocity->push_sample(value, true);
-                        }
-                    }
-
-                    if (FIFO_STREAMS & MPU_BIT_SLV2)
-                    {
-                        data += 2;
-                    }
-
-//                    if (math::length(m_samples.angular_velocity[i]) > 1.f)
-//                    {
-//                        LOG_ERR("XXX::: gyro: {}, acc: {}", m_samples.angular_velocity[i], m_samples.acceleration[i]);
-//                    }
+                    m_fifo_sample_dt = measured_dt;
                 }
+                m_fifo_clock.start_tp = count_tp;
+                m_fifo_clock.sample_count = 0;
             }
-            else
+        }
+    }
+
+    //Timestamps are reconstructed backwards from the newest sample.
+    //The INT pin of the sensor is not wired to anything we can timestamp, so instead of the data-ready time they are
+    // anchored to the time we read the fifo count, assuming the newest sample was written in the middle of the last period.
+    //This is off by up to half a fifo period plus the latency of the count read, and the error is the same for all the
+    // samples of a burst.
+    q::Clock::time_point newest_tp = count_tp - m_fifo_sample_dt / 2;
+    q::Clock::duration acc_dt = m_acceleration->get_dt();
+    q::Clock::duration av_dt = m_angular_velocity->get_dt();
+
+    float const* values = m_fifo_values.data();
+    for (size_t i = 0; i < sample_count; i++)
+    {
+        math::vec3f acceleration;
+        math::vec3f angular_velocity;
+
+        if (FIFO_STREAMS & MPU_BIT_ACCEL)
+        {
+            acceleration.set(values[0], values[1], values[2]);
+            values += 3;
+        }
+        if (FIFO_STREAMS & MPU_BIT_TEMP_FIFO_EN)
+        {
+            values += 1;
+        }
+        if (FIFO_STREAMS & MPU_BIT_GYRO_XO_UT)
+        {
+            angular_velocity.set(values[0], values[1], values[2]);
+            values += 3;
+        }
+        if (FIFO_STREAMS & MPU_BIT_SLV2)
+        {
+            values += 1;
+        }
+
+        //average groups of fifo samples to get to the configured rate
+        m_decimation.acceleration += acceleration;
+        m_decimation.angular_velocity += angular_velocity;
+        if (++m_decimation.count < m_fifo_decimation)
+        {
+            continue;
+        }
+        float inv_count = 1.f / float(m_decimation.count);
+        acceleration = m_decimation.acceleration * inv_count;
+        angular_velocity = m_decimation.angular_velocity * inv_count;
+
+        //the average is centered in the middle of the group, not at its last sample
+        q::Clock::time_point tp = newest_tp - m_fifo_sample_dt * (sample_count - 1 - i)
+                                            - m_fifo_sample_dt * (m_decimation.count - 1) / 2;
+        m_decimation = Decimation();
+
+        if (FIFO_STREAMS & MPU_BIT_ACCEL)
+        {
+            //jitter in our reads can make consecutive bursts overlap a bit. Keep the samples in order
+            q::Clock::time_point min_tp = m_acceleration->get_tp() + acc_dt / 2;
+            if (tp < min_tp)
             {
-                m_stats.bus_failures++;
+                m_stats.acc.late++;
             }
+
+            math::vec3f value = math::transform(m_imu_rotation, acceleration);
+            value = value * m_acceleration_scale - m_acceleration_bias;
+            m_acceleration->push_sample(value, std::max(tp, min_tp), true);
+        }
+
+        if (FIFO_STREAMS & MPU_BIT_GYRO_XO_UT)
+        {
+            q::Clock::time_point min_tp = m_angular_velocity->get_tp() + av_dt / 2;
+            if (tp < min_tp)
+            {
+                m_stats.av.late++;
+            }
+
+            math::vec3f value = angular_velocity * m_angular_velocity_sensor_scale;
+            value = math::transform(m_imu_rotation, value);
+            value = value - m_angular_velocity_bias;
+            m_angular_velocity->push_sample(value, std::max(tp, min_tp), true);
         }
     }
+}
+
+void MPU9250::process()
+{
+    QLOG_TOPIC("mpu9250::process");
+
+    m_acceleration->clear();
+    m_angular_velocity->clear();
+    m_magnetic_field->clear();
+    m_temperature->clear();
+
+    Buses buses = { m_i2c.lock(), m_spi.lock() };
+    if (!buses.i2c && !buses.spi)
+    {
+        return;
+    }
+
+    lock(buses);
+    At_Exit at_exit([this, &buses]()
+    {
+        unlock(buses);
+    });
+
+    //TODO - add health indication
+
+    process_fifo(buses);
 
     q::Clock::time_point now = q::Clock::now();
 
@@ -1157,9 +1214,9 @@ void MPU9250::process()
     {
         if (m_stats != Stats())
         {
-            QLOGW("IMU stats: A:a{}s{}, AV:a{}s{}, MF:r{}a{}o{}b{}, T:a{}b{}, bus{}",
-                        m_stats.acc.added, m_stats.acc.skipped,
-                        m_stats.av.added, m_stats.av.skipped,
+            QLOGW("IMU stats: A:a{}s{}l{}, AV:a{}s{}l{}, MF:r{}a{}o{}b{}, T:a{}b{}, bus{}",
+                        m_stats.acc.added, m_stats.acc.skipped, m_stats.acc.late,
+                        m_stats.av.added, m_stats.av.skipped, m_stats.av.late,
                         m_stats.mf.reset, m_stats.mf.added, m_stats.mf.overflow, m_stats.mf.bad_values,
                         m_stats.temp.added, m_stats.temp.bad_values,
                         m_stats.bus_failures);
@@ -1242,30 +1299,44 @@ void MPU9250::process_magnetometer(Buses& buses)
 
     bool data_available = false;
     std::array<uint8_t, 8> data;
-    if (dt >= m_magnetic_field->get_dt())
+    if (buses.i2c)
     {
-        if (buses.i2c)
+        //the AKM is slow to read through i2c so it's done asynchronously. The result is used in the next process call
+        if (!m_akm_transaction->is_pending.load(std::memory_order_acquire))
         {
-            if (akm_read(buses, AKM_REG_ST1, data.data(), data.size(), SENSOR_REGISTER_SPEED))
+            if (m_is_akm_transaction_submitted)
             {
-                data_available = true;
+                m_is_akm_transaction_submitted = false;
+                if (m_akm_transaction->is_ok)
+                {
+                    uint8_t const* src = m_akm_transaction->get_data(1);
+                    std::copy(src, src + data.size(), data.begin());
+                    data_available = true;
+                }
+                else
+                {
+                    m_stats.bus_failures++;
+                }
             }
-            else
+            if (dt >= m_magnetic_field->get_dt())
             {
-                m_stats.bus_failures++;
+                m_akm_transaction->clear();
+                m_akm_transaction->add_read_register(m_akm_address, AKM_REG_ST1, data.size());
+                m_is_akm_transaction_submitted = buses.i2c->submit(m_akm_transaction);
             }
         }
-        else //spi
+    }
+    else if (dt >= m_magnetic_field->get_dt()) //spi
+    {
+        //first read what is in the ext registers (so the previous reading)
+        if (mpu_read(buses, MPU_REG_EXT_SENS_DATA_00, data.data(), data.size(), SENSOR_REGISTER_SPEED))
         {
-            //first read what is in the ext registers (so the previous reading)
-            if (mpu_read(buses, MPU_REG_EXT_SENS_DATA_00, data.data(), data.size(), SENSOR_REGISTER_SPEED))
-            {
-                data_available = true;
-            }
-            else
-            {
-                m_stats.bus_failures++;
-            }
+            data_available = true;
+        }
+        else
+        {
+            m_stats.bus_failures++;
+        }
 
     //        //now request the transfer again
     //        constexpr uint8_t READ_FLAG = 0x80;
@@ -1277,7 +1348,6 @@ void MPU9250::process_magnetometer(Buses& buses)
     //        }
     //        mpu_write_u8(buses, MPU_REG_I2C_SLV0_REG,  AKM_REG_ST1);
     //        mpu_write_u8(buses, MPU_REG_I2C_SLV0_CTRL, MPU_BIT_I2C_SLV0_EN + data.size());
-        }
     }
 
     if (data_available && (data[0] & AKM_DATA_READY) != 0)
@@ -79,6 +79,7 @@ private:
     void unlock(Buses& buses);
 
     void reset_fifo(Buses& buses);
+    void process_fifo(Buses& buses);
 
     void process_thermometer(Buses& buses);
 
@@ -93,6 +94,26 @@ private:
     std::shared_ptr<hal::MPU9250_Config> m_config;
 
     mutable std::vector<uint8_t> m_fifo_buffer;
+    std::vector<float> m_fifo_values;
+
+    size_t m_fifo_rate = 1000;
+    size_t m_fifo_decimation = 1;
+    q::Clock::duration m_fifo_sample_dt = std::chrono::milliseconds(1);
+
+    //measures the real sample period of the sensor
+    struct Fifo_Clock
+    {
+        bool is_started = false;
+        q::Clock::time_point start_tp;
+        size_t sample_count = 0;
+    } m_fifo_clock;
+
+    struct Decimation
+    {
+        math::vec3f acceleration;
+        math::vec3f angular_velocity;
+        size_t count = 0;
+    } m_decimation;
 
     uint8_t m_user_ctrl_value = 0;
 
@@ -112,6 +133,8 @@ private:
     typedef Basic_Output_Stream<stream::IMagnetic_Field> Magnetic_Field_Stream;
     mutable std::shared_ptr<Magnetic_Field_Stream> m_magnetic_field;
     uint8_t m_akm_address = 0;
+    std::shared_ptr<bus::II2C::Transaction> m_akm_transaction; //reads the AKM on the i2c bus thread
+    bool m_is_akm_transaction_submitted = false;
     math::vec3f m_magnetic_field_sensor_scale;
     math::vec3f m_magnetic_field_scale = math::vec3f::one;
     math::vec3f m_magnetic_field_bias;
@@ -137,6 +160,7 @@ private:
             bool operator!=(Acceleration const& o) const { return !operator==(o); }
             size_t added = 0;
             size_t skipped = 0;
+            size_t late = 0;
         } acc;
         struct Angular_Velocity
         {
@@ -144,6 +168,7 @@ private:
             bool operator!=(Angular_Velocity const& o) const { return !operator==(o); }
             size_t added = 0;
             size_t skipped = 0;
+            size_t late = 0;
         } av;
         struct Magnetic_Field
         {
@@ -45,6 +45,9 @@ MS5611::MS5611(HAL& hal)
 {
     m_pressure = std::make_shared<Pressure_Stream>();
     m_temperature = std::make_shared<Temperature_Stream>();
+
+    m_i2c_transaction = std::make_shared<bus::II2C::Transaction>();
+    m_spi_transaction = std::make_shared<bus::ISPI::Transaction>();
 }
 
 auto MS5611::lock(Buses& buses) -> bool
@@ -75,19 +78,6 @@ void MS5611::unlock(Buses& buses)
     }
 }
 
-auto MS5611::bus_read_u24(Buses& buses, uint8_t reg, uint32_t& dst) -> bool
-{
-    uint8_t tx_data[3] = {0};
-    uint8_t rx_data[3];
-    bool res = buses.i2c ? buses.i2c->read_register(m_descriptor->get_i2c_address(), reg, rx_data, 3)
-                : buses.spi ? buses.spi->transfer_register(reg, tx_data, rx_data, 3)
-                : false;
-    if (res)
-    {
-        dst = (((uint32_t)rx_data[0]) << 16) | (((uint32_t)rx_data[1]) << 8) | rx_data[2];
-    }
-    return res;
-}
 auto MS5611::bus_read_u8(Buses& buses, uint8_t reg, uint8_t& rx_data) -> bool
 {
     uint8_t dummy_data = 0;
@@ -110,6 +100,50 @@ auto MS5611::bus_write(Buses& buses, uint8_t data) -> bool
          : false;
 }
 
+auto MS5611::is_transaction_pending() const -> bool
+{
+    return m_i2c_transaction->is_pending.load(std::memory_order_acquire) ||
+           m_spi_transaction->is_pending.load(std::memory_order_acquire);
+}
+auto MS5611::submit_transaction(Buses& buses, uint8_t conversion_cmd) -> bool
+{
+    if (buses.i2c)
+    {
+        bus::II2C::Transaction& t = *m_i2c_transaction;
+        t.clear();
+        m_transaction_read_idx = t.add_read_register(m_descriptor->get_i2c_address(), 0x00, 3);
+        t.add_write(m_descriptor->get_i2c_address(), &conversion_cmd, 1);
+        return buses.i2c->submit(m_i2c_transaction);
+    }
+    if (buses.spi)
+    {
+        bus::ISPI::Transaction& t = *m_spi_transaction;
+        t.clear();
+        m_transaction_read_idx = t.add_transfer_register(0x00, nullptr, 3);
+        t.add_transfer(&conversion_cmd, 1);
+        return buses.spi->submit(m_spi_transaction);
+    }
+    return false;
+}
+auto MS5611::get_transaction_result(uint32_t& dst) const -> bool
+{
+    uint8_t const* rx_data = nullptr;
+    if (m_i2c_transaction->is_ok && m_i2c_transaction->message_count > 0)
+    {
+        rx_data = m_i2c_transaction->get_data(m_transaction_read_idx);
+    }
+    else if (m_spi_transaction->is_ok && m_spi_transaction->transfer_count > 0)
+    {
+        rx_data = m_spi_transaction->get_register_rx_data(m_transaction_read_idx);
+    }
+    else
+    {
+        return false;
+    }
+    dst = (((uint32_t)rx_data[0]) << 16) | (((uint32_t)rx_data[1]) << 8) | rx_data[2];
+    return true;
+}
+
 auto MS5611::get_outputs() const -> std::vector<Output>
 {
     std::vector<Output> outputs(2);
@@ -219,45 +253,36 @@ void MS5611::process()
         return;
     }
 
-    lock(buses);
-    At_Exit at_exit([this, &buses]()
-    {
-        unlock(buses);
-    });
-
+    //No bus lock here: the transactions only go through the async queue and the bus thread locks the bus around each batch.
+    //Locking here would wait for the batch in flight, which is the stall the async transactions are for.
     QLOG_TOPIC("ms5611::process");
     auto now = q::Clock::now();
-    if (now - m_last_process_tp < MIN_CONVERSION_TIME)
+    if (now - m_last_process_tp < MIN_CONVERSION_TIME || is_transaction_pending())
     {
         return;
     }
     m_last_process_tp = now;
 
-    if (m_stage == Stage::PRESSURE)
+    if (m_is_transaction_submitted)
     {
         uint32_t data = 0;
-        //read pressure
-        if (bus_read_u24(buses, 0x00, data))
-        {
-            m_last_pressure_reading_tp = now;
-            m_pressure->reading = static_cast<double>(data);
-        }
-        else
+        if (get_transaction_result(data))
         {
-            m_stats.bus_failures++;
-        }
-    }
-    else if (m_stage == Stage::TEMPERATURE)
-    {
-        uint32_t data = 0;
-        //read temperature
-        if (bus_read_u24(buses, 0x00, data))
-        {
-            m_last_temperature_reading_tp = now;
-            m_temperature->reading = static_cast<double>(data);
+            if (m_transaction_stage == Stage::PRESSURE)
+            {
+                m_last_pressure_reading_tp = now;
+                m_pressure->reading = static_cast<double>(data);
+            }
+            else if (m_transaction_stage == Stage::TEMPERATURE)
+            {
+                m_last_temperature_reading_tp = now;
+                m_temperature->reading = static_cast<double>(data);
+            }
         }
         else
         {
+            //the conversion might not have started either
+            m_stage = Stage::UNKNOWN;
             m_stats.bus_failures++;
         }
     }
@@ -265,29 +290,19 @@ void MS5611::process()
     //figure out what to read next
     auto future_tp_p = m_last_pressure_reading_tp + m_pressure->get_dt();
     auto future_tp_t = m_last_temperature_reading_tp + m_temperature->get_dt();
-    if (future_tp_p < future_tp_t)
+    Stage next_stage = future_tp_p < future_tp_t ? Stage::PRESSURE : Stage::TEMPERATURE;
+    uint8_t cmd = next_stage == Stage::PRESSURE ? CMD_CONVERT_D1_OSR256 : CMD_CONVERT_D2_OSR256;
+
+    m_transaction_stage = m_stage;
+    m_is_transaction_submitted = submit_transaction(buses, cmd);
+    if (m_is_transaction_submitted)
     {
-        if (bus_write(buses, CMD_CONVERT_D1_OSR256)) //read pressure next
-        {
-            m_stage = Stage::PRESSURE;
-        }
-        else
-        {
-            m_stage = Stage::UNKNOWN;
-            m_stats.bus_failures++;
-        }
+        m_stage = next_stage;
     }
     else
     {
-        if (bus_write(buses, CMD_CONVERT_D2_OSR256)) //read temp next
-        {
-            m_stage = Stage::TEMPERATURE;
-        }
-        else
-        {
-            m_stage = Stage::UNKNOWN;
-            m_stats.bus_failures++;
-        }
+        m_stage = Stage::UNKNOWN;
+        m_stats.bus_failures++;
     }
 
     {
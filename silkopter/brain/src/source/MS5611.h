@@ -60,11 +60,20 @@ private:
 
     auto lock(Buses& buses) -> bool;
     void unlock(Buses& buses);
-    auto bus_read_u24(Buses& buses, uint8_t reg, uint32_t& dst) -> bool;
     auto bus_read_u8(Buses& buses, uint8_t reg, uint8_t& dst) -> bool;
     auto bus_read_u16(Buses& buses, uint8_t reg, uint16_t& dst) -> bool;
     auto bus_write(Buses& buses, uint8_t data) -> bool;
 
+    //The conversions are read and started asynchronously on the bus thread so the 10ms conversion never stalls the control loop.
+    //Each transaction reads the ADC (the conversion started by the previous transaction) and starts the next conversion
+    auto is_transaction_pending() const -> bool;
+    auto submit_transaction(Buses& buses, uint8_t conversion_cmd) -> bool;
+    auto get_transaction_result(uint32_t& dst) const -> bool;
+    std::shared_ptr<bus::II2C::Transaction> m_i2c_transaction;
+    std::shared_ptr<bus::ISPI::Transaction> m_spi_transaction;
+    size_t m_transaction_read_idx = 0;
+    bool m_is_transaction_submitted = false;
+
     std::shared_ptr<hal::MS5611_Descriptor> m_descriptor;
     std::shared_ptr<hal::MS5611_Config> m_config;
 
@@ -95,7 +104,8 @@ private:
         UNKNOWN
     };
 
-    Stage         m_stage = Stage::PRESSURE;
+    Stage         m_stage = Stage::PRESSURE; //the conversion in progress
+    Stage         m_transaction_stage = Stage::UNKNOWN; //the conversion read by the submitted transaction
     q::Clock::time_point m_last_process_tp = q::Clock::now();
     q::Clock::time_point m_last_temperature_reading_tp = q::Clock::now();
     q::Clock::time_point m_last_pressure_reading_tp = q::Clock::now();
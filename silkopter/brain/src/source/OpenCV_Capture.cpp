@@ -15,6 +15,8 @@ namespace silk
 namespace node
 {
 
+//video samples are big, keep only a few frames around
+constexpr size_t VIDEO_SAMPLE_CAPACITY = 8;
 
 #if !defined RASPBERRY_PI
 
@@ -90,6 +92,7 @@ OpenCV_Capture::~OpenCV_Capture()
 #endif
 
     m_stream = std::make_shared<Stream>();
+    m_stream->samples.set_capacity(VIDEO_SAMPLE_CAPACITY);
 }
 
 auto OpenCV_Capture::get_outputs() const -> std::vector<Output>
@@ -198,22 +201,15 @@ void OpenCV_Capture::process()
 
     std::lock_guard<std::mutex> lg(m_temp_samples.mutex);
 
-    //put the samples back
-    for (auto& sample: m_stream->samples)
-    {
-        m_temp_samples.samples.push_back(std::move(sample));
-    }
+    m_stream->samples.clear();
 
-    m_stream->samples.resize(m_temp_samples.count);
-    if (m_temp_samples.count > 0)
+    //swap the samples with the oldest ones in the stream so their buffers are reused next time
+    for (size_t i = 0; i < m_temp_samples.count; i++)
     {
-        for (size_t i = 0; i < m_temp_samples.count; i++)
-        {
-            m_stream->samples[i] = std::move(m_temp_samples.samples[i]);
-        }
-        m_temp_samples.samples.erase(m_temp_samples.samples.begin(), m_temp_samples.samples.begin() + m_temp_samples.count);
-        m_temp_samples.count = 0;
+        std::swap(m_stream->samples.prepare_push(), m_temp_samples.samples[i]);
+        m_stream->samples.commit_push();
     }
+    m_temp_samples.count = 0;
 }
 
 
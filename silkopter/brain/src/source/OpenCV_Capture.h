@@ -75,11 +75,11 @@ private:
 
     struct Stream : public stream::IVideo
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
 
         uint32_t rate = 0;
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
     };
     mutable std::shared_ptr<Stream> m_stream;
 
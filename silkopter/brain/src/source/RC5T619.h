@@ -58,10 +58,10 @@ private:
 
     struct Stream : public stream::IADC
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
 
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
         q::Clock::time_point last_tp = q::Clock::now();
         Sample last_sample;
         uint32_t rate = 0;
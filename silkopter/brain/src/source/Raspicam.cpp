@@ -1,5 +1,6 @@
 #include "BrainStdAfx.h"
 #include "Raspicam.h"
+#include "RC_Comms.h"
 
 #include "hal.def.h"
 
@@ -38,6 +39,8 @@ namespace silk
 namespace node
 {
 
+//video samples are big, keep only a few frames around
+constexpr size_t VIDEO_SAMPLE_CAPACITY = 8;
 
 #if defined RASPBERRY_PI
 
@@ -48,12 +51,20 @@ typedef std::shared_ptr<MMAL_POOL_T> Pool_ptr;
 ////////////////////////////////////////////////////////////////////
 /// \brief The Video_Server::Camera_Private_Data struct
 /// connection:
-/// - camera output
+/// - camera video port
 ///     - recording encoder
-///     - high resizer
-///         - high encoder
+/// - camera preview port
+///     - splitter
+///         - emergency resizer
+///             - emergency encoder
 ///         - low resizer
 ///             - low encoder
+///         - high resizer
+///             - high encoder
+///
+/// All the streaming tiers encode all the time and only the active one is sent.
+/// Switching waits for a keyframe from the new tier so the decoder never gets a frame it cannot decode
+/// and nothing has to be restarted.
 
 struct Raspicam::Impl
 {
@@ -66,6 +77,7 @@ struct Raspicam::Impl
 
     struct Encoder_Data
     {
+        Impl* impl = nullptr;
         hal::Raspicam_Descriptor::Quality* quality = nullptr;
 
         Component_ptr encoder;
@@ -75,6 +87,7 @@ struct Raspicam::Impl
         Connection_ptr resizer_connection;
 
         std::atomic<bool> is_active{false};
+        bool is_in_frame = false; //the last buffer didn't end the frame
 
         q::Clock::time_point start;
 
@@ -82,12 +95,25 @@ struct Raspicam::Impl
     };
 
     Encoder_Data recording;
-    Encoder_Data high;
-    Encoder_Data low;
+
+    //from the lowest resolution up
+    enum Tier
+    {
+        EMERGENCY,
+        LOW,
+        HIGH,
+        TIER_COUNT
+    };
+    std::array<Encoder_Data, TIER_COUNT> streaming;
+    size_t active_tier = LOW;
+    size_t target_tier = LOW; //becomes active at its next keyframe
+    std::atomic_bool needs_keyframe = {false}; //for the target tier, checked without the lock by the recording thread
 
     size_t frame_idx = 0;
 };
 
+static char const* TIER_NAMES[Raspicam::Impl::TIER_COUNT] = { "emergency", "low", "high" };
+
 static bool set_connection_enabled(Connection_ptr const& connection, bool yes)
 {
 //    SCOPED_PINS_GUARD;
@@ -107,10 +133,17 @@ static bool set_connection_enabled(Connection_ptr const& connection, bool yes)
     }
 }
 
+static bool request_keyframe(Component_ptr const& encoder)
+{
+    QASSERT(encoder);
+    return mmal_port_parameter_set_boolean(encoder->output[0], MMAL_PARAMETER_VIDEO_REQUEST_I_FRAME, 1) == MMAL_SUCCESS;
+}
+
 #endif
 
-Raspicam::Raspicam(HAL& hal)
+Raspicam::Raspicam(HAL& hal, RC_Comms& rc_comms)
     : m_hal(hal)
+    , m_rc_comms(rc_comms)
     , m_descriptor(new hal::Raspicam_Descriptor())
     , m_config(new hal::Raspicam_Config())
 {
@@ -118,20 +151,30 @@ Raspicam::Raspicam(HAL& hal)
 #if defined RASPBERRY_PI
     m_impl.reset(new Impl);
 
+    m_impl->recording.impl = m_impl.get();
     m_impl->recording.is_active = false;
-    m_impl->high.is_active = false;
-    m_impl->low.is_active = false;
-
     m_impl->recording.callback = std::bind(&Raspicam::recording_callback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-    m_impl->high.callback = std::bind(&Raspicam::streaming_callback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
-    m_impl->low.callback = std::bind(&Raspicam::streaming_callback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+
+    for (Impl::Encoder_Data& data: m_impl->streaming)
+    {
+        data.impl = m_impl.get();
+        data.is_active = false;
+        data.callback = std::bind(&Raspicam::streaming_callback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4);
+    }
 #endif
 
     m_descriptor->set_fps(30);
 
+    //short gop so the decoder recovers fast when the link is that bad
     hal::Raspicam_Descriptor::Quality quality;
+    quality.set_resolution({ 256, 144 });
+    quality.set_bitrate(50000);
+    quality.set_gop(15);
+    m_descriptor->set_streaming_emergency(quality);
+
     quality.set_resolution({ 320, 240 });
     quality.set_bitrate(100000);
+    quality.set_gop(30);
     m_descriptor->set_streaming_low(quality);
 
     quality.set_resolution({ 640, 480 });
@@ -143,6 +186,7 @@ Raspicam::Raspicam(HAL& hal)
     m_descriptor->set_recording(quality);
 
     m_stream = std::make_shared<Stream>();
+    m_stream->samples.set_capacity(VIDEO_SAMPLE_CAPACITY);
 }
 Raspicam::~Raspicam()
 {
@@ -157,8 +201,10 @@ Raspicam::~Raspicam()
 #if defined RASPBERRY_PI
     {
         //first kill the pools to disable the callbacks
-        m_impl->low.output_pool.reset();
-        m_impl->high.output_pool.reset();
+        for (Impl::Encoder_Data& data: m_impl->streaming)
+        {
+            data.output_pool.reset();
+        }
         m_impl->recording.output_pool.reset();
     }
 
@@ -166,15 +212,13 @@ Raspicam::~Raspicam()
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     std::lock_guard<std::mutex> lg(m_impl->mutex);
-    m_impl->low.resizer_connection.reset();
-    m_impl->low.encoder_connection.reset();
-    m_impl->low.resizer.reset();
-    m_impl->low.encoder.reset();
-
-    m_impl->high.resizer_connection.reset();
-    m_impl->high.encoder_connection.reset();
-    m_impl->high.resizer.reset();
-    m_impl->high.encoder.reset();
+    for (Impl::Encoder_Data& data: m_impl->streaming)
+    {
+        data.resizer_connection.reset();
+        data.encoder_connection.reset();
+        data.resizer.reset();
+        data.encoder.reset();
+    }
 
     m_impl->recording.resizer_connection.reset();
     m_impl->recording.encoder_connection.reset();
@@ -226,6 +270,9 @@ ts::Result<void> Raspicam::init()
     {
         while (!m_recording_data.should_stop)
         {
+            //here and not in process() so the control thread never waits for the encoder callbacks
+            adapt_to_video_link();
+
             {
                 std::lock_guard<std::mutex> lg(m_recording_data.mutex);
                 if (!m_recording_data.data_in.empty())
@@ -251,7 +298,8 @@ ts::Result<void> Raspicam::init()
 
 #if defined RASPBERRY_PI
     {
-        int policy = SCHED_IDLE;
+        //not idle, it also follows the video link and that cannot starve when the cpu is busy
+        int policy = SCHED_OTHER;
         struct sched_param param;
         param.sched_priority = sched_get_priority_min(policy);
         if (pthread_setschedparam(m_recording_data.thread.native_handle(), policy, &param) != 0)
@@ -268,8 +316,9 @@ ts::Result<void> Raspicam::init()
     m_stream->rate = m_descriptor->get_fps();
 
     m_impl->recording.quality = &m_descriptor->get_recording();
-    m_impl->high.quality = &m_descriptor->get_streaming_high();
-    m_impl->low.quality = &m_descriptor->get_streaming_low();
+    m_impl->streaming[Impl::EMERGENCY].quality = &m_descriptor->get_streaming_emergency();
+    m_impl->streaming[Impl::LOW].quality = &m_descriptor->get_streaming_low();
+    m_impl->streaming[Impl::HIGH].quality = &m_descriptor->get_streaming_high();
 
     if (!create_components())
     {
@@ -294,6 +343,7 @@ ts::Result<void> Raspicam::set_config(hal::INode_Config const& config)
         return make_error("Wrong config type");
     }
     *m_config = *specialized;
+    m_use_high_quality = m_config->get_quality() == hal::Raspicam_Config::quality_t::HIGH;
 
     activate_streams();
 
@@ -354,22 +404,15 @@ void Raspicam::process()
 
     std::lock_guard<std::mutex> lg(m_sample_queue.mutex);
 
-    //put the samples back
-    for (auto& sample: m_stream->samples)
-    {
-        m_sample_queue.samples.push_back(std::move(sample));
-    }
+    m_stream->samples.clear();
 
-    m_stream->samples.resize(m_sample_queue.count);
-    if (m_sample_queue.count > 0)
+    //swap the samples with the oldest ones in the stream so their buffers are reused next time
+    for (size_t i = 0; i < m_sample_queue.count; i++)
     {
-        for (size_t i = 0; i < m_sample_queue.count; i++)
-        {
-            m_stream->samples[i] = std::move(m_sample_queue.samples.front());
-            m_sample_queue.samples.pop_front();
-        }
-        m_sample_queue.count = 0;
+        std::swap(m_stream->samples.prepare_push(), m_sample_queue.samples[i]);
+        m_stream->samples.commit_push();
     }
+    m_sample_queue.count = 0;
 }
 
 
@@ -420,46 +463,96 @@ void Raspicam::streaming_callback(uint8_t const* data, size_t size, math::vec2u1
 void Raspicam::activate_streams()
 {
 #if defined RASPBERRY_PI
-    std::lock_guard<std::mutex> lg(m_impl->mutex);
-
-    bool recording = m_recording_data.file_sink != nullptr;
-    bool high = m_config->get_quality() == hal::Raspicam_Config::quality_t::HIGH;
-    bool low = m_config->get_quality() == hal::Raspicam_Config::quality_t::LOW;
+    Component_ptr keyframe_encoder;
 
-    if (m_impl->recording.is_active == recording &&
-        m_impl->high.is_active == high &&
-        m_impl->low.is_active == low)
     {
-        return;
-    }
+        std::lock_guard<std::mutex> lg(m_impl->mutex);
 
-    QLOGI("activating streams recording {}, quality {}", recording, m_config->get_quality());
+        bool recording = m_recording_data.file_sink != nullptr;
+        if (m_impl->recording.is_active != recording)
+        {
+            QLOGI("{} recording", recording ? "Starting" : "Stopping");
+            if (set_connection_enabled(m_impl->recording.encoder_connection, recording))
+            {
+                m_impl->recording.is_active = recording;
+            }
+            else
+            {
+                QLOGW("Cannot {} recording bitrate encoder", recording ? "enable" : "disable");
+            }
+        }
 
-    if (set_connection_enabled(m_impl->recording.encoder_connection, recording))
-    {
-        m_impl->recording.is_active = recording;
-    }
-    else
-    {
-        QLOGW("Cannot {} recording bitrate encoder", recording ? "enable" : "disable");
+        //the link can only lower the configured quality
+        size_t tier = m_use_high_quality ? Impl::HIGH : Impl::LOW;
+        if (m_use_emergency_quality)
+        {
+            tier = Impl::EMERGENCY;
+        }
+        else if (m_use_low_quality)
+        {
+            tier = std::min<size_t>(tier, Impl::LOW);
+        }
+
+        if (tier != m_impl->target_tier)
+        {
+            QLOGI("Switching streaming from {} to {} quality, link limited {}", TIER_NAMES[m_impl->active_tier], TIER_NAMES[tier], m_use_low_quality || m_use_emergency_quality);
+            m_impl->target_tier = tier;
+            m_impl->needs_keyframe = tier != m_impl->active_tier;
+        }
+
+        if (m_impl->needs_keyframe.exchange(false))
+        {
+            keyframe_encoder = m_impl->streaming[m_impl->target_tier].encoder;
+        }
     }
 
-    if (set_connection_enabled(m_impl->high.resizer_connection, high))
+    //not under the lock, the encoder callbacks need it
+    if (keyframe_encoder && !request_keyframe(keyframe_encoder))
     {
-        m_impl->high.is_active = high;
+        QLOGW("Cannot request a keyframe");
     }
-    else
+#endif
+}
+
+void Raspicam::adapt_to_video_link()
+{
+#if defined RASPBERRY_PI
+    util::comms::Video_Link_Controller::Output output = m_rc_comms.get_video_link_output();
+    bool tier_changed = output.use_low_quality != m_use_low_quality || output.use_emergency_quality != m_use_emergency_quality;
+    m_use_low_quality = output.use_low_quality;
+    m_use_emergency_quality = output.use_emergency_quality;
+
+    //the encoder callback asks again when it misses the keyframe of a pending tier switch
+    if (tier_changed || m_impl->needs_keyframe)
     {
-        QLOGW("Cannot {} high bitrate encoder", high ? "enable" : "disable");
+        activate_streams();
     }
 
-    if (set_connection_enabled(m_impl->low.resizer_connection, low))
+    //changing the encoder bitrate is not free, ignore small changes
+    if (std::abs(output.bitrate_scale - m_bitrate_scale) > 0.05f)
     {
-        m_impl->low.is_active = low;
+        m_bitrate_scale = output.bitrate_scale;
+        apply_streaming_bitrate();
     }
-    else
+#endif
+}
+
+void Raspicam::apply_streaming_bitrate()
+{
+#if defined RASPBERRY_PI
+    std::lock_guard<std::mutex> lg(m_impl->mutex);
+
+    for (Impl::Encoder_Data& data: m_impl->streaming)
     {
-        QLOGW("Cannot {} low bitrate encoder", low ? "enable" : "disable");
+        if (!data.encoder || !data.quality)
+        {
+            continue;
+        }
+        uint32_t bitrate = static_cast<uint32_t>(data.quality->get_bitrate() * m_bitrate_scale);
+        if (mmal_port_parameter_set_uint32(data.encoder->output[0], MMAL_PARAMETER_VIDEO_BIT_RATE, bitrate) != MMAL_SUCCESS)
+        {
+            QLOGW("Cannot set the streaming bitrate to {}", bitrate);
+        }
     }
 #endif
 }
@@ -849,7 +942,18 @@ static bool setup_encoder_component(Component_ptr encoder, MMAL_PORT_T* src, mat
     return res;
 }
 
-static Component_ptr create_encoder_component_for_recording(MMAL_PORT_T* src, math::vec2u16 const& resolution, size_t bitrate)
+static bool set_intra_period(MMAL_PORT_T* output, uint32_t gop)
+{
+    MMAL_PARAMETER_UINT32_T param = {{ MMAL_PARAMETER_INTRAPERIOD, sizeof(param)}, gop};
+    if (mmal_port_parameter_set(output, &param.hdr) != MMAL_SUCCESS)
+    {
+        QLOGW("failed to set MMAL_PARAMETER_INTRAPERIOD");
+        return false;
+    }
+    return true;
+}
+
+static Component_ptr create_encoder_component_for_recording(MMAL_PORT_T* src, math::vec2u16 const& resolution, size_t bitrate, uint32_t gop)
 {
     //    SCOPED_PINS_GUARD;;
 
@@ -893,6 +997,10 @@ static Component_ptr create_encoder_component_for_recording(MMAL_PORT_T* src, ma
         QLOGW("failed to set INLINE HEADER FLAG parameters");
         return Component_ptr();
     }
+    if (!set_intra_period(encoder->output[0], gop))
+    {
+        return Component_ptr();
+    }
 
 
     if (!enable_component(encoder))
@@ -908,7 +1016,7 @@ static Component_ptr create_encoder_component_for_recording(MMAL_PORT_T* src, ma
     return encoder;
 }
 
-static Component_ptr create_encoder_component_for_streaming(MMAL_PORT_T* src, math::vec2u16 const& resolution, size_t bitrate)
+static Component_ptr create_encoder_component_for_streaming(MMAL_PORT_T* src, math::vec2u16 const& resolution, size_t bitrate, uint32_t gop)
 {
     //    SCOPED_PINS_GUARD;;
 
@@ -991,13 +1099,9 @@ static Component_ptr create_encoder_component_for_streaming(MMAL_PORT_T* src, ma
         }
     }
 
+    if (!set_intra_period(output, gop))
     {
-        MMAL_PARAMETER_UINT32_T param = {{ MMAL_PARAMETER_INTRAPERIOD, sizeof(param)}, 30};
-        if (mmal_port_parameter_set(output, &param.hdr) != MMAL_SUCCESS)
-        {
-            QLOGW("failed to set MMAL_PARAMETER_INTRAPERIOD");
-            return Component_ptr();
-        }
+        return Component_ptr();
     }
 
 //    {
@@ -1078,7 +1182,7 @@ static Component_ptr create_splitter_component(MMAL_PORT_T* src)
 {
     //    SCOPED_PINS_GUARD;;
 
-    Component_ptr splitter = create_component(MMAL_COMPONENT_DEFAULT_SPLITTER, 1, 3);
+    Component_ptr splitter = create_component(MMAL_COMPONENT_DEFAULT_SPLITTER, 1, 1 + Raspicam::Impl::TIER_COUNT);
     if (!splitter)
     {
         return Component_ptr();
@@ -1176,13 +1280,15 @@ static void encoder_buffer_callback_fn(Raspicam::Impl& impl,
                                        MMAL_PORT_T* /*port*/,
                                        MMAL_BUFFER_HEADER_T* buffer)
 {
+    auto mmal_flags = buffer->flags;
+    encoder_data.is_in_frame = (mmal_flags & MMAL_BUFFER_HEADER_FLAG_FRAME_END) == 0;
+
     if (!encoder_data.callback)
     {
         MMAL_CALL(mmal_buffer_header_release(buffer));
         return;
     }
 
-    auto mmal_flags = buffer->flags;
     bool is_end_frame = (mmal_flags == MMAL_BUFFER_HEADER_FLAG_FRAME_END || mmal_flags == (MMAL_BUFFER_HEADER_FLAG_FRAME_END | MMAL_BUFFER_HEADER_FLAG_KEYFRAME));
     bool is_keyframe = (mmal_flags & MMAL_BUFFER_HEADER_FLAG_KEYFRAME) != 0;
 
@@ -1213,31 +1319,42 @@ static void recording_encoder_buffer_callback(MMAL_PORT_T* port, MMAL_BUFFER_HEA
     //    SCOPED_PINS_GUARD;;
 
     QASSERT(port && buffer);
-    Raspicam::Impl* impl = reinterpret_cast<Raspicam::Impl*>(port->userdata);
-    QASSERT(impl);
-    std::lock_guard<std::mutex> lg(impl->mutex);
+    Raspicam::Impl::Encoder_Data* encoder_data = reinterpret_cast<Raspicam::Impl::Encoder_Data*>(port->userdata);
+    QASSERT(encoder_data && encoder_data->impl);
+    Raspicam::Impl& impl = *encoder_data->impl;
+    std::lock_guard<std::mutex> lg(impl.mutex);
 
-    encoder_buffer_callback_fn(*impl, impl->recording, port, buffer);
+    encoder_buffer_callback_fn(impl, *encoder_data, port, buffer);
 }
 
-static void high_encoder_buffer_callback(MMAL_PORT_T* port, MMAL_BUFFER_HEADER_T* buffer)
+static void streaming_encoder_buffer_callback(MMAL_PORT_T* port, MMAL_BUFFER_HEADER_T* buffer)
 {
     QASSERT(port && buffer);
-    Raspicam::Impl* impl = reinterpret_cast<Raspicam::Impl*>(port->userdata);
-    QASSERT(impl);
-    std::lock_guard<std::mutex> lg(impl->mutex);
-
-    encoder_buffer_callback_fn(*impl, impl->high, port, buffer);
-}
-
-static void low_encoder_buffer_callback(MMAL_PORT_T* port, MMAL_BUFFER_HEADER_T* buffer)
-{
-    QASSERT(port && buffer);
-    Raspicam::Impl* impl = reinterpret_cast<Raspicam::Impl*>(port->userdata);
-    QASSERT(impl);
-    std::lock_guard<std::mutex> lg(impl->mutex);
+    Raspicam::Impl::Encoder_Data* encoder_data = reinterpret_cast<Raspicam::Impl::Encoder_Data*>(port->userdata);
+    QASSERT(encoder_data && encoder_data->impl);
+    Raspicam::Impl& impl = *encoder_data->impl;
+    std::lock_guard<std::mutex> lg(impl.mutex);
+
+    //Switch when the target tier starts a keyframe (or the SPS/PPS before it) and the active tier is between frames.
+    //This way the receiver gets whole frames and the first one from the new tier can be decoded
+    Raspicam::Impl::Encoder_Data& target = impl.streaming[impl.target_tier];
+    if (&target == encoder_data && impl.active_tier != impl.target_tier && !encoder_data->is_in_frame)
+    {
+        bool is_switch_point = (buffer->flags & (MMAL_BUFFER_HEADER_FLAG_KEYFRAME | MMAL_BUFFER_HEADER_FLAG_CONFIG)) != 0;
+        if (is_switch_point && !impl.streaming[impl.active_tier].is_in_frame)
+        {
+            impl.streaming[impl.active_tier].is_active = false;
+            impl.active_tier = impl.target_tier;
+            target.is_active = true;
+        }
+        else if (is_switch_point)
+        {
+            //missed it, ask for another one
+            impl.needs_keyframe = true;
+        }
+    }
 
-    encoder_buffer_callback_fn(*impl, impl->low, port, buffer);
+    encoder_buffer_callback_fn(impl, *encoder_data, port, buffer);
 }
 
 #endif
@@ -1267,8 +1384,6 @@ auto Raspicam::create_components() -> bool
     auto camera_capture_port = m_impl->camera->output[MMAL_CAMERA_CAPTURE_PORT];
 
     math::vec2u16 recording_resolution(m_descriptor->get_recording().get_resolution());
-    math::vec2u16 high_resolution(m_descriptor->get_streaming_high().get_resolution());
-    math::vec2u16 low_resolution(m_descriptor->get_streaming_low().get_resolution());
 
     //  set up the camera configuration
     {
@@ -1360,7 +1475,6 @@ auto Raspicam::create_components() -> bool
 
 
     static uint32_t buffer_count = 3;
-    auto userdata = reinterpret_cast<MMAL_PORT_USERDATA_T*>(m_impl.get());
 
     //enable the camera
     if (!enable_component(m_impl->camera))
@@ -1386,7 +1500,7 @@ auto Raspicam::create_components() -> bool
 
     //recording
     auto& recording = m_impl->recording;
-    recording.encoder = create_encoder_component_for_recording(camera_video_port, recording_resolution, m_descriptor->get_recording().get_bitrate());
+    recording.encoder = create_encoder_component_for_recording(camera_video_port, recording_resolution, m_descriptor->get_recording().get_bitrate(), m_descriptor->get_recording().get_gop());
     recording.encoder_connection = connect_ports(camera_video_port, recording.encoder->input[0]);
     if (!recording.encoder_connection || !set_connection_enabled(recording.encoder_connection, true))
     {
@@ -1394,72 +1508,59 @@ auto Raspicam::create_components() -> bool
         return false;
     }
 
-    recording.output_pool = create_output_port_pool(recording.encoder->output[0], userdata, recording_encoder_buffer_callback, buffer_count);
+    recording.output_pool = create_output_port_pool(recording.encoder->output[0], reinterpret_cast<MMAL_PORT_USERDATA_T*>(&recording), recording_encoder_buffer_callback, buffer_count);
     if (!recording.output_pool)
     {
         QLOGE("Cannot create recording bitrate encoder port");
         return false;
     }
 
-    //high
-    auto& high = m_impl->high;
-    high.resizer = create_resizer_component(m_impl->camera_splitter->output[1], high_resolution, m_descriptor->get_fps());
-    high.resizer_connection = connect_ports(m_impl->camera_splitter->output[1], high.resizer->input[0]);
-    if (!high.resizer_connection)
+    //streaming tiers, each on its own splitter output
+    for (size_t i = 0; i < Impl::TIER_COUNT; i++)
     {
-        QLOGE("Cannot create high bitrate resizer");
-        return false;
-    }
-    high.encoder = create_encoder_component_for_streaming(high.resizer->output[0], high_resolution, m_descriptor->get_streaming_high().get_bitrate());
-    if (!high.encoder)
-    {
-        QLOGE("Cannot create high bitrate encoder");
-        return false;
-    }
-    high.encoder_connection = connect_ports(high.resizer->output[0], high.encoder->input[0]);
-    if (!high.encoder_connection || !set_connection_enabled(high.encoder_connection, true))
-    {
-        QLOGE("Cannot create high bitrate encoder");
-        return false;
-    }
-    high.output_pool = create_output_port_pool(high.encoder->output[0], userdata, high_encoder_buffer_callback, buffer_count);
-    if (!high.output_pool)
-    {
-        QLOGE("Cannot create high bitrate encoder port");
-        return false;
-    }
+        Impl::Encoder_Data& data = m_impl->streaming[i];
+        char const* name = TIER_NAMES[i];
+        MMAL_PORT_T* splitter_output = m_impl->camera_splitter->output[i + 1];
+        math::vec2u16 resolution(data.quality->get_resolution());
 
-    //low
-    auto& low = m_impl->low;
-    low.resizer = create_resizer_component(m_impl->camera_splitter->output[2], low_resolution, m_descriptor->get_fps());
-    if (!low.resizer)
-    {
-        QLOGE("Cannot create low bitrate resizer");
-        return false;
-    }
-    low.resizer_connection = connect_ports(m_impl->camera_splitter->output[2], low.resizer->input[0]);
-    if (!low.resizer_connection)
-    {
-        QLOGE("Cannot create low bitrate resizer");
-        return false;
-    }
-    low.encoder = create_encoder_component_for_streaming(low.resizer->output[0], low_resolution, m_descriptor->get_streaming_low().get_bitrate());
-    if (!low.encoder)
-    {
-        QLOGE("Cannot create low bitrate encoder");
-        return false;
-    }
-    low.encoder_connection = connect_ports(low.resizer->output[0], low.encoder->input[0]);
-    if (!low.encoder_connection || !set_connection_enabled(low.encoder_connection, true))
-    {
-        QLOGE("Cannot create low bitrate encoder");
-        return false;
-    }
-    low.output_pool = create_output_port_pool(low.encoder->output[0], userdata, low_encoder_buffer_callback, buffer_count);
-    if (!low.output_pool)
-    {
-        QLOGE("Cannot create low bitrate encoder port");
-        return false;
+        data.resizer = create_resizer_component(splitter_output, resolution, m_descriptor->get_fps());
+        if (!data.resizer)
+        {
+            QLOGE("Cannot create {} bitrate resizer", name);
+            return false;
+        }
+        data.resizer_connection = connect_ports(splitter_output, data.resizer->input[0]);
+        if (!data.resizer_connection)
+        {
+            QLOGE("Cannot create {} bitrate resizer", name);
+            return false;
+        }
+        data.encoder = create_encoder_component_for_streaming(data.resizer->output[0], resolution, data.quality->get_bitrate(), data.quality->get_gop());
+        if (!data.encoder)
+        {
+            QLOGE("Cannot create {} bitrate encoder", name);
+            return false;
+        }
+        data.encoder_connection = connect_ports(data.resizer->output[0], data.encoder->input[0]);
+        if (!data.encoder_connection || !set_connection_enabled(data.encoder_connection, true))
+        {
+            QLOGE("Cannot create {} bitrate encoder", name);
+            return false;
+        }
+        data.output_pool = create_output_port_pool(data.encoder->output[0], reinterpret_cast<MMAL_PORT_USERDATA_T*>(&data), streaming_encoder_buffer_callback, buffer_count);
+        if (!data.output_pool)
+        {
+            QLOGE("Cannot create {} bitrate encoder port", name);
+            return false;
+        }
+
+        //all the tiers run all the time so switching is instant. Only the active one is sent
+        if (!set_connection_enabled(data.resizer_connection, true))
+        {
+            QLOGE("Cannot enable {} bitrate resizer", name);
+            return false;
+        }
+        data.is_active = i == m_impl->active_tier;
     }
 
 
@@ -8,6 +8,7 @@
 
 namespace silk
 {
+class RC_Comms;
 namespace hal
 {
 struct Raspicam_Descriptor;
@@ -25,7 +26,7 @@ namespace node
 class Raspicam : public ISource
 {
 public:
-    Raspicam(HAL& hal);
+    Raspicam(HAL& hal, RC_Comms& rc_comms);
     ~Raspicam();
 
     ts::Result<void> init(hal::INode_Descriptor const& descriptor) override;
@@ -55,6 +56,7 @@ public:
 
 private:
     HAL& m_hal;
+    RC_Comms& m_rc_comms;
 
     ts::Result<void> init();
 
@@ -63,6 +65,14 @@ private:
 
     void activate_streams();
 
+    //follows what the video link can carry. Called from the recording thread
+    void adapt_to_video_link();
+    void apply_streaming_bitrate();
+    std::atomic_bool m_use_high_quality = {true}; //from the config, which defaults to high
+    std::atomic_bool m_use_low_quality = {false};
+    std::atomic_bool m_use_emergency_quality = {false};
+    float m_bitrate_scale = 1.f;
+
     std::shared_ptr<Impl> m_impl;
 
     void streaming_callback(uint8_t const* data, size_t size, math::vec2u16 const& resolution, bool is_keyframe);
@@ -73,11 +83,11 @@ private:
 
     struct Stream : public stream::IVideo
     {
-        auto get_samples() const -> std::vector<Sample> const& { return samples; }
+        auto get_samples() const -> util::Ring_Buffer<Sample> const& { return samples; }
         auto get_rate() const -> uint32_t { return rate; }
 
         uint32_t rate = 0;
-        std::vector<Sample> samples;
+        util::Ring_Buffer<Sample> samples;
     };
     mutable std::shared_ptr<Stream> m_stream;
 
@@ -43,6 +43,7 @@ SRF02::SRF02(HAL& hal)
     m_config->set_direction(math::vec3f(0, 0, -1)); //pointing down
 
     m_output_stream = std::make_shared<Output_Stream>();
+    m_transaction = std::make_shared<bus::II2C::Transaction>();
 }
 
 auto SRF02::get_outputs() const -> std::vector<Output>
@@ -133,6 +134,23 @@ void SRF02::process()
 
     m_output_stream->clear();
 
+    if (m_transaction->is_pending.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    //TODO - add health indication
+
+    if (m_is_transaction_submitted)
+    {
+        m_is_transaction_submitted = false;
+        m_last_trigger_tp = m_transaction->completion_tp;
+        if (m_transaction->is_ok)
+        {
+            process_measurement(m_transaction->get_data(m_transaction_read_idx));
+        }
+    }
+
     //wait for echo
     auto now = q::Clock::now();
     if (now - m_last_trigger_tp < MAX_MEASUREMENT_DURATION ||
@@ -147,42 +165,32 @@ void SRF02::process()
         return;
     }
 
-    bus->lock();
-    At_Exit at_exit([this, &bus]()
-    {
-        bus->unlock();
-    });
+    //read the echo and trigger the next measurement immediately
+    m_transaction->clear();
+    m_transaction_read_idx = m_transaction->add_read_register(ADDR, RANGE_H, 4);
+    m_transaction->add_write_register(ADDR, SW_REV_CMD, &REAL_RAGING_MODE_CM, 1);
+    m_is_transaction_submitted = bus->submit(m_transaction);
+}
 
-    std::array<uint8_t, 4> buf;
-    bool res = bus->read_register(ADDR, RANGE_H, buf.data(), buf.size());
+void SRF02::process_measurement(uint8_t const* buf)
+{
+    int d = (unsigned int)(buf[0] << 8) | buf[1];
+    int min_d = (unsigned int)(buf[2] << 8) | buf[3];
 
-    //trigger immediately
-    trigger(*bus);
+    //QLOGI("d = {}, min_d = {}", d, min_d);
 
-    //TODO - add health indication
+    float distance = static_cast<float>(d) / 100.f; //meters
 
+    float min_distance = math::max(m_config->get_min_distance(), static_cast<float>(min_d) / 100.f); //meters
+    float max_distance = m_config->get_max_distance();
+    math::vec3f value = m_config->get_direction() * math::clamp(distance, min_distance, max_distance);
+    bool is_healthy = distance >= min_distance && distance <= max_distance;
 
-    if (res)
+    auto samples_needed = m_output_stream->compute_samples_needed();
+    while (samples_needed > 0)
     {
-        int d = (unsigned int)(buf[0] << 8) | buf[1];
-        int min_d = (unsigned int)(buf[2] << 8) | buf[3];
-
-        //QLOGI("d = {}, min_d = {}", d, min_d);
-
-        float distance = static_cast<float>(d) / 100.f; //meters
-
-        float min_distance = math::max(m_config->get_min_distance(), static_cast<float>(min_d) / 100.f); //meters
-        float max_distance = m_config->get_max_distance();
-        math::vec3f value = m_config->get_direction() * math::clamp(distance, min_distance, max_distance);
-        bool is_healthy = distance >= min_distance && distance <= max_distance;
-
-        m_output_stream->clear();
-        auto samples_needed = m_output_stream->compute_samples_needed();
-        while (samples_needed > 0)
-        {
-            m_output_stream->push_sample(value, is_healthy);
-            samples_needed--;
-        }
+        m_output_stream->push_sample(value, is_healthy);
+        samples_needed--;
     }
 }
 
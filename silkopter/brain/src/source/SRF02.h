@@ -46,6 +46,7 @@ private:
     ts::Result<void> init();
 
     void trigger(bus::II2C& bus);
+    void process_measurement(uint8_t const* buf);
 
     HAL& m_hal;
 
@@ -58,6 +59,11 @@ private:
     mutable std::shared_ptr<Output_Stream> m_output_stream;
     q::Clock::time_point m_last_trigger_tp;
 
+    //reads the last measurement and triggers the next one on the bus thread
+    std::shared_ptr<bus::II2C::Transaction> m_transaction;
+    size_t m_transaction_read_idx = 0;
+    bool m_is_transaction_submitted = false;
+
 };
 
 }
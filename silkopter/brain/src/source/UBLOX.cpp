@@ -584,6 +584,9 @@ void UBLOX::process()
         }
     }
 
+    //The position and velocity streams repeat the last fix until a new one arrives.
+    //All these samples are stamped with the time of the fix so consumers can tell the new ones apart.
+    set_sample_origin(m_last_position_tp);
     {
         size_t samples_needed = m_position_stream->compute_samples_needed();
         bool is_healthy = q::Clock::now() - m_last_position_tp <= m_position_stream->get_dt() * k_max_sample_difference;
@@ -600,6 +603,7 @@ void UBLOX::process()
         }
     }
 
+    set_sample_origin(m_last_velocity_tp);
     {
         size_t samples_needed = m_velocity_stream->compute_samples_needed();
         bool is_healthy = q::Clock::now() - m_last_velocity_tp <= m_velocity_stream->get_dt() * k_max_sample_difference;
@@ -615,6 +619,7 @@ void UBLOX::process()
             samples_needed--;
         }
     }
+    clear_sample_origin();
 
     if (m_stats.last_report_tp + std::chrono::seconds(1) < now)
     {
@@ -0,0 +1,175 @@
+#include "utils/comms/fec.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#ifdef NDEBUG
+static const int TIMES = 20000;
+#else
+static const int TIMES = 200;
+#endif
+
+//the size of the video packets
+static const size_t PACKET_SIZE = 1400;
+
+static const size_t MAX_KERNELS = 8;
+
+namespace
+{
+
+void fill_random(std::vector<gf>& data, uint32_t& seed)
+{
+    for (gf& d: data)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        d = static_cast<gf>(seed >> 24);
+    }
+}
+
+}
+
+//The SIMD kernels (SSSE3/AVX2 on x86, NEON on the Pi) have to give the same bytes as the table one for all the constants,
+// with sizes that are not a multiple of their width and with unaligned buffers
+BOOST_AUTO_TEST_CASE(FEC_ADDMUL_KERNELS_MATCH_TABLE)
+{
+    fec_addmul_fn kernels[MAX_KERNELS];
+    const char* names[MAX_KERNELS];
+    size_t count = fec_get_addmul_kernels(kernels, names, MAX_KERNELS);
+    BOOST_REQUIRE(count >= 1);
+
+#if defined __arm__ || defined __aarch64__
+    //the Pi has to run the neon kernel, falling back to the table one would go unnoticed otherwise
+    bool has_neon = false;
+    for (size_t k = 0; k < count; k++)
+    {
+        has_neon |= strcmp(names[k], "neon") == 0;
+    }
+    BOOST_REQUIRE_MESSAGE(has_neon, "no neon fec kernel on this arm build");
+#endif
+
+    uint32_t seed = 1234;
+    std::vector<gf> src(PACKET_SIZE + 64);
+    std::vector<gf> dst(PACKET_SIZE + 64);
+    std::vector<gf> expected(PACKET_SIZE + 64);
+    std::vector<gf> result(PACKET_SIZE + 64);
+
+    static const size_t sizes[] = { 0, 1, 15, 16, 17, 31, 32, 33, 63, 100, 255, PACKET_SIZE };
+    for (size_t k = 1; k < count; k++)
+    {
+        size_t mismatches = 0;
+        for (unsigned c = 1; c < 256; c++)
+        {
+            for (size_t size: sizes)
+            {
+                size_t offset = (c + size) % 16;
+                fill_random(src, seed);
+                fill_random(dst, seed);
+
+                expected = dst;
+                kernels[0](expected.data() + offset, src.data() + offset, static_cast<gf>(c), size);
+                result = dst;
+                kernels[k](result.data() + offset, src.data() + offset, static_cast<gf>(c), size);
+
+                //the bytes outside the range have to be untouched too
+                if (expected != result)
+                {
+                    mismatches++;
+                }
+            }
+        }
+        BOOST_CHECK_MESSAGE(mismatches == 0, names[k] << " differs from the table kernel in " << mismatches << " cases");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(FEC_ENCODE_DECODE)
+{
+    const unsigned short k = 8;
+    const unsigned short n = 12;
+    fec_t* fec = fec_new(k, n);
+
+    uint32_t seed = 5678;
+    std::vector<std::vector<gf>> blocks(n, std::vector<gf>(PACKET_SIZE));
+    for (size_t i = 0; i < k; i++)
+    {
+        fill_random(blocks[i], seed);
+    }
+
+    std::vector<gf const*> src(k);
+    std::vector<gf*> fecs(n - k);
+    std::vector<unsigned> block_nums(n - k);
+    for (size_t i = 0; i < k; i++)
+    {
+        src[i] = blocks[i].data();
+    }
+    for (size_t i = 0; i < n - k; i++)
+    {
+        fecs[i] = blocks[k + i].data();
+        block_nums[i] = k + i;
+    }
+    fec_encode(fec, src.data(), fecs.data(), block_nums.data(), block_nums.size(), PACKET_SIZE);
+
+    //lose the first 4 primary blocks, the secondary ones take their places
+    std::vector<gf const*> in(k);
+    std::vector<unsigned> index(k);
+    for (size_t i = 0; i < k; i++)
+    {
+        index[i] = i < n - k ? k + i : i;
+        in[i] = blocks[index[i]].data();
+    }
+    std::vector<std::vector<gf>> recovered(n - k, std::vector<gf>(PACKET_SIZE));
+    std::vector<gf*> out(n - k);
+    for (size_t i = 0; i < n - k; i++)
+    {
+        out[i] = recovered[i].data();
+    }
+    fec_decode(fec, in.data(), out.data(), index.data(), PACKET_SIZE);
+
+    for (size_t i = 0; i < n - k; i++)
+    {
+        BOOST_CHECK(recovered[i] == blocks[i]);
+    }
+
+    fec_free(fec);
+}
+
+BOOST_AUTO_TEST_CASE(BENCHMARK_FEC_ADDMUL)
+{
+    fec_addmul_fn kernels[MAX_KERNELS];
+    const char* names[MAX_KERNELS];
+    size_t count = fec_get_addmul_kernels(kernels, names, MAX_KERNELS);
+
+    std::cout << "FEC addmul " << PACKET_SIZE << " bytes x " << TIMES << std::endl;
+
+    uint32_t seed = 91011;
+    std::vector<gf> src(PACKET_SIZE);
+    std::vector<gf> dst(PACKET_SIZE);
+    fill_random(src, seed);
+    fill_random(dst, seed);
+
+    double table_ns = 0;
+    for (size_t k = 0; k < count; k++)
+    {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < TIMES; i++)
+        {
+            //all the constants, like the rows of the encoding matrix
+            kernels[k](dst.data(), src.data(), static_cast<gf>((i % 255) + 1), PACKET_SIZE);
+        }
+        auto d = std::chrono::high_resolution_clock::now() - start;
+        double ns = std::chrono::duration<double, std::nano>(d).count() / TIMES;
+        if (k == 0)
+        {
+            table_ns = ns;
+        }
+
+        double mbps = PACKET_SIZE / ns * 1000.0;
+        std::cout << "\t" << names[k] << ":\t" << ns << " ns/packet, " << mbps << " MB/s (" << table_ns / ns << "x)" << std::endl;
+    }
+
+    //keep the results alive
+    BOOST_CHECK(dst.size() == PACKET_SIZE);
+}
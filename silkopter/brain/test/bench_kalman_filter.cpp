@@ -0,0 +1,199 @@
+#include "utils/Kalman_Filter.h"
+#include "Eigen/Dense"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+#ifdef NDEBUG
+static const int TIMES = 1000000;
+#else
+static const int TIMES = 10000;
+#endif
+
+namespace
+{
+
+//The filter KF_ECEF used before util::Kalman_Filter: the measurements are folded in all at once
+// so the innovation covariance has to be inverted
+template<size_t St, size_t Me>
+struct Joint_Kalman_Filter
+{
+    Eigen::Matrix<double, St, St> A;
+    Eigen::Matrix<double, St, 1> x;
+    Eigen::Matrix<double, St, St> B;
+    Eigen::Matrix<double, St, 1> u;
+    Eigen::Matrix<double, Me, St> H;
+    Eigen::Matrix<double, Me, 1> z;
+    Eigen::Matrix<double, St, St> P;
+    Eigen::Matrix<double, St, St> Q;
+    Eigen::Matrix<double, St, Me> K;
+    Eigen::Matrix<double, Me, Me> R;
+    Eigen::Matrix<double, St, St> I;
+
+    Joint_Kalman_Filter()
+    {
+        A.setIdentity();
+        x.setZero();
+        B.setIdentity();
+        u.setZero();
+        H.setIdentity();
+        z.setZero();
+        P.setIdentity();
+        Q.setIdentity();
+        K.setIdentity();
+        R.setIdentity();
+        I.setIdentity();
+    }
+
+    void process()
+    {
+        x = A * x + B * u;
+        P = A * P * A.transpose() + Q;
+
+        auto HT = H.transpose();
+        Eigen::Matrix<double, Me, 1> y = z - H * x;
+        auto S = H * P * HT + R;
+        K = P * HT * S.inverse();
+        x = x + K * y;
+        P = (I - K * H) * P;
+    }
+};
+
+//the same setup as one axis of KF_ECEF at 100Hz
+template<class KF>
+void setup_ecef_axis(KF& kf)
+{
+    double dt = 0.01;
+    kf.A << 1,      dt,     0.5*dt*dt,
+            0,      1,      dt,
+            0,      0,      1;
+
+    double pn = 0.01;
+    double dt4 = dt*dt*dt*dt;
+    double dt3 = dt*dt*dt;
+    double dt2 = dt*dt;
+    kf.Q << pn*0.25*dt4,    pn*0.5*dt3, pn*0.5*dt2,
+            pn*0.5*dt3,     pn*dt2,     pn*dt,
+            pn*0.5*dt2,     pn*dt,      pn*1.0;
+}
+
+const double GPS_POS_VARIANCE = 4.0;
+const double GPS_VEL_VARIANCE = 0.04;
+const double ACC_VARIANCE = 0.25;
+
+void make_measurement(int step, double& pos, double& vel, double& acc)
+{
+    double t = step * 0.01;
+    acc = std::sin(t) + 0.1 * std::sin(step * 12.9898);
+    vel = -std::cos(t) + 0.05 * std::sin(step * 78.233);
+    pos = -std::sin(t) + 0.5 * std::sin(step * 37.719);
+}
+
+//precomputed so the benchmarks time only the filters
+struct Measurements
+{
+    static constexpr int COUNT = 1024;
+    double pos[COUNT];
+    double vel[COUNT];
+    double acc[COUNT];
+
+    Measurements()
+    {
+        for (int i = 0; i < COUNT; i++)
+        {
+            make_measurement(i, pos[i], vel[i], acc[i]);
+        }
+    }
+};
+
+template<class F>
+double measure_ns(F&& f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TIMES; i++)
+    {
+        f(i);
+    }
+    auto d = std::chrono::high_resolution_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(d).count() / TIMES;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(KALMAN_FILTER_MATCHES_JOINT_UPDATE)
+{
+    Joint_Kalman_Filter<3, 3> joint;
+    setup_ecef_axis(joint);
+    joint.R << GPS_POS_VARIANCE, 0, 0,
+               0, GPS_VEL_VARIANCE, 0,
+               0, 0, ACC_VARIANCE;
+
+    util::Kalman_Filter<3, 3> sequential;
+    setup_ecef_axis(sequential);
+    sequential.R << GPS_POS_VARIANCE, GPS_VEL_VARIANCE, ACC_VARIANCE;
+
+    double max_x_error = 0;
+    double max_p_error = 0;
+    for (int i = 0; i < 10000; i++)
+    {
+        double pos, vel, acc;
+        make_measurement(i, pos, vel, acc);
+        joint.z << pos, vel, acc;
+        sequential.z << pos, vel, acc;
+
+        joint.process();
+        sequential.process();
+
+        max_x_error = std::max(max_x_error, (joint.x - sequential.x).cwiseAbs().maxCoeff());
+        max_p_error = std::max(max_p_error, (joint.P - sequential.P).cwiseAbs().maxCoeff());
+    }
+    BOOST_CHECK_SMALL(max_x_error, 1e-9);
+    BOOST_CHECK_SMALL(max_p_error, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(BENCHMARK_KALMAN_FILTER)
+{
+    std::cout << "Kalman filter 3 states, 3 measurements, " << TIMES << " steps" << std::endl;
+
+    Joint_Kalman_Filter<3, 3> joint;
+    setup_ecef_axis(joint);
+    joint.R << GPS_POS_VARIANCE, 0, 0,
+               0, GPS_VEL_VARIANCE, 0,
+               0, 0, ACC_VARIANCE;
+
+    util::Kalman_Filter<3, 3> sequential;
+    setup_ecef_axis(sequential);
+    sequential.R << GPS_POS_VARIANCE, GPS_VEL_VARIANCE, ACC_VARIANCE;
+
+    Measurements m;
+    double joint_ns = measure_ns([&joint, &m](int i)
+    {
+        int idx = i & (Measurements::COUNT - 1);
+        joint.z << m.pos[idx], m.vel[idx], m.acc[idx];
+        joint.process();
+    });
+    double sequential_ns = measure_ns([&sequential, &m](int i)
+    {
+        int idx = i & (Measurements::COUNT - 1);
+        sequential.z << m.pos[idx], m.vel[idx], m.acc[idx];
+        sequential.process();
+    });
+
+    //KF_ECEF steps at the IMU rate and gets a GPS fix every 10-20 steps. The joint update cannot skip measurements
+    sequential.has_z = {{ false, false, true }};
+    double acc_only_ns = measure_ns([&sequential, &m](int i)
+    {
+        sequential.z(2) = m.acc[i & (Measurements::COUNT - 1)];
+        sequential.process();
+    });
+
+    std::cout << "\tjoint update:\t\t" << joint_ns << " ns/step" << std::endl;
+    std::cout << "\tsequential update:\t" << sequential_ns << " ns/step (" << joint_ns / sequential_ns << "x)" << std::endl;
+    std::cout << "\tsequential acc only:\t" << acc_only_ns << " ns/step (" << joint_ns / acc_only_ns << "x)" << std::endl;
+
+    //keep the results alive
+    BOOST_CHECK(std::isfinite(joint.x(0) + sequential.x(0)));
+}
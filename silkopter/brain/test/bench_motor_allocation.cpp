@@ -0,0 +1,128 @@
+#include "processor/Motor_Allocation.h"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+using namespace silk;
+
+#ifdef NDEBUG
+static const int TIMES = 1000000;
+#else
+static const int TIMES = 10000;
+#endif
+
+namespace
+{
+
+//Motors evenly spaced on a circle, alternating direction. Short arms so the yaw torque is small next to roll and pitch,
+// which is where a bias in the solve shows first
+constexpr float ARM_LENGTH = 0.1f;
+constexpr float Z_TORQUE = 0.02f; //Nm per N of thrust
+
+auto make_motor_torques(size_t count) -> std::vector<math::vec3f>
+{
+    std::vector<math::vec3f> torques(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        float a = math::anglef::_2pi * (float(i) + 0.5f) / float(count);
+        math::vec3f position(std::cos(a) * ARM_LENGTH, std::sin(a) * ARM_LENGTH, 0.f);
+        torques[i] = math::cross(position, math::vec3f(0, 0, 1)) + math::vec3f(0, 0, (i % 2) ? Z_TORQUE : -Z_TORQUE);
+    }
+    return torques;
+}
+
+auto get_torque(std::vector<math::vec3f> const& torques, Eigen::VectorXf const& thrusts) -> math::vec3f
+{
+    math::vec3f torque;
+    for (size_t i = 0; i < torques.size(); i++)
+    {
+        torque += torques[i] * thrusts(i);
+    }
+    return torque;
+}
+
+auto to_string(math::vec3f const& v) -> std::string
+{
+    return "(" + std::to_string(v.x) + ", " + std::to_string(v.y) + ", " + std::to_string(v.z) + ")";
+}
+
+}
+
+//Within the range the torque and the collective thrust come out exactly
+BOOST_AUTO_TEST_CASE(MOTOR_ALLOCATION_UNSATURATED_IS_EXACT)
+{
+    for (size_t count: { size_t(4), size_t(6) })
+    {
+        auto torques = make_motor_torques(count);
+        node::Motor_Allocation allocation;
+        allocation.set_motor_torques(torques);
+
+        float thrust = 5.f;
+        for (math::vec3f const& target: { math::vec3f(0.1f, 0, 0), math::vec3f(0, -0.05f, 0), math::vec3f(0, 0, 0.01f), math::vec3f(0.05f, 0.05f, -0.02f) })
+        {
+            Eigen::VectorXf const& thrusts = allocation.compute(target, thrust, 0.f, 10.f);
+            math::vec3f torque = get_torque(torques, thrusts);
+            BOOST_CHECK_MESSAGE(math::length(torque - target) < 1e-4f * math::length(target),
+                                count << " motors, target " << to_string(target) << ": torque " << to_string(torque));
+            BOOST_CHECK_CLOSE(thrusts.sum(), thrust * count, 1e-3f);
+        }
+    }
+}
+
+//Out of the range the motors are clamped and the torque wins over the collective thrust
+BOOST_AUTO_TEST_CASE(MOTOR_ALLOCATION_SATURATED_IS_CLAMPED)
+{
+    for (size_t count: { size_t(4), size_t(6) })
+    {
+        auto torques = make_motor_torques(count);
+        node::Motor_Allocation allocation;
+        allocation.set_motor_torques(torques);
+
+        float thrust = 5.f;
+        float min_thrust = 4.f;
+        float max_thrust = 6.f;
+        for (math::vec3f const& target: { math::vec3f(0.5f, 0, 0), math::vec3f(0, 0, 0.2f), math::vec3f(0.1f, 0.05f, 0.1f) })
+        {
+            Eigen::VectorXf const& thrusts = allocation.compute(target, thrust, min_thrust, max_thrust);
+            bool is_saturated = false;
+            for (size_t i = 0; i < count; i++)
+            {
+                BOOST_CHECK(thrusts(i) >= min_thrust && thrusts(i) <= max_thrust);
+                is_saturated |= thrusts(i) == min_thrust || thrusts(i) == max_thrust;
+            }
+            BOOST_CHECK(is_saturated);
+
+            //better than clamping the unconstrained solution
+            Eigen::VectorXf clipped = allocation.compute(target, thrust, 0.f, 100.f);
+            for (size_t i = 0; i < count; i++)
+            {
+                clipped(i) = math::clamp(clipped(i), min_thrust, max_thrust);
+            }
+            math::vec3f torque = get_torque(torques, allocation.compute(target, thrust, min_thrust, max_thrust));
+            math::vec3f clipped_torque = get_torque(torques, clipped);
+            BOOST_CHECK_MESSAGE(math::length(torque - target) <= math::length(clipped_torque - target) + 1e-5f,
+                                count << " motors, target " << to_string(target) << ": torque " << to_string(torque) << ", clipped " << to_string(clipped_torque));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BENCHMARK_MOTOR_ALLOCATION)
+{
+    auto torques = make_motor_torques(6);
+    node::Motor_Allocation allocation;
+    allocation.set_motor_torques(torques);
+
+    float sum = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < TIMES; i++)
+    {
+        math::vec3f target(std::sin(i * 0.01f) * 0.3f, std::cos(i * 0.01f) * 0.3f, 0.05f);
+        sum += allocation.compute(target, 5.f, 4.f, 6.f)(0);
+    }
+    auto d = std::chrono::high_resolution_clock::now() - start;
+    std::cout << "Motor allocation, 6 motors: "
+              << std::chrono::duration<double, std::nano>(d).count() / TIMES << " ns (" << sum << ")" << std::endl;
+}
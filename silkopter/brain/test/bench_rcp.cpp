@@ -0,0 +1,318 @@
+#include "utils/comms/RCP.h"
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+using namespace util::comms;
+
+namespace
+{
+
+//One end of a lossy link. What is sent arrives at the peer after a random delay - so the datagrams get reordered - unless it's dropped.
+//Everything runs on the test thread: process() delivers the datagrams that are due and completes the send in progress.
+class Loopback_Socket : public ISocket
+{
+public:
+    struct Link_Params
+    {
+        float loss = 0.f; //0 - 1
+        q::Clock::duration max_delay = q::Clock::duration(0);
+        bool is_down = false;
+    };
+
+    Loopback_Socket(uint32_t seed) : m_rng(seed) {}
+
+    void connect_to(Loopback_Socket& peer)
+    {
+        m_peer = &peer;
+    }
+    void set_link_params(Link_Params const& params)
+    {
+        m_params = params;
+    }
+
+    auto process() -> Result override
+    {
+        auto now = q::Clock::now();
+        while (!m_inbox.empty() && m_inbox.begin()->first <= now)
+        {
+            std::vector<uint8_t> data = std::move(m_inbox.begin()->second);
+            m_inbox.erase(m_inbox.begin());
+            if (receive_callback)
+            {
+                receive_callback(data.data(), data.size());
+            }
+        }
+        if (m_is_send_pending)
+        {
+            m_is_send_pending = false;
+            if (send_callback)
+            {
+                send_callback(Result::OK);
+            }
+        }
+        return Result::OK;
+    }
+
+    void async_send(void const* data, size_t size) override
+    {
+        QASSERT(m_is_locked);
+        m_is_send_pending = true;
+        sent_count++;
+
+        if (m_params.is_down || std::uniform_real_distribution<float>(0.f, 1.f)(m_rng) < m_params.loss)
+        {
+            dropped_count++;
+            return;
+        }
+        auto delay = std::chrono::duration_cast<q::Clock::duration>(m_params.max_delay * std::uniform_real_distribution<double>(0.0, 1.0)(m_rng));
+        uint8_t const* ptr = reinterpret_cast<uint8_t const*>(data);
+        m_peer->m_inbox.emplace(q::Clock::now() + delay, std::vector<uint8_t>(ptr, ptr + size));
+    }
+
+    auto get_mtu() const -> size_t override
+    {
+        return 1024;
+    }
+
+    auto lock() -> bool override
+    {
+        return !m_is_locked.exchange(true);
+    }
+    void unlock() override
+    {
+        m_is_locked = false;
+    }
+
+    size_t sent_count = 0;
+    size_t dropped_count = 0;
+
+private:
+    Loopback_Socket* m_peer = nullptr;
+    Link_Params m_params;
+    std::mt19937 m_rng;
+    std::multimap<q::Clock::time_point, std::vector<uint8_t>> m_inbox;
+    bool m_is_send_pending = false;
+    std::atomic_bool m_is_locked = {false};
+};
+
+constexpr uint8_t RELIABLE_CHANNEL = 3;
+constexpr uint8_t FEC_CHANNEL = 4;
+
+//Two RCPs talking through a pair of loopback sockets
+struct Loopback
+{
+    Loopback()
+        : socket_a(1)
+        , socket_b(2)
+    {
+        socket_a.connect_to(socket_b);
+        socket_b.connect_to(socket_a);
+        setup(rcp_a, socket_a);
+        setup(rcp_b, socket_b);
+    }
+
+    void setup(RCP& rcp, Loopback_Socket& socket)
+    {
+        RCP::Socket_Handle handle = rcp.add_socket(&socket);
+        rcp.set_internal_socket_handle(handle);
+        rcp.set_socket_handle(RELIABLE_CHANNEL, handle);
+        rcp.set_socket_handle(FEC_CHANNEL, handle);
+
+        RCP::Send_Params params;
+        params.is_reliable = true;
+        rcp.set_send_params(RELIABLE_CHANNEL, params);
+
+        params.is_reliable = false;
+        params.fec_k = 4;
+        params.fec_n = 8;
+        rcp.set_send_params(FEC_CHANNEL, params);
+
+        //a lost unreliable packet is skipped after this
+        RCP::Receive_Params receive_params;
+        receive_params.max_receive_time = std::chrono::milliseconds(200);
+        rcp.set_receive_params(FEC_CHANNEL, receive_params);
+    }
+
+    //Runs both ends until done() or the timeout. Returns done()
+    auto run(q::Clock::duration timeout, std::function<bool()> const& done) -> bool
+    {
+        auto start = q::Clock::now();
+        while (!done())
+        {
+            if (q::Clock::now() - start > timeout)
+            {
+                return false;
+            }
+            socket_a.process();
+            socket_b.process();
+            rcp_a.process();
+            rcp_b.process();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+
+    //On a clean link so a late connection request doesn't reset the connection in the middle of a test
+    auto connect() -> bool
+    {
+        bool ok = run(std::chrono::seconds(5), [this]() { return rcp_a.is_connected() && rcp_b.is_connected(); });
+        run(std::chrono::milliseconds(100), []() { return false; });
+        return ok && rcp_a.is_connected() && rcp_b.is_connected();
+    }
+
+    void set_link_params(Loopback_Socket::Link_Params const& params)
+    {
+        socket_a.set_link_params(params);
+        socket_b.set_link_params(params);
+    }
+
+    Loopback_Socket socket_a;
+    Loopback_Socket socket_b;
+    RCP rcp_a;
+    RCP rcp_b;
+};
+
+//Packets of different sizes, some of them of many fragments. The first 4 bytes are the index
+auto make_packet(uint32_t idx) -> std::vector<uint8_t>
+{
+    size_t size = 4 + (idx * 7919) % 5000;
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        data[i] = static_cast<uint8_t>((i * 31 + idx) >> (i % 3));
+    }
+    std::copy(reinterpret_cast<uint8_t const*>(&idx), reinterpret_cast<uint8_t const*>(&idx) + 4, data.begin());
+    return data;
+}
+
+//Sends the packets from a to b on the reliable channel and checks that all of them arrive, in order
+void check_reliable_transfer(Loopback& loopback, uint32_t first_idx, uint32_t count, q::Clock::duration timeout)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto data = make_packet(first_idx + i);
+        BOOST_REQUIRE(loopback.rcp_a.send(RELIABLE_CHANNEL, data.data(), data.size()));
+    }
+
+    uint32_t received = 0;
+    std::vector<uint8_t> data;
+    bool ok = loopback.run(timeout, [&]()
+    {
+        while (loopback.rcp_b.receive(RELIABLE_CHANNEL, data))
+        {
+            BOOST_CHECK_MESSAGE(data == make_packet(first_idx + received), "packet " << received << " is wrong");
+            received++;
+        }
+        return received >= count;
+    });
+    BOOST_CHECK_MESSAGE(ok, "received " << received << " of " << count);
+    BOOST_CHECK(received == count);
+}
+
+}
+
+//Every reliable packet arrives intact and in order through 20% loss and reordering, in both directions
+BOOST_AUTO_TEST_CASE(RCP_RELIABLE_UNDER_LOSS_AND_REORDERING)
+{
+    Loopback loopback;
+    BOOST_REQUIRE(loopback.connect());
+
+    Loopback_Socket::Link_Params params;
+    params.loss = 0.2f;
+    params.max_delay = std::chrono::milliseconds(20);
+    loopback.set_link_params(params);
+
+    check_reliable_transfer(loopback, 0, 100, std::chrono::seconds(30));
+    BOOST_CHECK(loopback.socket_a.dropped_count > 0);
+    BOOST_CHECK(loopback.socket_b.dropped_count > 0); //the confirmations are lost as well
+}
+
+//The parity datagrams rebuild most of what's lost on an unreliable channel, without resends
+BOOST_AUTO_TEST_CASE(RCP_FEC_RECOVERS_UNRELIABLE_LOSS)
+{
+    Loopback loopback;
+    BOOST_REQUIRE(loopback.connect());
+
+    Loopback_Socket::Link_Params params;
+    params.loss = 0.1f;
+    params.max_delay = std::chrono::milliseconds(5);
+    loopback.set_link_params(params);
+
+    //single fragment packets, a multiple of fec_k so the last group is complete
+    constexpr uint32_t COUNT = 200;
+    std::vector<bool> is_received(COUNT, false);
+    for (uint32_t i = 0; i < COUNT; i++)
+    {
+        std::vector<uint8_t> data(100, static_cast<uint8_t>(i));
+        std::copy(reinterpret_cast<uint8_t const*>(&i), reinterpret_cast<uint8_t const*>(&i) + 4, data.begin());
+        BOOST_REQUIRE(loopback.rcp_a.send(FEC_CHANNEL, data.data(), data.size()));
+    }
+
+    std::vector<uint8_t> data;
+    loopback.run(std::chrono::seconds(2), [&]()
+    {
+        while (loopback.rcp_b.receive(FEC_CHANNEL, data))
+        {
+            BOOST_REQUIRE(data.size() == 100);
+            uint32_t idx = 0;
+            std::copy(data.begin(), data.begin() + 4, reinterpret_cast<uint8_t*>(&idx));
+            BOOST_REQUIRE(idx < COUNT);
+            is_received[idx] = true;
+        }
+        return false;
+    });
+
+    size_t received = std::count(is_received.begin(), is_received.end(), true);
+    std::cout << "RCP fec 4/8, 10% loss: " << received << " of " << COUNT << " packets, "
+              << loopback.socket_a.dropped_count << " of " << loopback.socket_a.sent_count << " datagrams dropped" << std::endl;
+    //without the parity ~10% would be lost. With it a group is lost only when more than 4 of its 8 datagrams are
+    BOOST_CHECK(received >= COUNT * 98 / 100);
+}
+
+//Nothing gets through for a while - the packets sent meanwhile are resent once the link is back
+BOOST_AUTO_TEST_CASE(RCP_RECOVERS_AFTER_LINK_OUTAGE)
+{
+    Loopback loopback;
+    BOOST_REQUIRE(loopback.connect());
+
+    Loopback_Socket::Link_Params params;
+    params.max_delay = std::chrono::milliseconds(5);
+    params.is_down = true;
+    loopback.set_link_params(params);
+
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        auto data = make_packet(i);
+        BOOST_REQUIRE(loopback.rcp_a.send(RELIABLE_CHANNEL, data.data(), data.size()));
+    }
+    std::vector<uint8_t> data;
+    loopback.run(std::chrono::milliseconds(1500), [&]() { return loopback.rcp_b.receive(RELIABLE_CHANNEL, data); });
+    BOOST_CHECK(data.empty());
+
+    params.is_down = false;
+    loopback.set_link_params(params);
+
+    //well before the receiver gives up on the missing ones (max_receive_time)
+    uint32_t received = 0;
+    bool ok = loopback.run(std::chrono::seconds(3), [&]()
+    {
+        while (loopback.rcp_b.receive(RELIABLE_CHANNEL, data))
+        {
+            BOOST_CHECK_MESSAGE(data == make_packet(received), "packet " << received << " is wrong");
+            received++;
+        }
+        return received >= 20;
+    });
+    BOOST_CHECK_MESSAGE(ok, "received " << received << " of 20");
+    BOOST_CHECK(loopback.rcp_a.is_connected() && loopback.rcp_b.is_connected());
+
+    //and the link keeps working after
+    check_reliable_transfer(loopback, 1000, 20, std::chrono::seconds(10));
+}
@@ -0,0 +1,160 @@
+#include "utils/Polyphase_Resampler.h"
+#include "utils/Butterworth.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+#ifdef NDEBUG
+static const int TIMES = 100000;
+#else
+static const int TIMES = 2000;
+#endif
+
+namespace
+{
+
+struct Ratio
+{
+    uint32_t input_rate;
+    uint32_t output_rate;
+};
+
+//the ratios the resampler nodes are set up with
+const Ratio k_ratios[] = { { 1000, 100 }, { 1000, 400 }, { 1000, 300 }, { 400, 1000 }, { 100, 1000 }, { 200, 200 } };
+
+}
+
+//A ramp comes out exactly group delay late when the phases have more than one tap, and on average when they hold
+BOOST_AUTO_TEST_CASE(POLYPHASE_RESAMPLER_RAMP_LAG)
+{
+    for (Ratio const& ratio: k_ratios)
+    {
+        uint32_t max_rate = std::max(ratio.input_rate, ratio.output_rate);
+        util::Polyphase_Resampler<double> resampler;
+        BOOST_REQUIRE(resampler.setup(ratio.input_rate, ratio.output_rate, 1.f / max_rate));
+
+        std::vector<double> outputs;
+        for (uint32_t i = 0; i < ratio.input_rate; i++)
+        {
+            resampler.process(double(i) / ratio.input_rate, [&outputs](double value) { outputs.push_back(value); });
+        }
+        BOOST_CHECK_MESSAGE(outputs.size() == ratio.output_rate, ratio.input_rate << "->" << ratio.output_rate << ": " << outputs.size() << " outputs");
+
+        //the first outputs come out of a history filled with the first input
+        size_t first_output = (resampler.get_taps_per_phase() * ratio.output_rate + ratio.input_rate - 1) / ratio.input_rate;
+
+        double group_delay = resampler.get_group_delay();
+        double lag_sum = 0;
+        double max_lag_error = 0;
+        for (size_t i = first_output; i < outputs.size(); i++)
+        {
+            double lag = double(i) / ratio.output_rate - outputs[i];
+            lag_sum += lag;
+            max_lag_error = std::max(max_lag_error, std::abs(lag - group_delay));
+        }
+        double average_lag = lag_sum / (outputs.size() - first_output);
+        BOOST_CHECK_MESSAGE(std::abs(average_lag - group_delay) < 1e-6 + 0.5 / ratio.output_rate,
+                            ratio.input_rate << "->" << ratio.output_rate << ": lag " << average_lag << " instead of " << group_delay);
+        if (resampler.get_taps_per_phase() > 1)
+        {
+            BOOST_CHECK_MESSAGE(max_lag_error < 1e-6, ratio.input_rate << "->" << ratio.output_rate << ": lag error " << max_lag_error);
+        }
+        //at most one period of the higher rate, unless even holding the input (one tap) takes longer
+        BOOST_CHECK(group_delay <= std::max(1.0 / max_rate, 0.5 / ratio.input_rate) + 1e-9);
+    }
+}
+
+//The SIMD dot product of the vec3f streams has to match the scalar one of each axis
+BOOST_AUTO_TEST_CASE(POLYPHASE_RESAMPLER_VEC3F_MATCHES_FLOAT)
+{
+    util::Polyphase_Resampler<math::vec3f> resampler;
+    util::Polyphase_Resampler<float> resampler_x;
+    util::Polyphase_Resampler<float> resampler_y;
+    util::Polyphase_Resampler<float> resampler_z;
+    //many taps so the SIMD loop runs a few times, with a tail
+    BOOST_REQUIRE(resampler.setup(1000, 300, 0.01f));
+    BOOST_REQUIRE(resampler_x.setup(1000, 300, 0.01f));
+    BOOST_REQUIRE(resampler_y.setup(1000, 300, 0.01f));
+    BOOST_REQUIRE(resampler_z.setup(1000, 300, 0.01f));
+    BOOST_REQUIRE(resampler.get_taps_per_phase() > 4);
+
+    std::vector<math::vec3f> outputs;
+    std::vector<float> outputs_x;
+    std::vector<float> outputs_y;
+    std::vector<float> outputs_z;
+    for (int i = 0; i < 1000; i++)
+    {
+        math::vec3f value(std::sin(i * 0.01f), std::cos(i * 0.03f), std::sin(i * 0.07f) * 10.f);
+        resampler.process(value, [&outputs](math::vec3f const& v) { outputs.push_back(v); });
+        resampler_x.process(value.x, [&outputs_x](float v) { outputs_x.push_back(v); });
+        resampler_y.process(value.y, [&outputs_y](float v) { outputs_y.push_back(v); });
+        resampler_z.process(value.z, [&outputs_z](float v) { outputs_z.push_back(v); });
+    }
+    BOOST_REQUIRE(outputs.size() == outputs_x.size());
+
+    //the SIMD loop adds in a different order
+    float max_error = 0;
+    for (size_t i = 0; i < outputs.size(); i++)
+    {
+        max_error = std::max(max_error, std::abs(outputs[i].x - outputs_x[i]));
+        max_error = std::max(max_error, std::abs(outputs[i].y - outputs_y[i]));
+        max_error = std::max(max_error, std::abs(outputs[i].z - outputs_z[i]));
+    }
+    BOOST_CHECK_MESSAGE(max_error < 1e-4f, "vec3f differs from float by " << max_error);
+}
+
+BOOST_AUTO_TEST_CASE(BENCHMARK_RESAMPLER)
+{
+    std::cout << "Resampler vec3f, 1000 inputs x " << TIMES / 100 << std::endl;
+
+    std::vector<math::vec3f> inputs(1000);
+    for (size_t i = 0; i < inputs.size(); i++)
+    {
+        inputs[i] = math::vec3f(std::sin(i * 0.01f), std::cos(i * 0.03f), std::sin(i * 0.07f));
+    }
+
+    for (Ratio const& ratio: k_ratios)
+    {
+        uint32_t max_rate = std::max(ratio.input_rate, ratio.output_rate);
+        util::Butterworth<math::vec3f> iir;
+        util::Polyphase_Resampler<math::vec3f> fir;
+        BOOST_REQUIRE(iir.setup(4, max_rate, std::min(ratio.input_rate, ratio.output_rate) * 0.49f));
+        BOOST_REQUIRE(fir.setup(ratio.input_rate, ratio.output_rate, 1.f / max_rate));
+
+        std::vector<math::vec3f> block;
+        std::vector<math::vec3f> outputs;
+        std::chrono::high_resolution_clock::time_point start;
+        //the first pass resets the filters, which is slow and not what's measured
+        for (int t = -1; t < TIMES / 100; t++)
+        {
+            if (t == 0)
+            {
+                start = std::chrono::high_resolution_clock::now();
+            }
+            //the same order as the node: the Butterworth runs on the higher rate side, as a block
+            block = inputs;
+            outputs.clear();
+            if (ratio.input_rate >= ratio.output_rate)
+            {
+                iir.process(block.data(), block.size());
+            }
+            for (math::vec3f const& value: block)
+            {
+                fir.process(value, [&outputs](math::vec3f const& v) { outputs.push_back(v); });
+            }
+            if (ratio.input_rate < ratio.output_rate)
+            {
+                iir.process(outputs.data(), outputs.size());
+            }
+        }
+        auto d = std::chrono::high_resolution_clock::now() - start;
+        double ns = std::chrono::duration<double, std::nano>(d).count() / (TIMES / 100) / inputs.size();
+
+        std::cout << "\t" << ratio.input_rate << "->" << ratio.output_rate << ": " << fir.get_taps_per_phase() << " taps per phase, group delay "
+                  << (iir.get_group_delay() + fir.get_group_delay()) * 1000.f << " ms, " << ns << " ns/input" << std::endl;
+        BOOST_CHECK(outputs.size() == inputs.size() * ratio.output_rate / ratio.input_rate);
+    }
+}
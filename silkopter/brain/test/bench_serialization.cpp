@@ -0,0 +1,200 @@
+#include "hal.def.h"
+#include "gs_comms.def.h"
+#include "common/comms/Setup_Codec.h"
+
+#include <chrono>
+#include <iostream>
+#include <boost/test/unit_test.hpp>
+
+//the generated serialize/deserialize are found in these namespaces, not through the arguments
+using namespace silk;
+using namespace silk::hal;
+using namespace silk::gs_comms;
+
+#ifdef NDEBUG
+static const int TIMES = 20000;
+#else
+static const int TIMES = 200;
+#endif
+
+namespace
+{
+
+//what the brain sends when the gs connects, with the data of all nodes
+setup::Brain_Res make_get_nodes_res(size_t node_count)
+{
+    setup::Get_Nodes_Res res;
+    res.set_req_id(7);
+    for (size_t i = 0; i < node_count; i++)
+    {
+        setup::Node_Data node_data;
+        node_data.set_name("node_" + std::to_string(i));
+        node_data.set_type(3);
+        node_data.set_hash(static_cast<uint32_t>(i * 77777u));
+        for (size_t k = 0; k < 3; k++)
+        {
+            setup::Node_Data::Input input;
+            input.set_name("input_" + std::to_string(k));
+            input.set_rate(1000);
+            input.set_stream_path("node/output");
+            node_data.get_inputs().push_back(input);
+
+            setup::Node_Data::Output output;
+            output.set_name("output_" + std::to_string(k));
+            output.set_rate(500);
+            node_data.get_outputs().push_back(output);
+        }
+        node_data.set_descriptor_data(std::string(60, 'd'));
+        node_data.set_config_data(std::string(120, 'c'));
+        res.get_node_names().push_back(node_data.get_name());
+        res.get_node_datas().push_back(std::move(node_data));
+    }
+    return res;
+}
+
+setup::Brain_Req make_set_node_config_req()
+{
+    setup::Set_Node_Config_Req req;
+    req.set_req_id(8);
+    req.set_name("node_0");
+    req.set_config_data(std::string(120, 'c'));
+    return req;
+}
+
+//The streaming path has to write the same bytes as going through a sz::Value and read them back
+template<class T>
+void check_round_trip(char const* name, T const& value)
+{
+    std::string value_data;
+    ts::sz::to_binary(value_data, serialize(value));
+
+    std::string stream_data;
+    {
+        ts::sz::Binary_Writer writer(stream_data);
+        serialize(writer, value);
+    }
+    BOOST_CHECK_MESSAGE(value_data == stream_data, name << ": the streaming path writes different bytes");
+
+    T result;
+    ts::sz::Binary_Reader reader(stream_data.data(), stream_data.size());
+    auto deserialize_result = deserialize(result, reader);
+    if (deserialize_result != ts::success)
+    {
+        BOOST_FAIL(name << ": " << deserialize_result.error().what());
+    }
+    BOOST_CHECK_MESSAGE(reader.is_done(), name << ": the streaming path didn't read all the data");
+
+    std::string result_data;
+    ts::sz::to_binary(result_data, serialize(result));
+    BOOST_CHECK_MESSAGE(value_data == result_data, name << ": the round-trip changed the value");
+}
+
+template<class F>
+double measure_ns(int times, F&& f)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < times; i++)
+    {
+        f();
+    }
+    auto d = std::chrono::high_resolution_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(d).count() / times;
+}
+
+template<class T>
+void benchmark(char const* name, T const& value, int times)
+{
+    std::string data;
+    double value_encode_ns = measure_ns(times, [&]()
+    {
+        data.clear();
+        ts::sz::to_binary(data, serialize(value));
+    });
+    double stream_encode_ns = measure_ns(times, [&]()
+    {
+        data.clear();
+        ts::sz::Binary_Writer writer(data);
+        serialize(writer, value);
+    });
+
+    bool ok = true;
+    double value_decode_ns = measure_ns(times, [&]()
+    {
+        T result;
+        auto value_result = ts::sz::from_binary(data);
+        ok &= value_result == ts::success && deserialize(result, value_result.payload()) == ts::success;
+    });
+    double stream_decode_ns = measure_ns(times, [&]()
+    {
+        T result;
+        ts::sz::Binary_Reader reader(data.data(), data.size());
+        ok &= deserialize(result, reader) == ts::success;
+    });
+    BOOST_CHECK(ok);
+
+    std::cout << "\t" << name << ", " << data.size() << " bytes" << std::endl;
+    std::cout << "\t\tencode: value " << value_encode_ns << " ns, stream " << stream_encode_ns << " ns (" << value_encode_ns / stream_encode_ns << "x)" << std::endl;
+    std::cout << "\t\tdecode: value " << value_decode_ns << " ns, stream " << stream_decode_ns << " ns (" << value_decode_ns / stream_decode_ns << "x)" << std::endl;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(SERIALIZATION_STREAMING_MATCHES_VALUE)
+{
+    check_round_trip("gs_comms Get_Nodes_Res", make_get_nodes_res(40));
+    check_round_trip("gs_comms Set_Node_Config_Req", make_set_node_config_req());
+
+    check_round_trip("hal Multirotor_Simulator_Descriptor", hal::Poly<const hal::INode_Descriptor>(new hal::Multirotor_Simulator_Descriptor()));
+    check_round_trip("hal Multirotor_Simulator_Config", hal::Poly<const hal::INode_Config>(new hal::Multirotor_Simulator_Config()));
+    check_round_trip("hal Multirotor_Brain_Config", hal::Poly<const hal::INode_Config>(new hal::Multirotor_Brain_Config()));
+    check_round_trip("hal Multirotor_Descriptor", hal::Poly<const hal::IUAV_Descriptor>(new hal::Multirotor_Descriptor()));
+    check_round_trip("hal empty poly", hal::Poly<const hal::INode_Config>());
+}
+
+//The codec takes the streaming path for the binary format, it has to match the value path for both formats
+// and fail cleanly on truncated messages
+BOOST_AUTO_TEST_CASE(SETUP_CODEC_MATCHES_VALUE)
+{
+    setup::Brain_Res res = make_get_nodes_res(40);
+    hal::Poly<const hal::INode_Config> config(new hal::Multirotor_Brain_Config());
+
+    Setup_Codec codec;
+    for (Setup_Format format: { Setup_Format::JSON, Setup_Format::BINARY })
+    {
+        codec.set_format(format);
+        std::string data = codec.encode_message(res);
+        BOOST_CHECK(data == codec.encode_message(serialize(res)));
+
+        setup::Brain_Res decoded;
+        BOOST_CHECK(codec.decode_message(decoded, data.data(), data.size()) == ts::success);
+
+        std::string config_data = codec.encode_value(config);
+        hal::Poly<const hal::INode_Config> decoded_config;
+        BOOST_CHECK(codec.decode_value(decoded_config, config_data) == ts::success);
+
+        if (format == Setup_Format::BINARY)
+        {
+            //from 1 byte, the marker is what tells it's a binary message
+            size_t truncated_ok = 0;
+            for (size_t size = 1; size < data.size(); size += 7)
+            {
+                if (codec.decode_message(decoded, data.data(), size) == ts::success)
+                {
+                    truncated_ok++;
+                }
+            }
+            BOOST_CHECK_MESSAGE(truncated_ok == 0, truncated_ok << " truncated messages were decoded");
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(BENCHMARK_SERIALIZATION)
+{
+    std::cout << "Serialization, value path vs streaming path, binary format" << std::endl;
+
+    benchmark("gs_comms Get_Nodes_Res (40 nodes)", make_get_nodes_res(40), TIMES / 20);
+    benchmark("gs_comms Set_Node_Config_Req", make_set_node_config_req(), TIMES * 10);
+    benchmark("hal Multirotor_Simulator_Descriptor", hal::Poly<const hal::INode_Descriptor>(new hal::Multirotor_Simulator_Descriptor()), TIMES * 5);
+    benchmark("hal Multirotor_Simulator_Config", hal::Poly<const hal::INode_Config>(new hal::Multirotor_Simulator_Config()), TIMES * 5);
+    benchmark("hal Multirotor_Brain_Config", hal::Poly<const hal::INode_Config>(new hal::Multirotor_Brain_Config()), TIMES);
+}
@@ -0,0 +1,197 @@
+#include "common/stream/Telemetry_Codec.h"
+#include "common/stream/IAcceleration.h"
+#include "common/stream/IBool.h"
+#include "common/stream/IGPS_Info.h"
+#include "common/stream/IPressure.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+using namespace silk;
+
+namespace
+{
+
+//made by make_value, with a few unhealthy runs
+template<class Stream, class F> auto make_samples(size_t count, F&& make_value) -> std::vector<typename Stream::Sample>
+{
+    std::vector<typename Stream::Sample> samples(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        samples[i].value = make_value(i);
+        samples[i].is_healthy = (i / 37) % 5 != 4;
+    }
+    return samples;
+}
+
+template<class Stream> auto encode(std::vector<typename Stream::Sample> const& samples) -> util::serialization::Buffer_t
+{
+    stream::Telemetry_Codec<Stream> codec;
+    util::serialization::Buffer_t buffer;
+    size_t off = 0;
+    codec.encode(buffer, samples, off);
+    BOOST_REQUIRE(off == buffer.size());
+    return buffer;
+}
+
+//Every prefix of the packet has to be rejected, and so does a count it cannot hold
+template<class Stream> void check_truncated(util::serialization::Buffer_t const& buffer, size_t count)
+{
+    stream::Telemetry_Codec<Stream> codec;
+    std::vector<typename Stream::Sample> decoded;
+    for (size_t size = 0; size < buffer.size(); size++)
+    {
+        util::serialization::Buffer_t truncated(buffer.begin(), buffer.begin() + size);
+        size_t off = 0;
+        BOOST_CHECK_MESSAGE(!codec.decode(truncated, count, decoded, off), "decoded " << size << " of " << buffer.size() << " bytes");
+    }
+
+    //a corrupt count is rejected before the samples are allocated
+    size_t off = 0;
+    BOOST_CHECK(!codec.decode(buffer, 0xFFFFFFFFu, decoded, off));
+    BOOST_CHECK(decoded.capacity() < 0xFFFFFFFFu);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(TELEMETRY_CODEC_QUANTIZED_ROUND_TRIP)
+{
+    typedef stream::IAcceleration Stream;
+    auto samples = make_samples<Stream>(500, [](size_t i)
+    {
+        return math::vec3f(std::sin(i * 0.01f) * 9.81f, std::cos(i * 0.03f), static_cast<float>(i % 7) * 0.001f - 9.81f);
+    });
+    auto buffer = encode<Stream>(samples);
+    std::cout << "Telemetry codec, acceleration: " << samples.size() << " samples in " << buffer.size() << " bytes" << std::endl;
+
+    stream::Telemetry_Codec<Stream> codec;
+    std::vector<Stream::Sample> decoded;
+    size_t off = 0;
+    BOOST_REQUIRE(codec.decode(buffer, samples.size(), decoded, off));
+    BOOST_CHECK(off == buffer.size());
+    BOOST_REQUIRE(decoded.size() == samples.size());
+
+    //quantized to 1 mm/s^2
+    float max_error = 0;
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        BOOST_CHECK(decoded[i].is_healthy == samples[i].is_healthy);
+        max_error = math::max(max_error, math::length(decoded[i].value - samples[i].value));
+    }
+    BOOST_CHECK_MESSAGE(max_error < 0.001f, "max error " << max_error);
+
+    check_truncated<Stream>(buffer, samples.size());
+}
+
+BOOST_AUTO_TEST_CASE(TELEMETRY_CODEC_LOSSLESS_ROUND_TRIP)
+{
+    typedef stream::IPressure Stream;
+    auto samples = make_samples<Stream>(500, [](size_t i)
+    {
+        return 101.325 + std::sin(i * 0.01) * 0.1 + ((i % 50) == 0 ? 1.0 : 0.0);
+    });
+    samples[100].value = std::numeric_limits<double>::quiet_NaN();
+    auto buffer = encode<Stream>(samples);
+
+    stream::Telemetry_Codec<Stream> codec;
+    std::vector<Stream::Sample> decoded;
+    size_t off = 0;
+    BOOST_REQUIRE(codec.decode(buffer, samples.size(), decoded, off));
+    BOOST_CHECK(off == buffer.size());
+    BOOST_REQUIRE(decoded.size() == samples.size());
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        BOOST_CHECK(decoded[i].is_healthy == samples[i].is_healthy);
+        BOOST_CHECK(std::memcmp(&decoded[i].value, &samples[i].value, sizeof(double)) == 0);
+    }
+
+    check_truncated<Stream>(buffer, samples.size());
+}
+
+BOOST_AUTO_TEST_CASE(TELEMETRY_CODEC_BOOL_AND_ROWS_ROUND_TRIP)
+{
+    {
+        typedef stream::IBool Stream;
+        auto samples = make_samples<Stream>(1000, [](size_t i) { return (i / 100) % 2 == 0; });
+        auto buffer = encode<Stream>(samples);
+
+        stream::Telemetry_Codec<Stream> codec;
+        std::vector<Stream::Sample> decoded;
+        size_t off = 0;
+        BOOST_REQUIRE(codec.decode(buffer, samples.size(), decoded, off));
+        BOOST_REQUIRE(decoded.size() == samples.size());
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            BOOST_CHECK(decoded[i].is_healthy == samples[i].is_healthy);
+            BOOST_CHECK(decoded[i].value == samples[i].value);
+        }
+
+        check_truncated<Stream>(buffer, samples.size());
+    }
+    {
+        typedef stream::IGPS_Info Stream;
+        auto samples = make_samples<Stream>(20, [](size_t i)
+        {
+            Stream::Value value;
+            value.fix = Stream::Value::Fix::FIX_3D;
+            value.fix_satellites = static_cast<uint16_t>(i);
+            value.pacc = static_cast<float>(i) * 0.5f;
+            return value;
+        });
+        auto buffer = encode<Stream>(samples);
+
+        stream::Telemetry_Codec<Stream> codec;
+        std::vector<Stream::Sample> decoded;
+        size_t off = 0;
+        BOOST_REQUIRE(codec.decode(buffer, samples.size(), decoded, off));
+        BOOST_REQUIRE(decoded.size() == samples.size());
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            BOOST_CHECK(decoded[i].is_healthy == samples[i].is_healthy);
+            BOOST_CHECK(decoded[i].value.fix_satellites == samples[i].value.fix_satellites);
+            BOOST_CHECK(decoded[i].value.pacc == samples[i].value.pacc);
+        }
+
+        check_truncated<Stream>(buffer, samples.size());
+    }
+}
+
+//The column decoders check the count before reserving for it
+BOOST_AUTO_TEST_CASE(COLUMN_CODEC_REJECTS_IMPOSSIBLE_COUNTS)
+{
+    namespace cc = util::column_codec;
+
+    std::vector<float> column = { 1.f, 1.5f, 2.f, 2.5f };
+    for (int8_t exponent: { int8_t(-3), cc::LOSSLESS })
+    {
+        cc::Buffer_t buffer;
+        size_t off = 0;
+        cc::encode_float_column(buffer, column, exponent, off);
+
+        std::vector<float> decoded;
+        off = 0;
+        BOOST_CHECK(cc::decode_float_column(buffer, column.size(), decoded, off));
+        BOOST_CHECK(decoded == column);
+
+        off = 0;
+        BOOST_CHECK(!cc::decode_float_column(buffer, size_t(1) << 40, decoded, off));
+        BOOST_CHECK(decoded.capacity() < (size_t(1) << 40));
+    }
+
+    //a single run holds any count so the bool columns are capped
+    for (size_t count: { cc::MAX_BOOL_COLUMN_SIZE, cc::MAX_BOOL_COLUMN_SIZE + 1 })
+    {
+        std::vector<uint8_t> bools(count, 1);
+        cc::Buffer_t buffer;
+        size_t off = 0;
+        cc::encode_bool_column(buffer, bools, off);
+        BOOST_CHECK(buffer.size() < 8);
+
+        std::vector<uint8_t> decoded;
+        off = 0;
+        BOOST_CHECK(cc::decode_bool_column(buffer, count, decoded, off) == (count <= cc::MAX_BOOL_COLUMN_SIZE));
+    }
+}
@@ -0,0 +1,93 @@
+#include "utils/comms/Video_Streamer.h"
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+
+using namespace util::comms;
+
+//The loopback interface stands in for a monitor mode radio: what is injected comes back as received.
+//Raw sockets need root (or CAP_NET_RAW), without it the tests are skipped.
+static const char* INTERFACE = "lo";
+
+namespace
+{
+
+//Streams whole fec blocks through the loopback and checks that all the data comes out, in order
+void check_loopback_stream(bool use_rings)
+{
+    Video_Streamer::RX_Descriptor rx_descriptor;
+    rx_descriptor.interfaces = { INTERFACE };
+    rx_descriptor.coding_k = 4;
+    rx_descriptor.coding_n = 6;
+    rx_descriptor.use_rx_ring = use_rings;
+
+    Video_Streamer rx;
+    if (!rx.init_rx(rx_descriptor))
+    {
+        std::cout << "Video streamer on " << INTERFACE << ": cannot open it, skipped (no root?)" << std::endl;
+        return;
+    }
+
+    Video_Streamer::TX_Descriptor tx_descriptor;
+    tx_descriptor.interface = INTERFACE;
+    tx_descriptor.coding_k = rx_descriptor.coding_k;
+    tx_descriptor.coding_n = rx_descriptor.coding_n;
+    tx_descriptor.use_tx_ring = use_rings;
+
+    Video_Streamer tx;
+    BOOST_REQUIRE(tx.init_tx(tx_descriptor));
+    BOOST_CHECK(tx.is_using_rings() == use_rings);
+    BOOST_CHECK(rx.is_using_rings() == use_rings);
+
+    math::vec2u16 resolution(640, 480);
+    std::vector<uint8_t> received;
+    rx.on_data_received = [&](void const* data, size_t size, math::vec2u16 const& r)
+    {
+        BOOST_CHECK(r == resolution);
+        uint8_t const* ptr = reinterpret_cast<uint8_t const*>(data);
+        received.insert(received.end(), ptr, ptr + size);
+    };
+
+    //only whole datagrams go out so send whole blocks, in pieces that don't match the datagrams
+    constexpr size_t BLOCK_COUNT = 50;
+    std::vector<uint8_t> sent(tx.get_mtu() * tx_descriptor.coding_k * BLOCK_COUNT);
+    for (size_t i = 0; i < sent.size(); i++)
+    {
+        sent[i] = static_cast<uint8_t>((i * 7) ^ (i >> 9));
+    }
+    constexpr size_t CHUNK_SIZE = 1000;
+    for (size_t offset = 0; offset < sent.size(); offset += CHUNK_SIZE)
+    {
+        tx.send(sent.data() + offset, std::min(CHUNK_SIZE, sent.size() - offset), resolution);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    while (received.size() < sent.size() && std::chrono::steady_clock::now() - start < std::chrono::seconds(5))
+    {
+        rx.process();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    BOOST_CHECK_MESSAGE(received.size() == sent.size(), "received " << received.size() << " of " << sent.size() << " bytes");
+    BOOST_CHECK(received == sent);
+
+    Video_Streamer::RX_Stats stats = rx.get_rx_stats();
+    BOOST_CHECK(stats.lost_blocks == 0);
+    std::cout << "Video streamer on " << INTERFACE << (use_rings ? " with rings: " : " with pcap: ")
+              << stats.blocks << " blocks, " << stats.lost_datagrams << " lost datagrams" << std::endl;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(VIDEO_STREAMER_LOOPBACK_RINGS)
+{
+    check_loopback_stream(true);
+}
+
+BOOST_AUTO_TEST_CASE(VIDEO_STREAMER_LOOPBACK_PCAP)
+{
+    check_loopback_stream(false);
+}
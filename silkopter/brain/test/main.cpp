@@ -0,0 +1,7 @@
+// each test module could contain no more then one 'main' file with init function defined
+// alternatively you could define init function yourself
+#define BOOST_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+//The benchmarks print their timings, build it with CONFIG+=rpi to get the numbers of the target.
+//Run only some of them with --run_test=NAME
@@ -83,6 +83,7 @@ HEADERS += \
     ../../src/Nodes_Widget.h \
     ../../src/Comms.h \
     ../../../libs/common/comms/def/gs_comms.def.h \
+    ../../../libs/common/comms/Setup_Codec.h \
     ../../../libs/lz4/lz4.h \
     ../../src/Properties_Delegate.h \
     ../../src/Properties_Model.h \
@@ -149,7 +150,13 @@ HEADERS += \
     ../../src/stream_viewers/video/Video_Decoder.h \
     ../../../libs/utils/comms/Channel.h \
     ../../../libs/utils/comms/RCP.h \
+    ../../../libs/utils/MPSC_Queue.h \
+    ../../../libs/utils/MPMC_Queue.h \
+    ../../../libs/utils/Column_Codec.h \
+    ../../../libs/common/stream/Telemetry_Codec.h \
+    ../../../libs/common/stream/Stream_Type_Map.h \
     ../../../libs/utils/comms/UDP_Socket.h \
+    ../../../libs/utils/comms/fec.h \
     ../../src/QHexSpinBox.h \
     ../../src/Internal_Telemetry_Widget.h \
     ../../../libs/utils/Coordinates.h
@@ -160,6 +167,7 @@ SOURCES += \
     ../../src/Nodes_Widget.cpp \
     ../../src/Comms.cpp \
     ../../../libs/common/comms/def/gs_comms.def.cpp \
+    ../../../libs/common/comms/Setup_Codec.cpp \
     ../../../libs/lz4/lz4.c \
     ../../src/Properties_Delegate.cpp \
     ../../src/Properties_Model.cpp \
@@ -221,6 +229,7 @@ SOURCES += \
     ../../src/stream_viewers/video/Video_Decoder.cpp \
     ../../../libs/utils/comms/RCP.cpp \
     ../../../libs/utils/comms/UDP_Socket.cpp \
+    ../../../libs/utils/comms/fec.cpp \
     ../../src/Internal_Telemetry_Widget.cpp \
     ../../../libs/utils/Coordinates.cpp
 
@@ -23,63 +23,19 @@ using namespace silk;
 constexpr uint8_t SETUP_CHANNEL = 10;
 constexpr uint8_t TELEMETRY_CHANNEL = 11;
 
+struct Comms::Telemetry_Stream_Factory
+{
+    template<class Stream> auto create() -> std::unique_ptr<ITelemetry_Stream>
+    {
+        return std::unique_ptr<ITelemetry_Stream>(new Telemetry_Stream<Stream>());
+    }
+};
+
 Comms::Comms(ts::Type_System& ts)
     : m_ts(ts)
+    , m_streams(Telemetry_Stream_Factory())
     , m_telemetry_channel(TELEMETRY_CHANNEL)
 {
-    m_streams[stream::IAcceleration::TYPE] =            std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IAcceleration>());
-    m_streams[stream::IENU_Acceleration::TYPE] =        std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Acceleration>());
-    m_streams[stream::IECEF_Acceleration::TYPE] =       std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Acceleration>());
-
-    m_streams[stream::ILinear_Acceleration::TYPE] =     std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::ILinear_Acceleration>());
-    m_streams[stream::IENU_Linear_Acceleration::TYPE] = std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Linear_Acceleration>());
-    m_streams[stream::IECEF_Linear_Acceleration::TYPE] =std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Linear_Acceleration>());
-
-    m_streams[stream::IAngular_Velocity::TYPE] =        std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IAngular_Velocity>());
-    m_streams[stream::IENU_Angular_Velocity::TYPE] =    std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Angular_Velocity>());
-    m_streams[stream::IECEF_Angular_Velocity::TYPE] =   std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Angular_Velocity>());
-
-    m_streams[stream::IMagnetic_Field::TYPE] =          std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IMagnetic_Field>());
-    m_streams[stream::IENU_Magnetic_Field::TYPE] =      std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Magnetic_Field>());
-    m_streams[stream::IECEF_Magnetic_Field::TYPE] =     std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Magnetic_Field>());
-
-    m_streams[stream::IDistance::TYPE] =                std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IDistance>());
-    m_streams[stream::IENU_Distance::TYPE] =            std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Distance>());
-    m_streams[stream::IECEF_Distance::TYPE] =           std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Distance>());
-
-    m_streams[stream::IForce::TYPE] =                   std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IForce>());
-    m_streams[stream::IENU_Force::TYPE] =               std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Force>());
-    m_streams[stream::IECEF_Force::TYPE] =              std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Force>());
-
-    m_streams[stream::ITorque::TYPE] =                  std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::ITorque>());
-    m_streams[stream::IENU_Torque::TYPE] =              std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Torque>());
-    m_streams[stream::IECEF_Torque::TYPE] =             std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Torque>());
-
-    m_streams[stream::IVelocity::TYPE] =                std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IVelocity>());
-    m_streams[stream::IENU_Velocity::TYPE] =            std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Velocity>());
-    m_streams[stream::IECEF_Velocity::TYPE] =           std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Velocity>());
-
-    m_streams[stream::IGimbal_Frame::TYPE] =            std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IGimbal_Frame>());
-    m_streams[stream::IFrame::TYPE] =                   std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IFrame>());
-    m_streams[stream::IENU_Frame::TYPE] =               std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IENU_Frame>());
-
-    m_streams[stream::IADC::TYPE] =                     std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IADC>());
-    m_streams[stream::IBattery_State::TYPE] =           std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IBattery_State>());
-    m_streams[stream::ICurrent::TYPE] =                 std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::ICurrent>());
-    m_streams[stream::IFloat::TYPE] =                   std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IFloat>());
-    m_streams[stream::IBool::TYPE] =                    std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IBool>());
-    m_streams[stream::IGPS_Info::TYPE] =                std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IGPS_Info>());
-    m_streams[stream::IECEF_Position::TYPE] =           std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IECEF_Position>());
-    m_streams[stream::IPressure::TYPE] =                std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IPressure>());
-    m_streams[stream::IPWM::TYPE] =                     std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IPWM>());
-    m_streams[stream::ITemperature::TYPE] =             std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::ITemperature>());
-    m_streams[stream::IThrottle::TYPE] =                std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IThrottle>());
-    m_streams[stream::IVoltage::TYPE] =                 std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IVoltage>());
-    m_streams[stream::IVideo::TYPE] =                   std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IVideo>());
-    m_streams[stream::IMultirotor_Commands::TYPE] =     std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IMultirotor_Commands>());
-    m_streams[stream::IMultirotor_State::TYPE] =        std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IMultirotor_State>());
-    m_streams[stream::IProximity::TYPE] =               std::unique_ptr<Comms::ITelemetry_Stream>(new Comms::Telemetry_Stream<stream::IProximity>());
-
 }
 
 ts::Type_System& Comms::get_type_system()
@@ -171,6 +127,8 @@ void Comms::configure_channels()
 void Comms::reset()
 {
     m_last_req_id = 0;
+    m_known_nodes.clear();
+    m_setup_codec.set_format(gs_comms::Setup_Format::BINARY);
     sig_reset();
 }
 
@@ -179,9 +137,8 @@ void Comms::serialize_and_send(size_t channel_idx, T const& message)
 {
     if (m_rcp->is_connected())
     {
-        ts::sz::Value sz_value = silk::gs_comms::serialize(message);
-        std::string json = ts::sz::to_json(sz_value, true);
-        if (!m_rcp->send(channel_idx, json.data(), json.size()))
+        std::string const& data = m_setup_codec.encode_message(message);
+        if (!m_rcp->send(channel_idx, data.data(), data.size()))
         {
             QLOGE("Failed to send message");
             return;
@@ -222,11 +179,62 @@ void Comms::request_all_data()
     {
         gs_comms::setup::Get_Nodes_Req req;
         req.set_req_id(++m_last_req_id);
+        add_known_nodes(req);
         request = req;
         serialize_and_send(SETUP_CHANNEL, request);
     }
 }
 
+void Comms::add_known_nodes(gs_comms::setup::Get_Nodes_Req& req) const
+{
+    for (auto const& p: m_known_nodes)
+    {
+        gs_comms::setup::Get_Nodes_Req::Known_Node known;
+        known.set_name(p.first);
+        known.set_hash(p.second.hash);
+        req.get_known_nodes().push_back(std::move(known));
+    }
+}
+
+void Comms::set_known_node(uint32_t hash, Node const& node)
+{
+    auto result = copy_node(node);
+    if (result != ts::success)
+    {
+        //the brain will send it again next time
+        QLOGW("Cannot cache node '{}': {}", node.name, result.error().what());
+        m_known_nodes.erase(node.name);
+        return;
+    }
+
+    Known_Node& known = m_known_nodes[node.name];
+    known.hash = hash;
+    known.node = result.extract_payload();
+}
+
+ts::Result<Comms::Node> Comms::copy_node(Node const& node) const
+{
+    QASSERT(node.descriptor && node.config);
+
+    Node copy = node;
+
+    copy.descriptor = node.descriptor->get_specialized_type()->create_specialized_value();
+    auto result = copy.descriptor->copy_construct(*node.descriptor);
+    if (result != ts::success)
+    {
+        return ts::Error("Cannot copy descriptor: " + result.error().what());
+    }
+
+    copy.config = node.config->get_specialized_type()->create_specialized_value();
+    result = copy.config->copy_construct(*node.config);
+    if (result != ts::success)
+    {
+        return ts::Error("Cannot copy config: " + result.error().what());
+    }
+
+    return copy;
+}
+
 //void Comms::request_node_config(std::string const& name)
 //{
 //    m_setup_channel.pack_all(gs_comms::Setup_Message::NODE_CONFIG, name);
@@ -724,16 +732,14 @@ template<typename Stream>
 bool Comms::Telemetry_Stream<Stream>::unpack(Telemetry_Channel& channel, size_t sample_count)
 {
     samples.clear();
-    Sample sample;
-    for (uint32_t i = 0; i < sample_count; i++)
+    m_buffer.clear();
+    size_t off = 0;
+    if (!channel.unpack_remaining_data(m_buffer) ||
+        !m_codec.decode(m_buffer, sample_count, samples, off))
     {
-        if (!channel.unpack_param(sample))
-        {
-            samples.clear();
-            QLOGE("Error unpacking samples!!!");
-            return false;
-        }
-        samples.push_back(sample);
+        samples.clear();
+        QLOGE("Error unpacking samples!!!");
+        return false;
     }
 
     return true;
@@ -766,18 +772,14 @@ void Comms::handle_telemetry_stream()
         return;
     }
 
-    ITelemetry_Stream* telemetry_stream = nullptr;
-    auto it = m_streams.find(stream_type);
-    if (it != m_streams.end())
-    {
-        telemetry_stream = it->second.get();
-    }
-    else
+    std::unique_ptr<ITelemetry_Stream> const* entry = m_streams.find(stream_type);
+    if (!entry)
     {
         QLOGE("Failed to find a stream data holder for semantic {}, space {} for stream {}", stream_type.get_semantic(), stream_type.get_space(), stream_path);
         return;
     }
 
+    ITelemetry_Stream* telemetry_stream = entry->get();
     if (telemetry_stream->unpack(m_telemetry_channel, sample_count))
     {
         telemetry_stream->stream_type = stream_type;
@@ -797,6 +799,23 @@ void Comms::handle_internal_telemetry_stream()
         return;
     }
 
+    auto unpack_percentiles = [&channel](Internal_Telementry_Sample::Percentiles& percentiles)
+    {
+        uint32_t p50, p99, p999;
+        if (!channel.unpack_param(p50) ||
+            !channel.unpack_param(p99) ||
+            !channel.unpack_param(p999))
+        {
+            return false;
+        }
+        percentiles.p50 = std::chrono::microseconds(p50);
+        percentiles.p99 = std::chrono::microseconds(p99);
+        percentiles.p999 = std::chrono::microseconds(p999);
+        return true;
+    };
+
+    //Mirrors GS_Comms::gather_telemetry_data in the brain. The layout has no version so it only works against a brain
+    // built from the same sources (the latency fields are in the middle of the samples, not appended).
     m_internal_telemetry_samples.resize(sample_count);
     for (uint32_t i = 0; i < sample_count; i++)
     {
@@ -806,6 +825,7 @@ void Comms::handle_internal_telemetry_stream()
         uint32_t node_count;
         if (!channel.unpack_param(micros) ||
             !channel.unpack_param(max_micros) ||
+            !unpack_percentiles(sample.end_to_end_latency) ||
             !channel.unpack_param(node_count))
         {
             QLOGE("Error unpacking samples!!!");
@@ -820,7 +840,10 @@ void Comms::handle_internal_telemetry_stream()
             Internal_Telementry_Sample::Node& node = sample.nodes[n];
             if (!channel.unpack_param(node.name) ||
                 !channel.unpack_param(micros) ||
-                !channel.unpack_param(max_micros))
+                !channel.unpack_param(max_micros) ||
+                !channel.unpack_param(node.call_rate) ||
+                !unpack_percentiles(node.process_duration) ||
+                !unpack_percentiles(node.sample_age))
             {
                 QLOGE("Error unpacking samples!!!");
                 return;
@@ -874,20 +897,6 @@ void Comms::handle_internal_telemetry_stream()
 //    m_pilot_channel.try_sending(*m_rcp);
 //}
 
-std::string const& Comms::decode_json(std::string const& json_base64)
-{
-    m_base64_buffer.resize(q::util::compute_base64_max_decoded_size(json_base64.size()));
-    auto last_it = q::util::decode_base64(json_base64.data(), json_base64.data() + json_base64.size(), m_base64_buffer.begin());
-    m_base64_buffer.erase(last_it, m_base64_buffer.end());
-    return m_base64_buffer;
-}
-std::string const& Comms::encode_json(std::string const& json)
-{
-    m_base64_buffer.resize(q::util::compute_base64_encoded_size(json.size()));
-    q::util::encode_base64(reinterpret_cast<uint8_t const*>(json.data()), json.size(), &m_base64_buffer[0]);
-    return m_base64_buffer;
-}
-
 void Comms::handle_res(gs_comms::setup::Error const& res)
 {
     QLOGI("Error {}", res.get_req_id());
@@ -899,16 +908,15 @@ void Comms::handle_res(gs_comms::setup::Get_AST_Res const& res)
 {
     QLOGI("Get_AST_Res {}", res.get_req_id());
 
-    std::string const& json = decode_json(res.get_data());
-    auto json_result = ts::sz::from_json(json);
-    if (json_result != ts::success)
+    auto value_result = m_setup_codec.decode_value(res.get_data());
+    if (value_result != ts::success)
     {
-        QLOGE("Cannot deserialize ast json data: {}", json_result.error().what());
+        QLOGE("Cannot deserialize ast data: {}", value_result.error().what());
         return;
     }
 
     ts::ast::Builder builder;
-    auto deserialize_result = builder.get_ast_root_node().deserialize(json_result.payload());
+    auto deserialize_result = builder.get_ast_root_node().deserialize(value_result.payload());
     if (deserialize_result != ts::success)
     {
         QLOGE("Cannot deserialize ast root: {}", deserialize_result.error().what());
@@ -960,15 +968,14 @@ bool Comms::handle_uav_descriptor(std::string const& serialized_data)
         return false;
     }
 
-    std::string const& json = decode_json(serialized_data);
-    auto json_result = ts::sz::from_json(json);
-    if (json_result != ts::success)
+    auto value_result = m_setup_codec.decode_value(serialized_data);
+    if (value_result != ts::success)
     {
-        QLOGE("Cannot deserialize ast json data: {}", json_result.error().what());
+        QLOGE("Cannot deserialize value data: {}", value_result.error().what());
         return false;
     }
 
-    auto deserialize_result = descriptor_poly_value->deserialize(json_result.payload());
+    auto deserialize_result = descriptor_poly_value->deserialize(value_result.payload());
     if (deserialize_result != ts::success)
     {
         QLOGE("Cannot deserialize descriptor: {}", deserialize_result.error().what());
@@ -1059,15 +1066,14 @@ void Comms::handle_res(gs_comms::setup::Get_Node_Defs_Res const& res)
             node_def.outputs.push_back(std::move(output));
         }
 
-        std::string const& json = decode_json(node_def_data.get_descriptor_data());
-        auto json_result = ts::sz::from_json(json);
-        if (json_result != ts::success)
+        auto value_result = m_setup_codec.decode_value(node_def_data.get_descriptor_data());
+        if (value_result != ts::success)
         {
-            QLOGE("Cannot deserialize ast json data: {}", json_result.error().what());
+            QLOGE("Cannot deserialize value data: {}", value_result.error().what());
             return;
         }
 
-        auto deserialize_result = descriptor_poly_value->deserialize(json_result.payload());
+        auto deserialize_result = descriptor_poly_value->deserialize(value_result.payload());
         if (deserialize_result != ts::success)
         {
             QLOGE("Cannot deserialize descriptor: {}", deserialize_result.error().what());
@@ -1091,6 +1097,7 @@ void Comms::handle_res(gs_comms::setup::Remove_Node_Res const& res)
 {
     QLOGI("Remove_Node_Res {}", res.get_req_id());
 
+    m_known_nodes.erase(res.get_name());
     sig_node_removed();
 }
 
@@ -1152,14 +1159,13 @@ ts::Result<Comms::Node> Comms::handle_node_data(gs_comms::setup::Node_Data const
     }
 
     {
-        std::string const& json = decode_json(node_data.get_descriptor_data());
-        auto json_result = ts::sz::from_json(json);
-        if (json_result != ts::success)
+        auto value_result = m_setup_codec.decode_value(node_data.get_descriptor_data());
+        if (value_result != ts::success)
         {
-            return ts::Error("Cannot deserialize ast json data: " + json_result.error().what());
+            return ts::Error("Cannot deserialize value data: " + value_result.error().what());
         }
 
-        auto deserialize_result = descriptor_poly_value->deserialize(json_result.payload());
+        auto deserialize_result = descriptor_poly_value->deserialize(value_result.payload());
         if (deserialize_result != ts::success)
         {
             return ts::Error("Cannot deserialize descriptor: " + deserialize_result.error().what());
@@ -1173,14 +1179,13 @@ ts::Result<Comms::Node> Comms::handle_node_data(gs_comms::setup::Node_Data const
     }
 
     {
-        std::string const& json = decode_json(node_data.get_config_data());
-        auto json_result = ts::sz::from_json(json);
-        if (json_result != ts::success)
+        auto value_result = m_setup_codec.decode_value(node_data.get_config_data());
+        if (value_result != ts::success)
         {
-            return ts::Error("Cannot deserialize ast json data: " + json_result.error().what());
+            return ts::Error("Cannot deserialize value data: " + value_result.error().what());
         }
 
-        auto deserialize_result = config_poly_value->deserialize(json_result.payload());
+        auto deserialize_result = config_poly_value->deserialize(value_result.payload());
         if (deserialize_result != ts::success)
         {
             return ts::Error("Cannot deserialize config: " + deserialize_result.error().what());
@@ -1198,27 +1203,74 @@ ts::Result<Comms::Node> Comms::handle_node_data(gs_comms::setup::Node_Data const
 
 void Comms::handle_res(gs_comms::setup::Get_Nodes_Res const& res)
 {
-    QLOGI("Get_Nodes_Res {}", res.get_req_id());
+    QLOGI("Get_Nodes_Res {}: {} changed nodes out of {}", res.get_req_id(), res.get_node_datas().size(), res.get_node_names().size());
 
-    std::vector<Node> nodes;
+    //only the changed nodes are sent and parsed, the rest are copied from what we got last time
+    for (gs_comms::setup::Node_Data const& node_data: res.get_node_datas())
+    {
+        auto result = handle_node_data(node_data);
+        if (result != ts::success)
+        {
+            handle_nodes_res_error(res, false, "Cannot handle node '" + node_data.get_name() + "' data: " + result.error().what());
+            return;
+        }
+        Known_Node& known = m_known_nodes[node_data.get_name()];
+        known.hash = node_data.get_hash();
+        known.node = result.extract_payload();
+    }
 
-    std::vector<gs_comms::setup::Node_Data> const& node_datas = res.get_node_datas();
-    nodes.reserve(node_datas.size());
+    std::vector<Node> nodes;
+    nodes.reserve(res.get_node_names().size());
 
-    for (gs_comms::setup::Node_Data const& node_data: node_datas)
+    std::map<std::string, Known_Node> known_nodes;
+    for (std::string const& name: res.get_node_names())
     {
-        auto result = handle_node_data(node_data);
+        auto it = m_known_nodes.find(name);
+        if (it == m_known_nodes.end())
+        {
+            handle_nodes_res_error(res, true, "Node '" + name + "' was not sent and it's not known");
+            return;
+        }
+
+        auto result = copy_node(it->second.node);
         if (result != ts::success)
         {
-            QLOGE("Cannot handle node '{}' data: {}", node_data.get_name(), result.error().what());
+            handle_nodes_res_error(res, true, "Cannot copy node '" + name + "': " + result.error().what());
             return;
         }
         nodes.push_back(result.extract_payload());
+        known_nodes.insert(std::move(*it));
     }
 
+    //the gs always asks for all the nodes so whatever is not in the list was removed
+    m_known_nodes = std::move(known_nodes);
+
     sig_nodes_received(nodes);
 }
 
+void Comms::handle_nodes_res_error(gs_comms::setup::Get_Nodes_Res const& res, bool is_cache_error, std::string const& message)
+{
+    QLOGE("{}", message);
+    m_known_nodes.clear();
+
+    //The cache can miss nodes when two requests overlap, so ask again for all of them under the same req id.
+    //If all the nodes were sent the cache has nothing to do with it and asking again would fail the same way.
+    bool used_cache = res.get_node_datas().size() < res.get_node_names().size();
+    if (is_cache_error && used_cache)
+    {
+        QLOGI("Asking for all the nodes again");
+        gs_comms::setup::Get_Nodes_Req req;
+        req.set_req_id(res.get_req_id());
+        gs_comms::setup::Brain_Req request;
+        request = req;
+        serialize_and_send(SETUP_CHANNEL, request);
+    }
+    else
+    {
+        sig_error_received(res.get_req_id(), message);
+    }
+}
+
 void Comms::handle_res(gs_comms::setup::Add_Node_Res const& res)
 {
     QLOGI("Add_Node_Res {}", res.get_req_id());
@@ -1229,6 +1281,7 @@ void Comms::handle_res(gs_comms::setup::Add_Node_Res const& res)
         QLOGE("Cannot handle node '{}' data: {}", res.get_node_data().get_name(), result.error().what());
         return;
     }
+    set_known_node(res.get_node_data().get_hash(), result.payload());
 
     sig_node_added(result.extract_payload());
 }
@@ -1243,6 +1296,7 @@ void Comms::handle_res(gs_comms::setup::Set_Node_Input_Stream_Path_Res const& re
         QLOGE("Cannot handle node '{}' data: {}", res.get_node_data().get_name(), result.error().what());
         return;
     }
+    set_known_node(res.get_node_data().get_hash(), result.payload());
 
     sig_node_changed(result.extract_payload());
 }
@@ -1264,6 +1318,7 @@ void Comms::handle_res(gs_comms::setup::Set_Node_Config_Res const& res)
         QLOGE("Cannot handle node '{}' data: {}", res.get_node_data().get_name(), result.error().what());
         return;
     }
+    set_known_node(res.get_node_data().get_hash(), result.payload());
 
     sig_node_changed(result.extract_payload());
 }
@@ -1338,7 +1393,7 @@ ts::Result<std::shared_ptr<ts::IStruct_Value>> Comms::send_uav_descriptor(std::s
     gs_comms::setup::Set_UAV_Descriptor_Req req;
     req.set_req_id(++m_last_req_id);
 
-    req.set_data(encode_json(ts::sz::to_json(serialize_result.payload(), false)));
+    req.set_data(m_setup_codec.encode_value(serialize_result.payload()));
     request = req;
     serialize_and_send(SETUP_CHANNEL, request);
 
@@ -1409,6 +1464,7 @@ ts::Result<std::vector<Comms::Node>> Comms::request_nodes(std::chrono::high_reso
     gs_comms::setup::Brain_Req request;
     gs_comms::setup::Get_Nodes_Req req;
     req.set_req_id(++m_last_req_id);
+    add_known_nodes(req);
     request = req;
     serialize_and_send(SETUP_CHANNEL, request);
 
@@ -1473,7 +1529,7 @@ ts::Result<Comms::Node> Comms::add_node(std::string const& name,
     req.set_def_name(def_name);
     req.set_name(name);
 
-    req.set_descriptor_data(encode_json(ts::sz::to_json(serialize_result.payload(), false)));
+    req.set_descriptor_data(m_setup_codec.encode_value(serialize_result.payload()));
     request = req;
     serialize_and_send(SETUP_CHANNEL, request);
 
@@ -1678,7 +1734,7 @@ ts::Result<Comms::Node> Comms::set_node_config(std::string const& name,
     req.set_req_id(++m_last_req_id);
     req.set_name(name);
 
-    req.set_config_data(encode_json(ts::sz::to_json(serialize_result.payload(), false)));
+    req.set_config_data(m_setup_codec.encode_value(serialize_result.payload()));
     request = req;
     serialize_and_send(SETUP_CHANNEL, request);
 
@@ -1745,27 +1801,30 @@ void Comms::process()
     }
 
     Dispatch_Res_Visitor dispatcher(*this);
-    while (m_rcp->receive(SETUP_CHANNEL, m_setup_buffer))
+    util::comms::RCP::Received_Data received;
+    while (m_rcp->receive(SETUP_CHANNEL, received))
     {
-        const char* data = (const char*)m_setup_buffer.data();
-//        QLOGI("{}", std::string(data, data + m_setup_buffer.size()));
+//        QLOGI("{}", std::string((const char*)received.data, (const char*)received.data + received.size));
+
+        //the brain answers in json when it doesn't know our schema. The requests sent in binary are lost so ask again
+        if (m_setup_codec.get_format() == gs_comms::Setup_Format::BINARY &&
+                gs_comms::Setup_Codec::get_message_format(received.data, received.size) == gs_comms::Setup_Format::JSON)
+        {
+            QLOGW("The brain talks json, switching to it");
+            m_setup_codec.set_format(gs_comms::Setup_Format::JSON);
+            m_did_request_data = false;
+        }
 
-        auto parse_result = ts::sz::from_json(m_setup_buffer.data(), m_setup_buffer.size());
-        if (parse_result != ts::success)
+        silk::gs_comms::setup::Brain_Res res;
+        auto result = m_setup_codec.decode_message(res, received.data, received.size);
+        if (result != ts::success)
         {
-            QLOGE("Cannot parse setup req: {}", parse_result.error().what());
+            QLOGE("Cannot deserialize setup res: {}", result.error().what());
         }
         else
         {
-            silk::gs_comms::setup::Brain_Res res;
-            auto result = silk::gs_comms::deserialize(res, parse_result.payload());
-            if (result != ts::success)
-            {
-                QLOGE("Cannot deserialize setup res: {}", result.error().what());
-            }
             boost::apply_visitor(dispatcher, res);
         }
-        m_setup_buffer.clear();
     }
 
     while (m_telemetry_channel.get_next_message(*m_rcp))
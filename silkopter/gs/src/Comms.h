@@ -1,6 +1,7 @@
 #pragma once
 
 #include "common/Comm_Data.h"
+#include "common/comms/Setup_Codec.h"
 
 #include "common/stream/IAcceleration.h"
 #include "common/stream/IADC.h"
@@ -27,6 +28,8 @@
 #include "common/stream/IProximity.h"
 #include "common/stream/IMultirotor_Commands.h"
 #include "common/stream/IMultirotor_State.h"
+#include "common/stream/Telemetry_Codec.h"
+#include "common/stream/Stream_Type_Map.h"
 
 #include "utils/comms/RCP.h"
 #include "utils/comms/RCP_Channel.h"
@@ -47,6 +50,7 @@ namespace gs_comms
 namespace setup
 {
 class Node_Data;
+class Get_Nodes_Req;
 class Error;
 class Get_AST_Res;
 class Set_Clock_Res;
@@ -180,6 +184,8 @@ public:
         Samples samples;
     private:
         bool unpack(Telemetry_Channel& channel, size_t sample_count) override;
+        stream::Telemetry_Codec<Stream_T> m_codec;
+        std::vector<uint8_t> m_buffer;
     };
 
     boost::signals2::signal<void(ITelemetry_Stream const&)> sig_telemetry_samples_available;
@@ -189,13 +195,24 @@ public:
 
     struct Internal_Telementry_Sample
     {
+        struct Percentiles
+        {
+            q::Clock::duration p50;
+            q::Clock::duration p99;
+            q::Clock::duration p999;
+        };
+
         q::Clock::duration total_duration;
         q::Clock::duration max_total_duration;
+        Percentiles end_to_end_latency; //from sensor sample to actuator write
         struct Node
         {
             std::string name;
             q::Clock::duration duration;
             q::Clock::duration max_duration;
+            float call_rate = 0;
+            Percentiles process_duration;
+            Percentiles sample_age; //of the oldest sample consumed in each process call
         };
         std::vector<Node> nodes;
     };
@@ -220,7 +237,8 @@ private:
 
     void configure_channels();
 
-    std::map<stream::Type, std::unique_ptr<ITelemetry_Stream>> m_streams;
+    struct Telemetry_Stream_Factory;
+    stream::Stream_Type_Map<std::unique_ptr<ITelemetry_Stream>> m_streams;
 
     struct Dispatch_Res_Visitor;
     struct Dispatch_Req_Visitor;
@@ -236,11 +254,7 @@ private:
 
     uint32_t m_last_req_id = 0;
 
-    std::string const& decode_json(std::string const& json_base64);
-    std::string const& encode_json(std::string const& json);
-
-    std::vector<uint8_t> m_setup_buffer;
-    std::string m_base64_buffer;
+    gs_comms::Setup_Codec m_setup_codec;
 
     Telemetry_Channel m_telemetry_channel;
     void handle_telemetry_stream();
@@ -252,6 +266,22 @@ private:
     bool handle_uav_descriptor(std::string const& serialized_data);
     ts::Result<Node> handle_node_data(gs_comms::setup::Node_Data const& node_data);
 
+    //The last node received with each name. Its hash is sent back so the brain sends only what changed.
+    //The brain doesn't push changes on its own, the add/remove/config responses carry the node that changed
+    // and there is only one gs talking to it
+    struct Known_Node
+    {
+        uint32_t hash = 0;
+        Node node;
+    };
+    std::map<std::string, Known_Node> m_known_nodes;
+    void add_known_nodes(gs_comms::setup::Get_Nodes_Req& req) const;
+    void set_known_node(uint32_t hash, Node const& node);
+    void handle_nodes_res_error(gs_comms::setup::Get_Nodes_Res const& res, bool is_cache_error, std::string const& message);
+
+    //the values are edited in place by the ui so everyone gets their own copy
+    ts::Result<Node> copy_node(Node const& node) const;
+
     void handle_res(gs_comms::setup::Error const& res);
     void handle_res(gs_comms::setup::Get_AST_Res const& res);
     void handle_res(gs_comms::setup::Set_Clock_Res const& res);
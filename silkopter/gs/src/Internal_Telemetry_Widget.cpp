@@ -67,12 +67,34 @@ void Internal_Telemetry_Widget::init(silk::Comms& comms, std::vector<std::string
     Numeric_Viewer_Widget* max_widget = new Numeric_Viewer_Widget(this);
     max_widget->init("max", 10, false);
 
+    Numeric_Viewer_Widget* p99_widget = new Numeric_Viewer_Widget(this);
+    p99_widget->init("p99", 10, false);
+
+    Numeric_Viewer_Widget* p999_widget = new Numeric_Viewer_Widget(this);
+    p999_widget->init("p999", 10, false);
+
+    Numeric_Viewer_Widget* sample_age_widget = new Numeric_Viewer_Widget(this);
+    sample_age_widget->init("sample age p99", 10, false);
+
+    Numeric_Viewer_Widget* call_rate_widget = new Numeric_Viewer_Widget(this);
+    call_rate_widget->init("calls", 10, false);
+
+    Numeric_Viewer_Widget* end_to_end_widget = new Numeric_Viewer_Widget(this);
+    end_to_end_widget->init("end to end latency", 10, false);
+    end_to_end_widget->add_graph("p50", "s", QColor(0, 117, 220));
+    end_to_end_widget->add_graph("p99", "s", QColor(255, 164, 5));
+    end_to_end_widget->add_graph("p999", "s", QColor(255, 0, 16));
+
     uint32_t index = 0;
     for (std::string const& node_name: node_names)
     {
         RGB rgb = palette[index % palette.size()];
         widget->add_graph(node_name, "s", QColor(rgb.r, rgb.g, rgb.b));
         max_widget->add_graph(node_name, "s", QColor(rgb.r, rgb.g, rgb.b));
+        p99_widget->add_graph(node_name, "s", QColor(rgb.r, rgb.g, rgb.b));
+        p999_widget->add_graph(node_name, "s", QColor(rgb.r, rgb.g, rgb.b));
+        sample_age_widget->add_graph(node_name, "s", QColor(rgb.r, rgb.g, rgb.b));
+        call_rate_widget->add_graph(node_name, "Hz", QColor(rgb.r, rgb.g, rgb.b));
         m_node_indices[node_name] = index;
         index++;
     }
@@ -81,37 +103,56 @@ void Internal_Telemetry_Widget::init(silk::Comms& comms, std::vector<std::string
     layout()->setMargin(0);
     layout()->addWidget(widget);
     layout()->addWidget(max_widget);
+    layout()->addWidget(p99_widget);
+    layout()->addWidget(p999_widget);
+    layout()->addWidget(sample_age_widget);
+    layout()->addWidget(call_rate_widget);
+    layout()->addWidget(end_to_end_widget);
 
-    m_connection = m_comms->sig_internal_telemetry_samples_available.connect([this, widget, max_widget](std::vector<silk::Comms::Internal_Telementry_Sample> const& samples)
+    auto to_seconds = [](q::Clock::duration d)
     {
-        for (silk::Comms::Internal_Telementry_Sample const& sample: samples)
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count() / 1000000.f;
+    };
+
+    m_connection = m_comms->sig_internal_telemetry_samples_available.connect([=](std::vector<silk::Comms::Internal_Telementry_Sample> const& samples)
+    {
+        typedef silk::Comms::Internal_Telementry_Sample::Node Node;
+        auto add_node_samples = [this](silk::Comms::Internal_Telementry_Sample const& sample, Numeric_Viewer_Widget* w, std::function<float(Node const&)> const& getter)
         {
             m_data.clear(); //to rest everything to 0
-            m_data.resize(std::min(m_node_count, sample.nodes.size()));
+            m_data.resize(m_node_count);
             for (size_t i = 0; i < sample.nodes.size(); i++)
             {
                 auto it = m_node_indices.find(sample.nodes[i].name);
                 if (it != m_node_indices.end())
                 {
-                    m_data[it->second] = std::chrono::duration_cast<std::chrono::microseconds>(sample.nodes[i].duration).count() / 1000000.f;
+                    m_data[it->second] = getter(sample.nodes[i]);
                 }
             }
-            widget->add_samples(m_data.data(), true);
+            w->add_samples(m_data.data(), true);
+        };
 
-            m_data.clear(); //to rest everything to 0
-            m_data.resize(std::min(m_node_count, sample.nodes.size()));
-            for (size_t i = 0; i < sample.nodes.size(); i++)
-            {
-                auto it = m_node_indices.find(sample.nodes[i].name);
-                if (it != m_node_indices.end())
-                {
-                    m_data[it->second] = std::chrono::duration_cast<std::chrono::microseconds>(sample.nodes[i].max_duration).count() / 1000000.f;
-                }
-            }
-            max_widget->add_samples(m_data.data(), true);
+        for (silk::Comms::Internal_Telementry_Sample const& sample: samples)
+        {
+            add_node_samples(sample, widget, [&](Node const& node) { return to_seconds(node.duration); });
+            add_node_samples(sample, max_widget, [&](Node const& node) { return to_seconds(node.max_duration); });
+            add_node_samples(sample, p99_widget, [&](Node const& node) { return to_seconds(node.process_duration.p99); });
+            add_node_samples(sample, p999_widget, [&](Node const& node) { return to_seconds(node.process_duration.p999); });
+            add_node_samples(sample, sample_age_widget, [&](Node const& node) { return to_seconds(node.sample_age.p99); });
+            add_node_samples(sample, call_rate_widget, [](Node const& node) { return node.call_rate; });
+
+            float end_to_end[3] = { to_seconds(sample.end_to_end_latency.p50),
+                                    to_seconds(sample.end_to_end_latency.p99),
+                                    to_seconds(sample.end_to_end_latency.p999) };
+            end_to_end_widget->add_samples(end_to_end, true);
         }
 
         widget->process();
         max_widget->process();
+        p99_widget->process();
+        p999_widget->process();
+        sample_age_widget->process();
+        call_rate_widget->process();
+        end_to_end_widget->process();
     });
 }
@@ -1,5 +1,6 @@
 #include "Stream_Viewer_Window.h"
 #include "Comms.h"
+#include "common/stream/Stream_Type_Map.h"
 
 #include "stream_viewers/Acceleration_Stream_Viewer_Widget.h"
 #include "stream_viewers/ADC_Stream_Viewer_Widget.h"
@@ -27,6 +28,58 @@
 #include "stream_viewers/Video_Stream_Viewer_Widget.h"
 #include "stream_viewers/Voltage_Stream_Viewer_Widget.h"
 
+namespace
+{
+
+//The viewer of each semantic. Semantics without one have no viewer
+template<silk::stream::Semantic> struct Viewer_Widget { typedef void type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::ACCELERATION> { typedef Acceleration_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::ADC> { typedef ADC_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::ANGULAR_VELOCITY> { typedef Angular_Velocity_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::BATTERY_STATE> { typedef Battery_State_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::BOOL> { typedef Bool_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::CURRENT> { typedef Current_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::DISTANCE> { typedef Distance_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::FLOAT> { typedef Float_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::FORCE> { typedef Force_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::FRAME> { typedef Frame_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::GPS_INFO> { typedef GPS_Info_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::LINEAR_ACCELERATION> { typedef Linear_Acceleration_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::MAGNETIC_FIELD> { typedef Magnetic_Field_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::MULTIROTOR_COMMANDS> { typedef Multirotor_Commands_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::MULTIROTOR_STATE> { typedef Multirotor_State_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::POSITION> { typedef Position_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::PRESSURE> { typedef Pressure_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::PROXIMITY> { typedef Proximity_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::PWM> { typedef PWM_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::TEMPERATURE> { typedef Temperature_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::TORQUE> { typedef Torque_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::THROTTLE> { typedef Throttle_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::VELOCITY> { typedef Velocity_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::VIDEO> { typedef Video_Stream_Viewer_Widget type; };
+template<> struct Viewer_Widget<silk::stream::Semantic::VOLTAGE> { typedef Voltage_Stream_Viewer_Widget type; };
+
+typedef IStream_Viewer_Widget* (*Create_Viewer)(QWidget* parent);
+
+template<class Widget> IStream_Viewer_Widget* create_viewer(QWidget* parent)
+{
+    return new Widget(parent);
+}
+template<> IStream_Viewer_Widget* create_viewer<void>(QWidget*)
+{
+    return nullptr;
+}
+
+struct Viewer_Factory
+{
+    template<class Stream> auto create() -> Create_Viewer
+    {
+        return &create_viewer<typename Viewer_Widget<Stream::TYPE.get_semantic()>::type>;
+    }
+};
+
+}
+
 Stream_Viewer_Window::Stream_Viewer_Window(QWidget* parent)
     : QWidget(parent)
 {
@@ -43,35 +96,9 @@ void Stream_Viewer_Window::init(silk::Comms& comms, std::string const& stream_pa
 
     setWindowTitle(("Stream - " + m_stream_path).c_str());
 
-    IStream_Viewer_Widget* viewer = nullptr;
-    switch (m_stream_type.get_semantic())
-    {
-    case silk::stream::Semantic::ACCELERATION: viewer = new Acceleration_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::ADC: viewer = new ADC_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::ANGULAR_VELOCITY: viewer = new Angular_Velocity_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::BATTERY_STATE: viewer = new Battery_State_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::BOOL: viewer = new Bool_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::CURRENT: viewer = new Current_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::DISTANCE: viewer = new Distance_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::FLOAT: viewer = new Float_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::FORCE: viewer = new Force_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::FRAME: viewer = new Frame_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::GPS_INFO: viewer = new GPS_Info_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::LINEAR_ACCELERATION: viewer = new Linear_Acceleration_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::MAGNETIC_FIELD: viewer = new Magnetic_Field_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::MULTIROTOR_COMMANDS: viewer = new Multirotor_Commands_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::MULTIROTOR_STATE: viewer = new Multirotor_State_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::POSITION: viewer = new Position_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::PRESSURE: viewer = new Pressure_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::PROXIMITY: viewer = new Proximity_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::PWM: viewer = new PWM_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::TEMPERATURE: viewer = new Temperature_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::TORQUE: viewer = new Torque_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::THROTTLE: viewer = new Throttle_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::VELOCITY: viewer = new Velocity_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::VIDEO: viewer = new Video_Stream_Viewer_Widget(this); break;
-    case silk::stream::Semantic::VOLTAGE: viewer = new Voltage_Stream_Viewer_Widget(this); break;
-    }
+    static const silk::stream::Stream_Type_Map<Create_Viewer> s_viewers((Viewer_Factory()));
+    Create_Viewer const* create = s_viewers.find(m_stream_type);
+    IStream_Viewer_Widget* viewer = create ? (*create)(this) : nullptr;
 
     if (viewer)
     {
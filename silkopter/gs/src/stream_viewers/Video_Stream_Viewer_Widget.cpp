@@ -14,6 +14,9 @@ Video_Stream_Viewer_Widget::Video_Stream_Viewer_Widget(QWidget* parent)
 
 Video_Stream_Viewer_Widget::~Video_Stream_Viewer_Widget()
 {
+    //no more repaint requests from the decode thread
+    m_decoder.shutdown();
+
     auto result = m_comms->set_stream_telemetry_enabled(m_stream_path, false);
     if (result != ts::success)
     {
@@ -28,6 +31,23 @@ void Video_Stream_Viewer_Widget::init(silk::Comms& comms, std::string const& str
     stats_widget->init("x", m_stream_rate);
 
     stats_widget->add_graph("Frame Size", "KB", QColor(0xe74c3c));
+    stats_widget->add_graph("Receive To Present", "ms", QColor(0x3498db));
+    stats_widget->add_graph("Decode To Present", "ms", QColor(0x2ecc71));
+    stats_widget->add_graph("Dropped", "chunks", QColor(0xf1c40f));
+
+    //FPV, latency matters more than tearing
+    Video_Decoder::Descriptor descriptor;
+    descriptor.format = Video_Decoder::Format::BGRA;
+    descriptor.low_latency = true;
+    if (!m_decoder.init(descriptor))
+    {
+        QLOGE("Cannot initialize the video decoder");
+    }
+    m_decoder.on_frame_ready = [this]()
+    {
+        //from the decode thread
+        QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection);
+    };
 
     m_comms = &comms;
     m_stream_path = stream_path;
@@ -46,24 +66,17 @@ void Video_Stream_Viewer_Widget::init(silk::Comms& comms, std::string const& str
             {
                 for (silk::stream::IVideo::Sample const& sample: stream->samples)
                 {
-                    float values[1] = { static_cast<float>(sample.value.data.size()) / 1024.f };
-                    stats_widget->add_samples(values, true);
+                    m_decoder.add_chunk(sample.value);
 
-                    float ar = (float)sample.value.resolution.x / sample.value.resolution.y;
-                    int img_w = math::max(16, width());
-                    int img_h = img_w / ar;
-                    if (img_h > height())
+                    Video_Decoder::Stats stats = m_decoder.get_stats();
+                    float values[4] =
                     {
-                        img_h = height();
-                        img_w = img_h * ar;
-                    }
-
-                    if (m_decoder.decode_frame(sample.value, math::vec2u32(img_w, img_h), m_data, Video_Decoder::Format::BGRA))
-                    {
-                        m_image = QImage(m_data.data(), img_w, img_h, QImage::Format_ARGB32_Premultiplied);
-                        m_image_flipped = m_image;//.mirrored(false, false);
-                        update();
-                    }
+                        static_cast<float>(sample.value.data.size()) / 1024.f,
+                        std::chrono::duration<float, std::milli>(stats.receive_to_present).count(),
+                        std::chrono::duration<float, std::milli>(stats.decode_to_present).count(),
+                        static_cast<float>(stats.dropped_chunks),
+                    };
+                    stats_widget->add_samples(values, true);
                 }
                 stats_widget->process();
             }
@@ -73,8 +86,14 @@ void Video_Stream_Viewer_Widget::init(silk::Comms& comms, std::string const& str
 
 void Video_Stream_Viewer_Widget::paintEvent(QPaintEvent* ev)
 {
+    m_decoder.set_max_output_size(math::vec2u32(math::max(16, width()), math::max(16, height())));
+    if (m_decoder.acquire_frame(m_data, m_data_size))
+    {
+        m_image = QImage(m_data.data(), m_data_size.x, m_data_size.y, QImage::Format_ARGB32_Premultiplied);
+    }
+
     m_painter.begin(this);
     m_painter.setCompositionMode(QPainter::CompositionMode_Source);
-    m_painter.drawImage(QRectF(0, 0, m_image.width(), m_image.height()), m_image_flipped);
+    m_painter.drawImage(QRectF(0, 0, m_image.width(), m_image.height()), m_image);
     m_painter.end();
 }
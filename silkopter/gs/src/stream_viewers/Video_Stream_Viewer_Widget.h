@@ -32,6 +32,6 @@ private:
     Video_Decoder m_decoder;
     QPainter m_painter;
     QImage m_image;
-    QImage m_image_flipped;
     std::vector<uint8_t> m_data;
+    math::vec2u32 m_data_size;
 };
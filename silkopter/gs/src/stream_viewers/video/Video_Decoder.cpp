@@ -17,6 +17,48 @@ extern "C"
 
 bool Video_Decoder::s_codecs_registered = false;
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+//Looks at the NAL headers of an annex B chunk. Bytes before the first start code belong to the last NAL of the previous chunk
+static void parse_chunk(uint8_t const* data, size_t size, bool& last_nal_is_reference, bool& has_reference, bool& has_keyframe)
+{
+    has_reference = false;
+    has_keyframe = false;
+
+    bool starts_with_nal = false;
+    for (size_t i = 0; i + 3 < size; i++)
+    {
+        if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1)
+        {
+            continue;
+        }
+        //the 4 byte start code has an extra zero in front
+        if (i == 0 || (i == 1 && data[0] == 0))
+        {
+            starts_with_nal = true;
+        }
+        else if (!starts_with_nal && !has_reference)
+        {
+            has_reference = last_nal_is_reference;
+        }
+        starts_with_nal = true;
+
+        uint8_t header = data[i + 3];
+        uint8_t type = header & 0x1F;
+        last_nal_is_reference = (header & 0x60) != 0; //nal_ref_idc
+        has_reference |= last_nal_is_reference;
+        has_keyframe |= (type == 5 || type == 7); //IDR slice or SPS
+        i += 3;
+    }
+
+    if (!starts_with_nal)
+    {
+        has_reference = last_nal_is_reference;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 Video_Decoder::Video_Decoder()
 {
 #if !defined RASPBERRY_PI
@@ -25,20 +67,57 @@ Video_Decoder::Video_Decoder()
         av_register_all();
         avcodec_register_all();
         avformat_network_init();
+        s_codecs_registered = true;
     }
+#endif
+}
+
+Video_Decoder::~Video_Decoder()
+{
+    shutdown();
+
+#if !defined RASPBERRY_PI
+    sws_freeContext(m_ffmpeg.sws_context);
+    m_ffmpeg.sws_context = nullptr;
+
+    if (m_ffmpeg.frame_yuv)
+    {
+        av_frame_free(&m_ffmpeg.frame_yuv);
+    }
+    if (m_ffmpeg.context)
+    {
+        avcodec_close(m_ffmpeg.context);
+        avcodec_free_context(&m_ffmpeg.context);
+    }
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto Video_Decoder::init(Descriptor const& descriptor) -> bool
+{
+#if !defined RASPBERRY_PI
+    QASSERT(!m_ffmpeg.context);
+    if (m_ffmpeg.context)
+    {
+        return false;
+    }
+
+    m_descriptor = descriptor;
+    m_descriptor.max_queued_chunks = std::max<size_t>(m_descriptor.max_queued_chunks, 1);
 
     m_ffmpeg.codec = avcodec_find_decoder(AV_CODEC_ID_H264);
     if (!m_ffmpeg.codec)
     {
         QLOGE("Codec not found");
-        exit(1);
+        return false;
     }
 
     m_ffmpeg.context = avcodec_alloc_context3(m_ffmpeg.codec);
     if (!m_ffmpeg.context)
     {
         QLOGE("Could not allocate video codec context");
-        exit(1);
+        return false;
     }
 
     avcodec_get_context_defaults3(m_ffmpeg.context, m_ffmpeg.codec);
@@ -46,106 +125,370 @@ Video_Decoder::Video_Decoder()
     m_ffmpeg.context->flags |= CODEC_FLAG_LOW_DELAY;
     m_ffmpeg.context->flags2 |= CODEC_FLAG2_CHUNKS;
 
-    //m_ffmpeg.context->thread_count = 4;
-    //m_ffmpeg.context->thread_type = FF_THREAD_SLICE;
-    //m_ffmpeg.context->strict_std_compliance = FF_COMPLIANCE_EXPERIMENTAL;
-
-    // 	m_ffmpeg.context->profile = FF_PROFILE_H264_BASELINE;
+    //Frame threading adds a frame of latency per thread and doesn't report the slices
+    m_ffmpeg.context->thread_count = 1;
+    if (m_descriptor.low_latency)
+    {
+        m_ffmpeg.context->opaque = this;
+        m_ffmpeg.context->draw_horiz_band = &Video_Decoder::draw_horiz_band;
+        m_ffmpeg.context->slice_flags = SLICE_FLAG_CODED_ORDER | SLICE_FLAG_ALLOW_FIELD;
+    }
 
     if (avcodec_open2(m_ffmpeg.context, m_ffmpeg.codec, nullptr) < 0)
     {
         QLOGE("Could not open codec");
-        exit(1);
+        return false;
     }
 
     m_ffmpeg.frame_yuv = av_frame_alloc();
     if (!m_ffmpeg.frame_yuv)
     {
         QLOGE("Could not allocate video frame");
-        exit(1);
+        return false;
     }
 
-    m_ffmpeg.frame_rgb = av_frame_alloc();
-    if (!m_ffmpeg.frame_rgb)
+    m_exit = false;
+    m_thread = std::thread(&Video_Decoder::decode_thread_proc, this);
+    return true;
+#else
+    return false;
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::shutdown()
+{
     {
-        QLOGE("Could not allocate video frame");
-        exit(1);
+        std::lock_guard<std::mutex> lg(m_queue_mutex);
+        m_exit = true;
+    }
+    m_queue_cv.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::set_max_output_size(math::vec2u32 const& size)
+{
+    std::lock_guard<std::mutex> lg(m_output_mutex);
+    m_max_output_size = size;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::add_chunk(silk::stream::IVideo::Value const& value)
+{
+    if (value.data.empty())
+    {
+        return;
+    }
+
+    Chunk chunk;
+    chunk.received_tp = q::Clock::now();
+    parse_chunk(value.data.data(), value.data.size(), m_last_nal_is_reference, chunk.has_reference, chunk.has_keyframe);
+
+    size_t dropped_chunks = 0;
+    {
+        std::lock_guard<std::mutex> lg(m_queue_mutex);
+        if (!m_free_buffers.empty())
+        {
+            chunk.data = std::move(m_free_buffers.back());
+            m_free_buffers.pop_back();
+        }
+        chunk.data.assign(value.data.begin(), value.data.end());
+
+        //the decoder cannot keep up, the oldest data is the least useful
+        while (m_queue.size() >= m_descriptor.max_queued_chunks)
+        {
+            m_free_buffers.push_back(std::move(m_queue.front().data));
+            m_queue.pop_front();
+            dropped_chunks++;
+        }
+        m_queue.push_back(std::move(chunk));
+    }
+    m_queue_cv.notify_one();
+
+    std::lock_guard<std::mutex> lg(m_output_mutex);
+    m_stats.received_chunks++;
+    m_stats.dropped_chunks += dropped_chunks;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto Video_Decoder::skip_late_chunks() -> size_t
+{
+    //Way behind - no point in decoding a backlog the user will never see.
+    //Restart from the newest keyframe in the queue, if there is one
+    if (m_queue.empty() || q::Clock::now() - m_queue.front().received_tp < m_descriptor.max_latency * 2)
+    {
+        return 0;
+    }
+
+    size_t keyframe_idx = 0;
+    for (size_t i = m_queue.size(); i > 1; i--)
+    {
+        if (m_queue[i - 1].has_keyframe)
+        {
+            keyframe_idx = i - 1;
+            break;
+        }
+    }
+
+    for (size_t i = 0; i < keyframe_idx; i++)
+    {
+        m_free_buffers.push_back(std::move(m_queue.front().data));
+        m_queue.pop_front();
+    }
+    if (keyframe_idx > 0)
+    {
+        //whatever was decoded of the current frame is useless now
+        m_has_frame_start = false;
     }
+    return keyframe_idx;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::recycle_chunk(Chunk& chunk)
+{
+    std::lock_guard<std::mutex> lg(m_queue_mutex);
+    m_free_buffers.push_back(std::move(chunk.data));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::decode_thread_proc()
+{
+    while (true)
+    {
+        Chunk chunk;
+        size_t dropped_chunks = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_queue_cv.wait(lock, [this] { return m_exit || !m_queue.empty(); });
+            if (m_exit)
+            {
+                break;
+            }
+
+            dropped_chunks = skip_late_chunks();
+            chunk = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        //Late data that nothing references can go without any artifacts
+        bool is_late = q::Clock::now() - chunk.received_tp > m_descriptor.max_latency;
+        if (is_late && !chunk.has_reference)
+        {
+            dropped_chunks++;
+        }
+        else
+        {
+            decode_chunk(chunk);
+        }
+        recycle_chunk(chunk);
 
-    m_ffmpeg.rgb.reset(new AVPicture);
-    m_ffmpeg.rgb->linesize[0] = 0;
-    m_ffmpeg.rgb->data[0] = nullptr;
+        if (dropped_chunks > 0)
+        {
+            std::lock_guard<std::mutex> lg(m_output_mutex);
+            m_stats.dropped_chunks += dropped_chunks;
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto Video_Decoder::compute_output_size(int frame_w, int frame_h) const -> math::vec2u32
+{
+    math::vec2u32 max_size;
+    {
+        std::lock_guard<std::mutex> lg(m_output_mutex);
+        max_size = m_max_output_size;
+    }
+
+    float ar = static_cast<float>(frame_w) / static_cast<float>(math::max(frame_h, 1));
+    uint32_t w = math::max(16u, max_size.x);
+    uint32_t h = static_cast<uint32_t>(w / ar);
+    if (h > max_size.y)
+    {
+        h = math::max(16u, max_size.y);
+        w = static_cast<uint32_t>(h * ar);
+    }
+    return math::vec2u32(math::max(w, 2u), math::max(h, 2u));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Video_Decoder::prepare_scaler(int frame_w, int frame_h, math::vec2u32 const& output_size)
+{
+#if !defined RASPBERRY_PI
+    m_ffmpeg.sws_context = sws_getCachedContext(m_ffmpeg.sws_context,
+                                                frame_w, frame_h,
+                                                m_ffmpeg.context->pix_fmt,
+                                                output_size.x, output_size.y,
+                                                m_descriptor.format == Format::BGRA ? AV_PIX_FMT_RGB32 : AV_PIX_FMT_BGR32, //inverted for some reason
+                                                SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+    return m_ffmpeg.sws_context != nullptr;
+#else
+    return false;
 #endif
 }
 
-Video_Decoder::~Video_Decoder()
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Decoder::draw_horiz_band(AVCodecContext* context, AVFrame const* src, int offset[], int y, int /*type*/, int height)
 {
 #if !defined RASPBERRY_PI
-    m_ffmpeg.rgb.reset();
-    sws_freeContext(m_ffmpeg.sws_context);
-    m_ffmpeg.sws_context = nullptr;
+    Video_Decoder* self = reinterpret_cast<Video_Decoder*>(context->opaque);
+    QASSERT(self);
+    if (!src || height <= 0)
+    {
+        return;
+    }
+
+    //a new frame. The scaler needs the slices in order, starting from the top
+    if (y == 0)
+    {
+        self->m_decode_size = self->compute_output_size(context->width, context->height);
+        self->m_is_band_frame_valid = self->prepare_scaler(context->width, context->height, self->m_decode_size);
+    }
+    if (!self->m_is_band_frame_valid)
+    {
+        return;
+    }
+
+    uint8_t const* planes[4] = { src->data[0] + offset[0], src->data[1] + offset[1], src->data[2] + offset[2], nullptr };
+
+    {
+        std::lock_guard<std::mutex> lg(self->m_output_mutex);
+
+        math::vec2u32 const& size = self->m_decode_size;
+        if (self->m_output_size != size)
+        {
+            self->m_output_size = size;
+            self->m_output_data.resize(size.x * size.y * 4);
+        }
+
+        uint8_t* dst[4] = { self->m_output_data.data(), nullptr, nullptr, nullptr };
+        int dst_line_size[4] = { static_cast<int>(size.x * 4), 0, 0, 0 };
+        sws_scale(self->m_ffmpeg.sws_context, planes, src->linesize, y, height, dst, dst_line_size);
+
+        self->m_has_new_output = true;
+        self->m_output_received_tp = self->m_frame_received_tp;
+        self->m_output_decoded_tp = q::Clock::now();
+    }
 
-    av_frame_free(&m_ffmpeg.frame_rgb);
-    av_frame_free(&m_ffmpeg.frame_yuv);
-    avcodec_close(m_ffmpeg.context);
-    avcodec_free_context(&m_ffmpeg.context);
+    if (self->on_frame_ready)
+    {
+        self->on_frame_ready();
+    }
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
-bool Video_Decoder::decode_frame(silk::stream::IVideo::Value const& frame, math::vec2u32 const& size, std::vector<uint8_t>& data, Format format)
+void Video_Decoder::decode_chunk(Chunk const& chunk)
 {
 #if !defined RASPBERRY_PI
+    if (!m_has_frame_start)
+    {
+        m_has_frame_start = true;
+        m_frame_received_tp = chunk.received_tp;
+    }
+
     AVPacket packet;
     av_init_packet(&packet);
 
     packet.pts = AV_NOPTS_VALUE;
     packet.dts = AV_NOPTS_VALUE;
-    packet.data = const_cast<uint8_t*>(frame.data.data());
-    packet.size = frame.data.size();
+    packet.data = const_cast<uint8_t*>(chunk.data.data());
+    packet.size = chunk.data.size();
 
     int got_frame = 0;
     int len = avcodec_decode_video2(m_ffmpeg.context, m_ffmpeg.frame_yuv, &got_frame, &packet);
     if (len < 0)
     {
         QLOGW("Error while decoding frame");
-        return false;
+        return;
     }
-    if (got_frame)
+    if (!got_frame)
+    {
+        return;
+    }
+    m_has_frame_start = false;
+
+    q::Clock::time_point decoded_tp = q::Clock::now();
+
+    //in low latency mode the slices are already out
+    if (!m_descriptor.low_latency)
     {
         int frame_w = m_ffmpeg.frame_yuv->width;
         int frame_h = m_ffmpeg.frame_yuv->height;
+        math::vec2u32 size = compute_output_size(frame_w, frame_h);
+        if (!prepare_scaler(frame_w, frame_h, size))
+        {
+            return;
+        }
 
-        m_ffmpeg.sws_context = sws_getCachedContext(m_ffmpeg.sws_context,
-                                                    frame_w, frame_h,
-                                                    m_ffmpeg.context->pix_fmt,
-                                                    size.x, size.y,
-                                                    format == Format::BGRA ? AV_PIX_FMT_RGB32 : AV_PIX_FMT_BGR32, //inverted for some reason
-                                                    SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+        m_decode_data.resize(size.x * size.y * 4);
+        uint8_t* dst[4] = { m_decode_data.data(), nullptr, nullptr, nullptr };
+        int dst_line_size[4] = { static_cast<int>(size.x * 4), 0, 0, 0 };
+        sws_scale(m_ffmpeg.sws_context,
+                  m_ffmpeg.frame_yuv->data, m_ffmpeg.frame_yuv->linesize,
+                  0, frame_h,
+                  dst, dst_line_size);
 
-        if (m_ffmpeg.sws_context)
-        {
-            int line_size = static_cast<int>(size.x * 4);
-            if (line_size != m_ffmpeg.rgb->linesize[0])
-            {
-                m_ffmpeg.rgb->linesize[0] = line_size;
-                data.resize(line_size * size.y);
-//                delete[] m_ffmpeg.rgb->data[0];
-//                m_ffmpeg.rgb->data[0] = new uint8_t[(m_ffmpeg.rgb->linesize[0] + 1) * (img_h + 1)];
-                m_ffmpeg.rgb->data[0] = data.data();
-            }
+        //if the previous one was not presented it's replaced
+        std::lock_guard<std::mutex> lg(m_output_mutex);
+        std::swap(m_output_data, m_decode_data);
+        m_output_size = size;
+        m_has_new_output = true;
+        m_output_received_tp = m_frame_received_tp;
+        m_output_decoded_tp = decoded_tp;
+    }
 
-            sws_scale(m_ffmpeg.sws_context,
-                      m_ffmpeg.frame_yuv->data, m_ffmpeg.frame_yuv->linesize,
-                      0, frame_h,
-                      m_ffmpeg.rgb->data, m_ffmpeg.rgb->linesize);
+    {
+        std::lock_guard<std::mutex> lg(m_output_mutex);
+        m_stats.decoded_frames++;
+    }
 
-            return true;
-        }
+    if (!m_descriptor.low_latency && on_frame_ready)
+    {
+        on_frame_ready();
     }
-    return false;
-#else
-    return false;
 #endif
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Video_Decoder::acquire_frame(std::vector<uint8_t>& data, math::vec2u32& size)
+{
+    std::lock_guard<std::mutex> lg(m_output_mutex);
+    if (!m_has_new_output)
+    {
+        return false;
+    }
+    m_has_new_output = false;
+
+    data = m_output_data;
+    size = m_output_size;
+
+    auto now = q::Clock::now();
+    m_stats.presented_frames++;
+    m_stats.receive_to_decode = m_output_decoded_tp - m_output_received_tp;
+    m_stats.decode_to_present = now - m_output_decoded_tp;
+    m_stats.receive_to_present = now - m_output_received_tp;
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+auto Video_Decoder::get_stats() const -> Stats
+{
+    std::lock_guard<std::mutex> lg(m_output_mutex);
+    return m_stats;
+}
@@ -2,16 +2,24 @@
 
 #include "Comms.h"
 
+#include <thread>
+#include <condition_variable>
+
 extern "C"
 {
 struct AVCodec;
 struct AVCodecContext;
 struct SwsContext;
 struct AVFrame;
-struct AVPicture;
 }
 
-
+//Decodes the h264 chunks of a video stream on its own thread.
+//
+//The chunks go in a bounded queue and are stamped when they arrive. When a chunk waited longer than max_latency
+// it's dropped if nothing references it, and when the queue is way behind everything up to the newest keyframe is skipped.
+//Only the newest decoded frame is kept for presenting, the UI picks it up with acquire_frame.
+//In low latency mode the slices are converted and presented as soon as they are decoded so the top of the frame
+// shows up before the bottom is received.
 class Video_Decoder : q::util::Noncopyable
 {
 public:
@@ -24,18 +32,98 @@ public:
         BGRA
     };
 
-    bool decode_frame(silk::stream::IVideo::Value const& frame, math::vec2u32 const& size, std::vector<uint8_t>& out_data, Format format);
+    struct Descriptor
+    {
+        Format format = Format::BGRA;
+        bool low_latency = false;
+        q::Clock::duration max_latency = std::chrono::milliseconds(100);
+        size_t max_queued_chunks = 256;
+    };
+
+    auto init(Descriptor const& descriptor) -> bool;
+
+    //Stops the decode thread. No more on_frame_ready calls after this
+    void shutdown();
+
+    //Called from the decode thread when there's something new to present
+    std::function<void()> on_frame_ready;
+
+    //The frame is scaled to fit this, keeping the aspect ratio
+    void set_max_output_size(math::vec2u32 const& size);
+
+    void add_chunk(silk::stream::IVideo::Value const& chunk);
+
+    //Copies the newest frame, if there's a new one since the last call
+    bool acquire_frame(std::vector<uint8_t>& data, math::vec2u32& size);
+
+    struct Stats
+    {
+        size_t received_chunks = 0;
+        size_t dropped_chunks = 0;
+        size_t decoded_frames = 0;
+        size_t presented_frames = 0;
+
+        //of the last presented frame. Received is when its first chunk arrived
+        q::Clock::duration receive_to_decode = q::Clock::duration::zero();
+        q::Clock::duration decode_to_present = q::Clock::duration::zero();
+        q::Clock::duration receive_to_present = q::Clock::duration::zero();
+    };
+    auto get_stats() const -> Stats;
 
 private:
+    struct Chunk
+    {
+        q::Clock::time_point received_tp;
+        bool has_reference = true; //something else might need it to decode
+        bool has_keyframe = false; //IDR or SPS, the decoder can restart from here
+        std::vector<uint8_t> data;
+    };
+
+    void decode_thread_proc();
+    void decode_chunk(Chunk const& chunk);
+    auto skip_late_chunks() -> size_t;
+    void recycle_chunk(Chunk& chunk);
+    auto compute_output_size(int frame_w, int frame_h) const -> math::vec2u32;
+    bool prepare_scaler(int frame_w, int frame_h, math::vec2u32 const& output_size);
+
+    static void draw_horiz_band(AVCodecContext* context, AVFrame const* src, int offset[], int y, int type, int height);
+
     static bool s_codecs_registered;
 
+    Descriptor m_descriptor;
+
     struct FFMPEG
     {
         AVCodec* codec = nullptr;
         AVCodecContext* context = nullptr;
         SwsContext* sws_context = nullptr;
         AVFrame* frame_yuv = nullptr;
-        AVFrame* frame_rgb = nullptr;
-        std::shared_ptr<AVPicture> rgb;
     } m_ffmpeg;
+
+    //input
+    bool m_last_nal_is_reference = true;
+    std::mutex m_queue_mutex;
+    std::condition_variable m_queue_cv;
+    std::deque<Chunk> m_queue;
+    std::vector<std::vector<uint8_t>> m_free_buffers;
+    bool m_exit = false;
+    std::thread m_thread;
+
+    //decode thread only
+    bool m_has_frame_start = false;
+    q::Clock::time_point m_frame_received_tp;
+    math::vec2u32 m_decode_size;
+    std::vector<uint8_t> m_decode_data;
+    bool m_is_band_frame_valid = false;
+
+    //output
+    mutable std::mutex m_output_mutex;
+    math::vec2u32 m_max_output_size = math::vec2u32(640, 480);
+    math::vec2u32 m_output_size;
+    std::vector<uint8_t> m_output_data;
+    bool m_has_new_output = false;
+    q::Clock::time_point m_output_received_tp;
+    q::Clock::time_point m_output_decoded_tp;
+
+    Stats m_stats;
 };
@@ -64,6 +64,7 @@ enum class Packet_Type : uint8_t
     MULTIROTOR_COMMANDS,
     MULTIROTOR_STATE,
     HOME,
+    VIDEO_LINK_STATS,
 };
 
 }
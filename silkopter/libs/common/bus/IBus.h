@@ -14,6 +14,19 @@ namespace silk
 namespace bus
 {
 
+//The state shared by all the asynchronous bus transactions.
+//Transactions are owned by the nodes and reused between submissions so the steady state doesn't allocate.
+//Either poll is_pending from the node or use the callback - not both.
+struct Async_Transaction
+{
+    std::atomic<bool> is_pending{false};
+    bool is_ok = false; //valid after completion
+    q::Clock::time_point completion_tp;
+
+    //optional, called on the bus thread after the transaction is executed. It can resubmit the transaction.
+    std::function<void()> callback;
+};
+
 class IBus : q::util::Noncopyable
 {
     DEFINE_RTTI_BASE_CLASS(IBus);
@@ -23,6 +23,73 @@ public:
     virtual auto read_register(uint8_t address, uint8_t reg, uint8_t* data, size_t size) -> bool = 0;
     virtual auto write_register(uint8_t address, uint8_t reg, uint8_t const* data, size_t size) -> bool = 0;
 
+    //A list of reads and writes executed back to back on the bus thread.
+    //The bus can merge several transactions in a single kernel call, using repeated starts between the messages.
+    struct Transaction : public Async_Transaction
+    {
+        struct Message
+        {
+            uint8_t address = 0;
+            bool is_read = false;
+            std::vector<uint8_t> data; //written, or filled when reading
+        };
+        std::vector<Message> messages; //only the first message_count are used, the rest are kept to avoid reallocations
+        size_t message_count = 0;
+
+        void clear()
+        {
+            message_count = 0;
+        }
+        //returns the index of the message
+        auto add_read(uint8_t address, size_t size) -> size_t
+        {
+            Message& m = add_message(address, true, size);
+            std::fill(m.data.begin(), m.data.end(), 0);
+            return message_count - 1;
+        }
+        auto add_write(uint8_t address, uint8_t const* data, size_t size) -> size_t
+        {
+            Message& m = add_message(address, false, size);
+            std::copy(data, data + size, m.data.begin());
+            return message_count - 1;
+        }
+        //returns the index of the read message
+        auto add_read_register(uint8_t address, uint8_t reg, size_t size) -> size_t
+        {
+            add_write(address, &reg, 1);
+            return add_read(address, size);
+        }
+        auto add_write_register(uint8_t address, uint8_t reg, uint8_t const* data, size_t size) -> size_t
+        {
+            Message& m = add_message(address, false, size + 1);
+            m.data[0] = reg;
+            std::copy(data, data + size, m.data.begin() + 1);
+            return message_count - 1;
+        }
+        auto get_data(size_t idx) const -> uint8_t const*
+        {
+            QASSERT(idx < message_count);
+            return messages[idx].data.data();
+        }
+
+    private:
+        auto add_message(uint8_t address, bool is_read, size_t size) -> Message&
+        {
+            if (message_count >= messages.size())
+            {
+                messages.resize(message_count + 1);
+            }
+            Message& m = messages[message_count++];
+            m.address = address;
+            m.is_read = is_read;
+            m.data.resize(size);
+            return m;
+        }
+    };
+
+    //Queues the transaction for the bus thread. Fails if the transaction is still pending.
+    virtual auto submit(std::shared_ptr<Transaction> const& transaction) -> bool = 0;
+
     //convenience method
     auto read_register_u16(uint8_t address, uint8_t reg, uint16_t& dst) -> bool
     {
@@ -20,6 +20,65 @@ public:
     virtual auto transfer(uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool = 0;
     virtual auto transfer_register(uint8_t reg, uint8_t const* tx_data, uint8_t* rx_data, size_t size, uint32_t speed = 0) -> bool = 0;
 
+    //A list of transfers executed back to back on the bus thread, with the chip select toggled between them.
+    //The bus can merge several transactions in a single kernel call.
+    struct Transaction : public Async_Transaction
+    {
+        struct Transfer
+        {
+            std::vector<uint8_t> tx_data;
+            std::vector<uint8_t> rx_data;
+            uint32_t speed = 0;
+        };
+        std::vector<Transfer> transfers; //only the first transfer_count are used, the rest are kept to avoid reallocations
+        size_t transfer_count = 0;
+
+        void clear()
+        {
+            transfer_count = 0;
+        }
+        //returns the index of the transfer
+        auto add_transfer(uint8_t const* tx_data, size_t size, uint32_t speed = 0) -> size_t
+        {
+            if (transfer_count >= transfers.size())
+            {
+                transfers.resize(transfer_count + 1);
+            }
+            Transfer& t = transfers[transfer_count];
+            t.tx_data.resize(size);
+            t.rx_data.resize(size);
+            t.speed = speed;
+            if (tx_data)
+            {
+                std::copy(tx_data, tx_data + size, t.tx_data.begin());
+            }
+            else
+            {
+                std::fill(t.tx_data.begin(), t.tx_data.end(), 0);
+            }
+            return transfer_count++;
+        }
+        auto add_transfer_register(uint8_t reg, uint8_t const* tx_data, size_t size, uint32_t speed = 0) -> size_t
+        {
+            size_t idx = add_transfer(nullptr, size + 1, speed);
+            Transfer& t = transfers[idx];
+            t.tx_data[0] = reg;
+            if (tx_data)
+            {
+                std::copy(tx_data, tx_data + size, t.tx_data.begin() + 1);
+            }
+            return idx;
+        }
+        auto get_register_rx_data(size_t idx) const -> uint8_t const*
+        {
+            QASSERT(idx < transfer_count);
+            return transfers[idx].rx_data.data() + 1;
+        }
+    };
+
+    //Queues the transaction for the bus thread. Fails if the transaction is still pending.
+    virtual auto submit(std::shared_ptr<Transaction> const& transaction) -> bool = 0;
+
     //convenience method
     auto transfer_register_u16(uint8_t reg, uint16_t tx_data, uint16_t& rx_data, uint32_t speed = 0) -> bool
     {
@@ -0,0 +1,116 @@
+#include "Setup_Codec.h"
+#include "def_lang/JSON_Serializer.h"
+
+namespace silk
+{
+namespace gs_comms
+{
+
+void Setup_Codec::set_format(Setup_Format format)
+{
+    m_format = format;
+}
+
+auto Setup_Codec::get_format() const -> Setup_Format
+{
+    return m_format;
+}
+
+auto Setup_Codec::get_message_format(void const* data, size_t size) -> Setup_Format
+{
+    return (size > 0 && *reinterpret_cast<uint8_t const*>(data) == BINARY_MARKER) ? Setup_Format::BINARY : Setup_Format::JSON;
+}
+
+auto Setup_Codec::is_message_schema_compatible(void const* data, size_t size) -> bool
+{
+    if (get_message_format(data, size) == Setup_Format::JSON)
+    {
+        return true;
+    }
+    if (size <= 1 + SCHEMA_HASH_SIZE)
+    {
+        return false;
+    }
+
+    uint8_t const* ptr = reinterpret_cast<uint8_t const*>(data) + 1;
+    uint64_t hash = 0;
+    for (size_t i = 0; i < SCHEMA_HASH_SIZE; i++)
+    {
+        hash |= static_cast<uint64_t>(ptr[i]) << (i * 8);
+    }
+    return hash == get_schema_hash();
+}
+
+auto Setup_Codec::encode_message(ts::sz::Value const& value) -> std::string const&
+{
+    if (m_format == Setup_Format::JSON)
+    {
+        return ts::sz::to_json(m_message_buffer, value, false);
+    }
+
+    begin_binary_message();
+    return ts::sz::to_binary(m_message_buffer, value);
+}
+
+void Setup_Codec::begin_binary_message()
+{
+    m_message_buffer.clear();
+    m_message_buffer.push_back(static_cast<char>(BINARY_MARKER));
+    uint64_t hash = get_schema_hash();
+    for (size_t i = 0; i < SCHEMA_HASH_SIZE; i++)
+    {
+        m_message_buffer.push_back(static_cast<char>(hash >> (i * 8)));
+    }
+}
+
+auto Setup_Codec::decode_message(void const* data, size_t size) const -> ts::Result<ts::sz::Value>
+{
+    if (get_message_format(data, size) == Setup_Format::JSON)
+    {
+        return ts::sz::from_json(data, size);
+    }
+    if (!is_message_schema_compatible(data, size))
+    {
+        return ts::Error("Setup message schema mismatch");
+    }
+    return ts::sz::from_binary(reinterpret_cast<uint8_t const*>(data) + 1 + SCHEMA_HASH_SIZE, size - 1 - SCHEMA_HASH_SIZE);
+}
+
+auto Setup_Codec::encode_value(ts::sz::Value const& value) -> std::string const&
+{
+    if (m_format == Setup_Format::JSON)
+    {
+        ts::sz::to_json(m_base64_buffer, value, false);
+        m_value_buffer.resize(q::util::compute_base64_encoded_size(m_base64_buffer.size()));
+        q::util::encode_base64(reinterpret_cast<uint8_t const*>(m_base64_buffer.data()), m_base64_buffer.size(), &m_value_buffer[0]);
+        return m_value_buffer;
+    }
+
+    m_value_buffer.clear();
+    m_value_buffer.push_back(static_cast<char>(BINARY_MARKER));
+    return ts::sz::to_binary(m_value_buffer, value);
+}
+
+auto Setup_Codec::decode_value(std::string const& data) -> ts::Result<ts::sz::Value>
+{
+    if (data.empty())
+    {
+        return ts::Error("Empty value data");
+    }
+    if (static_cast<uint8_t>(data[0]) == BINARY_MARKER)
+    {
+        if (data.size() < 2)
+        {
+            return ts::Error("Empty value data");
+        }
+        return ts::sz::from_binary(data.data() + 1, data.size() - 1);
+    }
+
+    m_base64_buffer.resize(q::util::compute_base64_max_decoded_size(data.size()));
+    auto last_it = q::util::decode_base64(data.data(), data.data() + data.size(), m_base64_buffer.begin());
+    m_base64_buffer.erase(last_it, m_base64_buffer.end());
+    return ts::sz::from_json(m_base64_buffer);
+}
+
+}
+}
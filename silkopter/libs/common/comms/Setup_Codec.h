@@ -0,0 +1,153 @@
+#pragma once
+
+#include "gs_comms.def.h"
+#include "def_lang/Binary_Serializer.h"
+
+namespace silk
+{
+namespace gs_comms
+{
+
+enum class Setup_Format : uint8_t
+{
+    JSON,
+    BINARY
+};
+
+//Encodes the setup channel messages and the hal values carried inside them (descriptors, configs, the ast).
+//
+//JSON messages are the json text, JSON values are base64'd json text.
+//BINARY messages are the marker, the 8 byte gs_comms schema hash and the def_lang binary encoding of the message.
+//BINARY values are the marker and the binary encoding. They don't need a hash, the gs builds its hal types from the ast.
+//
+//The typed overloads stream the generated structs straight to/from the binary encoding without building
+// a ts::sz::Value first. The bytes are the same as the ts::sz::Value overloads produce.
+//
+//Decoding detects the format so either side can switch without breaking the other.
+//The gs starts in BINARY, the brain answers in the format of the last request and sends a JSON error
+// when the schema hash doesn't match, so the gs falls back to JSON.
+class Setup_Codec
+{
+public:
+    //json text starts with '{' and base64 never has this
+    static constexpr uint8_t BINARY_MARKER = 0xB1;
+
+    void set_format(Setup_Format format);
+    auto get_format() const -> Setup_Format;
+
+    static auto get_message_format(void const* data, size_t size) -> Setup_Format;
+    //false for binary messages encoded with a different gs_comms.def (or too short to have a value)
+    static auto is_message_schema_compatible(void const* data, size_t size) -> bool;
+
+    //The result is valid until the next encode_message call
+    auto encode_message(ts::sz::Value const& value) -> std::string const&;
+    auto decode_message(void const* data, size_t size) const -> ts::Result<ts::sz::Value>;
+
+    template<class T> auto encode_message(T const& message) -> std::string const&;
+    template<class T> auto decode_message(T& message, void const* data, size_t size) const -> ts::Result<void>;
+
+    //The result is valid until the next encode_value call
+    auto encode_value(ts::sz::Value const& value) -> std::string const&;
+    auto decode_value(std::string const& data) -> ts::Result<ts::sz::Value>;
+
+    template<class T> auto encode_value(T const& value) -> std::string const&;
+    template<class T> auto decode_value(T& value, std::string const& data) -> ts::Result<void>;
+
+private:
+    static constexpr size_t SCHEMA_HASH_SIZE = sizeof(uint64_t);
+
+    void begin_binary_message();
+
+    Setup_Format m_format = Setup_Format::JSON;
+    std::string m_message_buffer;
+    std::string m_value_buffer;
+    std::string m_base64_buffer;
+};
+
+template<class T>
+auto Setup_Codec::encode_message(T const& message) -> std::string const&
+{
+    if (m_format == Setup_Format::JSON)
+    {
+        return encode_message(serialize(message));
+    }
+
+    begin_binary_message();
+    ts::sz::Binary_Writer writer(m_message_buffer);
+    serialize(writer, message);
+    return m_message_buffer;
+}
+
+template<class T>
+auto Setup_Codec::decode_message(T& message, void const* data, size_t size) const -> ts::Result<void>
+{
+    if (get_message_format(data, size) == Setup_Format::JSON)
+    {
+        auto result = decode_message(data, size);
+        if (result != ts::success)
+        {
+            return result.error();
+        }
+        return deserialize(message, result.payload());
+    }
+    if (!is_message_schema_compatible(data, size))
+    {
+        return ts::Error("Setup message schema mismatch");
+    }
+
+    ts::sz::Binary_Reader reader(reinterpret_cast<uint8_t const*>(data) + 1 + SCHEMA_HASH_SIZE, size - 1 - SCHEMA_HASH_SIZE);
+    auto result = deserialize(message, reader);
+    if (result != ts::success)
+    {
+        return result;
+    }
+    if (!reader.is_done())
+    {
+        return ts::Error("Trailing data after setup message");
+    }
+    return ts::success;
+}
+
+template<class T>
+auto Setup_Codec::encode_value(T const& value) -> std::string const&
+{
+    if (m_format == Setup_Format::JSON)
+    {
+        return encode_value(serialize(value));
+    }
+
+    m_value_buffer.clear();
+    m_value_buffer.push_back(static_cast<char>(BINARY_MARKER));
+    ts::sz::Binary_Writer writer(m_value_buffer);
+    serialize(writer, value);
+    return m_value_buffer;
+}
+
+template<class T>
+auto Setup_Codec::decode_value(T& value, std::string const& data) -> ts::Result<void>
+{
+    if (data.size() < 2 || static_cast<uint8_t>(data[0]) != BINARY_MARKER)
+    {
+        auto result = decode_value(data);
+        if (result != ts::success)
+        {
+            return result.error();
+        }
+        return deserialize(value, result.payload());
+    }
+
+    ts::sz::Binary_Reader reader(data.data() + 1, data.size() - 1);
+    auto result = deserialize(value, reader);
+    if (result != ts::success)
+    {
+        return result;
+    }
+    if (!reader.is_done())
+    {
+        return ts::Error("Trailing data after value");
+    }
+    return ts::success;
+}
+
+}
+}
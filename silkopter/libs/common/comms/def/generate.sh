@@ -1,3 +1,3 @@
 #!/bin/bash
 
-../../../../../def_lang/bin/pc/debug/generator --def gs_comms.def --namespace silk::gs_comms --xheader gen_support.h --enum-hashes true
+../../../../../def_lang/bin/pc/debug/generator --def gs_comms.def --namespace silk::gs_comms --xheader gen_support.h --enum-hashes true --stream-sz true
@@ -20,6 +20,11 @@ T max(T v, T max)
 {
   return std::max(v, max);
 }
+uint64_t get_schema_hash()
+{
+  return 0xD9AA75376E821C47ULL;
+}
+
 namespace setup
 {
 
@@ -705,6 +710,48 @@ namespace setup
     return m_config_data;
   }
 
+////////////////////////////////////////////////////////////
+  void Node_Data::set_hash(uint32_t const& value)
+  {
+    m_hash = value;
+  }
+  void Node_Data::set_hash(uint32_t&& value)
+  {
+    m_hash = std::move(value);
+  }
+  auto Node_Data::get_hash() const -> uint32_t const& 
+  {
+    return m_hash;
+  }
+
+////////////////////////////////////////////////////////////
+    void Get_Nodes_Req::Known_Node::set_name(std::string const& value)
+    {
+      m_name = value;
+    }
+    void Get_Nodes_Req::Known_Node::set_name(std::string&& value)
+    {
+      m_name = std::move(value);
+    }
+    auto Get_Nodes_Req::Known_Node::get_name() const -> std::string const& 
+    {
+      return m_name;
+    }
+
+////////////////////////////////////////////////////////////
+    void Get_Nodes_Req::Known_Node::set_hash(uint32_t const& value)
+    {
+      m_hash = value;
+    }
+    void Get_Nodes_Req::Known_Node::set_hash(uint32_t&& value)
+    {
+      m_hash = std::move(value);
+    }
+    auto Get_Nodes_Req::Known_Node::get_hash() const -> uint32_t const& 
+    {
+      return m_hash;
+    }
+
 ////////////////////////////////////////////////////////////
   void Get_Nodes_Req::set_req_id(uint32_t const& value)
   {
@@ -733,6 +780,25 @@ namespace setup
     return m_name;
   }
 
+////////////////////////////////////////////////////////////
+  void Get_Nodes_Req::set_known_nodes(std::vector<setup::Get_Nodes_Req::Known_Node> const& value)
+  {
+    m_known_nodes = value;
+  }
+  void Get_Nodes_Req::set_known_nodes(std::vector<setup::Get_Nodes_Req::Known_Node>&& value)
+  {
+    m_known_nodes = std::move(value);
+  }
+  auto Get_Nodes_Req::get_known_nodes() const -> std::vector<setup::Get_Nodes_Req::Known_Node> const& 
+  {
+    return m_known_nodes;
+  }
+
+  auto Get_Nodes_Req::get_known_nodes() -> std::vector<setup::Get_Nodes_Req::Known_Node>& 
+  {
+    return m_known_nodes;
+  }
+
 ////////////////////////////////////////////////////////////
   void Get_Nodes_Res::set_req_id(uint32_t const& value)
   {
@@ -747,6 +813,25 @@ namespace setup
     return m_req_id;
   }
 
+////////////////////////////////////////////////////////////
+  void Get_Nodes_Res::set_node_names(std::vector<std::string> const& value)
+  {
+    m_node_names = value;
+  }
+  void Get_Nodes_Res::set_node_names(std::vector<std::string>&& value)
+  {
+    m_node_names = std::move(value);
+  }
+  auto Get_Nodes_Res::get_node_names() const -> std::vector<std::string> const& 
+  {
+    return m_node_names;
+  }
+
+  auto Get_Nodes_Res::get_node_names() -> std::vector<std::string>& 
+  {
+    return m_node_names;
+  }
+
 ////////////////////////////////////////////////////////////
   void Get_Nodes_Res::set_node_datas(std::vector<setup::Node_Data> const& value)
   {
@@ -1118,6 +1203,38 @@ namespace setup
   }
 
 ////////////////////////////////////////////////////////////
+  void Remove_Node_Res::set_name(std::string const& value)
+  {
+    m_name = value;
+  }
+  void Remove_Node_Res::set_name(std::string&& value)
+  {
+    m_name = std::move(value);
+  }
+  auto Remove_Node_Res::get_name() const -> std::string const& 
+  {
+    return m_name;
+  }
+
+////////////////////////////////////////////////////////////
+}
+ts::Result<void> deserialize(std::string& value, ts::sz::Value const& sz_value)
+{
+  if (!sz_value.is_string()) { return ts::Error("Expected string value when deserializing"); }
+  value = sz_value.get_as_string();
+  return ts::success;
+}
+ts::sz::Value serialize(std::string const& value)
+{
+  return ts::sz::Value(value);
+}
+ts::Result<void> deserialize(std::string& value, ts::sz::Binary_Reader& reader)
+{
+  return reader.read(value);
+}
+void serialize(ts::sz::Binary_Writer& writer, std::string const& value)
+{
+  writer.write(value);
 }
 ts::Result<void> deserialize(bool& value, ts::sz::Value const& sz_value)
 {
@@ -1129,15 +1246,13 @@ ts::sz::Value serialize(bool const& value)
 {
   return ts::sz::Value(value);
 }
-ts::Result<void> deserialize(std::string& value, ts::sz::Value const& sz_value)
+ts::Result<void> deserialize(bool& value, ts::sz::Binary_Reader& reader)
 {
-  if (!sz_value.is_string()) { return ts::Error("Expected string value when deserializing"); }
-  value = sz_value.get_as_string();
-  return ts::success;
+  return reader.read(value);
 }
-ts::sz::Value serialize(std::string const& value)
+void serialize(ts::sz::Binary_Writer& writer, bool const& value)
 {
-  return ts::sz::Value(value);
+  writer.write(value);
 }
 ts::Result<void> deserialize(int64_t& value, ts::sz::Value const& sz_value)
 {
@@ -1149,6 +1264,18 @@ ts::sz::Value serialize(int64_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(int64_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, int64_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(float& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_real_number()) { return ts::Error("Expected real number value when deserializing"); }
@@ -1159,6 +1286,18 @@ ts::sz::Value serialize(float const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(float& value, ts::sz::Binary_Reader& reader)
+{
+  double v = 0;
+  auto result = reader.read_real(v);
+  if (result != ts::success) { return result; }
+  value = (float)v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, float const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(double& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_real_number()) { return ts::Error("Expected real number value when deserializing"); }
@@ -1169,6 +1308,16 @@ ts::sz::Value serialize(double const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(double& value, ts::sz::Binary_Reader& reader)
+{
+  auto result = reader.read_real(value);
+  if (result != ts::success) { return result; }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, double const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(vec2f& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1194,6 +1343,53 @@ ts::sz::Value serialize(vec2f const& value)
   sz_value.add_object_member("y", serialize(value.y));
   return sz_value;
 }
+ts::Result<void> deserialize(vec2f& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec2f const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+}
 ts::Result<void> deserialize(vec2d& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1219,6 +1415,53 @@ ts::sz::Value serialize(vec2d const& value)
   sz_value.add_object_member("y", serialize(value.y));
   return sz_value;
 }
+ts::Result<void> deserialize(vec2d& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec2d const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+}
 ts::Result<void> deserialize(vec2i& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1244,6 +1487,53 @@ ts::sz::Value serialize(vec2i const& value)
   sz_value.add_object_member("y", serialize(value.y));
   return sz_value;
 }
+ts::Result<void> deserialize(vec2i& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec2i const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+}
 ts::Result<void> deserialize(vec3f& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1276,6 +1566,62 @@ ts::sz::Value serialize(vec3f const& value)
   sz_value.add_object_member("z", serialize(value.z));
   return sz_value;
 }
+ts::Result<void> deserialize(vec3f& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec3f const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+}
 ts::Result<void> deserialize(vec3d& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1308,6 +1654,62 @@ ts::sz::Value serialize(vec3d const& value)
   sz_value.add_object_member("z", serialize(value.z));
   return sz_value;
 }
+ts::Result<void> deserialize(vec3d& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec3d const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+}
 ts::Result<void> deserialize(vec3i& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1340,6 +1742,62 @@ ts::sz::Value serialize(vec3i const& value)
   sz_value.add_object_member("z", serialize(value.z));
   return sz_value;
 }
+ts::Result<void> deserialize(vec3i& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec3i const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+}
 ts::Result<void> deserialize(vec4f& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1379,6 +1837,71 @@ ts::sz::Value serialize(vec4f const& value)
   sz_value.add_object_member("w", serialize(value.w));
   return sz_value;
 }
+ts::Result<void> deserialize(vec4f& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else if (name == "w")
+    {
+      auto result = deserialize(value.w, reader);
+      if (result != ts::success) { return result; }
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  if (!found[3]) { return ts::Error("Cannot find component 'w'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec4f const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+  writer.write_member_name("w");
+  serialize(writer, value.w);
+}
 ts::Result<void> deserialize(vec4d& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1418,6 +1941,71 @@ ts::sz::Value serialize(vec4d const& value)
   sz_value.add_object_member("w", serialize(value.w));
   return sz_value;
 }
+ts::Result<void> deserialize(vec4d& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else if (name == "w")
+    {
+      auto result = deserialize(value.w, reader);
+      if (result != ts::success) { return result; }
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  if (!found[3]) { return ts::Error("Cannot find component 'w'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec4d const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+  writer.write_member_name("w");
+  serialize(writer, value.w);
+}
 ts::Result<void> deserialize(vec4i& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1457,6 +2045,71 @@ ts::sz::Value serialize(vec4i const& value)
   sz_value.add_object_member("w", serialize(value.w));
   return sz_value;
 }
+ts::Result<void> deserialize(vec4i& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "x")
+    {
+      auto result = deserialize(value.x, reader);
+      if (result != ts::success) { return result; }
+      found[0] = true;
+    }
+    else if (name == "y")
+    {
+      auto result = deserialize(value.y, reader);
+      if (result != ts::success) { return result; }
+      found[1] = true;
+    }
+    else if (name == "z")
+    {
+      auto result = deserialize(value.z, reader);
+      if (result != ts::success) { return result; }
+      found[2] = true;
+    }
+    else if (name == "w")
+    {
+      auto result = deserialize(value.w, reader);
+      if (result != ts::success) { return result; }
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find component 'x'"); }
+  if (!found[1]) { return ts::Error("Cannot find component 'y'"); }
+  if (!found[2]) { return ts::Error("Cannot find component 'z'"); }
+  if (!found[3]) { return ts::Error("Cannot find component 'w'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, vec4i const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("x");
+  serialize(writer, value.x);
+  writer.write_member_name("y");
+  serialize(writer, value.y);
+  writer.write_member_name("z");
+  serialize(writer, value.z);
+  writer.write_member_name("w");
+  serialize(writer, value.w);
+}
 ts::Result<void> deserialize(int8_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1467,6 +2120,18 @@ ts::sz::Value serialize(int8_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(int8_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, int8_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(uint8_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1477,6 +2142,18 @@ ts::sz::Value serialize(uint8_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(uint8_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, uint8_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(int16_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1487,6 +2164,18 @@ ts::sz::Value serialize(int16_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(int16_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, int16_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(uint16_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1497,6 +2186,18 @@ ts::sz::Value serialize(uint16_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(uint16_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, uint16_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(int32_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1507,6 +2208,18 @@ ts::sz::Value serialize(int32_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(int32_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, int32_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(uint32_t& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_integral_number()) { return ts::Error("Expected integral number value when deserializing"); }
@@ -1517,6 +2230,18 @@ ts::sz::Value serialize(uint32_t const& value)
 {
   return ts::sz::Value(value);
 }
+ts::Result<void> deserialize(uint32_t& value, ts::sz::Binary_Reader& reader)
+{
+  int64_t v = 0;
+  auto result = reader.read_integral(v);
+  if (result != ts::success) { return result; }
+  value = v;
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, uint32_t const& value)
+{
+  writer.write(value);
+}
 ts::Result<void> deserialize(setup::IReq& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1537,6 +2262,46 @@ ts::sz::Value serialize(setup::IReq const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::IReq& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::IReq const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::IRes& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1557,6 +2322,46 @@ ts::sz::Value serialize(setup::IRes const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::IRes& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::IRes const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::Error& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1586,6 +2391,57 @@ ts::sz::Value serialize(setup::Error const& value)
   sz_value.add_object_member("message", serialize(value.get_message()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Error& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "message")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_message())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_message(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'message'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Error const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("message");
+  serialize(writer, value.get_message());
+}
 ts::Result<void> deserialize(setup::Get_AST_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1606,6 +2462,46 @@ ts::sz::Value serialize(setup::Get_AST_Req const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_AST_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_AST_Req const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::Get_AST_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1635,6 +2531,57 @@ ts::sz::Value serialize(setup::Get_AST_Res const& value)
   sz_value.add_object_member("data", serialize(value.get_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_AST_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_AST_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("data");
+  serialize(writer, value.get_data());
+}
 ts::Result<void> deserialize(setup::Set_Clock_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1664,6 +2611,57 @@ ts::sz::Value serialize(setup::Set_Clock_Req const& value)
   sz_value.add_object_member("time", serialize(value.get_time()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Clock_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "time")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_time())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_time(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'time'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Clock_Req const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("time");
+  serialize(writer, value.get_time());
+}
 ts::Result<void> deserialize(setup::Set_Clock_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1693,6 +2691,57 @@ ts::sz::Value serialize(setup::Set_Clock_Res const& value)
   sz_value.add_object_member("time", serialize(value.get_time()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Clock_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "time")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_time())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_time(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'time'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Clock_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("time");
+  serialize(writer, value.get_time());
+}
 ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1722,6 +2771,57 @@ ts::sz::Value serialize(setup::Set_UAV_Descriptor_Req const& value)
   sz_value.add_object_member("data", serialize(value.get_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_UAV_Descriptor_Req const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("data");
+  serialize(writer, value.get_data());
+}
 ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1751,6 +2851,57 @@ ts::sz::Value serialize(setup::Set_UAV_Descriptor_Res const& value)
   sz_value.add_object_member("data", serialize(value.get_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_UAV_Descriptor_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("data");
+  serialize(writer, value.get_data());
+}
 ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1771,6 +2922,46 @@ ts::sz::Value serialize(setup::Get_UAV_Descriptor_Req const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_UAV_Descriptor_Req const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1800,6 +2991,57 @@ ts::sz::Value serialize(setup::Get_UAV_Descriptor_Res const& value)
   sz_value.add_object_member("data", serialize(value.get_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_UAV_Descriptor_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("data");
+  serialize(writer, value.get_data());
+}
 ts::Result<void> deserialize(setup::Node_Def_Data::Input& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1838,25 +3080,87 @@ ts::sz::Value serialize(setup::Node_Def_Data::Input const& value)
   sz_value.add_object_member("semantic", serialize(value.get_semantic()));
   return sz_value;
 }
-ts::Result<void> deserialize(setup::Node_Def_Data::Output& value, ts::sz::Value const& sz_value)
+ts::Result<void> deserialize(setup::Node_Def_Data::Input& value, ts::sz::Binary_Reader& reader)
 {
-  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  size_t member_count = 0;
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("name");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'name'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
+    auto result = reader.begin_object(member_count);
     if (result != ts::success) { return result; }
-    value.set_name(std::move(v));
   }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("space");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'space'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
-    if (result != ts::success) { return result; }
-    value.set_space(std::move(v));
-  }
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "space")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_space(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "semantic")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_semantic())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_semantic(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'space'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'semantic'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data::Input const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("space");
+  serialize(writer, value.get_space());
+  writer.write_member_name("semantic");
+  serialize(writer, value.get_semantic());
+}
+ts::Result<void> deserialize(setup::Node_Def_Data::Output& value, ts::sz::Value const& sz_value)
+{
+  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("name");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'name'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_name(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("space");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'space'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_space(std::move(v));
+  }
   {
     auto const* member_sz_value = sz_value.find_object_member_by_name("semantic");
     if (!member_sz_value) { return ts::Error("Cannot find member value 'semantic'"); }
@@ -1876,6 +3180,68 @@ ts::sz::Value serialize(setup::Node_Def_Data::Output const& value)
   sz_value.add_object_member("semantic", serialize(value.get_semantic()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Node_Def_Data::Output& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "space")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_space(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "semantic")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_semantic())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_semantic(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'space'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'semantic'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data::Output const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("space");
+  serialize(writer, value.get_space());
+  writer.write_member_name("semantic");
+  serialize(writer, value.get_semantic());
+}
 ts::Result<void> deserialize(setup::Node_Def_Data& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1932,6 +3298,90 @@ ts::sz::Value serialize(setup::Node_Def_Data const& value)
   sz_value.add_object_member("descriptor_data", serialize(value.get_descriptor_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Node_Def_Data& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[5] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "type")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_type())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_type(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "inputs")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_inputs())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_inputs(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "outputs")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_outputs())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_outputs(std::move(v));
+      found[3] = true;
+    }
+    else if (name == "descriptor_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_descriptor_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_descriptor_data(std::move(v));
+      found[4] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'type'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'inputs'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'outputs'"); }
+  if (!found[4]) { return ts::Error("Cannot find member value 'descriptor_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data const& value)
+{
+  writer.begin_object(5);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("type");
+  serialize(writer, value.get_type());
+  writer.write_member_name("inputs");
+  serialize(writer, value.get_inputs());
+  writer.write_member_name("outputs");
+  serialize(writer, value.get_outputs());
+  writer.write_member_name("descriptor_data");
+  serialize(writer, value.get_descriptor_data());
+}
 ts::Result<void> deserialize(setup::Get_Node_Defs_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1952,6 +3402,46 @@ ts::sz::Value serialize(setup::Get_Node_Defs_Req const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_Node_Defs_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Node_Defs_Req const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::Get_Node_Defs_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -1981,6 +3471,57 @@ ts::sz::Value serialize(setup::Get_Node_Defs_Res const& value)
   sz_value.add_object_member("node_def_datas", serialize(value.get_node_def_datas()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Get_Node_Defs_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_def_datas")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_def_datas())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_def_datas(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_def_datas'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Node_Defs_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_def_datas");
+  serialize(writer, value.get_node_def_datas());
+}
 ts::Result<void> deserialize(setup::Node_Data::Input& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2037,6 +3578,90 @@ ts::sz::Value serialize(setup::Node_Data::Input const& value)
   sz_value.add_object_member("stream_path", serialize(value.get_stream_path()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Node_Data::Input& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[5] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "space")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_space(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "semantic")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_semantic())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_semantic(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "rate")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_rate())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_rate(std::move(v));
+      found[3] = true;
+    }
+    else if (name == "stream_path")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_stream_path())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_stream_path(std::move(v));
+      found[4] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'space'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'semantic'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'rate'"); }
+  if (!found[4]) { return ts::Error("Cannot find member value 'stream_path'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data::Input const& value)
+{
+  writer.begin_object(5);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("space");
+  serialize(writer, value.get_space());
+  writer.write_member_name("semantic");
+  serialize(writer, value.get_semantic());
+  writer.write_member_name("rate");
+  serialize(writer, value.get_rate());
+  writer.write_member_name("stream_path");
+  serialize(writer, value.get_stream_path());
+}
 ts::Result<void> deserialize(setup::Node_Data::Output& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2084,6 +3709,79 @@ ts::sz::Value serialize(setup::Node_Data::Output const& value)
   sz_value.add_object_member("rate", serialize(value.get_rate()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Node_Data::Output& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "space")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_space())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_space(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "semantic")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_semantic())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_semantic(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "rate")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_rate())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_rate(std::move(v));
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'space'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'semantic'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'rate'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data::Output const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("space");
+  serialize(writer, value.get_space());
+  writer.write_member_name("semantic");
+  serialize(writer, value.get_semantic());
+  writer.write_member_name("rate");
+  serialize(writer, value.get_rate());
+}
 ts::Result<void> deserialize(setup::Node_Data& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2135,31 +3833,138 @@ ts::Result<void> deserialize(setup::Node_Data& value, ts::sz::Value const& sz_va
     if (result != ts::success) { return result; }
     value.set_config_data(std::move(v));
   }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("hash");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'hash'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_hash())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_hash(std::move(v));
+  }
   return ts::success;
 }
 ts::sz::Value serialize(setup::Node_Data const& value)
 {
   ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
-  sz_value.reserve_object_members(6);
+  sz_value.reserve_object_members(7);
   sz_value.add_object_member("name", serialize(value.get_name()));
   sz_value.add_object_member("type", serialize(value.get_type()));
   sz_value.add_object_member("inputs", serialize(value.get_inputs()));
   sz_value.add_object_member("outputs", serialize(value.get_outputs()));
   sz_value.add_object_member("descriptor_data", serialize(value.get_descriptor_data()));
   sz_value.add_object_member("config_data", serialize(value.get_config_data()));
+  sz_value.add_object_member("hash", serialize(value.get_hash()));
   return sz_value;
 }
-ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Value const& sz_value)
+ts::Result<void> deserialize(setup::Node_Data& value, ts::sz::Binary_Reader& reader)
 {
-  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  size_t member_count = 0;
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("req_id");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'req_id'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
+    auto result = reader.begin_object(member_count);
     if (result != ts::success) { return result; }
-    value.set_req_id(std::move(v));
   }
+  bool found[7] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "type")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_type())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_type(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "inputs")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_inputs())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_inputs(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "outputs")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_outputs())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_outputs(std::move(v));
+      found[3] = true;
+    }
+    else if (name == "descriptor_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_descriptor_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_descriptor_data(std::move(v));
+      found[4] = true;
+    }
+    else if (name == "config_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_config_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_config_data(std::move(v));
+      found[5] = true;
+    }
+    else if (name == "hash")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_hash())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_hash(std::move(v));
+      found[6] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'type'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'inputs'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'outputs'"); }
+  if (!found[4]) { return ts::Error("Cannot find member value 'descriptor_data'"); }
+  if (!found[5]) { return ts::Error("Cannot find member value 'config_data'"); }
+  if (!found[6]) { return ts::Error("Cannot find member value 'hash'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data const& value)
+{
+  writer.begin_object(7);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("type");
+  serialize(writer, value.get_type());
+  writer.write_member_name("inputs");
+  serialize(writer, value.get_inputs());
+  writer.write_member_name("outputs");
+  serialize(writer, value.get_outputs());
+  writer.write_member_name("descriptor_data");
+  serialize(writer, value.get_descriptor_data());
+  writer.write_member_name("config_data");
+  serialize(writer, value.get_config_data());
+  writer.write_member_name("hash");
+  serialize(writer, value.get_hash());
+}
+ts::Result<void> deserialize(setup::Get_Nodes_Req::Known_Node& value, ts::sz::Value const& sz_value)
+{
+  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
   {
     auto const* member_sz_value = sz_value.find_object_member_by_name("name");
     if (!member_sz_value) { return ts::Error("Cannot find member value 'name'"); }
@@ -2168,46 +3973,76 @@ ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Value const& s
     if (result != ts::success) { return result; }
     value.set_name(std::move(v));
   }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("hash");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'hash'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_hash())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_hash(std::move(v));
+  }
   return ts::success;
 }
-ts::sz::Value serialize(setup::Get_Nodes_Req const& value)
+ts::sz::Value serialize(setup::Get_Nodes_Req::Known_Node const& value)
 {
   ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
   sz_value.reserve_object_members(2);
-  sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   sz_value.add_object_member("name", serialize(value.get_name()));
+  sz_value.add_object_member("hash", serialize(value.get_hash()));
   return sz_value;
 }
-ts::Result<void> deserialize(setup::Get_Nodes_Res& value, ts::sz::Value const& sz_value)
+ts::Result<void> deserialize(setup::Get_Nodes_Req::Known_Node& value, ts::sz::Binary_Reader& reader)
 {
-  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  size_t member_count = 0;
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("req_id");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'req_id'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
+    auto result = reader.begin_object(member_count);
     if (result != ts::success) { return result; }
-    value.set_req_id(std::move(v));
   }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("node_datas");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'node_datas'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_node_datas())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
-    if (result != ts::success) { return result; }
-    value.set_node_datas(std::move(v));
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "hash")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_hash())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_hash(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
   }
+  if (!found[0]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'hash'"); }
   return ts::success;
 }
-ts::sz::Value serialize(setup::Get_Nodes_Res const& value)
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Req::Known_Node const& value)
 {
-  ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
-  sz_value.reserve_object_members(2);
-  sz_value.add_object_member("req_id", serialize(value.get_req_id()));
-  sz_value.add_object_member("node_datas", serialize(value.get_node_datas()));
-  return sz_value;
+  writer.begin_object(2);
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("hash");
+  serialize(writer, value.get_hash());
 }
-ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::sz::Value const& sz_value)
+ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
   {
@@ -2219,41 +4054,314 @@ ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::s
     value.set_req_id(std::move(v));
   }
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("node_name");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'node_name'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_node_name())>::type>::type v;
-    auto result = deserialize(v, *member_sz_value);
-    if (result != ts::success) { return result; }
-    value.set_node_name(std::move(v));
-  }
-  {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("input_name");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'input_name'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_input_name())>::type>::type v;
+    auto const* member_sz_value = sz_value.find_object_member_by_name("name");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'name'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
     auto result = deserialize(v, *member_sz_value);
     if (result != ts::success) { return result; }
-    value.set_input_name(std::move(v));
+    value.set_name(std::move(v));
   }
   {
-    auto const* member_sz_value = sz_value.find_object_member_by_name("stream_path");
-    if (!member_sz_value) { return ts::Error("Cannot find member value 'stream_path'"); }
-    std::remove_cv<std::remove_reference<decltype(value.get_stream_path())>::type>::type v;
+    auto const* member_sz_value = sz_value.find_object_member_by_name("known_nodes");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'known_nodes'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_known_nodes())>::type>::type v;
     auto result = deserialize(v, *member_sz_value);
     if (result != ts::success) { return result; }
-    value.set_stream_path(std::move(v));
+    value.set_known_nodes(std::move(v));
   }
   return ts::success;
 }
-ts::sz::Value serialize(setup::Set_Node_Input_Stream_Path_Req const& value)
+ts::sz::Value serialize(setup::Get_Nodes_Req const& value)
 {
   ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
-  sz_value.reserve_object_members(4);
+  sz_value.reserve_object_members(3);
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
-  sz_value.add_object_member("node_name", serialize(value.get_node_name()));
-  sz_value.add_object_member("input_name", serialize(value.get_input_name()));
+  sz_value.add_object_member("name", serialize(value.get_name()));
+  sz_value.add_object_member("known_nodes", serialize(value.get_known_nodes()));
+  return sz_value;
+}
+ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "known_nodes")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_known_nodes())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_known_nodes(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'known_nodes'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Req const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("known_nodes");
+  serialize(writer, value.get_known_nodes());
+}
+ts::Result<void> deserialize(setup::Get_Nodes_Res& value, ts::sz::Value const& sz_value)
+{
+  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("req_id");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'req_id'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_req_id(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("node_names");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'node_names'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_node_names())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_node_names(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("node_datas");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'node_datas'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_node_datas())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_node_datas(std::move(v));
+  }
+  return ts::success;
+}
+ts::sz::Value serialize(setup::Get_Nodes_Res const& value)
+{
+  ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
+  sz_value.reserve_object_members(3);
+  sz_value.add_object_member("req_id", serialize(value.get_req_id()));
+  sz_value.add_object_member("node_names", serialize(value.get_node_names()));
+  sz_value.add_object_member("node_datas", serialize(value.get_node_datas()));
+  return sz_value;
+}
+ts::Result<void> deserialize(setup::Get_Nodes_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_names")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_names())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_names(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "node_datas")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_datas())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_datas(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_names'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'node_datas'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Res const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_names");
+  serialize(writer, value.get_node_names());
+  writer.write_member_name("node_datas");
+  serialize(writer, value.get_node_datas());
+}
+ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::sz::Value const& sz_value)
+{
+  if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("req_id");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'req_id'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_req_id(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("node_name");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'node_name'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_node_name())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_node_name(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("input_name");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'input_name'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_input_name())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_input_name(std::move(v));
+  }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("stream_path");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'stream_path'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_stream_path())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_stream_path(std::move(v));
+  }
+  return ts::success;
+}
+ts::sz::Value serialize(setup::Set_Node_Input_Stream_Path_Req const& value)
+{
+  ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
+  sz_value.reserve_object_members(4);
+  sz_value.add_object_member("req_id", serialize(value.get_req_id()));
+  sz_value.add_object_member("node_name", serialize(value.get_node_name()));
+  sz_value.add_object_member("input_name", serialize(value.get_input_name()));
   sz_value.add_object_member("stream_path", serialize(value.get_stream_path()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_name(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "input_name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_input_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_input_name(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "stream_path")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_stream_path())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_stream_path(std::move(v));
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_name'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'input_name'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'stream_path'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Input_Stream_Path_Req const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_name");
+  serialize(writer, value.get_node_name());
+  writer.write_member_name("input_name");
+  serialize(writer, value.get_input_name());
+  writer.write_member_name("stream_path");
+  serialize(writer, value.get_stream_path());
+}
 ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2283,6 +4391,57 @@ ts::sz::Value serialize(setup::Set_Node_Input_Stream_Path_Res const& value)
   sz_value.add_object_member("node_data", serialize(value.get_node_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Input_Stream_Path_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_data");
+  serialize(writer, value.get_node_data());
+}
 ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2321,6 +4480,68 @@ ts::sz::Value serialize(setup::Set_Stream_Telemetry_Enabled_Req const& value)
   sz_value.add_object_member("enabled", serialize(value.get_enabled()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "stream_path")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_stream_path())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_stream_path(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "enabled")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_enabled())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_enabled(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'stream_path'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'enabled'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Stream_Telemetry_Enabled_Req const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("stream_path");
+  serialize(writer, value.get_stream_path());
+  writer.write_member_name("enabled");
+  serialize(writer, value.get_enabled());
+}
 ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2341,6 +4562,46 @@ ts::sz::Value serialize(setup::Set_Stream_Telemetry_Enabled_Res const& value)
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[1] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Stream_Telemetry_Enabled_Res const& value)
+{
+  writer.begin_object(1);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+}
 ts::Result<void> deserialize(setup::Add_Node_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2388,6 +4649,79 @@ ts::sz::Value serialize(setup::Add_Node_Req const& value)
   sz_value.add_object_member("descriptor_data", serialize(value.get_descriptor_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Add_Node_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[4] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "def_name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_def_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_def_name(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[2] = true;
+    }
+    else if (name == "descriptor_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_descriptor_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_descriptor_data(std::move(v));
+      found[3] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'def_name'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[3]) { return ts::Error("Cannot find member value 'descriptor_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Add_Node_Req const& value)
+{
+  writer.begin_object(4);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("def_name");
+  serialize(writer, value.get_def_name());
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("descriptor_data");
+  serialize(writer, value.get_descriptor_data());
+}
 ts::Result<void> deserialize(setup::Add_Node_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2417,6 +4751,57 @@ ts::sz::Value serialize(setup::Add_Node_Res const& value)
   sz_value.add_object_member("node_data", serialize(value.get_node_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Add_Node_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Add_Node_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_data");
+  serialize(writer, value.get_node_data());
+}
 ts::Result<void> deserialize(setup::Set_Node_Config_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2455,6 +4840,68 @@ ts::sz::Value serialize(setup::Set_Node_Config_Req const& value)
   sz_value.add_object_member("config_data", serialize(value.get_config_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Node_Config_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[3] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[1] = true;
+    }
+    else if (name == "config_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_config_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_config_data(std::move(v));
+      found[2] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'name'"); }
+  if (!found[2]) { return ts::Error("Cannot find member value 'config_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Config_Req const& value)
+{
+  writer.begin_object(3);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+  writer.write_member_name("config_data");
+  serialize(writer, value.get_config_data());
+}
 ts::Result<void> deserialize(setup::Set_Node_Config_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2484,6 +4931,57 @@ ts::sz::Value serialize(setup::Set_Node_Config_Res const& value)
   sz_value.add_object_member("node_data", serialize(value.get_node_data()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Set_Node_Config_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "node_data")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_node_data())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_node_data(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'node_data'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Config_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("node_data");
+  serialize(writer, value.get_node_data());
+}
 ts::Result<void> deserialize(setup::Remove_Node_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2513,6 +5011,57 @@ ts::sz::Value serialize(setup::Remove_Node_Req const& value)
   sz_value.add_object_member("name", serialize(value.get_name()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Remove_Node_Req& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'name'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Remove_Node_Req const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+}
 ts::Result<void> deserialize(setup::Remove_Node_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2524,15 +5073,75 @@ ts::Result<void> deserialize(setup::Remove_Node_Res& value, ts::sz::Value const&
     if (result != ts::success) { return result; }
     value.set_req_id(std::move(v));
   }
+  {
+    auto const* member_sz_value = sz_value.find_object_member_by_name("name");
+    if (!member_sz_value) { return ts::Error("Cannot find member value 'name'"); }
+    std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+    auto result = deserialize(v, *member_sz_value);
+    if (result != ts::success) { return result; }
+    value.set_name(std::move(v));
+  }
   return ts::success;
 }
 ts::sz::Value serialize(setup::Remove_Node_Res const& value)
 {
   ts::sz::Value sz_value(ts::sz::Value::Type::OBJECT);
-  sz_value.reserve_object_members(1);
+  sz_value.reserve_object_members(2);
   sz_value.add_object_member("req_id", serialize(value.get_req_id()));
+  sz_value.add_object_member("name", serialize(value.get_name()));
   return sz_value;
 }
+ts::Result<void> deserialize(setup::Remove_Node_Res& value, ts::sz::Binary_Reader& reader)
+{
+  size_t member_count = 0;
+  {
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+  }
+  bool found[2] = {};
+  for (size_t i = 0; i < member_count; i++)
+  {
+    ts::sz::Name_View name;
+    {
+      auto result = reader.read_member_name(name);
+      if (result != ts::success) { return result; }
+    }
+    if (false) {} //this is here just to have the next items with 'else if'
+    else if (name == "req_id")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_req_id())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_req_id(std::move(v));
+      found[0] = true;
+    }
+    else if (name == "name")
+    {
+      std::remove_cv<std::remove_reference<decltype(value.get_name())>::type>::type v;
+      auto result = deserialize(v, reader);
+      if (result != ts::success) { return result; }
+      value.set_name(std::move(v));
+      found[1] = true;
+    }
+    else
+    {
+      ts::sz::Value v;
+      auto result = reader.read(v);
+      if (result != ts::success) { return result; }
+    }
+  }
+  if (!found[0]) { return ts::Error("Cannot find member value 'req_id'"); }
+  if (!found[1]) { return ts::Error("Cannot find member value 'name'"); }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Remove_Node_Res const& value)
+{
+  writer.begin_object(2);
+  writer.write_member_name("req_id");
+  serialize(writer, value.get_req_id());
+  writer.write_member_name("name");
+  serialize(writer, value.get_name());
+}
 ts::Result<void> deserialize(setup::Brain_Req& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2694,6 +5303,175 @@ ts::sz::Value serialize(setup::Brain_Req const& value)
   }
   else { TS_ASSERT(false); return ts::sz::Value(); }
 }
+ts::Result<void> deserialize(setup::Brain_Req& value, ts::sz::Binary_Reader& reader)
+{
+  std::string path;
+  {
+    size_t member_count = 0;
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+    if (member_count != 2) { return ts::Error("Expected 'type' and 'value' when deserializing"); }
+    ts::sz::Name_View name;
+    result = reader.read_member_name(name);
+    if (result != ts::success) { return result; }
+    if (name != "type") { return ts::Error("Expected 'type' string value when deserializing"); }
+    result = reader.read(path);
+    if (result != ts::success) { return result; }
+    result = reader.read_member_name(name);
+    if (result != ts::success) { return result; }
+    if (name != "value") { return ts::Error("Expected 'value' when deserializing"); }
+  }
+  if (false) { return ts::Error(""); } //this is here just to have the next items with 'else if'
+  else if (path == "::setup::Get_AST_Req")
+  {
+    value = setup::Get_AST_Req();
+    return deserialize(boost::get<setup::Get_AST_Req>(value), reader);
+  }
+  else if (path == "::setup::Set_Clock_Req")
+  {
+    value = setup::Set_Clock_Req();
+    return deserialize(boost::get<setup::Set_Clock_Req>(value), reader);
+  }
+  else if (path == "::setup::Set_UAV_Descriptor_Req")
+  {
+    value = setup::Set_UAV_Descriptor_Req();
+    return deserialize(boost::get<setup::Set_UAV_Descriptor_Req>(value), reader);
+  }
+  else if (path == "::setup::Get_UAV_Descriptor_Req")
+  {
+    value = setup::Get_UAV_Descriptor_Req();
+    return deserialize(boost::get<setup::Get_UAV_Descriptor_Req>(value), reader);
+  }
+  else if (path == "::setup::Get_Node_Defs_Req")
+  {
+    value = setup::Get_Node_Defs_Req();
+    return deserialize(boost::get<setup::Get_Node_Defs_Req>(value), reader);
+  }
+  else if (path == "::setup::Remove_Node_Req")
+  {
+    value = setup::Remove_Node_Req();
+    return deserialize(boost::get<setup::Remove_Node_Req>(value), reader);
+  }
+  else if (path == "::setup::Add_Node_Req")
+  {
+    value = setup::Add_Node_Req();
+    return deserialize(boost::get<setup::Add_Node_Req>(value), reader);
+  }
+  else if (path == "::setup::Get_Nodes_Req")
+  {
+    value = setup::Get_Nodes_Req();
+    return deserialize(boost::get<setup::Get_Nodes_Req>(value), reader);
+  }
+  else if (path == "::setup::Set_Node_Input_Stream_Path_Req")
+  {
+    value = setup::Set_Node_Input_Stream_Path_Req();
+    return deserialize(boost::get<setup::Set_Node_Input_Stream_Path_Req>(value), reader);
+  }
+  else if (path == "::setup::Set_Stream_Telemetry_Enabled_Req")
+  {
+    value = setup::Set_Stream_Telemetry_Enabled_Req();
+    return deserialize(boost::get<setup::Set_Stream_Telemetry_Enabled_Req>(value), reader);
+  }
+  else if (path == "::setup::Set_Node_Config_Req")
+  {
+    value = setup::Set_Node_Config_Req();
+    return deserialize(boost::get<setup::Set_Node_Config_Req>(value), reader);
+  }
+  else { return ts::Error("Cannot find type '" + path + "' when deserializing"); }
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Brain_Req const& value)
+{
+  if (false) {} //this is here just to have the next items with 'else if'
+  else if (auto* v = boost::get<setup::Get_AST_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_AST_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Clock_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Clock_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_UAV_Descriptor_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_UAV_Descriptor_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_UAV_Descriptor_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_UAV_Descriptor_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_Node_Defs_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_Node_Defs_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Remove_Node_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Remove_Node_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Add_Node_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Add_Node_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_Nodes_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_Nodes_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Node_Input_Stream_Path_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Node_Input_Stream_Path_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Stream_Telemetry_Enabled_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Stream_Telemetry_Enabled_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Node_Config_Req>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Node_Config_Req");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else { TS_ASSERT(false); writer.write_empty(); }
+}
 ts::Result<void> deserialize(setup::Brain_Res& value, ts::sz::Value const& sz_value)
 {
   if (!sz_value.is_object()) { return ts::Error("Expected object value when deserializing"); }
@@ -2868,6 +5646,188 @@ ts::sz::Value serialize(setup::Brain_Res const& value)
   }
   else { TS_ASSERT(false); return ts::sz::Value(); }
 }
+ts::Result<void> deserialize(setup::Brain_Res& value, ts::sz::Binary_Reader& reader)
+{
+  std::string path;
+  {
+    size_t member_count = 0;
+    auto result = reader.begin_object(member_count);
+    if (result != ts::success) { return result; }
+    if (member_count != 2) { return ts::Error("Expected 'type' and 'value' when deserializing"); }
+    ts::sz::Name_View name;
+    result = reader.read_member_name(name);
+    if (result != ts::success) { return result; }
+    if (name != "type") { return ts::Error("Expected 'type' string value when deserializing"); }
+    result = reader.read(path);
+    if (result != ts::success) { return result; }
+    result = reader.read_member_name(name);
+    if (result != ts::success) { return result; }
+    if (name != "value") { return ts::Error("Expected 'value' when deserializing"); }
+  }
+  if (false) { return ts::Error(""); } //this is here just to have the next items with 'else if'
+  else if (path == "::setup::Get_AST_Res")
+  {
+    value = setup::Get_AST_Res();
+    return deserialize(boost::get<setup::Get_AST_Res>(value), reader);
+  }
+  else if (path == "::setup::Set_Clock_Res")
+  {
+    value = setup::Set_Clock_Res();
+    return deserialize(boost::get<setup::Set_Clock_Res>(value), reader);
+  }
+  else if (path == "::setup::Set_UAV_Descriptor_Res")
+  {
+    value = setup::Set_UAV_Descriptor_Res();
+    return deserialize(boost::get<setup::Set_UAV_Descriptor_Res>(value), reader);
+  }
+  else if (path == "::setup::Get_UAV_Descriptor_Res")
+  {
+    value = setup::Get_UAV_Descriptor_Res();
+    return deserialize(boost::get<setup::Get_UAV_Descriptor_Res>(value), reader);
+  }
+  else if (path == "::setup::Get_Node_Defs_Res")
+  {
+    value = setup::Get_Node_Defs_Res();
+    return deserialize(boost::get<setup::Get_Node_Defs_Res>(value), reader);
+  }
+  else if (path == "::setup::Remove_Node_Res")
+  {
+    value = setup::Remove_Node_Res();
+    return deserialize(boost::get<setup::Remove_Node_Res>(value), reader);
+  }
+  else if (path == "::setup::Add_Node_Res")
+  {
+    value = setup::Add_Node_Res();
+    return deserialize(boost::get<setup::Add_Node_Res>(value), reader);
+  }
+  else if (path == "::setup::Get_Nodes_Res")
+  {
+    value = setup::Get_Nodes_Res();
+    return deserialize(boost::get<setup::Get_Nodes_Res>(value), reader);
+  }
+  else if (path == "::setup::Set_Node_Input_Stream_Path_Res")
+  {
+    value = setup::Set_Node_Input_Stream_Path_Res();
+    return deserialize(boost::get<setup::Set_Node_Input_Stream_Path_Res>(value), reader);
+  }
+  else if (path == "::setup::Set_Stream_Telemetry_Enabled_Res")
+  {
+    value = setup::Set_Stream_Telemetry_Enabled_Res();
+    return deserialize(boost::get<setup::Set_Stream_Telemetry_Enabled_Res>(value), reader);
+  }
+  else if (path == "::setup::Set_Node_Config_Res")
+  {
+    value = setup::Set_Node_Config_Res();
+    return deserialize(boost::get<setup::Set_Node_Config_Res>(value), reader);
+  }
+  else if (path == "::setup::Error")
+  {
+    value = setup::Error();
+    return deserialize(boost::get<setup::Error>(value), reader);
+  }
+  else { return ts::Error("Cannot find type '" + path + "' when deserializing"); }
+}
+void serialize(ts::sz::Binary_Writer& writer, setup::Brain_Res const& value)
+{
+  if (false) {} //this is here just to have the next items with 'else if'
+  else if (auto* v = boost::get<setup::Get_AST_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_AST_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Clock_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Clock_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_UAV_Descriptor_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_UAV_Descriptor_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_UAV_Descriptor_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_UAV_Descriptor_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_Node_Defs_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_Node_Defs_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Remove_Node_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Remove_Node_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Add_Node_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Add_Node_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Get_Nodes_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Get_Nodes_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Node_Input_Stream_Path_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Node_Input_Stream_Path_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Stream_Telemetry_Enabled_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Stream_Telemetry_Enabled_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Set_Node_Config_Res>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Set_Node_Config_Res");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else if (auto* v = boost::get<setup::Error>(&value))
+  {
+    writer.begin_object(2);
+    writer.write_member_name("type");
+    writer.write("::setup::Error");
+    writer.write_member_name("value");
+    serialize(writer, *v);
+  }
+  else { TS_ASSERT(false); writer.write_empty(); }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Input>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -2890,6 +5850,30 @@ ts::sz::Value serialize(std::vector<setup::Node_Def_Data::Input> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Input>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data::Input> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Output>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -2912,6 +5896,30 @@ ts::sz::Value serialize(std::vector<setup::Node_Def_Data::Output> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Output>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data::Output> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -2934,6 +5942,30 @@ ts::sz::Value serialize(std::vector<setup::Node_Def_Data> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Data::Input>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -2956,6 +5988,30 @@ ts::sz::Value serialize(std::vector<setup::Node_Data::Input> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Data::Input>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data::Input> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Data::Output>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -2978,6 +6034,122 @@ ts::sz::Value serialize(std::vector<setup::Node_Data::Output> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Data::Output>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data::Output> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
+ts::Result<void> deserialize(std::vector<setup::Get_Nodes_Req::Known_Node>& value, ts::sz::Value const& sz_value)
+{
+  value.clear();
+  if (!sz_value.is_array()) { return ts::Error("Expected array value when deserializing"); }
+  value.resize(sz_value.get_array_element_count());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], sz_value.get_array_element_value(i));
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+ts::sz::Value serialize(std::vector<setup::Get_Nodes_Req::Known_Node> const& value)
+{
+  ts::sz::Value sz_value(ts::sz::Value::Type::ARRAY);
+  sz_value.reserve_array_members(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    sz_value.add_array_element(serialize(value[i]));
+  }
+  return sz_value;
+}
+ts::Result<void> deserialize(std::vector<setup::Get_Nodes_Req::Known_Node>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Get_Nodes_Req::Known_Node> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
+ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Value const& sz_value)
+{
+  value.clear();
+  if (!sz_value.is_array()) { return ts::Error("Expected array value when deserializing"); }
+  value.resize(sz_value.get_array_element_count());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], sz_value.get_array_element_value(i));
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+ts::sz::Value serialize(std::vector<std::string> const& value)
+{
+  ts::sz::Value sz_value(ts::sz::Value::Type::ARRAY);
+  sz_value.reserve_array_members(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    sz_value.add_array_element(serialize(value[i]));
+  }
+  return sz_value;
+}
+ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<std::string> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 ts::Result<void> deserialize(std::vector<setup::Node_Data>& value, ts::sz::Value const& sz_value)
 {
   value.clear();
@@ -3000,5 +6172,29 @@ ts::sz::Value serialize(std::vector<setup::Node_Data> const& value)
   }
   return sz_value;
 }
+ts::Result<void> deserialize(std::vector<setup::Node_Data>& value, ts::sz::Binary_Reader& reader)
+{
+  value.clear();
+  size_t count = 0;
+  {
+    auto result = reader.begin_array(count);
+    if (result != ts::success) { return result; }
+  }
+  value.resize(count);
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    auto result = deserialize(value[i], reader);
+    if (result != ts::success) { return result; }
+  }
+  return ts::success;
+}
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data> const& value)
+{
+  writer.begin_array(value.size());
+  for (size_t i = 0; i < value.size(); i++)
+  {
+    serialize(writer, value[i]);
+  }
+}
 }
 }
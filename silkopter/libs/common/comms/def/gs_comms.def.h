@@ -8,6 +8,7 @@
 #include <boost/variant.hpp>
 #include <def_lang/Result.h>
 #include <def_lang/Serialization.h>
+#include <def_lang/Binary_Serializer.h>
 #include "gen_support.h"
 namespace silk
 {
@@ -39,6 +40,8 @@ private:
   template<class U> friend class Poly;
   std::shared_ptr<T> ptr;
 };
+// Returns a hash of the definitions. Both ends of a binary channel have to agree on it
+uint64_t get_schema_hash();
 typedef int8_t int8_t;
 typedef uint8_t uint8_t;
 typedef int16_t int16_t;
@@ -416,6 +419,10 @@ public:
   void set_config_data(setup::serialized_data_t&& value);
   auto get_config_data() const -> setup::serialized_data_t const&;
 
+  void set_hash(uint32_t const& value);
+  void set_hash(uint32_t&& value);
+  auto get_hash() const -> uint32_t const&;
+
 private:
   std::string m_name;
   uint8_t m_type = {0};
@@ -423,11 +430,29 @@ private:
   std::vector<setup::Node_Data::Output> m_outputs;
   setup::serialized_data_t m_descriptor_data;
   setup::serialized_data_t m_config_data;
+  uint32_t m_hash = {0};
 };
 
 struct Get_Nodes_Req : public setup::IReq
 {
 public:
+  struct Known_Node
+  {
+  public:
+    virtual ~Known_Node() = default;
+    void set_name(std::string const& value);
+    void set_name(std::string&& value);
+    auto get_name() const -> std::string const&;
+
+    void set_hash(uint32_t const& value);
+    void set_hash(uint32_t&& value);
+    auto get_hash() const -> uint32_t const&;
+
+  private:
+    std::string m_name;
+    uint32_t m_hash = {0};
+  };
+
   virtual ~Get_Nodes_Req() = default;
   void set_req_id(uint32_t const& value);
   void set_req_id(uint32_t&& value);
@@ -437,9 +462,15 @@ public:
   void set_name(std::string&& value);
   auto get_name() const -> std::string const&;
 
+  void set_known_nodes(std::vector<setup::Get_Nodes_Req::Known_Node> const& value);
+  void set_known_nodes(std::vector<setup::Get_Nodes_Req::Known_Node>&& value);
+  auto get_known_nodes() const -> std::vector<setup::Get_Nodes_Req::Known_Node> const&;
+  auto get_known_nodes() -> std::vector<setup::Get_Nodes_Req::Known_Node>&;
+
 private:
   uint32_t m_req_id = {0};
   std::string m_name;
+  std::vector<setup::Get_Nodes_Req::Known_Node> m_known_nodes;
 };
 
 struct Get_Nodes_Res : public setup::IRes
@@ -450,6 +481,11 @@ public:
   void set_req_id(uint32_t&& value);
   auto get_req_id() const -> uint32_t const&;
 
+  void set_node_names(std::vector<std::string> const& value);
+  void set_node_names(std::vector<std::string>&& value);
+  auto get_node_names() const -> std::vector<std::string> const&;
+  auto get_node_names() -> std::vector<std::string>&;
+
   void set_node_datas(std::vector<setup::Node_Data> const& value);
   void set_node_datas(std::vector<setup::Node_Data>&& value);
   auto get_node_datas() const -> std::vector<setup::Node_Data> const&;
@@ -457,6 +493,7 @@ public:
 
 private:
   uint32_t m_req_id = {0};
+  std::vector<std::string> m_node_names;
   std::vector<setup::Node_Data> m_node_datas;
 };
 
@@ -649,130 +686,265 @@ public:
   void set_req_id(uint32_t&& value);
   auto get_req_id() const -> uint32_t const&;
 
+  void set_name(std::string const& value);
+  void set_name(std::string&& value);
+  auto get_name() const -> std::string const&;
+
 private:
   uint32_t m_req_id = {0};
+  std::string m_name;
 };
 
 typedef boost::variant<setup::Get_AST_Req,setup::Set_Clock_Req,setup::Set_UAV_Descriptor_Req,setup::Get_UAV_Descriptor_Req,setup::Get_Node_Defs_Req,setup::Remove_Node_Req,setup::Add_Node_Req,setup::Get_Nodes_Req,setup::Set_Node_Input_Stream_Path_Req,setup::Set_Stream_Telemetry_Enabled_Req,setup::Set_Node_Config_Req> Brain_Req;
 typedef boost::variant<setup::Get_AST_Res,setup::Set_Clock_Res,setup::Set_UAV_Descriptor_Res,setup::Get_UAV_Descriptor_Res,setup::Get_Node_Defs_Res,setup::Remove_Node_Res,setup::Add_Node_Res,setup::Get_Nodes_Res,setup::Set_Node_Input_Stream_Path_Res,setup::Set_Stream_Telemetry_Enabled_Res,setup::Set_Node_Config_Res,setup::Error> Brain_Res;
 }
-ts::Result<void> deserialize(bool& value, ts::sz::Value const& sz_value);
-ts::sz::Value serialize(bool const& value);
 ts::Result<void> deserialize(std::string& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::string const& value);
+ts::Result<void> deserialize(std::string& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::string const& value);
+ts::Result<void> deserialize(bool& value, ts::sz::Value const& sz_value);
+ts::sz::Value serialize(bool const& value);
+ts::Result<void> deserialize(bool& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, bool const& value);
 ts::Result<void> deserialize(int64_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int64_t const& value);
+ts::Result<void> deserialize(int64_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int64_t const& value);
 ts::Result<void> deserialize(float& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(float const& value);
+ts::Result<void> deserialize(float& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, float const& value);
 ts::Result<void> deserialize(double& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(double const& value);
+ts::Result<void> deserialize(double& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, double const& value);
 ts::Result<void> deserialize(vec2f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2f const& value);
+ts::Result<void> deserialize(vec2f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2f const& value);
 ts::Result<void> deserialize(vec2d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2d const& value);
+ts::Result<void> deserialize(vec2d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2d const& value);
 ts::Result<void> deserialize(vec2i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec2i const& value);
+ts::Result<void> deserialize(vec2i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec2i const& value);
 ts::Result<void> deserialize(vec3f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3f const& value);
+ts::Result<void> deserialize(vec3f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3f const& value);
 ts::Result<void> deserialize(vec3d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3d const& value);
+ts::Result<void> deserialize(vec3d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3d const& value);
 ts::Result<void> deserialize(vec3i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec3i const& value);
+ts::Result<void> deserialize(vec3i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec3i const& value);
 ts::Result<void> deserialize(vec4f& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4f const& value);
+ts::Result<void> deserialize(vec4f& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4f const& value);
 ts::Result<void> deserialize(vec4d& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4d const& value);
+ts::Result<void> deserialize(vec4d& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4d const& value);
 ts::Result<void> deserialize(vec4i& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(vec4i const& value);
+ts::Result<void> deserialize(vec4i& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, vec4i const& value);
 ts::Result<void> deserialize(int8_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int8_t const& value);
+ts::Result<void> deserialize(int8_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int8_t const& value);
 ts::Result<void> deserialize(uint8_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint8_t const& value);
+ts::Result<void> deserialize(uint8_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint8_t const& value);
 ts::Result<void> deserialize(int16_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int16_t const& value);
+ts::Result<void> deserialize(int16_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int16_t const& value);
 ts::Result<void> deserialize(uint16_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint16_t const& value);
+ts::Result<void> deserialize(uint16_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint16_t const& value);
 ts::Result<void> deserialize(int32_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(int32_t const& value);
+ts::Result<void> deserialize(int32_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, int32_t const& value);
 ts::Result<void> deserialize(uint32_t& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(uint32_t const& value);
+ts::Result<void> deserialize(uint32_t& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, uint32_t const& value);
 ts::Result<void> deserialize(setup::IReq& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::IReq const& value);
+ts::Result<void> deserialize(setup::IReq& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::IReq const& value);
 ts::Result<void> deserialize(setup::IRes& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::IRes const& value);
+ts::Result<void> deserialize(setup::IRes& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::IRes const& value);
 ts::Result<void> deserialize(setup::Error& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Error const& value);
+ts::Result<void> deserialize(setup::Error& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Error const& value);
 ts::Result<void> deserialize(setup::Get_AST_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_AST_Req const& value);
+ts::Result<void> deserialize(setup::Get_AST_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_AST_Req const& value);
 ts::Result<void> deserialize(setup::Get_AST_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_AST_Res const& value);
+ts::Result<void> deserialize(setup::Get_AST_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_AST_Res const& value);
 ts::Result<void> deserialize(setup::Set_Clock_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Clock_Req const& value);
+ts::Result<void> deserialize(setup::Set_Clock_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Clock_Req const& value);
 ts::Result<void> deserialize(setup::Set_Clock_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Clock_Res const& value);
+ts::Result<void> deserialize(setup::Set_Clock_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Clock_Res const& value);
 ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_UAV_Descriptor_Req const& value);
+ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_UAV_Descriptor_Req const& value);
 ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_UAV_Descriptor_Res const& value);
+ts::Result<void> deserialize(setup::Set_UAV_Descriptor_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_UAV_Descriptor_Res const& value);
 ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_UAV_Descriptor_Req const& value);
+ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_UAV_Descriptor_Req const& value);
 ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_UAV_Descriptor_Res const& value);
+ts::Result<void> deserialize(setup::Get_UAV_Descriptor_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_UAV_Descriptor_Res const& value);
 ts::Result<void> deserialize(setup::Node_Def_Data::Input& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Def_Data::Input const& value);
+ts::Result<void> deserialize(setup::Node_Def_Data::Input& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data::Input const& value);
 ts::Result<void> deserialize(setup::Node_Def_Data::Output& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Def_Data::Output const& value);
+ts::Result<void> deserialize(setup::Node_Def_Data::Output& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data::Output const& value);
 ts::Result<void> deserialize(setup::Node_Def_Data& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Def_Data const& value);
+ts::Result<void> deserialize(setup::Node_Def_Data& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Def_Data const& value);
 ts::Result<void> deserialize(setup::Get_Node_Defs_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_Node_Defs_Req const& value);
+ts::Result<void> deserialize(setup::Get_Node_Defs_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Node_Defs_Req const& value);
 ts::Result<void> deserialize(setup::Get_Node_Defs_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_Node_Defs_Res const& value);
+ts::Result<void> deserialize(setup::Get_Node_Defs_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Node_Defs_Res const& value);
 ts::Result<void> deserialize(setup::Node_Data::Input& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Data::Input const& value);
+ts::Result<void> deserialize(setup::Node_Data::Input& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data::Input const& value);
 ts::Result<void> deserialize(setup::Node_Data::Output& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Data::Output const& value);
+ts::Result<void> deserialize(setup::Node_Data::Output& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data::Output const& value);
 ts::Result<void> deserialize(setup::Node_Data& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Node_Data const& value);
+ts::Result<void> deserialize(setup::Node_Data& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Node_Data const& value);
+ts::Result<void> deserialize(setup::Get_Nodes_Req::Known_Node& value, ts::sz::Value const& sz_value);
+ts::sz::Value serialize(setup::Get_Nodes_Req::Known_Node const& value);
+ts::Result<void> deserialize(setup::Get_Nodes_Req::Known_Node& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Req::Known_Node const& value);
 ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_Nodes_Req const& value);
+ts::Result<void> deserialize(setup::Get_Nodes_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Req const& value);
 ts::Result<void> deserialize(setup::Get_Nodes_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Get_Nodes_Res const& value);
+ts::Result<void> deserialize(setup::Get_Nodes_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Get_Nodes_Res const& value);
 ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Node_Input_Stream_Path_Req const& value);
+ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Input_Stream_Path_Req const& value);
 ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Node_Input_Stream_Path_Res const& value);
+ts::Result<void> deserialize(setup::Set_Node_Input_Stream_Path_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Input_Stream_Path_Res const& value);
 ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Stream_Telemetry_Enabled_Req const& value);
+ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Stream_Telemetry_Enabled_Req const& value);
 ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Stream_Telemetry_Enabled_Res const& value);
+ts::Result<void> deserialize(setup::Set_Stream_Telemetry_Enabled_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Stream_Telemetry_Enabled_Res const& value);
 ts::Result<void> deserialize(setup::Add_Node_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Add_Node_Req const& value);
+ts::Result<void> deserialize(setup::Add_Node_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Add_Node_Req const& value);
 ts::Result<void> deserialize(setup::Add_Node_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Add_Node_Res const& value);
+ts::Result<void> deserialize(setup::Add_Node_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Add_Node_Res const& value);
 ts::Result<void> deserialize(setup::Set_Node_Config_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Node_Config_Req const& value);
+ts::Result<void> deserialize(setup::Set_Node_Config_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Config_Req const& value);
 ts::Result<void> deserialize(setup::Set_Node_Config_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Set_Node_Config_Res const& value);
+ts::Result<void> deserialize(setup::Set_Node_Config_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Set_Node_Config_Res const& value);
 ts::Result<void> deserialize(setup::Remove_Node_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Remove_Node_Req const& value);
+ts::Result<void> deserialize(setup::Remove_Node_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Remove_Node_Req const& value);
 ts::Result<void> deserialize(setup::Remove_Node_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Remove_Node_Res const& value);
+ts::Result<void> deserialize(setup::Remove_Node_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Remove_Node_Res const& value);
 ts::Result<void> deserialize(setup::Brain_Req& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Brain_Req const& value);
+ts::Result<void> deserialize(setup::Brain_Req& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Brain_Req const& value);
 ts::Result<void> deserialize(setup::Brain_Res& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(setup::Brain_Res const& value);
+ts::Result<void> deserialize(setup::Brain_Res& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, setup::Brain_Res const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Input>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Def_Data::Input> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Input>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data::Input> const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Output>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Def_Data::Output> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data::Output>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data::Output> const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Def_Data>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Def_Data> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Def_Data>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Def_Data> const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Data::Input>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Data::Input> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Data::Input>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data::Input> const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Data::Output>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Data::Output> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Data::Output>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data::Output> const& value);
+ts::Result<void> deserialize(std::vector<setup::Get_Nodes_Req::Known_Node>& value, ts::sz::Value const& sz_value);
+ts::sz::Value serialize(std::vector<setup::Get_Nodes_Req::Known_Node> const& value);
+ts::Result<void> deserialize(std::vector<setup::Get_Nodes_Req::Known_Node>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Get_Nodes_Req::Known_Node> const& value);
+ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Value const& sz_value);
+ts::sz::Value serialize(std::vector<std::string> const& value);
+ts::Result<void> deserialize(std::vector<std::string>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<std::string> const& value);
 ts::Result<void> deserialize(std::vector<setup::Node_Data>& value, ts::sz::Value const& sz_value);
 ts::sz::Value serialize(std::vector<setup::Node_Data> const& value);
+ts::Result<void> deserialize(std::vector<setup::Node_Data>& value, ts::sz::Binary_Reader& reader);
+void serialize(ts::sz::Binary_Writer& writer, std::vector<setup::Node_Data> const& value);
 }
 }
@@ -15,7 +15,7 @@ public:
 
     typedef math::vec3f       Value; //micro T(eslas)
     typedef stream::Sample<Value>     Sample;
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 typedef IMagnetic_FieldT<Space::LOCAL>    IMagnetic_Field;
@@ -124,7 +124,7 @@ public:
 
     virtual ~IMultirotor_Commands() = default;
 
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 
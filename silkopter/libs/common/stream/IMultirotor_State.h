@@ -59,7 +59,7 @@ public:
 
     virtual ~IMultirotor_State() {}
 
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 
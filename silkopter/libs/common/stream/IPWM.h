@@ -14,7 +14,7 @@ public:
 
     typedef float                   Value; //0 .. 1 representing duty cycle
     typedef stream::Sample<Value>     Sample;
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 
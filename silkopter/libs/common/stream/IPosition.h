@@ -16,7 +16,7 @@ public:
 
     typedef util::coordinates::ECEF Value; //meters
     typedef stream::Sample<Value>     Sample;
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 class ILLA_Position : public ISpatial_Stream<Semantic::POSITION, Space::LLA>
@@ -26,7 +26,7 @@ public:
 
     typedef util::coordinates::LLA Value;
     typedef stream::Sample<Value>     Sample;
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "utils/Serialization.h"
+#include "utils/Ring_Buffer.h"
 
 namespace silk
 {
@@ -103,9 +104,9 @@ struct Type
     }
     Type() : Type(Semantic::ACCELERATION, Space::LOCAL) {}
 
-    Semantic get_semantic() const { return static_cast<Semantic>((id >> 8) & 0xFF); }
-    Space get_space() const { return static_cast<Space>((id) & 0xFF); }
-    uint16_t get_id() const { return id; }
+    constexpr Semantic get_semantic() const { return static_cast<Semantic>((id >> 8) & 0xFF); }
+    constexpr Space get_space() const { return static_cast<Space>((id) & 0xFF); }
+    constexpr uint16_t get_id() const { return id; }
 
     bool operator==(Type const& other) const { return id == other.id; }
     bool operator!=(Type const& other) const { return !operator==(other); }
@@ -133,6 +134,9 @@ public:
 
     virtual auto get_rate() const -> uint32_t = 0;
     virtual auto get_type() const -> Type = 0;
+
+    //How much the samples lag behind the signal they were computed from because of filtering (like the resampler filters)
+    virtual auto get_group_delay() const -> q::Clock::duration { return q::Clock::duration(0); }
 };
 
 
@@ -149,6 +153,9 @@ template<class T> struct Sample
 
     T value;
     bool is_healthy = false;
+
+    //when the sensor reading this sample was computed from was taken. Not serialized, it's used to track latency
+    q::Clock::time_point tp;
 };
 
 
@@ -15,7 +15,7 @@ public:
 
     typedef math::vec3f             Value; //Nm
     typedef stream::Sample<Value>     Sample;
-    virtual auto get_samples() const -> std::vector<Sample> const& = 0;
+    virtual auto get_samples() const -> util::Ring_Buffer<Sample> const& = 0;
 };
 
 typedef ITorqueT<Space::LOCAL>    ITorque;
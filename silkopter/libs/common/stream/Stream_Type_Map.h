@@ -0,0 +1,100 @@
+#pragma once
+
+#include "IAcceleration.h"
+#include "IADC.h"
+#include "IAngular_Velocity.h"
+#include "IBattery_State.h"
+#include "IBool.h"
+#include "ICurrent.h"
+#include "IDistance.h"
+#include "IFloat.h"
+#include "IForce.h"
+#include "IFrame.h"
+#include "IGPS_Info.h"
+#include "ILinear_Acceleration.h"
+#include "IMagnetic_Field.h"
+#include "IMultirotor_Commands.h"
+#include "IMultirotor_State.h"
+#include "IPosition.h"
+#include "IPressure.h"
+#include "IProximity.h"
+#include "IPWM.h"
+#include "ITemperature.h"
+#include "IThrottle.h"
+#include "ITorque.h"
+#include "IVelocity.h"
+#include "IVideo.h"
+#include "IVoltage.h"
+
+#include <unordered_map>
+
+namespace silk
+{
+namespace stream
+{
+
+template<class... Streams> struct Stream_List {};
+
+//All the stream interfaces that can be sent around - as telemetry or to the viewers.
+//A new interface added here gets all of these without touching the comms.
+//ILLA_Position is missing on purpose, nothing produces it and its value cannot be serialized.
+typedef Stream_List<
+    IAcceleration, IENU_Acceleration, IECEF_Acceleration,
+    IAngular_Velocity, IENU_Angular_Velocity, IECEF_Angular_Velocity,
+    IMagnetic_Field, IENU_Magnetic_Field, IECEF_Magnetic_Field,
+    ILinear_Acceleration, IENU_Linear_Acceleration, IECEF_Linear_Acceleration,
+    IDistance, IENU_Distance, IECEF_Distance,
+    IForce, IENU_Force, IECEF_Force,
+    ITorque, IENU_Torque, IECEF_Torque,
+    IVelocity, IENU_Velocity, IECEF_Velocity,
+    IGimbal_Frame, IFrame, IENU_Frame,
+    IECEF_Position,
+    IADC, IBattery_State, IBool, ICurrent, IFloat, IGPS_Info, IPressure, IPWM, ITemperature, IThrottle, IVoltage,
+    IMultirotor_Commands, IMultirotor_State, IProximity, IVideo
+> All_Streams;
+
+//A table from stream type to something built for each stream interface in All_Streams.
+//
+//The factory has a template<class Stream> T create() method and it's called once for every interface at construction,
+// so whatever depends on the interface type (a serializer, a sample holder) is resolved there and looking up
+// a type afterwards is a single hash lookup instead of trying the interfaces one by one.
+template<class T>
+class Stream_Type_Map
+{
+public:
+    template<class Factory>
+    explicit Stream_Type_Map(Factory&& factory)
+    {
+        add(factory, All_Streams());
+    }
+
+    //nullptr if the type is unknown
+    auto find(Type type) const -> T const*
+    {
+        auto it = m_entries.find(type.get_id());
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+    auto find(Type type) -> T*
+    {
+        auto it = m_entries.find(type.get_id());
+        return it != m_entries.end() ? &it->second : nullptr;
+    }
+
+private:
+    template<class Factory>
+    void add(Factory&, Stream_List<>)
+    {
+    }
+    template<class Factory, class Stream, class... Rest>
+    void add(Factory& factory, Stream_List<Stream, Rest...>)
+    {
+        bool is_new = m_entries.emplace(Stream::TYPE.get_id(), factory.template create<Stream>()).second;
+        QASSERT_MSG(is_new, "Duplicated stream type {}", get_as_string(Stream::TYPE, false));
+        add(factory, Stream_List<Rest...>());
+    }
+
+    std::unordered_map<uint16_t, T> m_entries;
+};
+
+}
+}
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "IStream.h"
+#include "utils/Column_Codec.h"
+
+namespace silk
+{
+namespace stream
+{
+
+//Decimal exponent of the quantization step used when sending the samples as telemetry.
+//It's well under the noise of the sensors producing them. Some semantics are sent lossless
+inline auto get_telemetry_quantization(Semantic semantic) -> int8_t
+{
+    switch (semantic)
+    {
+    case Semantic::ACCELERATION: return -3;         //1 mm/s^2
+    case Semantic::ADC: return -4;
+    case Semantic::ANGULAR_VELOCITY: return -3;     //1 mrad/s
+    case Semantic::CURRENT: return -3;              //1 mA
+    case Semantic::DISTANCE: return -3;             //1 mm
+    case Semantic::FORCE: return -3;                //1 mN
+    case Semantic::FRAME: return -5;
+    case Semantic::LINEAR_ACCELERATION: return -3;  //1 mm/s^2
+    case Semantic::POSITION: return -3;             //1 mm
+    case Semantic::MAGNETIC_FIELD: return -2;       //0.01 uT
+    case Semantic::PWM: return -4;
+    case Semantic::TEMPERATURE: return -2;          //0.01 degrees
+    case Semantic::TORQUE: return -4;               //0.1 mNm
+    case Semantic::VELOCITY: return -3;             //1 mm/s
+    case Semantic::THROTTLE: return -4;
+    case Semantic::VOLTAGE: return -3;              //1 mV
+    case Semantic::PRESSURE: return util::column_codec::LOSSLESS; //the altitude comes from these, a few Pa is a meter
+    case Semantic::FLOAT: return util::column_codec::LOSSLESS; //no idea what it is
+    default: return util::column_codec::LOSSLESS;
+    }
+}
+
+namespace detail
+{
+
+enum class Telemetry_Layout
+{
+    ROWS,       //serialized as they are, value after value
+    COLUMNS,    //a float column for each component
+    BOOL        //run-length encoded
+};
+
+//How a value is split in columns
+template<class T> struct Telemetry_Columns
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::ROWS;
+    typedef float Scalar;
+};
+template<> struct Telemetry_Columns<bool>
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::BOOL;
+    typedef float Scalar;
+};
+template<> struct Telemetry_Columns<float>
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::COLUMNS;
+    static constexpr size_t COUNT = 1;
+    typedef float Scalar;
+    static auto get(float const& v, size_t) -> Scalar { return v; }
+    static void set(float& v, size_t, Scalar s) { v = s; }
+};
+template<> struct Telemetry_Columns<double>
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::COLUMNS;
+    static constexpr size_t COUNT = 1;
+    typedef double Scalar;
+    static auto get(double const& v, size_t) -> Scalar { return v; }
+    static void set(double& v, size_t, Scalar s) { v = s; }
+};
+template<class T> struct Telemetry_Columns<math::vec3<T>>
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::COLUMNS;
+    static constexpr size_t COUNT = 3;
+    typedef T Scalar;
+    static auto get(math::vec3<T> const& v, size_t c) -> Scalar { return c == 0 ? v.x : c == 1 ? v.y : v.z; }
+    static void set(math::vec3<T>& v, size_t c, Scalar s) { (c == 0 ? v.x : c == 1 ? v.y : v.z) = s; }
+};
+template<class T> struct Telemetry_Columns<math::quat<T>>
+{
+    static constexpr Telemetry_Layout LAYOUT = Telemetry_Layout::COLUMNS;
+    static constexpr size_t COUNT = 4;
+    typedef T Scalar;
+    static auto get(math::quat<T> const& v, size_t c) -> Scalar { return c == 0 ? v.x : c == 1 ? v.y : c == 2 ? v.z : v.w; }
+    static void set(math::quat<T>& v, size_t c, Scalar s) { (c == 0 ? v.x : c == 1 ? v.y : c == 2 ? v.z : v.w) = s; }
+};
+
+}
+
+//Encodes batches of samples of a stream for the telemetry channel.
+//
+//The samples are transposed in columns: the health bits first, run-length encoded, and then one column per value component.
+//Float components are quantized with the step of the stream semantic and delta encoded, so a slowly changing
+// signal takes a byte or two per component instead of 4 or 8. Lossless semantics use the XOR encoding.
+//Values that don't split in float components (structs, video) are serialized as they are, after the health column.
+//The sample count is not encoded, it has to be sent along.
+template<class Stream>
+class Telemetry_Codec
+{
+public:
+    typedef typename Stream::Value Value;
+    typedef typename Stream::Sample Sample;
+    typedef util::serialization::Buffer_t Buffer_t;
+
+    void encode(Buffer_t& buffer, std::vector<Sample> const& samples, size_t& off)
+    {
+        m_bool_column.resize(samples.size());
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            m_bool_column[i] = samples[i].is_healthy ? 1 : 0;
+        }
+        util::column_codec::encode_bool_column(buffer, m_bool_column, off);
+
+        encode_values(buffer, samples, off, Layout_Tag<Columns::LAYOUT>());
+    }
+
+    //At most util::column_codec::MAX_BOOL_COLUMN_SIZE samples, the health column is a bool one
+    auto decode(Buffer_t const& buffer, size_t count, std::vector<Sample>& samples, size_t& off) -> bool
+    {
+        //the count comes from the same packet, it's checked against what's left of it before allocating the samples
+        if (count > util::column_codec::MAX_BOOL_COLUMN_SIZE ||
+                !util::column_codec::is_count_possible(buffer, count, get_min_value_bits(Layout_Tag<Columns::LAYOUT>()), off))
+        {
+            return false;
+        }
+        samples.resize(count);
+        if (!util::column_codec::decode_bool_column(buffer, count, m_bool_column, off))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++)
+        {
+            samples[i].is_healthy = m_bool_column[i] != 0;
+        }
+
+        return decode_values(buffer, samples, off, Layout_Tag<Columns::LAYOUT>());
+    }
+
+private:
+    typedef detail::Telemetry_Columns<Value> Columns;
+    typedef typename Columns::Scalar Scalar;
+    template<detail::Telemetry_Layout L> struct Layout_Tag {};
+
+    //The least each sample value can take in the packet
+    static constexpr auto get_min_value_bits(Layout_Tag<detail::Telemetry_Layout::ROWS>) -> size_t { return 8; }
+    static constexpr auto get_min_value_bits(Layout_Tag<detail::Telemetry_Layout::COLUMNS>) -> size_t { return Columns::COUNT; }
+    static constexpr auto get_min_value_bits(Layout_Tag<detail::Telemetry_Layout::BOOL>) -> size_t { return 0; }
+
+    void encode_values(Buffer_t& buffer, std::vector<Sample> const& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::ROWS>)
+    {
+        for (Sample const& sample: samples)
+        {
+            util::serialization::serialize(buffer, sample.value, off);
+        }
+    }
+    auto decode_values(Buffer_t const& buffer, std::vector<Sample>& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::ROWS>) -> bool
+    {
+        for (Sample& sample: samples)
+        {
+            if (!util::serialization::deserialize(buffer, sample.value, off))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void encode_values(Buffer_t& buffer, std::vector<Sample> const& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::COLUMNS>)
+    {
+        int8_t exponent = get_telemetry_quantization(Stream::TYPE.get_semantic());
+        m_column.resize(samples.size());
+        for (size_t c = 0; c < Columns::COUNT; c++)
+        {
+            for (size_t i = 0; i < samples.size(); i++)
+            {
+                m_column[i] = Columns::get(samples[i].value, c);
+            }
+            util::column_codec::encode_float_column(buffer, m_column, exponent, off);
+        }
+    }
+    auto decode_values(Buffer_t const& buffer, std::vector<Sample>& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::COLUMNS>) -> bool
+    {
+        for (size_t c = 0; c < Columns::COUNT; c++)
+        {
+            if (!util::column_codec::decode_float_column(buffer, samples.size(), m_column, off))
+            {
+                return false;
+            }
+            for (size_t i = 0; i < samples.size(); i++)
+            {
+                Columns::set(samples[i].value, c, m_column[i]);
+            }
+        }
+        return true;
+    }
+
+    void encode_values(Buffer_t& buffer, std::vector<Sample> const& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::BOOL>)
+    {
+        m_bool_column.resize(samples.size());
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            m_bool_column[i] = samples[i].value ? 1 : 0;
+        }
+        util::column_codec::encode_bool_column(buffer, m_bool_column, off);
+    }
+    auto decode_values(Buffer_t const& buffer, std::vector<Sample>& samples, size_t& off, Layout_Tag<detail::Telemetry_Layout::BOOL>) -> bool
+    {
+        if (!util::column_codec::decode_bool_column(buffer, samples.size(), m_bool_column, off))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            samples[i].value = m_bool_column[i] != 0;
+        }
+        return true;
+    }
+
+    std::vector<uint8_t> m_bool_column;
+    std::vector<Scalar> m_column;
+};
+
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "qmath.h"
+#include "Simd.h"
 
 namespace util
 {
@@ -66,6 +67,94 @@ template<> inline void apply_coefficients(math::vec2f& x, math::vec2f& w0, math:
     MATH_ASSERT(math::is_finite(w1));
 }
 
+//Block processing.
+//Each biquad stage runs over the whole block before the next one so its coefficients and state stay in registers.
+//There are no asserts in the loops - the block is checked once at the end.
+
+template<class T> void process_stage(T* x, size_t count, T& w1, T& w2, double d1, double d2, double A)
+{
+    T w0;
+    for (size_t i = 0; i < count; i++)
+    {
+        apply_coefficients(x[i], w0, w1, w2, d1, d2, A);
+    }
+}
+
+//double accumulators. The state is promoted once per block instead of once per sample
+inline void process_stage(math::vec3f* x, size_t count, math::vec3f& w1, math::vec3f& w2, double d1, double d2, double A)
+{
+    double w1x = w1.x, w1y = w1.y, w1z = w1.z;
+    double w2x = w2.x, w2y = w2.y, w2z = w2.z;
+    for (size_t i = 0; i < count; i++)
+    {
+        math::vec3f& v = x[i];
+        double w0x = d1*w1x + d2*w2x + v.x;
+        double w0y = d1*w1y + d2*w2y + v.y;
+        double w0z = d1*w1z + d2*w2z + v.z;
+        v.set(static_cast<float>(A*(w0x + 2.0*w1x + w2x)),
+              static_cast<float>(A*(w0y + 2.0*w1y + w2y)),
+              static_cast<float>(A*(w0z + 2.0*w1z + w2z)));
+        w2x = w1x; w2y = w1y; w2z = w1z;
+        w1x = w0x; w1y = w0y; w1z = w0z;
+    }
+    w1.set(static_cast<float>(w1x), static_cast<float>(w1y), static_cast<float>(w1z));
+    w2.set(static_cast<float>(w2x), static_cast<float>(w2y), static_cast<float>(w2z));
+}
+
+//float accumulators, the 3 axes in one SIMD register (the 4th lane is ignored)
+inline void process_stage(math::vec3f* x, size_t count, math::vec3f& w1, math::vec3f& w2, float d1, float d2, float A)
+{
+#if defined UTIL_SIMD_NEON
+    auto load = [](math::vec3f const& v) { return vcombine_f32(vld1_f32(&v.x), vdup_n_f32(v.z)); };
+    auto store = [](math::vec3f& v, float32x4_t r) { vst1_f32(&v.x, vget_low_f32(r)); vst1q_lane_f32(&v.z, r, 2); };
+
+    float32x4_t vw1 = load(w1);
+    float32x4_t vw2 = load(w2);
+    for (size_t i = 0; i < count; i++)
+    {
+        float32x4_t vw0 = vmlaq_n_f32(vmlaq_n_f32(load(x[i]), vw1, d1), vw2, d2);
+        float32x4_t r = vmulq_n_f32(vaddq_f32(vaddq_f32(vw0, vw2), vaddq_f32(vw1, vw1)), A);
+        store(x[i], r);
+        vw2 = vw1;
+        vw1 = vw0;
+    }
+    store(w1, vw1);
+    store(w2, vw2);
+#elif defined UTIL_SIMD_SSE2
+    auto load = [](math::vec3f const& v) { return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<__m64 const*>(&v.x)), _mm_load_ss(&v.z)); };
+    auto store = [](math::vec3f& v, __m128 r) { _mm_storel_pi(reinterpret_cast<__m64*>(&v.x), r); _mm_store_ss(&v.z, _mm_movehl_ps(r, r)); };
+
+    __m128 vd1 = _mm_set1_ps(d1);
+    __m128 vd2 = _mm_set1_ps(d2);
+    __m128 vA = _mm_set1_ps(A);
+    __m128 vw1 = load(w1);
+    __m128 vw2 = load(w2);
+    for (size_t i = 0; i < count; i++)
+    {
+        __m128 vw0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vw1, vd1), _mm_mul_ps(vw2, vd2)), load(x[i]));
+        __m128 r = _mm_mul_ps(_mm_add_ps(_mm_add_ps(vw0, vw2), _mm_add_ps(vw1, vw1)), vA);
+        store(x[i], r);
+        vw2 = vw1;
+        vw1 = vw0;
+    }
+    store(w1, vw1);
+    store(w2, vw2);
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        math::vec3f w0 = d1*w1 + d2*w2 + x[i];
+        x[i] = A*(w0 + 2.f*w1 + w2);
+        w2 = w1;
+        w1 = w0;
+    }
+#endif
+}
+
+template<class T> void process_stage(T* x, size_t count, T& w1, T& w2, float d1, float d2, float A)
+{
+    process_stage(x, count, w1, w2, double(d1), double(d2), double(A));
+}
+
 }
 
 
@@ -78,7 +167,16 @@ class Butterworth
 public:
     Butterworth() = default;
 
-    bool setup(size_t order, float rate, float cutoff_frequency)
+    //Only the block processing of vec3f streams has a float path. Float is precise enough
+    // unless the cutoff is very low compared to the rate - then the poles get too close to 1.
+    enum class Precision
+    {
+        AUTO,
+        FLOAT,
+        DOUBLE
+    };
+
+    bool setup(size_t order, float rate, float cutoff_frequency, Precision precision = Precision::AUTO)
     {
         if (rate < math::epsilon<float>() ||
                 cutoff_frequency < math::epsilon<float>() ||
@@ -103,6 +201,9 @@ public:
         A.resize(m_order);
         d1.resize(m_order);
         d2.resize(m_order);
+        Af.resize(m_order);
+        d1f.resize(m_order);
+        d2f.resize(m_order);
         w0.resize(m_order);
         w1.resize(m_order);
         w2.resize(m_order);
@@ -116,11 +217,32 @@ public:
             A[i] = a2/s;
             d1[i] = 2.0*(1.0-a2)/s;
             d2[i] = -(a2 - 2.0*a*r + 1.0)/s;
+            Af[i] = static_cast<float>(A[i]);
+            d1f[i] = static_cast<float>(d1[i]);
+            d2f[i] = static_cast<float>(d2[i]);
         }
 
+        constexpr float k_min_float_cutoff_ratio = 0.01f;
+        m_use_double = precision == Precision::DOUBLE ||
+                (precision == Precision::AUTO && cutoff_frequency / rate < k_min_float_cutoff_ratio);
+
+        //each section adds 2*r/w of delay at DC, w being the prewarped cutoff: 2*rate*a
+        double group_delay = 0;
+        for(size_t i = 0; i < m_order; ++i)
+        {
+            group_delay += math::sin(math::angled::pi*(2.0*i+1.0)/(4.0*m_order)) / (rate*a);
+        }
+        m_group_delay = static_cast<float>(group_delay);
+
         return true;
     }
 
+    //At DC, in seconds. It's the delay of the slow signals - the ones the filter lets through
+    auto get_group_delay() const -> float
+    {
+        return m_group_delay;
+    }
+
     void reset(T const& t)
     {
         for(size_t i = 0; i < m_order; ++i)
@@ -169,13 +291,48 @@ public:
         m_last = t;
     }
 
+    //Filters count samples in place. Equivalent to calling process for each of them but not bit exact:
+    // - the double path keeps the state in double for the whole block where process rounds it to T after every sample
+    // - the float path (Precision::FLOAT or AUTO above k_min_float_cutoff_ratio) uses float coefficients and arithmetic,
+    //   so its error grows as the cutoff gets closer to k_min_float_cutoff_ratio * rate
+    void process(T* values, size_t count)
+    {
+        if (count == 0)
+        {
+            return;
+        }
+        if (m_needs_reset)
+        {
+            m_needs_reset = false;
+            reset(values[0]);
+        }
+        for (size_t i = 0; i < m_order; ++i)
+        {
+            if (m_use_double)
+            {
+                dsp::process_stage(values, count, w1[i], w2[i], d1[i], d2[i], A[i]);
+            }
+            else
+            {
+                dsp::process_stage(values, count, w1[i], w2[i], d1f[i], d2f[i], Af[i]);
+            }
+        }
+        m_last = values[count - 1];
+        MATH_ASSERT(math::is_finite(m_last));
+    }
+
 private:
     size_t m_order = 0;
     float m_rate = 0;
+    float m_group_delay = 0;
     bool m_needs_reset = true;
     std::vector<double> A;
     std::vector<double> d1;
     std::vector<double> d2;
+    std::vector<float> Af;
+    std::vector<float> d1f;
+    std::vector<float> d2f;
+    bool m_use_double = true;
     std::vector<T> w0;
     std::vector<T> w1;
     std::vector<T> w2;
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include "utils/Serialization.h"
+
+namespace util
+{
+namespace column_codec
+{
+
+//Compact encodings for columns of samples, where consecutive values are close to each other.
+//
+//Integers are zigzag encoded (small negative values stay small) and then written as varints, 7 bits per byte.
+//Float columns are either quantized to a decimal step and delta encoded, or XOR-ed with the previous value and
+// only the meaningful bits of the result are written (Gorilla style) when they have to stay lossless.
+//Bool columns are run-length encoded.
+//Like the serialization functions, encoding writes at off and grows the buffer and decoding fails on truncated data.
+
+typedef serialization::Buffer_t Buffer_t;
+
+//the quantization exponent that means keep all the bits
+constexpr int8_t LOSSLESS = std::numeric_limits<int8_t>::max();
+
+//A few bytes of runs hold a bool column of any size so its count cannot be checked against the input. It's capped instead
+constexpr size_t MAX_BOOL_COLUMN_SIZE = 1 << 20;
+
+//Every value takes at least min_bits so a count that needs more bits than what's left is garbage.
+//Checked before reserving anything, like Binary_Reader::read_count
+inline auto is_count_possible(Buffer_t const& buffer, size_t count, size_t min_bits, size_t off) -> bool
+{
+    size_t remaining = off < buffer.size() ? buffer.size() - off : 0;
+    return min_bits == 0 || count <= remaining * 8 / min_bits;
+}
+
+inline auto zigzag(int64_t value) -> uint64_t
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+inline auto unzigzag(uint64_t value) -> int64_t
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+inline void encode_varint(Buffer_t& buffer, uint64_t value, size_t& off)
+{
+    uint8_t data[10];
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        data[size++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    data[size++] = static_cast<uint8_t>(value);
+
+    if (off + size > buffer.size())
+    {
+        buffer.resize(off + size);
+    }
+    std::copy(data, data + size, buffer.data() + off);
+    off += size;
+}
+inline auto decode_varint(Buffer_t const& buffer, uint64_t& value, size_t& off) -> bool
+{
+    value = 0;
+    for (size_t shift = 0; shift < 64; shift += 7)
+    {
+        if (off >= buffer.size())
+        {
+            return false;
+        }
+        uint8_t byte = buffer[off++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////
+
+//MSB first. Call flush when done, the last byte is padded with zeroes
+class Bit_Writer
+{
+public:
+    Bit_Writer(Buffer_t& buffer, size_t& off) : m_buffer(buffer), m_off(off) {}
+
+    void write(uint64_t value, size_t bits)
+    {
+        while (bits > 0)
+        {
+            size_t n = std::min(bits, 8 - m_bit_count);
+            uint32_t chunk = static_cast<uint32_t>(value >> (bits - n)) & ((1u << n) - 1);
+            m_byte = static_cast<uint8_t>((m_byte << n) | chunk);
+            m_bit_count += n;
+            bits -= n;
+            if (m_bit_count == 8)
+            {
+                put_byte();
+            }
+        }
+    }
+    void flush()
+    {
+        if (m_bit_count > 0)
+        {
+            m_byte = static_cast<uint8_t>(m_byte << (8 - m_bit_count));
+            put_byte();
+        }
+    }
+
+private:
+    void put_byte()
+    {
+        serialization::serialize(m_buffer, m_byte, m_off);
+        m_byte = 0;
+        m_bit_count = 0;
+    }
+
+    Buffer_t& m_buffer;
+    size_t& m_off;
+    uint8_t m_byte = 0;
+    size_t m_bit_count = 0;
+};
+
+class Bit_Reader
+{
+public:
+    Bit_Reader(Buffer_t const& buffer, size_t& off) : m_buffer(buffer), m_off(off) {}
+
+    auto read(uint64_t& value, size_t bits) -> bool
+    {
+        value = 0;
+        while (bits > 0)
+        {
+            if (m_bit_count == 0)
+            {
+                if (m_off >= m_buffer.size())
+                {
+                    return false;
+                }
+                m_byte = m_buffer[m_off++];
+                m_bit_count = 8;
+            }
+            size_t n = std::min(bits, m_bit_count);
+            uint32_t chunk = (m_byte >> (m_bit_count - n)) & ((1u << n) - 1);
+            value = (value << n) | chunk;
+            m_bit_count -= n;
+            bits -= n;
+        }
+        return true;
+    }
+
+private:
+    Buffer_t const& m_buffer;
+    size_t& m_off;
+    uint8_t m_byte = 0;
+    size_t m_bit_count = 0;
+};
+
+///////////////////////////////////////////////////
+
+//The first value and then the length of each run. The runs alternate between true and false
+inline void encode_bool_column(Buffer_t& buffer, std::vector<uint8_t> const& column, size_t& off)
+{
+    if (column.empty())
+    {
+        return;
+    }
+
+    bool value = column[0] != 0;
+    serialization::serialize(buffer, static_cast<uint8_t>(value ? 1 : 0), off);
+
+    uint64_t run = 0;
+    for (uint8_t v: column)
+    {
+        if ((v != 0) != value)
+        {
+            encode_varint(buffer, run, off);
+            value = !value;
+            run = 0;
+        }
+        run++;
+    }
+    encode_varint(buffer, run, off);
+}
+inline auto decode_bool_column(Buffer_t const& buffer, size_t count, std::vector<uint8_t>& column, size_t& off) -> bool
+{
+    column.clear();
+    if (count == 0)
+    {
+        return true;
+    }
+
+    if (count > MAX_BOOL_COLUMN_SIZE)
+    {
+        return false;
+    }
+
+    uint8_t value = 0;
+    if (!serialization::deserialize(buffer, value, off) || value > 1)
+    {
+        return false;
+    }
+    column.reserve(count);
+    while (column.size() < count)
+    {
+        uint64_t run = 0;
+        if (!decode_varint(buffer, run, off) || run == 0 || run > count - column.size())
+        {
+            return false;
+        }
+        column.insert(column.end(), static_cast<size_t>(run), value);
+        value ^= 1;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////
+
+namespace detail
+{
+
+template<class T> struct Float_Bits;
+template<> struct Float_Bits<float>
+{
+    typedef uint32_t Bits;
+    static constexpr size_t SIZE = 32;
+    static constexpr size_t SIZE_BITS = 5; //to write 0 .. SIZE - 1
+};
+template<> struct Float_Bits<double>
+{
+    typedef uint64_t Bits;
+    static constexpr size_t SIZE = 64;
+    static constexpr size_t SIZE_BITS = 6;
+};
+
+template<class T> auto to_bits(T value) -> uint64_t
+{
+    typename Float_Bits<T>::Bits bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+template<class T> auto from_bits(uint64_t value) -> T
+{
+    auto bits = static_cast<typename Float_Bits<T>::Bits>(value);
+    T v;
+    std::memcpy(&v, &bits, sizeof(v));
+    return v;
+}
+
+//Every value is XOR-ed with the previous one:
+// 0                                        - same value
+// 1 0 <meaningful bits>                    - the meaningful bits fit in the previous window
+// 1 1 <leading zeroes> <size - 1> <bits>   - new window
+template<class T> void encode_xor_column(Buffer_t& buffer, std::vector<T> const& column, size_t& off)
+{
+    typedef Float_Bits<T> FB;
+
+    Bit_Writer writer(buffer, off);
+    uint64_t prev = to_bits(column[0]);
+    writer.write(prev, FB::SIZE);
+
+    size_t prev_leading = FB::SIZE; //no window yet
+    size_t prev_trailing = 0;
+    for (size_t i = 1; i < column.size(); i++)
+    {
+        uint64_t bits = to_bits(column[i]);
+        uint64_t x = bits ^ prev;
+        prev = bits;
+        if (x == 0)
+        {
+            writer.write(0, 1);
+            continue;
+        }
+
+        size_t leading = static_cast<size_t>(__builtin_clzll(x)) - (64 - FB::SIZE);
+        size_t trailing = static_cast<size_t>(__builtin_ctzll(x));
+        if (prev_leading < FB::SIZE && leading >= prev_leading && trailing >= prev_trailing)
+        {
+            writer.write(2, 2);
+            writer.write(x >> prev_trailing, FB::SIZE - prev_leading - prev_trailing);
+        }
+        else
+        {
+            size_t size = FB::SIZE - leading - trailing;
+            writer.write(3, 2);
+            writer.write(leading, FB::SIZE_BITS);
+            writer.write(size - 1, FB::SIZE_BITS);
+            writer.write(x >> trailing, size);
+            prev_leading = leading;
+            prev_trailing = trailing;
+        }
+    }
+    writer.flush();
+}
+template<class T> auto decode_xor_column(Buffer_t const& buffer, size_t count, std::vector<T>& column, size_t& off) -> bool
+{
+    typedef Float_Bits<T> FB;
+
+    Bit_Reader reader(buffer, off);
+    uint64_t prev = 0;
+    if (!reader.read(prev, FB::SIZE))
+    {
+        return false;
+    }
+    column.push_back(from_bits<T>(prev));
+
+    size_t prev_leading = FB::SIZE;
+    size_t prev_trailing = 0;
+    uint64_t bit = 0;
+    while (column.size() < count)
+    {
+        if (!reader.read(bit, 1))
+        {
+            return false;
+        }
+        if (bit != 0)
+        {
+            uint64_t x = 0;
+            if (!reader.read(bit, 1))
+            {
+                return false;
+            }
+            if (bit == 0)
+            {
+                if (prev_leading >= FB::SIZE || !reader.read(x, FB::SIZE - prev_leading - prev_trailing))
+                {
+                    return false;
+                }
+                x <<= prev_trailing;
+            }
+            else
+            {
+                uint64_t leading = 0, size = 0;
+                if (!reader.read(leading, FB::SIZE_BITS) || !reader.read(size, FB::SIZE_BITS))
+                {
+                    return false;
+                }
+                size++;
+                if (leading + size > FB::SIZE || !reader.read(x, size))
+                {
+                    return false;
+                }
+                prev_leading = leading;
+                prev_trailing = FB::SIZE - leading - size;
+                x <<= prev_trailing;
+            }
+            prev ^= x;
+        }
+        column.push_back(from_bits<T>(prev));
+    }
+    return true;
+}
+
+//Values are quantized to multiples of 10^exponent
+inline auto quantize(double value, int8_t exponent) -> double
+{
+    return std::round(exponent < 0 ? value * std::pow(10.0, -exponent) : value / std::pow(10.0, exponent));
+}
+//dividing by an exact power of 10 is more precise than multiplying with an inexact one
+inline auto dequantize(int64_t value, int8_t exponent) -> double
+{
+    return exponent < 0 ? static_cast<double>(value) / std::pow(10.0, -exponent) : static_cast<double>(value) * std::pow(10.0, exponent);
+}
+
+//NaNs or values too big for the step cannot be quantized
+template<class T> auto is_quantizable(std::vector<T> const& column, int8_t exponent) -> bool
+{
+    constexpr double MAX_QUANTIZED = 4503599627370496.0; //2^52, so the deltas fit as well
+    for (T v: column)
+    {
+        if (!(std::abs(quantize(v, exponent)) < MAX_QUANTIZED))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//The first value and then the deltas
+template<class T> void encode_quantized_column(Buffer_t& buffer, std::vector<T> const& column, int8_t exponent, size_t& off)
+{
+    int64_t prev = 0;
+    for (T v: column)
+    {
+        auto q = static_cast<int64_t>(quantize(v, exponent));
+        encode_varint(buffer, zigzag(q - prev), off);
+        prev = q;
+    }
+}
+template<class T> auto decode_quantized_column(Buffer_t const& buffer, size_t count, int8_t exponent, std::vector<T>& column, size_t& off) -> bool
+{
+    int64_t q = 0;
+    while (column.size() < count)
+    {
+        uint64_t delta = 0;
+        if (!decode_varint(buffer, delta, off))
+        {
+            return false;
+        }
+        q += unzigzag(delta);
+        column.push_back(static_cast<T>(dequantize(q, exponent)));
+    }
+    return true;
+}
+
+}
+
+enum class Column_Mode : uint8_t
+{
+    XOR,
+    QUANTIZED
+};
+
+//Quantized when possible and asked for, otherwise lossless.
+//The mode and the step are stored in the column so the decoder doesn't have to know them in advance
+template<class T> void encode_float_column(Buffer_t& buffer, std::vector<T> const& column, int8_t exponent, size_t& off)
+{
+    static_assert(std::is_floating_point<T>::value, "Only float columns");
+    if (column.empty())
+    {
+        return;
+    }
+
+    if (exponent != LOSSLESS && detail::is_quantizable(column, exponent))
+    {
+        serialization::serialize(buffer, Column_Mode::QUANTIZED, off);
+        serialization::serialize(buffer, exponent, off);
+        detail::encode_quantized_column(buffer, column, exponent, off);
+        return;
+    }
+
+    serialization::serialize(buffer, Column_Mode::XOR, off);
+    detail::encode_xor_column(buffer, column, off);
+}
+template<class T> auto decode_float_column(Buffer_t const& buffer, size_t count, std::vector<T>& column, size_t& off) -> bool
+{
+    static_assert(std::is_floating_point<T>::value, "Only float columns");
+    column.clear();
+    if (count == 0)
+    {
+        return true;
+    }
+
+    Column_Mode mode;
+    if (!serialization::deserialize(buffer, mode, off))
+    {
+        return false;
+    }
+    if (mode == Column_Mode::XOR)
+    {
+        //one bit for each repeated value
+        if (!is_count_possible(buffer, count, 1, off))
+        {
+            return false;
+        }
+        column.reserve(count);
+        return detail::decode_xor_column(buffer, count, column, off);
+    }
+    if (mode == Column_Mode::QUANTIZED)
+    {
+        //one varint byte for each delta
+        int8_t exponent = 0;
+        if (!serialization::deserialize(buffer, exponent, off) ||
+                exponent == LOSSLESS ||
+                !is_count_possible(buffer, count, 8, off))
+        {
+            return false;
+        }
+        column.reserve(count);
+        return detail::decode_quantized_column(buffer, count, exponent, column, off);
+    }
+    return false;
+}
+
+}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Simd.h"
+
+namespace util
+{
+
+//Converts count big endian int16 values (like the ones in the sensor FIFOs) to floats.
+//8 values are converted per iteration with NEON or SSE2 when available, the tail is scalar.
+inline void convert_int16_be_to_float(uint8_t const* src, float* dst, size_t count)
+{
+    size_t i = 0;
+
+#if defined UTIL_SIMD_NEON
+    for (; i + 8 <= count; i += 8)
+    {
+        int16x8_t v = vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(src + i * 2)));
+        vst1q_f32(dst + i, vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))));
+        vst1q_f32(dst + i + 4, vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))));
+    }
+#elif defined UTIL_SIMD_SSE2
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i * 2));
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        //unpack to the high half of each 32 bit lane and shift back to sign extend
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(dst + i, _mm_cvtepi32_ps(lo));
+        _mm_storeu_ps(dst + i + 4, _mm_cvtepi32_ps(hi));
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        dst[i] = static_cast<float>(static_cast<int16_t>((src[i * 2] << 8) | src[i * 2 + 1]));
+    }
+}
+
+}
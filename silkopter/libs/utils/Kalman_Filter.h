@@ -0,0 +1,202 @@
+#pragma once
+
+#include "Eigen/Core"
+#include <array>
+
+namespace util
+{
+
+namespace kf
+{
+
+//Folds the measurements in one at a time so there is no innovation covariance to invert, only a scalar division.
+//This needs uncorrelated measurements (diagonal R).
+//The covariance is updated in Joseph form which keeps it symmetric and positive definite even when the gain is not optimal.
+//For a scalar measurement it reduces to P - k*Ph' - Ph*k' + s*k*k' which is O(St^2).
+//Rows of H that select a single state (most of them) skip the dot products.
+template<class State_Vector, class State_Matrix, class Observation_Matrix, class Measurement_Vector, size_t Me>
+void sequential_update(State_Vector& x,
+                       State_Matrix& P,
+                       Observation_Matrix const& H,
+                       Measurement_Vector const& z,
+                       Measurement_Vector const& R,
+                       std::array<bool, Me> const& has_z)
+{
+    typedef typename State_Vector::Scalar Scalar;
+    constexpr int St = State_Vector::RowsAtCompileTime;
+    static_assert(Observation_Matrix::RowsAtCompileTime == int(Me) && Observation_Matrix::ColsAtCompileTime == St, "Bad observation matrix size");
+
+    typedef State_Vector Vector;
+    for (size_t i = 0; i < Me; i++)
+    {
+        if (!has_z[i])
+        {
+            continue;
+        }
+
+        //is it a unit row?
+        int index = -1;
+        for (int j = 0; j < St; j++)
+        {
+            Scalar h = H(i, j);
+            if (h == Scalar(1) && index < 0)
+            {
+                index = j;
+            }
+            else if (h != Scalar(0))
+            {
+                index = -2;
+                break;
+            }
+        }
+
+        Vector Ph;
+        Scalar y;
+        Scalar s;
+        if (index >= 0)
+        {
+            Ph = P.col(index);
+            y = z(i) - x(index);
+            s = Ph(index) + R(i);
+        }
+        else
+        {
+            auto h = H.row(i);
+            Ph = P * h.transpose();
+            y = z(i) - h.dot(x);
+            s = h.dot(Ph) + R(i);
+        }
+        if (s <= Scalar(0))
+        {
+            continue;
+        }
+
+        Vector k = Ph / s;
+        x += k * y;
+        P += s * (k * k.transpose()) - k * Ph.transpose() - Ph * k.transpose();
+    }
+}
+
+}
+
+//Linear Kalman filter with fixed size matrices - no allocations.
+//
+//Set has_z for the measurements available in this step. When none is available update() does nothing,
+// so a filter running faster than its slowest sensor only pays for the predict.
+template<size_t St, size_t Me, class Scalar = double>
+class Kalman_Filter
+{
+public:
+    typedef Eigen::Matrix<Scalar, St, 1> State_Vector;
+    typedef Eigen::Matrix<Scalar, St, St> State_Matrix;
+    typedef Eigen::Matrix<Scalar, St, 1> Input_Vector;
+    typedef Eigen::Matrix<Scalar, Me, 1> Measurement_Vector;
+    typedef Eigen::Matrix<Scalar, Me, St> Observation_Matrix;
+
+    Kalman_Filter()
+    {
+        A.setIdentity();
+        x.setZero();
+        B.setIdentity();
+        u.setZero();
+        H.setIdentity();
+        z.setZero();
+        P.setIdentity();
+        Q.setIdentity();
+        R.setOnes();
+        has_z.fill(true);
+    }
+
+    //state
+    State_Matrix A; //State transition matrix.
+    State_Vector x; //State estimate
+
+    //input
+    State_Matrix B; //Control matrix. This is used to define linear equations for any control factors.
+    Input_Vector u;
+
+    Observation_Matrix H; //Observation matrix. Multiply a state vector by H to translate it to a measurement vector.
+    Measurement_Vector z; //measurement data
+    std::array<bool, Me> has_z; //which measurements are present
+
+    //error
+    State_Matrix P; //state error
+    State_Matrix Q; //estimated process error covariance
+    Measurement_Vector R; //measurement error variances (the diagonal of the covariance)
+
+    void predict()
+    {
+        x = A * x + B * u; //state prediction
+        P = A * P * A.transpose() + Q; //covariance prediction
+    }
+    void update()
+    {
+        kf::sequential_update(x, P, H, z, R, has_z);
+    }
+
+    void process()
+    {
+        predict();
+        update();
+    }
+};
+
+//Error state Kalman filter.
+//The nominal state lives outside and is propagated with the full nonlinear model. The filter tracks the covariance of the
+// error and, on update, estimates the error from the measurement residuals so the owner can inject it in the nominal state.
+template<size_t St, size_t Me, class Scalar = double>
+class Error_State_Kalman_Filter
+{
+public:
+    typedef Eigen::Matrix<Scalar, St, 1> State_Vector;
+    typedef Eigen::Matrix<Scalar, St, St> State_Matrix;
+    typedef Eigen::Matrix<Scalar, Me, 1> Measurement_Vector;
+    typedef Eigen::Matrix<Scalar, Me, St> Observation_Matrix;
+
+    Error_State_Kalman_Filter()
+    {
+        F.setIdentity();
+        dx.setZero();
+        H.setIdentity();
+        y.setZero();
+        P.setIdentity();
+        Q.setIdentity();
+        R.setOnes();
+        has_y.fill(true);
+    }
+
+    State_Matrix F; //Error transition matrix - the jacobian of the nominal model around the current state
+    State_Vector dx; //Error estimate. Zero between updates
+
+    Observation_Matrix H; //Measurement jacobian
+    Measurement_Vector y; //residuals: measurement - h(nominal state)
+    std::array<bool, Me> has_y;
+
+    State_Matrix P;
+    State_Matrix Q;
+    Measurement_Vector R;
+
+    void predict()
+    {
+        //the error mean stays zero, only the covariance grows
+        P = F * P * F.transpose() + Q;
+    }
+
+    //Returns the error to inject in the nominal state
+    auto update() -> State_Vector const&
+    {
+        dx.setZero();
+        kf::sequential_update(dx, P, H, y, R, has_y);
+        return dx;
+    }
+
+    //Call after injecting dx when the error parametrization depends on the nominal state (like attitude errors).
+    //G is the jacobian of the new error with respect to the old one.
+    void reset(State_Matrix const& G)
+    {
+        P = G * P * G.transpose();
+        dx.setZero();
+    }
+};
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <algorithm>
+
+namespace util
+{
+
+//HDR style histogram of durations with microsecond resolution.
+//The buckets are log-linear: every power of 2 is split in SUB_BUCKET_COUNT linear buckets so the relative error of
+// the percentiles is under 1/SUB_BUCKET_COUNT from 1us to minutes.
+//Recording is a couple of shifts and an increment and it never allocates, so it can be used in the control loop.
+class Latency_Histogram
+{
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 4;
+    static constexpr size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr size_t MAGNITUDE_COUNT = 24; //everything above ~4 minutes ends up in the last bucket
+    static constexpr size_t BUCKET_COUNT = SUB_BUCKET_COUNT * (MAGNITUDE_COUNT + 1);
+
+    void record(std::chrono::nanoseconds duration)
+    {
+        int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+        uint64_t value = us > 0 ? static_cast<uint64_t>(us) : 0;
+
+        m_buckets[get_bucket_index(value)]++;
+        m_count++;
+        m_max = std::max(m_max, value);
+    }
+
+    //adds all the values recorded in the other histogram
+    void merge(Latency_Histogram const& other)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_count += other.m_count;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    void clear()
+    {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_max = 0;
+    }
+
+    auto get_count() const -> size_t
+    {
+        return m_count;
+    }
+    auto get_max() const -> std::chrono::microseconds
+    {
+        return std::chrono::microseconds(m_max);
+    }
+
+    //Returns the upper bound of the bucket containing the percentile (0..1), clamped to the max recorded value.
+    //Zero if nothing was recorded
+    auto get_percentile(float percentile) const -> std::chrono::microseconds
+    {
+        if (m_count == 0)
+        {
+            return std::chrono::microseconds(0);
+        }
+
+        percentile = std::min(std::max(percentile, 0.f), 1.f);
+        size_t target = std::max<size_t>(static_cast<size_t>(percentile * m_count + 0.5f), 1);
+
+        size_t accumulated = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++)
+        {
+            accumulated += m_buckets[i];
+            if (accumulated >= target)
+            {
+                return std::chrono::microseconds(std::min(get_bucket_upper_bound(i), m_max));
+            }
+        }
+        return std::chrono::microseconds(m_max);
+    }
+
+private:
+    static auto get_bucket_index(uint64_t value) -> size_t
+    {
+        if (value < SUB_BUCKET_COUNT)
+        {
+            return static_cast<size_t>(value);
+        }
+
+        size_t msb = 63 - __builtin_clzll(value);
+        size_t shift = msb - SUB_BUCKET_BITS;
+        if (shift >= MAGNITUDE_COUNT)
+        {
+            return BUCKET_COUNT - 1;
+        }
+        size_t sub_bucket = static_cast<size_t>(value >> shift) - SUB_BUCKET_COUNT;
+        return SUB_BUCKET_COUNT + shift * SUB_BUCKET_COUNT + sub_bucket;
+    }
+    static auto get_bucket_upper_bound(size_t index) -> uint64_t
+    {
+        if (index < SUB_BUCKET_COUNT)
+        {
+            return index;
+        }
+        size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_COUNT;
+        size_t sub_bucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_COUNT;
+        return ((static_cast<uint64_t>(SUB_BUCKET_COUNT + sub_bucket + 1)) << shift) - 1;
+    }
+
+    std::array<uint32_t, BUCKET_COUNT> m_buckets = {{}};
+    size_t m_count = 0;
+    uint64_t m_max = 0;
+};
+
+}
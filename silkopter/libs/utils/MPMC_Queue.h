@@ -0,0 +1,139 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+
+namespace util
+{
+
+//Bounded queue with any number of producers and consumers. No locks and no allocations after construction.
+//
+//The same slot sequences as MPSC_Queue, except the consumers also claim a slot by advancing the read index with a CAS.
+//A slot is only reused after its sequence went around the whole queue so a stale index never matches (no ABA).
+//When the queue is full push_back fails and when it's empty pop_front does, neither blocks.
+template<class T>
+class MPMC_Queue
+{
+public:
+    typedef T value_type;
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    explicit MPMC_Queue(size_t capacity = DEFAULT_CAPACITY)
+    {
+        set_capacity(capacity);
+    }
+    MPMC_Queue(MPMC_Queue const&) = delete;
+    MPMC_Queue& operator=(MPMC_Queue const&) = delete;
+
+    //Rounded up to a power of 2. This drops all the items so call it only when nobody is using the queue.
+    void set_capacity(size_t capacity)
+    {
+        size_t c = 2;
+        while (c < capacity)
+        {
+            c <<= 1;
+        }
+        m_slots.reset(new Slot[c]);
+        for (size_t i = 0; i < c; i++)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_capacity = c;
+        m_mask = c - 1;
+        m_read_index.store(0, std::memory_order_relaxed);
+        m_write_index.store(0, std::memory_order_release);
+    }
+    auto get_capacity() const -> size_t
+    {
+        return m_capacity;
+    }
+
+    ///////////////////////////////////////////////////
+    //producers
+
+    auto push_back(T&& value) -> bool
+    {
+        size_t index = m_write_index.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = m_slots[index & m_mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(index);
+            if (diff == 0)
+            {
+                if (m_write_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+                {
+                    slot.value = std::move(value);
+                    slot.sequence.store(index + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                //no consumer got to this slot yet - full
+                return false;
+            }
+            else
+            {
+                index = m_write_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////
+    //consumers
+
+    //The item is moved out so the slot doesn't keep it alive
+    auto pop_front(T& value) -> bool
+    {
+        size_t index = m_read_index.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = m_slots[index & m_mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(index + 1);
+            if (diff == 0)
+            {
+                if (m_read_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(slot.value);
+                    slot.sequence.store(index + m_capacity, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                //no producer published this slot yet - empty
+                return false;
+            }
+            else
+            {
+                index = m_read_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence = {0};
+        T value;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+
+    //the producers' and consumers' indices on their own cache lines
+    uint8_t m_padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> m_write_index = {0};
+    uint8_t m_padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_read_index = {0};
+};
+
+template<class T> constexpr size_t MPMC_Queue<T>::CACHE_LINE_SIZE;
+template<class T> constexpr size_t MPMC_Queue<T>::DEFAULT_CAPACITY;
+
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <memory>
+#include <atomic>
+
+namespace util
+{
+
+//Bounded queue with any number of producers and a single consumer. No locks and no allocations after construction.
+//
+//Every slot has a sequence number that says whose turn it is. A producer claims a slot by advancing the write index and
+// publishes it by advancing the slot sequence, so producers only race each other on the write index and never wait for the consumer.
+//When the queue is full push_back fails instead of growing or blocking.
+template<class T>
+class MPSC_Queue
+{
+public:
+    typedef T value_type;
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t DEFAULT_CAPACITY = 256;
+
+    explicit MPSC_Queue(size_t capacity = DEFAULT_CAPACITY)
+    {
+        set_capacity(capacity);
+    }
+    MPSC_Queue(MPSC_Queue const&) = delete;
+    MPSC_Queue& operator=(MPSC_Queue const&) = delete;
+
+    //Rounded up to a power of 2. This drops all the items so call it only when nobody is using the queue.
+    void set_capacity(size_t capacity)
+    {
+        size_t c = 2;
+        while (c < capacity)
+        {
+            c <<= 1;
+        }
+        m_slots.reset(new Slot[c]);
+        for (size_t i = 0; i < c; i++)
+        {
+            m_slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        m_capacity = c;
+        m_mask = c - 1;
+        m_read_index.store(0, std::memory_order_relaxed);
+        m_write_index.store(0, std::memory_order_release);
+    }
+    auto get_capacity() const -> size_t
+    {
+        return m_capacity;
+    }
+
+    ///////////////////////////////////////////////////
+    //producers
+
+    auto push_back(T const& value) -> bool
+    {
+        Slot* slot = claim();
+        if (!slot)
+        {
+            return false;
+        }
+        slot->value = value;
+        publish(*slot);
+        return true;
+    }
+    auto push_back(T&& value) -> bool
+    {
+        Slot* slot = claim();
+        if (!slot)
+        {
+            return false;
+        }
+        slot->value = std::move(value);
+        publish(*slot);
+        return true;
+    }
+
+    ///////////////////////////////////////////////////
+    //consumer
+
+    //The item is moved out so the slot doesn't keep it alive
+    auto pop_front(T& value) -> bool
+    {
+        size_t read_index = m_read_index.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[read_index & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != read_index + 1)
+        {
+            return false;
+        }
+        value = std::move(slot.value);
+        slot.sequence.store(read_index + m_capacity, std::memory_order_release);
+        m_read_index.store(read_index + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    //Can be called from any thread but from the producers it's only a hint
+    auto empty() const -> bool
+    {
+        size_t read_index = m_read_index.load(std::memory_order_relaxed);
+        return m_slots[read_index & m_mask].sequence.load(std::memory_order_acquire) != read_index + 1;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> sequence = {0};
+        T value;
+    };
+
+    auto claim() -> Slot*
+    {
+        size_t index = m_write_index.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = m_slots[index & m_mask];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(index);
+            if (diff == 0)
+            {
+                if (m_write_index.compare_exchange_weak(index, index + 1, std::memory_order_relaxed))
+                {
+                    return &slot;
+                }
+            }
+            else if (diff < 0)
+            {
+                //the consumer didn't get to this slot yet - full
+                return nullptr;
+            }
+            else
+            {
+                index = m_write_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    void publish(Slot& slot)
+    {
+        slot.sequence.store(slot.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    std::unique_ptr<Slot[]> m_slots;
+    size_t m_capacity = 0;
+    size_t m_mask = 0;
+
+    //the producers' index on its own cache line, away from the consumer's
+    uint8_t m_padding0[CACHE_LINE_SIZE];
+    std::atomic<size_t> m_write_index = {0};
+    uint8_t m_padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> m_read_index = {0};
+};
+
+template<class T> constexpr size_t MPSC_Queue<T>::CACHE_LINE_SIZE;
+template<class T> constexpr size_t MPSC_Queue<T>::DEFAULT_CAPACITY;
+
+}
@@ -0,0 +1,241 @@
+#pragma once
+
+#include "qmath.h"
+#include "Simd.h"
+
+namespace util
+{
+
+namespace dsp
+{
+
+//The coefficients have the precision of the samples
+template<class T> struct Fir_Scalar { typedef float type; };
+template<> struct Fir_Scalar<double> { typedef double type; };
+template<> struct Fir_Scalar<math::vec3d> { typedef double type; };
+
+//How many times each coefficient is repeated in the tables. vec3f has one per axis so the dot product can run on
+// the samples as a flat array of floats
+template<class T> struct Fir_Stride { static constexpr size_t value = 1; };
+template<> struct Fir_Stride<math::vec3f> { static constexpr size_t value = 3; };
+
+template<class T, class C> T fir_dot(T const* samples, C const* coefficients, size_t count)
+{
+    T acc = samples[0] * coefficients[0];
+    for (size_t i = 1; i < count; i++)
+    {
+        acc += samples[i] * coefficients[i];
+    }
+    return acc;
+}
+
+//4 vec3f (12 floats, 3 registers) per iteration. Lane i of register r holds axis (4r + i) % 3
+inline math::vec3f fir_dot(math::vec3f const* samples, float const* coefficients, size_t count)
+{
+    static_assert(sizeof(math::vec3f) == 3 * sizeof(float), "vec3f has to be packed");
+    float const* s = &samples[0].x;
+    size_t i = 0;
+    float acc[12] = { 0 };
+
+#if defined UTIL_SIMD_NEON
+    float32x4_t a0 = vdupq_n_f32(0.f);
+    float32x4_t a1 = vdupq_n_f32(0.f);
+    float32x4_t a2 = vdupq_n_f32(0.f);
+    for (; i + 4 <= count; i += 4)
+    {
+        a0 = vmlaq_f32(a0, vld1q_f32(s + i*3), vld1q_f32(coefficients + i*3));
+        a1 = vmlaq_f32(a1, vld1q_f32(s + i*3 + 4), vld1q_f32(coefficients + i*3 + 4));
+        a2 = vmlaq_f32(a2, vld1q_f32(s + i*3 + 8), vld1q_f32(coefficients + i*3 + 8));
+    }
+    vst1q_f32(acc, a0);
+    vst1q_f32(acc + 4, a1);
+    vst1q_f32(acc + 8, a2);
+#elif defined UTIL_SIMD_SSE2
+    __m128 a0 = _mm_setzero_ps();
+    __m128 a1 = _mm_setzero_ps();
+    __m128 a2 = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4)
+    {
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(s + i*3), _mm_loadu_ps(coefficients + i*3)));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(s + i*3 + 4), _mm_loadu_ps(coefficients + i*3 + 4)));
+        a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(s + i*3 + 8), _mm_loadu_ps(coefficients + i*3 + 8)));
+    }
+    _mm_storeu_ps(acc, a0);
+    _mm_storeu_ps(acc + 4, a1);
+    _mm_storeu_ps(acc + 8, a2);
+#endif
+
+    math::vec3f result(acc[0] + acc[3] + acc[6] + acc[9],
+                       acc[1] + acc[4] + acc[7] + acc[10],
+                       acc[2] + acc[5] + acc[8] + acc[11]);
+    for (; i < count; i++)
+    {
+        result.x += s[i*3 + 0] * coefficients[i*3 + 0];
+        result.y += s[i*3 + 1] * coefficients[i*3 + 1];
+        result.z += s[i*3 + 2] * coefficients[i*3 + 2];
+    }
+    return result;
+}
+
+}
+
+
+//Resamples by a rational factor L/M (output_rate / input_rate reduced by their gcd) with a polyphase FIR.
+//The filter is split in L phases of K taps so each output costs K multiply-adds no matter the ratio,
+// and the input samples are never zero-stuffed.
+//
+//The phases are Lagrange interpolators of order K - 1 so every phase has unity DC gain and the same delay for
+// slow signals: (L*K - 1) / 2 samples at the upsampled rate. They don't band limit anything, the signal has to be
+// filtered at the higher rate (by an IIR, with much less delay than a steep FIR) before or after the resampling.
+template<class T>
+class Polyphase_Resampler
+{
+    Polyphase_Resampler(Polyphase_Resampler<T> const&) = delete;
+    Polyphase_Resampler<T>& operator=(Polyphase_Resampler<T> const&) = delete;
+public:
+    typedef typename dsp::Fir_Scalar<T>::type Scalar;
+
+    static constexpr size_t MIN_TAPS_PER_PHASE = 1;
+    static constexpr size_t MAX_TAPS_PER_PHASE = 8;
+    static constexpr size_t MAX_PHASES = 256;
+
+    Polyphase_Resampler() = default;
+
+    //The phases get as many taps as fit in max_group_delay (in seconds), and at least one.
+    //With one tap it holds the last input (the delay is then the average one). With L == 1 it only picks every M-th sample.
+    bool setup(uint32_t input_rate, uint32_t output_rate, float max_group_delay)
+    {
+        if (input_rate == 0 || output_rate == 0)
+        {
+            return false;
+        }
+
+        uint32_t gcd = input_rate;
+        for (uint32_t b = output_rate; b != 0; )
+        {
+            uint32_t t = gcd % b;
+            gcd = b;
+            b = t;
+        }
+        size_t L = output_rate / gcd;
+        size_t M = input_rate / gcd;
+        if (L > MAX_PHASES)
+        {
+            return false;
+        }
+
+        //(L*K - 1) / 2 upsampled samples of delay <= max_group_delay. The epsilon keeps a budget of exactly K taps from
+        // rounding down
+        double max_K = (2.0 * math::max(max_group_delay, 0.f) * double(input_rate) * L + 1.0) / L + 1e-6;
+        size_t K = static_cast<size_t>(math::clamp(max_K, double(MIN_TAPS_PER_PHASE), double(MAX_TAPS_PER_PHASE)));
+        if (L == 1)
+        {
+            //the outputs land on input samples, more taps would only delay them
+            K = 1;
+        }
+
+        //Phase p of input n is the output at n + p/L - delay, delay being (L*K - 1) / (2*L) input samples.
+        //In the window of the last K inputs (0 is the oldest) that's position u = K/2 - 1 + (p + 0.5)/L
+        m_L = L;
+        m_M = M;
+        m_K = K;
+        constexpr size_t stride = dsp::Fir_Stride<T>::value;
+        m_coefficients.resize(L * K * stride);
+        for (size_t p = 0; p < L; p++)
+        {
+            double u = K * 0.5 - 1.0 + (p + 0.5) / L;
+            for (size_t k = 0; k < K; k++)
+            {
+                double w = 1.0;
+                for (size_t j = 0; j < K; j++)
+                {
+                    if (j != k)
+                    {
+                        w *= (u - double(j)) / (double(k) - double(j));
+                    }
+                }
+                Scalar c = static_cast<Scalar>(w);
+                for (size_t s = 0; s < stride; s++)
+                {
+                    m_coefficients[(p*K + k) * stride + s] = c;
+                }
+            }
+        }
+
+        m_group_delay = static_cast<float>((L * K - 1) * 0.5 / (double(input_rate) * L));
+        m_history.resize(K * 2);
+        m_phase = 0;
+        m_needs_reset = true;
+        return true;
+    }
+
+    //In seconds
+    auto get_group_delay() const -> float
+    {
+        return m_group_delay;
+    }
+    auto get_taps_per_phase() const -> size_t
+    {
+        return m_K;
+    }
+
+    //Fills the history with the value so there is no start-up transient.
+    //The phase is kept so the outputs stay on the same grid
+    void reset(T const& t)
+    {
+        for (T& h: m_history)
+        {
+            h = t;
+        }
+        m_history_idx = 0;
+        m_needs_reset = false;
+    }
+    void reset()
+    {
+        m_needs_reset = true;
+    }
+
+    //Feeds one input sample and calls output(T const&) for each output sample it completes
+    template<class F> void process(T const& input, F&& output)
+    {
+        if (m_K == 0)
+        {
+            return;
+        }
+        if (m_needs_reset)
+        {
+            reset(input);
+        }
+
+        //the history is stored twice so the last K samples are always contiguous
+        m_history[m_history_idx] = input;
+        m_history[m_history_idx + m_K] = input;
+        m_history_idx = (m_history_idx + 1) % m_K;
+        T const* window = m_history.data() + m_history_idx;
+
+        constexpr size_t stride = dsp::Fir_Stride<T>::value;
+        while (m_phase < m_L)
+        {
+            output(dsp::fir_dot(window, m_coefficients.data() + m_phase * m_K * stride, m_K));
+            m_phase += m_M;
+        }
+        m_phase -= m_L;
+    }
+
+private:
+    size_t m_L = 1;
+    size_t m_M = 1;
+    size_t m_K = 0;
+    float m_group_delay = 0;
+    std::vector<Scalar> m_coefficients;
+    std::vector<T> m_history;
+    size_t m_history_idx = 0;
+    size_t m_phase = 0;
+    bool m_needs_reset = true;
+};
+
+template<class T> constexpr size_t Polyphase_Resampler<T>::MIN_TAPS_PER_PHASE;
+template<class T> constexpr size_t Polyphase_Resampler<T>::MAX_TAPS_PER_PHASE;
+template<class T> constexpr size_t Polyphase_Resampler<T>::MAX_PHASES;
+
+}
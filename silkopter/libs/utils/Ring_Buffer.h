@@ -0,0 +1,203 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <iterator>
+
+namespace util
+{
+
+//Fixed capacity ring buffer with a single producer and any number of consumers.
+//
+//Consumers don't remove anything, they each keep their own Cursor.
+//The producer overwrites the oldest items so it never allocates after the buffer is warmed up (items are assigned, not constructed).
+//Consumers read the items in place with read()/get_frame() so they must not run at the same time as the producer
+// (its own thread, or nodes the HAL orders after their producers).
+//
+//The producer also marks the start of its frame with clear(). get_frame() returns a snapshot of the items pushed since then;
+// take it once and iterate it, the ring itself has no begin/end as two separate snapshots would give an inconsistent range.
+template<class T>
+class Ring_Buffer
+{
+public:
+    typedef T value_type;
+
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    static constexpr size_t DEFAULT_CAPACITY = 128;
+
+    class const_iterator : public std::iterator<std::random_access_iterator_tag, T const>
+    {
+    public:
+        const_iterator() = default;
+        const_iterator(Ring_Buffer const* ring, uint64_t index) : m_ring(ring), m_index(index) {}
+
+        T const& operator*() const { return m_ring->at(m_index); }
+        T const* operator->() const { return &m_ring->at(m_index); }
+        T const& operator[](ptrdiff_t off) const { return m_ring->at(m_index + off); }
+
+        const_iterator& operator++() { m_index++; return *this; }
+        const_iterator operator++(int) { const_iterator it = *this; m_index++; return it; }
+        const_iterator& operator--() { m_index--; return *this; }
+        const_iterator operator--(int) { const_iterator it = *this; m_index--; return it; }
+        const_iterator& operator+=(ptrdiff_t off) { m_index += off; return *this; }
+        const_iterator& operator-=(ptrdiff_t off) { m_index -= off; return *this; }
+        const_iterator operator+(ptrdiff_t off) const { return const_iterator(m_ring, m_index + off); }
+        const_iterator operator-(ptrdiff_t off) const { return const_iterator(m_ring, m_index - off); }
+        ptrdiff_t operator-(const_iterator const& other) const { return static_cast<ptrdiff_t>(m_index - other.m_index); }
+
+        bool operator==(const_iterator const& other) const { return m_index == other.m_index; }
+        bool operator!=(const_iterator const& other) const { return m_index != other.m_index; }
+        bool operator<(const_iterator const& other) const { return m_index < other.m_index; }
+        bool operator>(const_iterator const& other) const { return m_index > other.m_index; }
+        bool operator<=(const_iterator const& other) const { return m_index <= other.m_index; }
+        bool operator>=(const_iterator const& other) const { return m_index >= other.m_index; }
+
+    private:
+        Ring_Buffer const* m_ring = nullptr;
+        uint64_t m_index = 0;
+    };
+
+    //A view of a range of items. It stays valid until the producer overwrites them
+    class Span
+    {
+    public:
+        Span() = default;
+        Span(Ring_Buffer const* ring, uint64_t begin, uint64_t end) : m_ring(ring), m_begin(begin), m_end(end) {}
+
+        auto begin() const -> const_iterator { return const_iterator(m_ring, m_begin); }
+        auto end() const -> const_iterator { return const_iterator(m_ring, m_end); }
+        auto size() const -> size_t { return static_cast<size_t>(m_end - m_begin); }
+        auto empty() const -> bool { return m_end == m_begin; }
+        auto front() const -> T const& { QASSERT(!empty()); return m_ring->at(m_begin); }
+        auto back() const -> T const& { QASSERT(!empty()); return m_ring->at(m_end - 1); }
+        auto operator[](size_t idx) const -> T const& { QASSERT(idx < size()); return m_ring->at(m_begin + idx); }
+
+    private:
+        Ring_Buffer const* m_ring = nullptr;
+        uint64_t m_begin = 0;
+        uint64_t m_end = 0;
+    };
+
+    //The read position of one consumer. On its own cache line so the consumers don't bounce the producer's write index
+    struct alignas(CACHE_LINE_SIZE) Cursor
+    {
+        uint64_t index = 0;
+        bool is_initialized = false;
+    };
+
+    explicit Ring_Buffer(size_t capacity = DEFAULT_CAPACITY)
+    {
+        set_capacity(capacity);
+    }
+    Ring_Buffer(Ring_Buffer const&) = delete;
+    Ring_Buffer& operator=(Ring_Buffer const&) = delete;
+
+    //Rounded up to a power of 2. This drops all the items so call it only when nobody is reading.
+    void set_capacity(size_t capacity)
+    {
+        size_t c = 1;
+        while (c < capacity)
+        {
+            c <<= 1;
+        }
+        m_data.clear();
+        m_data.resize(c);
+        m_mask = c - 1;
+        m_write_index.store(0, std::memory_order_relaxed);
+        m_frame_begin_index.store(0, std::memory_order_release);
+    }
+    auto get_capacity() const -> size_t
+    {
+        return m_data.size();
+    }
+
+    ///////////////////////////////////////////////////
+    //producer
+
+    //Starts a new frame. Nothing is destroyed, the consumers can still read the older items with their cursors
+    void clear()
+    {
+        m_frame_begin_index.store(m_write_index.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    void push_back(T const& value)
+    {
+        prepare_push() = value;
+        commit_push();
+    }
+    void push_back(T&& value)
+    {
+        prepare_push() = std::move(value);
+        commit_push();
+    }
+
+    //Returns the slot for the next item. It still contains the old (overwritten) item so it can be swapped to recycle its buffers.
+    //The item is not visible to consumers until commit_push
+    auto prepare_push() -> T&
+    {
+        return m_data[m_write_index.load(std::memory_order_relaxed) & m_mask];
+    }
+    void commit_push()
+    {
+        m_write_index.store(m_write_index.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    ///////////////////////////////////////////////////
+    //the items pushed since the last clear
+
+    auto get_frame() const -> Span
+    {
+        uint64_t begin = m_frame_begin_index.load(std::memory_order_acquire);
+        uint64_t end = m_write_index.load(std::memory_order_acquire);
+        if (end - begin > m_data.size())
+        {
+            begin = end - m_data.size();
+        }
+        return Span(this, begin, end);
+    }
+
+    ///////////////////////////////////////////////////
+    //consumers
+
+    //All the items after the cursor, read in place. A new cursor starts with the current frame.
+    //Use it only while the producer is not pushing, the items can be overwritten while they are read otherwise.
+    auto read(Cursor& cursor) const -> Span
+    {
+        uint64_t end = m_write_index.load(std::memory_order_acquire);
+        if (!cursor.is_initialized || cursor.index > end)
+        {
+            cursor.index = std::min(m_frame_begin_index.load(std::memory_order_acquire), end);
+            cursor.is_initialized = true;
+        }
+        if (end - cursor.index > m_data.size())
+        {
+            QLOGW("Ring buffer consumer is {} items behind. Skipping to the oldest one", end - cursor.index);
+            cursor.index = end - m_data.size();
+        }
+        return Span(this, cursor.index, end);
+    }
+    void consume(Cursor& cursor, size_t count) const
+    {
+        QASSERT(cursor.is_initialized);
+        QASSERT(cursor.index + count <= m_write_index.load(std::memory_order_acquire));
+        cursor.index += count;
+    }
+
+    auto at(uint64_t index) const -> T const&
+    {
+        return m_data[index & m_mask];
+    }
+
+private:
+    //the indices written by the producer get their own cache lines, away from the members that are only read
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_write_index = {0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_frame_begin_index = {0};
+
+    alignas(CACHE_LINE_SIZE) std::vector<T> m_data;
+    uint64_t m_mask = 0;
+};
+
+template<class T> constexpr size_t Ring_Buffer<T>::CACHE_LINE_SIZE;
+template<class T> constexpr size_t Ring_Buffer<T>::DEFAULT_CAPACITY;
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+//Picks the SIMD instruction set the compiler targets.
+//UTIL_SIMD_NEON on ARM with NEON, UTIL_SIMD_SSE2 on x86 (the simulator builds). Code using them needs a scalar fallback.
+
+#if defined __ARM_NEON || defined __ARM_NEON__
+#   include <arm_neon.h>
+#   define UTIL_SIMD_NEON
+#elif defined __SSE2__
+#   include <emmintrin.h>
+#   define UTIL_SIMD_SSE2
+#endif
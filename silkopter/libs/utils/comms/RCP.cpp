@@ -1,6 +1,7 @@
 #include "RCP.h"
 #include "utils/Timed_Scope.h"
 #include "lz4/lz4.h"
+#include "fec.h"
 #include <zlib.h>
 
 namespace util
@@ -25,6 +26,9 @@ auto RCP::acquire_tx_datagram(size_t zero_size, size_t data_size) -> RCP::TX::Da
     datagram->sent_tp = q::Clock::time_point(q::Clock::duration{0});
     datagram->added_tp = q::Clock::time_point(q::Clock::duration{0});
     datagram->sent_count = 0;
+    datagram->epoch = m_tx.epoch.load(std::memory_order_acquire);
+    datagram->is_done = false;
+    datagram->is_fec_protected = false;
 
     return datagram;
 }
@@ -45,6 +49,9 @@ auto RCP::RX::acquire_packet() -> RCP::RX::Packet_ptr
 {
     auto packet = packet_pool.acquire();
     packet->received_fragment_count = 0;
+    packet->has_main_header = false;
+    packet->data_size = 0;
+    packet->early_fragments.clear();
     packet->added_tp = q::Clock::now();
     return packet;
 }
@@ -79,6 +86,7 @@ auto RCP::get_header_size(void const* data_ptr, size_t data_size) -> size_t
     case Type::TYPE_CONFIRMATIONS: return sizeof(Confirmations_Header);
     case Type::TYPE_CONNECT_REQ: return sizeof(Connect_Req_Header);
     case Type::TYPE_CONNECT_RES: return sizeof(Connect_Res_Header);
+    case Type::TYPE_FEC: return sizeof(Fec_Header);
     }
     return 0;
 }
@@ -117,6 +125,14 @@ RCP::RCP()
 //        hsz =sizeof(Packets_Confirmed_Header);
 
     m_rx.packet_pool.release = [](RX::Packet& p)
+    {
+        //the data and bitmap keep their capacity for the next packet
+        p.has_main_header = false;
+        p.data_size = 0;
+        p.received_fragment_count = 0;
+        p.early_fragments.clear();
+    };
+    m_tx.packet_pool.release = [](TX::Packet& p)
     {
         p.fragments.clear();
     };
@@ -152,6 +168,9 @@ RCP::Socket_Handle RCP::add_socket(ISocket* socket)
     socket->receive_callback = std::bind(&RCP::handle_receive, this, std::placeholders::_1, std::placeholders::_2);
     socket->send_callback = std::bind(&RCP::handle_send, this, handle, std::placeholders::_1);
 
+    m_tx.schedulers.emplace_back(new TX::Scheduler());
+    reset_scheduler(*m_tx.schedulers.back(), handle);
+
     return handle;
 }
 
@@ -337,12 +356,22 @@ auto RCP::_send_locked(uint8_t channel_idx, Send_Params const& params, void cons
 
     Socket_Data& socket_data = m_sockets[channel_data.socket_handle];
 
+    bool use_fec = !params.is_reliable && params.fec_k > 0;
+    if (use_fec && (params.fec_k > MAX_FEC_K || params.fec_n <= params.fec_k || params.fec_n > MAX_FEC_N))
+    {
+        QLOGW("Bad fec params {}/{} for channel {}. Sending without fec", params.fec_k, params.fec_n, channel_idx);
+        use_fec = false;
+    }
+
+    //the parity datagrams have their header on top of the biggest datagram
+    size_t mtu = use_fec ? socket_data.mtu - sizeof(Fec_Header) : socket_data.mtu;
+
     size_t fragment_count = 1; //main fragment
 
-    if (size > (socket_data.mtu - sizeof(Packet_Main_Header)))
+    if (size > (mtu - sizeof(Packet_Main_Header)))
     {
-        size_t left = size - (socket_data.mtu - sizeof(Packet_Main_Header));
-        size_t fs = (socket_data.mtu - sizeof(Packet_Header));
+        size_t left = size - (mtu - sizeof(Packet_Main_Header));
+        size_t fs = (mtu - sizeof(Packet_Header));
         fragment_count += left / fs; //rest of the fragments
         if (left % fs > 0)
         {
@@ -361,111 +390,95 @@ auto RCP::_send_locked(uint8_t channel_idx, Send_Params const& params, void cons
 
     auto id = ++m_last_id[channel_idx];
 
+    TX::Packet_ptr packet = m_tx.packet_pool.acquire();
+    packet->id = id;
+    packet->epoch = m_tx.epoch.load(std::memory_order_acquire);
+    packet->params = params;
+    packet->fragments.reserve(fragment_count);
+
+    //add the new fragments
+    size_t left = size;
+    for (size_t i = 0; i < fragment_count; i++)
     {
-        //cancel all previous packets if needed
-        if (params.cancel_previous_data)
+        QASSERT(left > 0);
+        size_t header_size = (i == 0) ? sizeof(Packet_Main_Header) : sizeof(Packet_Header);
+        size_t max_fragment_size = mtu - header_size;
+        size_t fragment_size = math::min(max_fragment_size, left);
+
+        auto fragment = acquire_tx_datagram(header_size, header_size + fragment_size);
+
+        fragment->params = params;
+        fragment->packet_id = id;
+        fragment->fragment_idx = static_cast<uint16_t>(i);
+        fragment->is_fec_protected = use_fec;
+
+        Packet_Header& header = get_header<Packet_Header>(fragment->data.data());
+        header.id = id;
+        header.channel_idx = channel_idx;
+        header.flag_needs_confirmation = params.is_reliable || params.unreliable_retransmit_count > 0;
+        header.flag_is_compressed = is_compressed;
+        header.type = TYPE_PACKET;
+        header.fragment_idx = i;
+
+        if (i == 0)
         {
-            auto& queue = m_tx.packet_queue;
-            std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
-
-            for (auto it = queue.begin(); it != queue.end();)
-            {
-                auto& datagram = *it;
-                auto const& hdr = get_header<Packet_Header>(datagram->data.data());
-                if (hdr.channel_idx == channel_idx && hdr.id < id)
-                {
-                    it = queue.erase(it);
-                    continue;
-                }
-                ++it;
-            }
+            Packet_Main_Header& f_header = get_header<Packet_Main_Header>(fragment->data.data());
+            f_header.packet_size = uncompressed_size;
+            f_header.fragment_count = fragment_count;
         }
+        std::copy(data, data + fragment_size, fragment->data.data() + header_size);
 
-        //QLOGI("crt +{}", fragment_count);
-
-        channel_data.fragments_to_insert.clear();
-        channel_data.fragments_to_insert.reserve(fragment_count);
-
-        //add the new fragments
-        size_t left = size;
-        for (size_t i = 0; i < fragment_count; i++)
-        {
-            QASSERT(left > 0);
-            size_t header_size = (i == 0) ? sizeof(Packet_Main_Header) : sizeof(Packet_Header);
-            size_t max_fragment_size = socket_data.mtu - header_size;
-            size_t fragment_size = math::min(max_fragment_size, left);
-
-            auto fragment = acquire_tx_datagram(header_size, header_size + fragment_size);
-
-            fragment->params = params;
-
-            Packet_Header& header = get_header<Packet_Header>(fragment->data.data());
-            header.id = id;
-            header.channel_idx = channel_idx;
-            header.flag_needs_confirmation = params.is_reliable || params.unreliable_retransmit_count > 0;
-            header.flag_is_compressed = is_compressed;
-            header.type = TYPE_PACKET;
-            header.fragment_idx = i;
-
-            if (i == 0)
-            {
-                Packet_Main_Header& f_header = get_header<Packet_Main_Header>(fragment->data.data());
-                f_header.packet_size = uncompressed_size;
-                f_header.fragment_count = fragment_count;
-            }
-            std::copy(data, data + fragment_size, fragment->data.data() + header_size);
-
-            data += fragment_size;
-            left -= fragment_size;
+        data += fragment_size;
+        left -= fragment_size;
 
-            fragment->added_tp = now;
-            prepare_to_send_datagram(*fragment);
+        fragment->added_tp = now;
+        prepare_to_send_datagram(*fragment);
 
-            channel_data.fragments_to_insert.push_back(fragment);
-        }
-        QASSERT(left == 0);
-//        for (auto const& d: queue)
-//        {
-//            QLOGI("{}, id: {}, f: {}, sc: {}", &d - &queue.front(), int(get_header<Packet_Header>(d->data).id), int(get_header<Packet_Header>(d->data).fragment_idx), d->sent_count);
-//        }
+        packet->fragments.push_back(std::move(fragment));
+    }
+    QASSERT(left == 0);
 
-        if (!channel_data.fragments_to_insert.empty())
-        {
-            std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
+    if (use_fec)
+    {
+        encode_fec(channel_data, params, *packet);
+    }
+    packet->pending_count = packet->fragments.size();
 
-            auto& queue = m_tx.packet_queue;
-            queue.insert(std::upper_bound(queue.begin(), queue.end(), channel_data.fragments_to_insert[0], tx_packet_datagram_predicate),
-                    std::make_move_iterator(channel_data.fragments_to_insert.begin()),
-                    std::make_move_iterator(channel_data.fragments_to_insert.end()));
-        }
-        channel_data.fragments_to_insert.clear();
+    //the scheduler of the socket takes it from here
+    if (!channel_data.queue.push_back(std::move(packet)))
+    {
+        //the group has a hole now
+        channel_data.fec.sources.clear();
 
+        //give the id back so the other end doesn't wait for a packet that never comes
+        m_last_id[channel_idx].compare_exchange_strong(id, id - 1);
+        QLOGW("Send queue for channel {} is full", channel_idx);
+        return false;
     }
+    m_tx.schedulers[channel_data.socket_handle]->dirty_channels.fetch_or(1u << channel_idx, std::memory_order_release);
 
     send_datagram(channel_data.socket_handle);
 
     return true;
 }
 
-inline auto RCP::tx_packet_datagram_predicate(TX::Datagram_ptr const& AA, TX::Datagram_ptr const& BB) -> bool
+bool RCP::receive(uint8_t channel_idx, std::vector<uint8_t>& data)
 {
-    int priority_AA = AA->params.importance;
-    int priority_BB = BB->params.importance;
-    int sent_count_AA = AA->sent_count;
-    int sent_count_BB = BB->sent_count;
-    uint32_t id_AA = get_header<Packet_Header>(AA->data.data()).id;
-    uint32_t id_BB = get_header<Packet_Header>(BB->data.data()).id;
-
-    return priority_AA > priority_BB ||
-            (priority_AA == priority_BB && sent_count_AA < sent_count_BB) ||
-            (priority_AA == priority_BB && sent_count_AA == sent_count_BB && id_AA > id_BB);
+    Received_Data received;
+    if (!receive(channel_idx, received))
+    {
+        data.clear();
+        return false;
+    }
+    data.assign(received.data, received.data + received.size);
+    return true;
 }
 
-bool RCP::receive(uint8_t channel_idx, std::vector<uint8_t>& data)
+bool RCP::receive(uint8_t channel_idx, Received_Data& data)
 {
     QLOG_TOPIC("RCP::receive");
 
-    data.clear();
+    data = Received_Data();
     if (channel_idx >= MAX_CHANNELS)
     {
         QLOGE("Invalid channel {}", channel_idx);
@@ -477,49 +490,41 @@ bool RCP::receive(uint8_t channel_idx, std::vector<uint8_t>& data)
     }
 
     auto& queue = m_rx.packet_queues[channel_idx];
-    auto& packets = queue.packets;
     std::lock_guard<std::mutex> lg(queue.mutex);
 
-    auto const& params = m_receive_params[channel_idx];
+    //the data returned last time is not needed anymore
+    queue.received_packet.reset();
 
+    auto const& params = m_receive_params[channel_idx];
+    auto max_receive_time = params.max_receive_time.count() > 0 ? params.max_receive_time : m_global_receive_params.max_receive_time;
 
     auto& last_packet_id = m_rx.last_packet_ids[channel_idx];
 
     while (true)
     {
-        if (packets.empty())
-        {
-            break;
-        }
-        RX::Packet_ptr const& packet = packets.front().second;
-        QASSERT(packet);
+        auto now = q::Clock::now();
 
         auto next_expected_id = last_packet_id + 1;
+        RX::Packet_ptr& slot = queue.window[next_expected_id % RX::WINDOW_SIZE];
 
-        auto id = packet->any_header.id;
-        QASSERT(id > 0);
-
-        //is it from the past?
-        if (id <= last_packet_id)
+        //the next packet in sequence is missing - wait for it some more or cancel
+        if (!slot)
         {
-            QLOGW("Ignoring past packet {}", id);
-            m_global_stats.rx_zombie_packets++;
-            if (packet->any_header.flag_needs_confirmation)
+            //wait as long as the oldest packet after it allows
+            RX::Packet const* next_packet = nullptr;
+            for (uint32_t id = next_expected_id + 1; id <= queue.max_id; id++)
             {
-                add_packet_confirmation(channel_idx, id);
+                next_packet = queue.window[id % RX::WINDOW_SIZE].get();
+                if (next_packet)
+                {
+                    break;
+                }
             }
-            packets.pop_front();
-            m_global_stats.rx_dropped_packets++;
-            continue;
-        }
-
-        auto now = q::Clock::now();
-        auto max_receive_time = params.max_receive_time.count() > 0 ? params.max_receive_time : m_global_receive_params.max_receive_time;
-        bool is_late = (max_receive_time.count() > 0 && now - packet->added_tp >= max_receive_time);
-
-        //the next packet in sequence is missing - wait for it some more or cancel
-        if (id > next_expected_id)
-        {
+            if (!next_packet)
+            {
+                break;
+            }
+            bool is_late = (max_receive_time.count() > 0 && now - next_packet->added_tp >= max_receive_time);
             if (!is_late)
             {
                 //wait some more
@@ -534,72 +539,60 @@ bool RCP::receive(uint8_t channel_idx, std::vector<uint8_t>& data)
             continue;
         }
 
+        RX::Packet_ptr packet = slot;
+        QASSERT(packet->id == next_expected_id);
+
         //no header yet or not all packages received?
-        if (!packet->fragments[0] || packet->received_fragment_count < packet->main_header.fragment_count)
+        if (!is_rx_packet_complete(*packet))
         {
+            bool is_late = (max_receive_time.count() > 0 && now - packet->added_tp >= max_receive_time);
             if (!is_late)
             {
                 break;
             }
 
-            QLOGW("Canceling late packet {}. {} / {}", id, packet->received_fragment_count, packet->fragments[0] ? packet->main_header.fragment_count : 0);
-            add_packet_confirmation(channel_idx, id);
-            packets.pop_front();
-            last_packet_id = id;
+            QLOGW("Canceling late packet {}. {} / {}", packet->id, packet->received_fragment_count, packet->has_main_header ? packet->main_header.fragment_count : 0);
+            add_packet_confirmation(channel_idx, packet->id);
+            slot.reset();
+            last_packet_id = packet->id;
             m_global_stats.rx_dropped_packets++;
-
-//                QLOGW("Still waiting for packet {}: {}/{} received", id, packet->received_fragment_count, static_cast<size_t>(packet->main_header.fragment_count));
             continue;
         }
-        QASSERT(packet->fragments[0]);
 
         //QLOGI("Received packet {}", id);
 
-        last_packet_id = id;
+        slot.reset();
+        last_packet_id = packet->id;
         m_global_stats.rx_packets++;
 
-        //copy the data
         auto const& main_header = packet->main_header;
-        queue.decompression_buffer.clear();
-        queue.decompression_buffer.resize(main_header.packet_size);
-        size_t offset = 0;
-        size_t fragment_idx = 0;
-        for (auto it = packet->fragments.begin(); it != packet->fragments.end(); ++it, fragment_idx++)
-        {
-            auto const& fragment = it->second;
-            QASSERT(it->first == fragment_idx);
-            auto header_size = (fragment_idx == 0 ? sizeof(Packet_Main_Header) : sizeof(Packet_Header));
-            QASSERT(fragment->data.size() > header_size);
-            std::copy(fragment->data.begin() + header_size, fragment->data.end(), queue.decompression_buffer.begin() + offset);
-            offset += fragment->data.size() - header_size;
-        }
-        packet->fragments.clear();
-
         if (main_header.flag_is_compressed)
         {
-            data.resize(main_header.packet_size);
-            int ret = LZ4_decompress_fast(reinterpret_cast<const char*>(queue.decompression_buffer.data()),
-                                          reinterpret_cast<char*>(data.data()),
+            queue.decompression_buffer.resize(main_header.packet_size);
+            int ret = LZ4_decompress_safe(reinterpret_cast<const char*>(packet->data.data()),
+                                          reinterpret_cast<char*>(queue.decompression_buffer.data()),
+                                          static_cast<int>(packet->data_size),
                                           static_cast<int>(main_header.packet_size));
-            if (ret < 0)
+            if (ret != static_cast<int>(main_header.packet_size))
             {
                 QLOGW("Decompression error: {}", ret);
-                data.clear();
+                break;
             }
-            //return true;//ret == Z_OK;
+            data.data = queue.decompression_buffer.data();
+            data.size = main_header.packet_size;
         }
         else
         {
-            QASSERT(queue.decompression_buffer.size() == main_header.packet_size);
-            std::swap(data, queue.decompression_buffer);
+            QASSERT(packet->data_size == main_header.packet_size);
+            queue.received_packet = std::move(packet);
+            data.data = queue.received_packet->data.data();
+            data.size = queue.received_packet->data_size;
         }
 
-        packets.pop_front();
-
         break;
     }
 
-    return !data.empty();
+    return data.size > 0;
 }
 
 void RCP::process_connection()
@@ -629,8 +622,7 @@ void RCP::process()
         if (q::Clock::now() - tp > std::chrono::seconds(1))
         {
             tp = q::Clock::now();
-            std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
-            QLOGI("{}: txd {} / tdf {} / rx {} / rxf {} / cf {}", m_tx.packet_queue.size(), m_global_stats.tx_datagrams, m_global_stats.tx_fragments, m_global_stats.rx_datagrams, m_global_stats.rx_fragments, m_global_stats.tx_confirmed_fragments);
+            QLOGI("txd {} / tdf {} / rx {} / rxf {} / cf {} / rsf {}", m_global_stats.tx_datagrams, m_global_stats.tx_fragments, m_global_stats.rx_datagrams, m_global_stats.rx_fragments, m_global_stats.tx_confirmed_fragments, m_global_stats.tx_resent_fragments);
         }
     }
 
@@ -641,6 +633,12 @@ void RCP::process()
     else
     {
         send_pending_confirmations();
+
+        //the resends are driven by time so the sockets can't wait for new data to pick them up
+        for (size_t i = 0; i < m_sockets.size(); i++)
+        {
+            send_datagram(static_cast<Socket_Handle>(i));
+        }
     }
 }
 
@@ -705,255 +703,696 @@ auto RCP::add_datagram_to_send_buffer(Socket_Data& socket_data, TX::Datagram_ptr
     return false;
 }
 
-auto RCP::compute_next_transit_datagram(Socket_Handle socket_handle) -> bool
+void RCP::reset_scheduler(TX::Scheduler& scheduler, Socket_Handle socket_handle)
+{
+    scheduler.internal_datagrams.clear();
+    scheduler.in_flight.clear();
+    scheduler.repeats.clear();
+    scheduler.active_levels.fill(0);
+    scheduler.level_channels.fill(0);
+    scheduler.level_cursors.fill(0);
+
+    for (TX::Channel_Data& channel_data: m_tx.channel_data)
+    {
+        if (channel_data.socket_handle == socket_handle)
+        {
+            channel_data.packets.clear();
+            channel_data.fresh.clear();
+            channel_data.resends.clear();
+            channel_data.level = -1;
+            channel_data.deficit = 0;
+        }
+    }
+
+    //a new connection can go over a different path
+    Socket_Data const& socket_data = m_sockets[socket_handle];
+    scheduler.srtt = q::Clock::duration{0};
+    scheduler.rttvar = q::Clock::duration{0};
+    scheduler.rto = INITIAL_RTO;
+    scheduler.backoff_tp = q::Clock::time_point(q::Clock::duration{0});
+    scheduler.resend_window = INITIAL_RESEND_WINDOW * socket_data.mtu;
+    scheduler.resend_tokens = scheduler.resend_window;
+    scheduler.resend_tokens_tp = q::Clock::now();
+}
+
+auto RCP::get_next_queue(TX::Channel_Data& channel_data) -> std::deque<TX::Datagram_ptr>*
+{
+    //new data first, same as before
+    if (!channel_data.fresh.empty())
+    {
+        return &channel_data.fresh;
+    }
+    if (!channel_data.resends.empty())
+    {
+        return &channel_data.resends;
+    }
+    return nullptr;
+}
+
+void RCP::update_channel_level(TX::Scheduler& scheduler, uint8_t channel_idx)
 {
-    size_t merged = 0;
+    TX::Channel_Data& channel_data = m_tx.channel_data[channel_idx];
 
-    Socket_Data& socket_data = m_sockets[socket_handle];
-    socket_data.buffer.clear();
+    auto* queue = get_next_queue(channel_data);
+    int level = queue ? queue->front()->params.importance - std::numeric_limits<int8_t>::min() : -1;
+    if (level == channel_data.level)
+    {
+        return;
+    }
 
-    if (socket_handle == m_tx.internal_queues.socket_handle)
+    uint32_t bit = 1u << channel_idx;
+    if (channel_data.level >= 0)
     {
-        std::lock_guard<std::mutex> lg(m_tx.internal_queues.mutex);
-        if (m_tx.internal_queues.connection_res && add_datagram_to_send_buffer(socket_data, m_tx.internal_queues.connection_res))
+        uint32_t& channels = scheduler.level_channels[channel_data.level];
+        channels &= ~bit;
+        if (channels == 0)
         {
-            m_tx.internal_queues.connection_res.reset();
-            merged++;
-//                QLOGI("Sending connection res datagram {}", static_cast<int>(get_header<Con_Header>(datagram->data).seq));
+            scheduler.active_levels[channel_data.level / 64] &= ~(uint64_t(1) << (channel_data.level % 64));
         }
-        else if (m_tx.internal_queues.connection_req && add_datagram_to_send_buffer(socket_data, m_tx.internal_queues.connection_req))
+    }
+    if (level >= 0)
+    {
+        scheduler.level_channels[level] |= bit;
+        scheduler.active_levels[level / 64] |= uint64_t(1) << (level % 64);
+    }
+    else
+    {
+        channel_data.deficit = 0;
+    }
+    channel_data.level = level;
+}
+
+auto RCP::get_next_channel(TX::Scheduler& scheduler, size_t quantum) -> int
+{
+    int level = -1;
+    for (size_t i = scheduler.active_levels.size(); i > 0; i--)
+    {
+        uint64_t levels = scheduler.active_levels[i - 1];
+        if (levels != 0)
         {
-            m_tx.internal_queues.connection_req.reset();
-            merged++;
-//                QLOGI("Sending connection_req datagram {}", static_cast<int>(get_header<connection_req_Header>(datagram->data).seq));
+            level = static_cast<int>((i - 1) * 64 + 63 - __builtin_clzll(levels));
+            break;
         }
+    }
+    if (level < 0)
+    {
+        return -1;
+    }
+
+    //Deficit round robin between the channels of the level.
+    //The quantum is at least one datagram so this goes around at most once.
+    uint32_t channels = scheduler.level_channels[level];
+    uint8_t& cursor = scheduler.level_cursors[level];
+    QASSERT(channels != 0);
+    while (true)
+    {
+        uint32_t rotated = cursor == 0 ? channels : (channels >> cursor) | (channels << (MAX_CHANNELS - cursor));
+        uint8_t channel_idx = static_cast<uint8_t>((cursor + __builtin_ctz(rotated)) % MAX_CHANNELS);
 
-        //next the confirmations
+        TX::Channel_Data& channel_data = m_tx.channel_data[channel_idx];
+        size_t size = get_next_queue(channel_data)->front()->data.size();
+        if (channel_data.deficit >= size)
         {
-            auto& queue = m_tx.internal_queues.confirmations;
-            while (!queue.empty() && add_datagram_to_send_buffer(socket_data, queue.front()))
-            {
-//                    QLOGI("Sending confirmation for {} datagrams", static_cast<int>(get_header<Packets_Confirmed_Header>(datagram->data).count));
-                merged++;
-                queue.pop_front();
-            }
+            cursor = channel_idx;
+            return channel_idx;
         }
+
+        //its turn is over
+        channel_data.deficit += quantum;
+        cursor = static_cast<uint8_t>((channel_idx + 1) % MAX_CHANNELS);
     }
+}
 
-    if (!socket_data.buffer.empty())
+auto RCP::find_tx_packet(TX::Channel_Data& channel_data, uint32_t id) -> TX::Packet*
+{
+    auto& packets = channel_data.packets;
+    auto it = std::lower_bound(packets.begin(), packets.end(), id, [](TX::Packet_ptr const& packet, uint32_t id)
     {
-        //don't continue further as we're not likely to fit anything else
-        return true;
+        return packet->id < id;
+    });
+    return (it != packets.end() && (*it)->id == id) ? it->get() : nullptr;
+}
+
+auto RCP::set_tx_fragment_done(TX::Packet& packet, size_t fragment_idx) -> bool
+{
+    if (fragment_idx >= packet.fragments.size())
+    {
+        return false;
+    }
+    TX::Datagram& datagram = *packet.fragments[fragment_idx];
+    if (datagram.is_done)
+    {
+        return false;
     }
+    datagram.is_done = true;
+    QASSERT(packet.pending_count > 0);
+    packet.pending_count--;
+    return true;
+}
 
-    //next normal packets
+void RCP::set_tx_datagram_done(TX::Channel_Data& channel_data, TX::Datagram const& datagram)
+{
+    TX::Packet* packet = find_tx_packet(channel_data, datagram.packet_id);
+    if (packet)
     {
-        std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
+        set_tx_fragment_done(*packet, datagram.fragment_idx);
+    }
+}
 
-        m_tx.reinsert_queue.clear();
+void RCP::pop_done_tx_packets(TX::Channel_Data& channel_data)
+{
+    auto& packets = channel_data.packets;
+    while (!packets.empty() && packets.front()->pending_count == 0)
+    {
+        packets.pop_front();
+    }
+}
 
-        auto now = q::Clock::now();
+void RCP::drain_channel_queue(TX::Scheduler& scheduler, uint8_t channel_idx)
+{
+    TX::Channel_Data& channel_data = m_tx.channel_data[channel_idx];
 
-//        std::string dbg;
-//        dbg.reserve(1024);
+    TX::Packet_ptr packet;
+    while (channel_data.queue.pop_front(packet))
+    {
+        if (packet->epoch != scheduler.epoch)
+        {
+            continue;
+        }
 
-        //now go through the queue and see what we can pack together and send
-        auto& queue = m_tx.packet_queue;
-        for (auto it = queue.begin(); it != queue.end();)
+        //cancel all previous packets if needed
+        if (packet->params.cancel_previous_data)
         {
-            auto& datagram = *it;
-            if (datagram->params.cancel_after.count() > 0 && now - datagram->added_tp >= datagram->params.cancel_after)
+            for (TX::Packet_ptr const& p: channel_data.packets)
             {
-                it = queue.erase(it);
-                continue;
+                for (size_t i = 0; i < p->fragments.size(); i++)
+                {
+                    set_tx_fragment_done(*p, i);
+                }
             }
+        }
 
-            Packet_Header const& pheader = get_header<Packet_Header>(datagram->data.data());
-
-            if (now - datagram->sent_tp >= MIN_RESEND_DURATION && socket_handle == m_tx.channel_data[pheader.channel_idx].socket_handle)
-            {
-                if (add_datagram_to_send_buffer(socket_data, datagram))
-                {
-//                  dbg += q::util::format<std::string>("{}:{}:{}:{}", datagram->params.importance, datagram->sent_count, pheader.id, pheader.fragment_idx);
-//                  dbg += "#,";
+        channel_data.fresh.insert(channel_data.fresh.end(), packet->fragments.begin(), packet->fragments.end());
+        channel_data.packets.push_back(std::move(packet));
+    }
 
-                    merged++;
-                    datagram->sent_tp = now;
-                    datagram->sent_count++;
+    pop_done_tx_packets(channel_data);
+    update_channel_level(scheduler, channel_idx);
+}
 
-//                  auto& header = get_header<Packet_Header>(datagram->data.data());
-//                  QLOGI("SENDING {}: pk {} fr {}, ch {}", queue.size(), int(header.id), header.fragment_idx, static_cast<int>(header.channel_idx));
+void RCP::apply_received_confirmations(TX::Scheduler& scheduler, Socket_Data const& socket_data)
+{
+    size_t confirmed_size = 0;
 
-                    //do I have to insert it back?
-                    if (datagram->params.is_reliable == true || datagram->sent_count < datagram->params.unreliable_retransmit_count)
-                    {
-                        m_tx.reinsert_queue.push_back(std::move(datagram));
-                    }
+    TX::Received_Confirmation confirmation;
+    while (scheduler.received_confirmations.pop_front(confirmation))
+    {
+        if (confirmation.epoch != scheduler.epoch || confirmation.channel_idx >= MAX_CHANNELS)
+        {
+            continue;
+        }
 
-                    it = queue.erase(it);
+        TX::Channel_Data& channel_data = m_tx.channel_data[confirmation.channel_idx];
+        TX::Packet* packet = find_tx_packet(channel_data, confirmation.id);
+        if (!packet)
+        {
+            continue;
+        }
 
-                    //can we fit another packet, maybe?
-                    constexpr size_t useful_payload = 8;
-                    if (socket_data.buffer.size() + sizeof(Header) + useful_payload >= socket_data.mtu) //plus some extra payload
-                    {
-                        //no, no space left so stop searching
-                        break;
-                    }
-                    else
-                    {
-                        //some space left, keep looking
-                        continue;
-                    }
-                }
+        if (confirmation.fragment_idx == FRAGMENT_IDX_ALL)
+        {
+            for (size_t i = 0; i < packet->fragments.size(); i++)
+            {
+                confirmed_size += confirm_tx_fragment(scheduler, *packet, i, confirmation.received_tp);
             }
-            //            dbg += " ,";
-
-            ++it;
         }
-
-//        if (merged > 0)
-//        {
-//            QLOGI("mrg:{} dg: {}", merged, dbg);
-//        }
-
-        //now reinsert datagrams
-        for (auto& datagram: m_tx.reinsert_queue)
+        else
         {
-            queue.insert(std::upper_bound(queue.begin(), queue.end(), datagram, tx_packet_datagram_predicate), std::move(datagram));
+            uint64_t fragments = confirmation.fragments;
+            while (fragments != 0)
+            {
+                size_t fragment_idx = confirmation.fragment_idx + __builtin_ctzll(fragments);
+                fragments &= fragments - 1;
+                confirmed_size += confirm_tx_fragment(scheduler, *packet, fragment_idx, confirmation.received_tp);
+            }
         }
-        m_tx.reinsert_queue.clear();
+
+        //the datagrams still in the resend queues are dropped when they get there
+        pop_done_tx_packets(channel_data);
     }
 
-//    if (merged > 1)
-//    {
-//        QLOGI("Merged: {}", merged);
-//    }
-    return socket_data.buffer.empty() == false;
+    //additive increase - about one mtu for each window of confirmed data
+    if (confirmed_size > 0)
+    {
+        //The link works again so the backoff is over. After an outage everything in flight was resent and, by Karn,
+        // gives no samples - waiting for one would keep the rto (and the resends) at the maximum long after the link is back
+        restore_rto(scheduler);
+
+        size_t increment = std::max<size_t>(socket_data.mtu * confirmed_size / scheduler.resend_window, 1);
+        scheduler.resend_window = std::min(scheduler.resend_window + increment, MAX_RESEND_WINDOW * socket_data.mtu);
+    }
 }
 
-void RCP::send_datagram(Socket_Handle socket_handle)
+auto RCP::confirm_tx_fragment(TX::Scheduler& scheduler, TX::Packet& packet, size_t fragment_idx, q::Clock::time_point received_tp) -> size_t
 {
-    Socket_Data& socket_data = m_sockets[socket_handle];
-    ISocket* socket = socket_data.socket;
-    QASSERT(socket != nullptr);
-
-//    if (m_is_sending.exchange(true))
-//    {
-//        //was already sending, return
-//        //QLOGI("send blocked {}", q::Clock::now());
-//        return;
-//    }
-    if (!socket->lock())
+    if (!set_tx_fragment_done(packet, fragment_idx))
     {
-        return;
+        return 0;
     }
-    //QLOGI("locking for sending");
+    m_global_stats.tx_confirmed_fragments++;
 
-    if (!compute_next_transit_datagram(socket_handle))
+    //Karn: the confirmation of a resent datagram could be for any of its sends so it's not a valid sample
+    TX::Datagram const& datagram = *packet.fragments[fragment_idx];
+    if (datagram.sent_count == 1 && received_tp > datagram.sent_tp)
     {
-        //QLOGI("unlocking - no data");
-        socket->unlock();
-        return;
+        update_rto(scheduler, received_tp - datagram.sent_tp);
     }
-
-    socket->async_send(socket_data.buffer.data(), socket_data.buffer.size());
+    return datagram.data.size();
 }
 
-void RCP::handle_send(Socket_Handle socket_handle, ISocket::Result)
+void RCP::update_rto(TX::Scheduler& scheduler, q::Clock::duration rtt)
 {
-    Socket_Data& socket_data = m_sockets[socket_handle];
-    ISocket* socket = socket_data.socket;
-    QASSERT(socket != nullptr);
-
-    //QLOGI("unlocking - done sending");
-    socket->unlock();
-
-    send_datagram(socket_handle);
+    if (scheduler.srtt.count() == 0)
+    {
+        scheduler.srtt = rtt;
+        scheduler.rttvar = rtt / 2;
+    }
+    else
+    {
+        q::Clock::duration delta = scheduler.srtt > rtt ? scheduler.srtt - rtt : rtt - scheduler.srtt;
+        scheduler.rttvar = (scheduler.rttvar * 3 + delta) / 4;
+        scheduler.srtt = (scheduler.srtt * 7 + rtt) / 8;
+    }
+    restore_rto(scheduler);
 }
 
-void RCP::handle_receive(uint8_t* data, size_t size)
+void RCP::restore_rto(TX::Scheduler& scheduler)
 {
-    if (data != nullptr && size > 0)
+    if (scheduler.srtt.count() == 0)
     {
-        process_incoming_data(data, size);
+        scheduler.rto = INITIAL_RTO;
+        return;
     }
+    scheduler.rto = std::min(std::max(scheduler.srtt + scheduler.rttvar * 4, MIN_RTO), MAX_RTO);
 }
 
-void RCP::add_fragment_confirmation(uint8_t channel_idx, uint32_t id, uint16_t fragment_idx)
+void RCP::backoff_rto(TX::Scheduler& scheduler, Socket_Data const& socket_data, q::Clock::time_point now)
 {
-    std::lock_guard<std::mutex> lg(m_tx.confirmations_mutex);
+    //all the datagrams that expire within one rto are the same loss event
+    if (now - scheduler.backoff_tp < scheduler.rto)
+    {
+        return;
+    }
+    scheduler.backoff_tp = now;
+    m_global_stats.tx_timeouts++;
 
-    TX::Confirmation conf;
-    conf.channel_idx = channel_idx;
-    conf.id = id;
-    conf.fragment_idx = fragment_idx;
-    m_tx.confirmations.push_back(conf);
+    scheduler.rto = std::min(scheduler.rto * 2, MAX_RTO);
+    scheduler.resend_window = std::max(scheduler.resend_window / 2, MIN_RESEND_WINDOW * socket_data.mtu);
+    scheduler.resend_tokens = std::min(scheduler.resend_tokens, scheduler.resend_window);
 }
 
-void RCP::add_packet_confirmation(uint8_t channel_idx, uint32_t id)
+void RCP::refill_resend_tokens(TX::Scheduler& scheduler, Socket_Data const& socket_data, q::Clock::time_point now)
 {
-    std::lock_guard<std::mutex> lg(m_tx.confirmations_mutex);
+    //a full window per round trip. Not per rto - that's a timeout, backed off while nothing gets through
+    q::Clock::duration rtt = std::max(scheduler.srtt.count() > 0 ? scheduler.srtt : INITIAL_RTO, MIN_RTO);
+    q::Clock::duration elapsed = now - scheduler.resend_tokens_tp;
+    size_t tokens = scheduler.resend_window;
+    if (elapsed < rtt)
+    {
+        tokens = static_cast<size_t>(scheduler.resend_window * elapsed.count() / rtt.count());
+    }
 
-    TX::Confirmation conf;
-    conf.channel_idx = channel_idx;
-    conf.id = id;
-    conf.fragment_idx = FRAGMENT_IDX_ALL;
-    m_tx.confirmations.push_back(conf);
+    //keep the fractions for the next time
+    if (tokens > 0)
+    {
+        scheduler.resend_tokens = std::min(scheduler.resend_tokens + tokens, scheduler.resend_window);
+        scheduler.resend_tokens_tp = now;
+    }
+    QASSERT(scheduler.resend_window >= MIN_RESEND_WINDOW * socket_data.mtu);
 }
 
-void RCP::send_pending_confirmations()
+auto RCP::compute_next_transit_datagram(Socket_Handle socket_handle) -> bool
 {
+    Socket_Data& socket_data = m_sockets[socket_handle];
+    socket_data.buffer.clear();
+
+    TX::Scheduler& scheduler = *m_tx.schedulers[socket_handle];
+
+    uint32_t epoch = m_tx.epoch.load(std::memory_order_acquire);
+    if (scheduler.epoch != epoch)
     {
-        std::lock_guard<std::mutex> lg(m_tx.confirmations_mutex);
+        reset_scheduler(scheduler, socket_handle);
+        scheduler.epoch = epoch;
+    }
 
-        //don't send confirmations too often otherwise we spam the channel and the other end cannot send data
-        //Send often enough to avoid resends though
-        auto now = q::Clock::now();
-        if (now - m_tx.confirmations_last_time_point < MIN_RESEND_DURATION / 2)
+    //connection requests/responses and confirmations first
+    {
+        TX::Datagram_ptr datagram;
+        while (scheduler.internal_queue.pop_front(datagram))
         {
-            return;
+            if (datagram->epoch == epoch)
+            {
+                scheduler.internal_datagrams.push_back(std::move(datagram));
+            }
         }
-        m_tx.confirmations_last_time_point = now;
 
-
-        //first throw away the ones we sent enough times
-        while (!m_tx.confirmations.empty() && m_tx.confirmations.front().sent_count >= TX::MAX_CONFIRMATION_SEND_COUNT)
+        auto& queue = scheduler.internal_datagrams;
+        while (!queue.empty() && add_datagram_to_send_buffer(socket_data, queue.front()))
         {
-            m_tx.confirmations.pop_front();
+            queue.pop_front();
         }
+    }
 
-        size_t header_size = sizeof(Confirmations_Header);
+    apply_received_confirmations(scheduler, socket_data);
 
-        Socket_Data& socket_data = m_sockets[m_tx.internal_queues.socket_handle];
+    //new packets
+    uint32_t dirty_channels = scheduler.dirty_channels.exchange(0, std::memory_order_acquire);
+    while (dirty_channels != 0)
+    {
+        uint8_t channel_idx = static_cast<uint8_t>(__builtin_ctz(dirty_channels));
+        dirty_channels &= dirty_channels - 1;
+        drain_channel_queue(scheduler, channel_idx);
+    }
 
-        size_t max_count = math::min<size_t>((socket_data.mtu - header_size) / sizeof(Confirmations_Header::Data), Confirmations_Header::MAX_CONFIRMATIONS);
+    auto now = q::Clock::now();
+
+    refill_resend_tokens(scheduler, socket_data, now);
+
+    //reliable datagrams that got no confirmation for an rto go back to their channels, as fast as the tokens allow.
+    //They were sent in order and all wait the same, so only the front has to be checked
+    while (!scheduler.in_flight.empty())
+    {
+        TX::Datagram_ptr& datagram = scheduler.in_flight.front();
+        if (!datagram->is_done)
+        {
+            if (now - datagram->sent_tp < scheduler.rto)
+            {
+                break;
+            }
+            backoff_rto(scheduler, socket_data, now);
+
+            size_t size = datagram->data.size();
+            if (scheduler.resend_tokens < size)
+            {
+                break;
+            }
+            scheduler.resend_tokens -= size;
+            m_global_stats.tx_resent_fragments++;
+
+            uint8_t channel_idx = get_header<Packet_Header>(datagram->data.data()).channel_idx;
+            m_tx.channel_data[channel_idx].resends.push_back(std::move(datagram));
+            update_channel_level(scheduler, channel_idx);
+        }
+        scheduler.in_flight.pop_front();
+    }
+
+    //unreliable datagrams are repeated blindly, there is no confirmation to time them with
+    while (!scheduler.repeats.empty())
+    {
+        TX::Datagram_ptr& datagram = scheduler.repeats.front();
+        if (!datagram->is_done)
+        {
+            if (now - datagram->sent_tp < MIN_RESEND_DURATION)
+            {
+                break;
+            }
+            uint8_t channel_idx = get_header<Packet_Header>(datagram->data.data()).channel_idx;
+            m_tx.channel_data[channel_idx].resends.push_back(std::move(datagram));
+            update_channel_level(scheduler, channel_idx);
+        }
+        scheduler.repeats.pop_front();
+    }
+
+    //now pack as many as fit.
+    //Except the datagrams of fec groups - the parity only helps if they are lost independently, so at most one per send
+    bool has_fec_datagram = false;
+    constexpr size_t useful_payload = 8;
+    while (socket_data.buffer.size() + sizeof(Header) + useful_payload < socket_data.mtu) //plus some extra payload
+    {
+        int next_channel = get_next_channel(scheduler, socket_data.mtu);
+        if (next_channel < 0)
+        {
+            break;
+        }
+
+        uint8_t channel_idx = static_cast<uint8_t>(next_channel);
+        TX::Channel_Data& channel_data = m_tx.channel_data[channel_idx];
+        auto* queue = get_next_queue(channel_data);
+        QASSERT(queue);
+
+        TX::Datagram_ptr datagram = queue->front();
+        bool is_canceled = datagram->params.cancel_after.count() > 0 && now - datagram->added_tp >= datagram->params.cancel_after;
+        if (datagram->is_done || is_canceled)
+        {
+            set_tx_datagram_done(channel_data, *datagram);
+            queue->pop_front();
+            pop_done_tx_packets(channel_data);
+            update_channel_level(scheduler, channel_idx);
+            continue;
+        }
+
+        if (datagram->is_fec_protected && has_fec_datagram)
+        {
+            break;
+        }
+        if (!add_datagram_to_send_buffer(socket_data, datagram))
+        {
+            break;
+        }
+        queue->pop_front();
+        has_fec_datagram |= datagram->is_fec_protected;
+
+        QASSERT(channel_data.deficit >= datagram->data.size());
+        channel_data.deficit -= datagram->data.size();
+
+        datagram->sent_tp = now;
+        datagram->sent_count++;
+
+        //do I have to send it again?
+        if (datagram->params.is_reliable == true)
+        {
+            scheduler.in_flight.push_back(std::move(datagram));
+        }
+        else if (datagram->sent_count < datagram->params.unreliable_retransmit_count)
+        {
+            scheduler.repeats.push_back(std::move(datagram));
+        }
+        else
+        {
+            set_tx_datagram_done(channel_data, *datagram);
+            pop_done_tx_packets(channel_data);
+        }
+
+        update_channel_level(scheduler, channel_idx);
+    }
+
+    return socket_data.buffer.empty() == false;
+}
+
+void RCP::send_datagram(Socket_Handle socket_handle)
+{
+    Socket_Data& socket_data = m_sockets[socket_handle];
+    ISocket* socket = socket_data.socket;
+    QASSERT(socket != nullptr);
+
+    TX::Scheduler& scheduler = *m_tx.schedulers[socket_handle];
+
+    //if the socket is busy, whoever has it will pick up the new data when done
+    while (socket->lock())
+    {
+        if (compute_next_transit_datagram(socket_handle))
+        {
+            socket->async_send(socket_data.buffer.data(), socket_data.buffer.size());
+            return;
+        }
+        socket->unlock();
+
+        //Something might have been queued after we looked. Its producer couldn't lock the socket so we have to send it
+        if (scheduler.dirty_channels.load(std::memory_order_acquire) == 0 && scheduler.internal_queue.empty())
+        {
+            return;
+        }
+    }
+}
+
+void RCP::handle_send(Socket_Handle socket_handle, ISocket::Result)
+{
+    Socket_Data& socket_data = m_sockets[socket_handle];
+    ISocket* socket = socket_data.socket;
+    QASSERT(socket != nullptr);
+
+    //QLOGI("unlocking - done sending");
+    socket->unlock();
+
+    send_datagram(socket_handle);
+}
+
+void RCP::handle_receive(uint8_t* data, size_t size)
+{
+    if (data != nullptr && size > 0)
+    {
+        process_incoming_data(data, size);
+    }
+}
+
+void RCP::add_fragment_confirmation(uint8_t channel_idx, uint32_t id, uint16_t fragment_idx)
+{
+    TX::Confirmation conf;
+    conf.channel_idx = channel_idx;
+    conf.id = id;
+    conf.fragment_idx = fragment_idx;
+    conf.epoch = m_tx.epoch.load(std::memory_order_acquire);
+    if (!m_tx.confirmation_queue.push_back(conf))
+    {
+        QLOGW("Too many pending confirmations");
+    }
+}
+
+void RCP::add_packet_confirmation(uint8_t channel_idx, uint32_t id)
+{
+    TX::Confirmation conf;
+    conf.channel_idx = channel_idx;
+    conf.id = id;
+    conf.fragment_idx = FRAGMENT_IDX_ALL;
+    conf.epoch = m_tx.epoch.load(std::memory_order_acquire);
+    if (!m_tx.confirmation_queue.push_back(conf))
+    {
+        QLOGW("Too many pending confirmations");
+    }
+}
+
+void RCP::send_pending_confirmations()
+{
+    TX::Scheduler& scheduler = *m_tx.schedulers[m_tx.internal_queues.socket_handle];
+
+    {
+        //don't send confirmations too often otherwise we spam the channel and the other end cannot send data
+        //Send often enough to avoid resends though
+        auto now = q::Clock::now();
+        if (now - m_tx.confirmations_last_time_point < MIN_RESEND_DURATION / 2)
+        {
+            return;
+        }
+        m_tx.confirmations_last_time_point = now;
+
+        uint32_t epoch = m_tx.epoch.load(std::memory_order_acquire);
+        if (m_tx.confirmations_epoch != epoch)
+        {
+            m_tx.confirmations.clear();
+            m_tx.confirmations_epoch = epoch;
+        }
+        TX::Confirmation confirmation;
+        while (m_tx.confirmation_queue.pop_front(confirmation))
+        {
+            if (confirmation.epoch == epoch)
+            {
+                m_tx.confirmations.push_back(confirmation);
+            }
+        }
+
+
+        //first throw away the ones we sent enough times
+        while (!m_tx.confirmations.empty() && m_tx.confirmations.front().sent_count >= TX::MAX_CONFIRMATION_SEND_COUNT)
+        {
+            m_tx.confirmations.pop_front();
+        }
+
+        //group them by packet
+        auto& sorted = m_tx.sorted_confirmations;
+        sorted.assign(m_tx.confirmations.begin(), m_tx.confirmations.end());
+        for (TX::Confirmation& confirmation: m_tx.confirmations)
+        {
+            confirmation.sent_count++;
+        }
+        std::sort(sorted.begin(), sorted.end(), [](TX::Confirmation const& a, TX::Confirmation const& b)
+        {
+            return std::tie(a.channel_idx, a.id, a.fragment_idx) < std::tie(b.channel_idx, b.id, b.fragment_idx);
+        });
+        sorted.erase(std::unique(sorted.begin(), sorted.end(), [](TX::Confirmation const& a, TX::Confirmation const& b)
+        {
+            return a.channel_idx == b.channel_idx && a.id == b.id && a.fragment_idx == b.fragment_idx;
+        }), sorted.end());
+
+        size_t header_size = sizeof(Confirmations_Header);
+        size_t sack_size = sizeof(Confirmations_Header::Sack);
+
+        Socket_Data& socket_data = m_sockets[m_tx.internal_queues.socket_handle];
+        QASSERT(socket_data.mtu > header_size + sack_size);
+
+        //a sack always fits in an empty datagram
+        size_t max_bitmap_size = math::min<size_t>(socket_data.mtu - header_size - sack_size, 255);
+        //a gap bigger than this is cheaper as a new sack
+        size_t max_fragment_gap = sack_size * 8;
 
         size_t datagrams_added = 0;
-        //now take them and pack them in a datagram
+        //now take them and pack them in datagrams
         size_t pidx = 0;
-        while (pidx < m_tx.confirmations.size())
+        while (pidx < sorted.size())
         {
-            size_t count = math::min(m_tx.confirmations.size() - pidx, max_count);
+            TX::Datagram_ptr datagram = acquire_tx_datagram(header_size, socket_data.mtu);
+            uint8_t* data_ptr = datagram->data.data() + header_size;
+            size_t data_size = 0;
+            size_t count = 0;
+
+            while (pidx < sorted.size() && count < Confirmations_Header::MAX_CONFIRMATIONS)
+            {
+                TX::Confirmation const& first = sorted[pidx];
+                size_t group_end = pidx + 1;
+                while (group_end < sorted.size() && sorted[group_end].channel_idx == first.channel_idx && sorted[group_end].id == first.id)
+                {
+                    group_end++;
+                }
 
-            size_t data_size = count * sizeof(Confirmations_Header::Data);
-            TX::Datagram_ptr datagram = acquire_tx_datagram(header_size, header_size + data_size); //channel_idx:1 + id:3);
+                //FRAGMENT_IDX_ALL sorts last so it's enough to check the last one
+                bool is_packet = sorted[group_end - 1].fragment_idx == FRAGMENT_IDX_ALL;
+                size_t end = group_end;
+                size_t bitmap_size = 0;
+                if (!is_packet)
+                {
+                    end = pidx + 1;
+                    while (end < group_end &&
+                           sorted[end].fragment_idx - sorted[end - 1].fragment_idx <= max_fragment_gap &&
+                           (sorted[end].fragment_idx - first.fragment_idx) / 8 < max_bitmap_size)
+                    {
+                        end++;
+                    }
+                    bitmap_size = (sorted[end - 1].fragment_idx - first.fragment_idx) / 8 + 1;
+                }
+
+                if (header_size + data_size + sack_size + bitmap_size > socket_data.mtu)
+                {
+                    break;
+                }
+
+                auto& sack = get_header<Confirmations_Header::Sack>(data_ptr + data_size);
+                sack.id = first.id;
+                sack.channel_idx = first.channel_idx;
+                sack.is_packet = is_packet ? 1 : 0;
+                sack.reserved = 0;
+                sack.fragment_idx = is_packet ? FRAGMENT_IDX_ALL : first.fragment_idx;
+                sack.bitmap_size = static_cast<uint8_t>(bitmap_size);
+                data_size += sack_size;
+
+                uint8_t* bitmap = data_ptr + data_size;
+                std::fill(bitmap, bitmap + bitmap_size, 0);
+                for (size_t i = pidx; i < end && !is_packet; i++)
+                {
+                    size_t bit = sorted[i].fragment_idx - first.fragment_idx;
+                    bitmap[bit / 8] |= 1 << (bit % 8);
+                }
+                data_size += bitmap_size;
+
+                pidx = end;
+                count++;
+            }
+            QASSERT(count > 0);
+            datagram->data.resize(header_size + data_size);
 
             auto& header = get_header<Confirmations_Header>(datagram->data.data());
             header.type = TYPE_CONFIRMATIONS;
             header.count = static_cast<uint8_t>(count);
             header.is_compressed = 0;
 
-            Confirmations_Header::Data* data_ptr = reinterpret_cast<Confirmations_Header::Data*>(datagram->data.data() + header_size);
-            for (size_t i = 0; i < count; i++, pidx++, data_ptr++)
-            {
-                auto& res = m_tx.confirmations[pidx];
-                res.sent_count++;
-                data_ptr->all = 0;
-                data_ptr->id = res.id;
-                data_ptr->fragment_idx = res.fragment_idx;
-                data_ptr->channel_idx = res.channel_idx;
-            }
-
             int comp_size = LZ4_compressBound(static_cast<int>(data_size));
             m_tx.confirmations_comp_state.buffer.resize(comp_size);
             int ret = LZ4_compress_fast_extState(m_tx.confirmations_comp_state.lz4_state.data(),
@@ -974,9 +1413,10 @@ void RCP::send_pending_confirmations()
 
             prepare_to_send_datagram(*datagram);
 
+            if (!scheduler.internal_queue.push_back(std::move(datagram)))
             {
-                std::lock_guard<std::mutex> ilg(m_tx.internal_queues.mutex);
-                m_tx.internal_queues.confirmations.push_back(datagram);
+                QLOGW("Internal queue full, dropping confirmations");
+                break;
             }
 
             datagrams_added++;
@@ -993,33 +1433,32 @@ void RCP::send_pending_confirmations()
 
 void RCP::send_packet_connect_req()
 {
-    {
-        std::lock_guard<std::mutex> lg(m_tx.internal_queues.mutex);
+    auto datagram = acquire_tx_datagram(sizeof(Connect_Req_Header));
+    auto& header = get_header<Connect_Req_Header>(datagram->data.data());
+    header.version = VERSION;
+    header.type = TYPE_CONNECT_REQ;
 
-        m_tx.internal_queues.connection_req = acquire_tx_datagram(sizeof(Connect_Req_Header));
-        auto& header = get_header<Connect_Req_Header>(m_tx.internal_queues.connection_req->data.data());
-        header.version = VERSION;
-        header.type = TYPE_CONNECT_REQ;
+    prepare_to_send_datagram(*datagram);
 
-        prepare_to_send_datagram(*m_tx.internal_queues.connection_req);
+    if (m_tx.schedulers[m_tx.internal_queues.socket_handle]->internal_queue.push_back(std::move(datagram)))
+    {
+        send_datagram(m_tx.internal_queues.socket_handle);
     }
-
-    send_datagram(m_tx.internal_queues.socket_handle);
 }
 void RCP::send_packet_connect_res(Connect_Res_Header::Response response)
 {
-    {
-        std::lock_guard<std::mutex> lg(m_tx.internal_queues.mutex);
+    auto datagram = acquire_tx_datagram(sizeof(Connect_Res_Header));
+    auto& header = get_header<Connect_Res_Header>(datagram->data.data());
+    header.version = VERSION;
+    header.response = response;
+    header.type = TYPE_CONNECT_RES;
 
-        m_tx.internal_queues.connection_res = acquire_tx_datagram(sizeof(Connect_Res_Header));
-        auto& header = get_header<Connect_Res_Header>(m_tx.internal_queues.connection_res->data.data());
-        header.version = VERSION;
-        header.response = response;
-        header.type = TYPE_CONNECT_RES;
+    prepare_to_send_datagram(*datagram);
 
-        prepare_to_send_datagram(*m_tx.internal_queues.connection_res);
+    if (m_tx.schedulers[m_tx.internal_queues.socket_handle]->internal_queue.push_back(std::move(datagram)))
+    {
+        send_datagram(m_tx.internal_queues.socket_handle);
     }
-    send_datagram(m_tx.internal_queues.socket_handle);
 }
 
 void RCP::process_incoming_data(uint8_t* data_ptr, size_t data_size)
@@ -1059,6 +1498,7 @@ void RCP::process_incoming_data(uint8_t* data_ptr, size_t data_size)
         crc_t crc1 = header.crc;
         header.crc = 0;
         crc_t crc2 = compute_crc(start_ptr, size);
+        header.crc = crc1; //the fec parities include it
         if (crc1 != crc2)
         {
             m_global_stats.rx_corrupted_datagrams++;
@@ -1083,8 +1523,12 @@ void RCP::process_incoming_data(uint8_t* data_ptr, size_t data_size)
             {
                 switch (header.type)
                 {
-                case Type::TYPE_PACKET: process_packet_data(start_ptr, size); break;
+                case Type::TYPE_PACKET:
+                    add_rx_fec_source(start_ptr, size);
+                    process_packet_data(start_ptr, size);
+                    break;
                 case Type::TYPE_CONFIRMATIONS: process_confirmations_data(start_ptr, size); break;
+                case Type::TYPE_FEC: process_fec_data(start_ptr, size); break;
                 case Type::TYPE_CONNECT_REQ: process_connect_req_data(start_ptr, size); break;
                 case Type::TYPE_CONNECT_RES: QLOGW("Ignoring connection response while connected."); break;
                 default: QASSERT(0); break;
@@ -1101,9 +1545,111 @@ void RCP::process_incoming_data(uint8_t* data_ptr, size_t data_size)
     //QLOGI("rcv:{} - {}", count, dbg);
 }
 
-auto RCP::rx_packet_id_predicate(RX::Packet_Queue::Item const& item1, uint32_t id) -> bool
+auto RCP::is_rx_packet_complete(RX::Packet const& packet) -> bool
 {
-    return item1.first < id;
+    return packet.has_main_header && packet.received_fragment_count == packet.main_header.fragment_count;
+}
+
+auto RCP::place_rx_fragment(RX::Packet& packet, uint16_t fragment_idx, uint8_t const* data, size_t size) -> bool
+{
+    QASSERT(packet.has_main_header);
+    if (fragment_idx >= packet.main_header.fragment_count)
+    {
+        return false;
+    }
+
+    uint64_t& bits = packet.received_fragments[fragment_idx / 64];
+    uint64_t bit = uint64_t(1) << (fragment_idx % 64);
+    if (bits & bit)
+    {
+        return false;
+    }
+
+    //the main fragment is full when there are more, and the rest have a smaller header
+    size_t offset = 0;
+    if (fragment_idx > 0)
+    {
+        size_t fragment_size = packet.main_fragment_size + sizeof(Packet_Main_Header) - sizeof(Packet_Header);
+        offset = packet.main_fragment_size + (fragment_idx - 1) * fragment_size;
+    }
+    if (offset + size > packet.data.size())
+    {
+        return false;
+    }
+
+    std::copy(data, data + size, packet.data.begin() + offset);
+    bits |= bit;
+    packet.data_size += size;
+    return true;
+}
+
+auto RCP::add_rx_fragment(RX::Packet& packet, uint8_t const* data_ptr, size_t data_size) -> bool
+{
+    auto const& header = get_header<Packet_Header>(data_ptr);
+    uint16_t fragment_idx = header.fragment_idx;
+    size_t header_size = (fragment_idx == 0) ? sizeof(Packet_Main_Header) : sizeof(Packet_Header);
+    if (data_size <= header_size)
+    {
+        return false;
+    }
+
+    if (packet.has_main_header)
+    {
+        if (!place_rx_fragment(packet, fragment_idx, data_ptr + header_size, data_size - header_size))
+        {
+            return false;
+        }
+    }
+    else if (fragment_idx != 0)
+    {
+        //no idea where it goes yet
+        for (RX::Datagram_ptr const& datagram: packet.early_fragments)
+        {
+            if (get_header<Packet_Header>(datagram->data.data()).fragment_idx == fragment_idx)
+            {
+                return false;
+            }
+        }
+        auto datagram = acquire_rx_datagram(0, data_size);
+        std::copy(data_ptr, data_ptr + data_size, datagram->data.begin());
+        packet.early_fragments.push_back(std::move(datagram));
+    }
+    else
+    {
+        auto const& main_header = get_header<Packet_Main_Header>(data_ptr);
+        if (main_header.fragment_count == 0)
+        {
+            return false;
+        }
+        packet.has_main_header = true;
+        packet.main_header = main_header;
+        packet.main_fragment_size = data_size - header_size;
+        packet.data.resize(main_header.packet_size);
+        packet.data_size = 0;
+        packet.received_fragments.assign((main_header.fragment_count + 63) / 64, 0);
+
+        if (!place_rx_fragment(packet, 0, data_ptr + header_size, data_size - header_size))
+        {
+            packet.has_main_header = false;
+            return false;
+        }
+
+        for (RX::Datagram_ptr const& datagram: packet.early_fragments)
+        {
+            uint16_t idx = get_header<Packet_Header>(datagram->data.data()).fragment_idx;
+            if (!place_rx_fragment(packet, idx, datagram->data.data() + sizeof(Packet_Header), datagram->data.size() - sizeof(Packet_Header)))
+            {
+                QLOGW("Dropping bad fragment {} for packet {}", idx, packet.id);
+                QASSERT(packet.received_fragment_count > 0);
+                packet.received_fragment_count--;
+            }
+        }
+        packet.early_fragments.clear();
+    }
+
+    packet.received_fragment_count++;
+    packet.any_header = header;
+    return true;
 }
 
 void RCP::process_packet_data(uint8_t* data_ptr, size_t data_size)
@@ -1118,8 +1664,6 @@ void RCP::process_packet_data(uint8_t* data_ptr, size_t data_size)
     auto& queue = m_rx.packet_queues[channel_idx];
     std::lock_guard<std::mutex> lg(queue.mutex);
 
-    auto& packets = queue.packets;
-
     auto last_packet_id = m_rx.last_packet_ids[channel_idx];
     if (id <= last_packet_id)
     {
@@ -1130,44 +1674,36 @@ void RCP::process_packet_data(uint8_t* data_ptr, size_t data_size)
         }
         m_global_stats.rx_dropped_packets++;
     }
+    else if (id - last_packet_id > RX::WINDOW_SIZE)
+    {
+        //too far ahead. Not confirming it so it will be sent again
+        m_global_stats.rx_dropped_packets++;
+    }
     else
     {
-        RX::Packet_ptr packet;
-
-        auto iter = std::lower_bound(packets.begin(), packets.end(), id, rx_packet_id_predicate);
-        if (iter != packets.end() && iter->first == id)
-        {
-            packet = iter->second;
-        }
-        else
+        RX::Packet_ptr& packet = queue.window[id % RX::WINDOW_SIZE];
+        if (!packet)
         {
             packet = m_rx.acquire_packet();
-            packets.insert(iter, std::make_pair(id, packet));
+            packet->id = id;
+            queue.max_id = std::max(queue.max_id, id);
         }
+        QASSERT(packet->id == id);
 
-        if (packet->fragments[fragment_idx]) //we already have the fragment
+        if (add_rx_fragment(*packet, data_ptr, data_size))
         {
-            m_global_stats.rx_duplicated_fragments++;
-            //QLOGW("Duplicated fragment {} for packet {}.", fragment_idx, id);
+            m_global_stats.rx_fragments++;
         }
         else
         {
-            m_global_stats.rx_fragments++;
-            packet->received_fragment_count++;
-            packet->any_header = header;
-            if (fragment_idx == 0)
-            {
-                packet->main_header = get_header<Packet_Main_Header>(data_ptr);
-            }
-            auto datagram = acquire_rx_datagram(data_size);
-            std::copy(data_ptr, data_ptr + data_size, datagram->data.begin());
-            packet->fragments[fragment_idx] = std::move(datagram);
+            m_global_stats.rx_duplicated_fragments++;
+            //QLOGW("Duplicated fragment {} for packet {}.", fragment_idx, id);
         }
 
         if (header.flag_needs_confirmation)
         {
             //if we received everything, tell the sender to stop sending this packet
-            if (packet->fragments[0] && packet->received_fragment_count == packet->main_header.fragment_count)
+            if (is_rx_packet_complete(*packet))
             {
                 add_packet_confirmation(channel_idx, id);
             }
@@ -1177,14 +1713,6 @@ void RCP::process_packet_data(uint8_t* data_ptr, size_t data_size)
             }
         }
     }
-
-    //send_pending_confirmations();
-
-//    if (channel_idx == 4)
-//    {
-//        QLOGI("Received fragment {} for packet {}: {}/{} received", fragment_idx, id, packet->received_fragment_count,
-//              packet->fragments[0] ? static_cast<size_t>(packet->main_header.fragment_count) : 0u);
-//    }
 }
 void RCP::process_confirmations_data(uint8_t* data_ptr, size_t data_size)
 {
@@ -1195,11 +1723,11 @@ void RCP::process_confirmations_data(uint8_t* data_ptr, size_t data_size)
 
     if (header.is_compressed)
     {
-        data_size = header.count * sizeof(Confirmations_Header::Data);
-        m_rx.confirmations_decompression_buffer.resize(data_size);
-        int ret = LZ4_decompress_fast(reinterpret_cast<const char*>(data_ptr),
+        m_rx.confirmations_decompression_buffer.resize(Header::MAX_SIZE);
+        int ret = LZ4_decompress_safe(reinterpret_cast<const char*>(data_ptr),
                                       reinterpret_cast<char*>(m_rx.confirmations_decompression_buffer.data()),
-                                      static_cast<int>(data_size));
+                                      static_cast<int>(data_size),
+                                      static_cast<int>(m_rx.confirmations_decompression_buffer.size()));
         if (ret < 0)
         {
             QLOGW("Decompression error: {}", ret);
@@ -1207,108 +1735,364 @@ void RCP::process_confirmations_data(uint8_t* data_ptr, size_t data_size)
         }
 
         data_ptr = m_rx.confirmations_decompression_buffer.data();
+        data_size = static_cast<size_t>(ret);
     }
 
     size_t count = header.count;
     QASSERT(count > 0);
 
-    QASSERT(data_size == sizeof(Confirmations_Header::Data)*count);
+    //hand them to the schedulers of the sockets, they drop the confirmed datagrams the next time they run
+    uint32_t epoch = m_tx.epoch.load(std::memory_order_acquire);
+    auto now = q::Clock::now();
+    for (size_t i = 0; i < count; i++)
+    {
+        if (data_size < sizeof(Confirmations_Header::Sack))
+        {
+            QLOGW("Truncated confirmations");
+            return;
+        }
+        auto const& sack = get_header<Confirmations_Header::Sack>(data_ptr);
+        data_ptr += sizeof(Confirmations_Header::Sack);
+        data_size -= sizeof(Confirmations_Header::Sack);
 
-    Confirmations_Header::Data* conf = reinterpret_cast<Confirmations_Header::Data*>(data_ptr);
-    Confirmations_Header::Data* conf_end = conf + count;
+        uint8_t const* bitmap = data_ptr;
+        size_t bitmap_size = sack.bitmap_size;
+        if (data_size < bitmap_size)
+        {
+            QLOGW("Truncated confirmations");
+            return;
+        }
+        data_ptr += bitmap_size;
+        data_size -= bitmap_size;
 
-    //sort the confirmations ascending so we can search fast
-    std::sort(conf, conf_end);//, [](Fragments_Res_Header::Data const& a, Fragments_Res_Header::Data const& b) { return a.all < b.all; });
+        Socket_Handle socket_handle = m_tx.channel_data[sack.channel_idx].socket_handle;
+        if (socket_handle < 0)
+        {
+            continue;
+        }
+        TX::Scheduler& scheduler = *m_tx.schedulers[socket_handle];
 
-    //confirm packet datagrams
-    {
-        std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
+        TX::Received_Confirmation confirmation;
+        confirmation.id = sack.id;
+        confirmation.channel_idx = sack.channel_idx;
+        confirmation.epoch = epoch;
+        confirmation.received_tp = now;
 
-        auto& queue = m_tx.packet_queue;
-        for (auto it = queue.begin(); it != queue.end();)
+        if (sack.is_packet)
         {
-            auto& datagram = *it;
-            auto const& hdr = get_header<Packet_Header>(datagram->data.data());
-            Confirmations_Header::Data key;
-
-            key.all = 0;
-            key.channel_idx = hdr.channel_idx;
-            key.id = hdr.id;
-            key.fragment_idx = hdr.fragment_idx;
+            confirmation.fragment_idx = FRAGMENT_IDX_ALL;
+            scheduler.received_confirmations.push_back(confirmation);
+            continue;
+        }
 
-            auto lb = std::lower_bound(conf, conf_end, key);
-            if (lb != conf_end && *lb == key)
+        //64 fragments at a time
+        for (size_t b = 0; b < bitmap_size; b += 8)
+        {
+            uint64_t fragments = 0;
+            for (size_t j = 0; j < 8 && b + j < bitmap_size; j++)
+            {
+                fragments |= uint64_t(bitmap[b + j]) << (j * 8);
+            }
+            size_t fragment_idx = sack.fragment_idx + b * 8;
+            if (fragments == 0 || fragment_idx >= FRAGMENT_IDX_ALL)
             {
-//                if (hdr.channel_idx == 20)
-//                {
-//                    QLOGI("Confirming fragment {} for packet {}: {} / {}", hdr.fragment_idx, hdr.id, q::Clock::now() - datagram->added_tp, q::Clock::now() - datagram->sent_tp);
-//                }
-                it = queue.erase(it);
-                m_global_stats.tx_confirmed_fragments++;
                 continue;
             }
+            confirmation.fragment_idx = static_cast<uint16_t>(fragment_idx);
+            confirmation.fragments = fragments;
+            scheduler.received_confirmations.push_back(confirmation);
+        }
+    }
+}
+
+void RCP::Fec_Deleter::operator()(fec_t* fec) const
+{
+    fec_free(fec);
+}
+
+auto RCP::create_fec(Fec_ptr& code, size_t k, size_t n) -> bool
+{
+    if (code && code->k == k && code->n == n)
+    {
+        return false;
+    }
+    //fec_new initializes some global tables the first time
+    static std::mutex s_mutex;
+    std::lock_guard<std::mutex> lg(s_mutex);
+    code.reset(fec_new(static_cast<unsigned short>(k), static_cast<unsigned short>(n)));
+    return true;
+}
 
-            key.fragment_idx = FRAGMENT_IDX_ALL;
+void RCP::encode_fec(TX::Channel_Data& channel_data, Send_Params const& params, TX::Packet& packet)
+{
+    TX::Fec_Encoder& fec = channel_data.fec;
 
-            lb = std::lower_bound(conf, conf_end, key);
-            //if (lb != conf_end && lb->channel_idx == key.channel_idx && lb->id == key.id)
-            if (lb != conf_end && *lb == key)
+    size_t k = params.fec_k;
+    size_t n = params.fec_n;
+    if (create_fec(fec.code, k, n) || fec.epoch != packet.epoch)
+    {
+        fec.sources.clear();
+        fec.epoch = packet.epoch;
+    }
+
+    size_t fragment_count = packet.fragments.size();
+    for (size_t f = 0; f < fragment_count; f++)
+    {
+        fec.sources.push_back(packet.fragments[f]);
+        if (fec.sources.size() < k)
+        {
+            continue;
+        }
+
+        //the group is complete
+        size_t block_size = 0;
+        for (TX::Datagram_ptr const& datagram: fec.sources)
+        {
+            block_size = std::max(block_size, datagram->data.size());
+        }
+
+        fec.blocks.assign(k * block_size, 0);
+        fec.source_ptrs.resize(k);
+        uint32_t packet_starts = 0;
+        for (size_t i = 0; i < k; i++)
+        {
+            Buffer_t const& data = fec.sources[i]->data;
+            uint8_t* block = fec.blocks.data() + i * block_size;
+            std::copy(data.begin(), data.end(), block);
+            fec.source_ptrs[i] = block;
+            if (i > 0 && get_header<Packet_Header>(data.data()).fragment_idx == 0)
             {
-//                if (hdr.channel_idx == 20)
-//                {
-//                    QLOGI("Confirming packet {}: {} / {}", hdr.id, q::Clock::now() - datagram->added_tp, q::Clock::now() - datagram->sent_tp);
-//                }
-                it = queue.erase(it);
-                m_global_stats.tx_confirmed_fragments++;
-                continue;
+                packet_starts |= 1u << i;
             }
+        }
+
+        auto const& first_header = get_header<Packet_Header>(fec.sources[0]->data.data());
+
+        size_t parity_count = n - k;
+        size_t first_parity_idx = packet.fragments.size();
+        fec.parity_ptrs.resize(parity_count);
+        fec.block_nums.resize(parity_count);
+        for (size_t i = 0; i < parity_count; i++)
+        {
+            auto datagram = acquire_tx_datagram(sizeof(Fec_Header), sizeof(Fec_Header) + block_size);
+            datagram->params = params;
+            datagram->packet_id = packet.id;
+            datagram->fragment_idx = static_cast<uint16_t>(packet.fragments.size());
+            datagram->is_fec_protected = true;
+
+            Fec_Header& header = get_header<Fec_Header>(datagram->data.data());
+            header.type = TYPE_FEC;
+            header.id = first_header.id;
+            header.channel_idx = first_header.channel_idx;
+            header.fragment_idx = first_header.fragment_idx;
+            header.packet_starts = packet_starts;
+            header.k = static_cast<uint8_t>(k);
+            header.n = static_cast<uint8_t>(n);
+            header.block_idx = static_cast<uint8_t>(k + i);
+
+            fec.parity_ptrs[i] = datagram->data.data() + sizeof(Fec_Header);
+            fec.block_nums[i] = static_cast<unsigned>(k + i);
+            packet.fragments.push_back(std::move(datagram));
+        }
+
+        fec_encode(fec.code.get(), fec.source_ptrs.data(), fec.parity_ptrs.data(), fec.block_nums.data(), parity_count, block_size);
+
+        for (size_t i = first_parity_idx; i < packet.fragments.size(); i++)
+        {
+            packet.fragments[i]->added_tp = packet.fragments[0]->added_tp;
+            prepare_to_send_datagram(*packet.fragments[i]);
+        }
 
-            ++it;
+        fec.sources.clear();
+    }
+}
+
+void RCP::add_rx_fec_source(uint8_t const* data_ptr, size_t data_size)
+{
+    auto const& header = get_header<Packet_Header>(data_ptr);
+    RX::Fec_Decoder& decoder = m_rx.fec_decoders[header.channel_idx];
+    if (!decoder.is_active.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto datagram = acquire_rx_datagram(0, data_size);
+    std::copy(data_ptr, data_ptr + data_size, datagram->data.begin());
+
+    std::lock_guard<std::mutex> lg(decoder.mutex);
+    decoder.sources.push_back(std::move(datagram));
+    while (decoder.sources.size() > MAX_FEC_N * 2)
+    {
+        decoder.sources.pop_front();
+    }
+}
+
+auto RCP::recover_fec_group(RX::Fec_Decoder& decoder, RX::Fec_Group& group) -> bool
+{
+    size_t k = group.k;
+    size_t block_size = group.block_size;
+
+    decoder.in_ptrs.resize(k);
+    decoder.indices.resize(k);
+    decoder.out_ptrs.clear();
+
+    //find the datagrams of the group
+    size_t missing_count = 0;
+    uint32_t id = group.id;
+    uint16_t fragment_idx = group.fragment_idx;
+    for (size_t i = 0; i < k; i++)
+    {
+        if (i > 0)
+        {
+            bool is_packet_start = (group.packet_starts >> i) & 1;
+            id = is_packet_start ? (id + 1) & 0xFFFFFF : id;
+            fragment_idx = is_packet_start ? 0 : fragment_idx + 1;
+        }
+
+        auto it = std::find_if(decoder.sources.begin(), decoder.sources.end(), [id, fragment_idx](RX::Datagram_ptr const& datagram)
+        {
+            auto const& header = get_header<Packet_Header>(datagram->data.data());
+            return header.id == id && header.fragment_idx == fragment_idx;
+        });
+        if (it != decoder.sources.end() && (*it)->data.size() <= block_size)
+        {
+            decoder.in_ptrs[i] = (*it)->data.data();
+            decoder.indices[i] = static_cast<unsigned>(i);
+        }
+        else
+        {
+            decoder.in_ptrs[i] = nullptr;
+            missing_count++;
         }
     }
 
-//    Confirmations_Header::Data* conf = reinterpret_cast<Confirmations_Header::Data*>(data_ptr);
+    if (missing_count == 0)
+    {
+        return true;
+    }
+    if (missing_count > group.parities.size())
+    {
+        return false;
+    }
 
-//    //confirm packet datagrams
-//    {
-//        std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
-//        auto& queue = m_tx.packet_queue;
+    create_fec(decoder.code, k, group.n);
 
-//        for (size_t i = 0; i < count; i++)
-//        {
-//            const Confirmations_Header::Data& c = conf[i];
+    //the present datagrams are padded, the parities go in the holes and the missing ones are decoded after them
+    decoder.blocks.assign((k + missing_count) * block_size, 0);
+    size_t parity_idx = 0;
+    for (size_t i = 0; i < k; i++)
+    {
+        uint8_t* block = decoder.blocks.data() + i * block_size;
+        if (decoder.in_ptrs[i])
+        {
+            auto const& header = get_header<Header>(decoder.in_ptrs[i]);
+            std::copy(decoder.in_ptrs[i], decoder.in_ptrs[i] + header.size, block);
+            decoder.in_ptrs[i] = block;
+        }
+        else
+        {
+            RX::Datagram_ptr const& parity = group.parities[parity_idx++];
+            decoder.in_ptrs[i] = parity->data.data() + sizeof(Fec_Header);
+            decoder.indices[i] = get_header<Fec_Header>(parity->data.data()).block_idx;
+            decoder.out_ptrs.push_back(decoder.blocks.data() + (k + decoder.out_ptrs.size()) * block_size);
+        }
+    }
 
-//            auto it = std::find_if(queue.begin(), queue.end(), [&c](TX::Datagram_ptr const& datagram)
-//            {
-//                Packet_Header const& hdr = get_header<Packet_Header>(datagram->data.data());
-//                return c.channel_idx == hdr.channel_idx && c.id == hdr.id &&
-//                        (c.fragment_idx == hdr.fragment_idx || c.fragment_idx == FRAGMENT_IDX_ALL);
-//            });
+    fec_decode(decoder.code.get(), decoder.in_ptrs.data(), decoder.out_ptrs.data(), decoder.indices.data(), block_size);
 
-//            if (it != queue.end())
-//            {
-//                Packet_Header const& hdr = get_header<Packet_Header>((*it)->data.data());
-//                if (c.fragment_idx == FRAGMENT_IDX_ALL)
-//                {
-////                  if (hdr.channel_idx == 20)
-////                  {
-////                      QLOGI("Confirming packet {}: {} / {}", hdr.id, q::Clock::now() - datagram->added_tp, q::Clock::now() - datagram->sent_tp);
-////                  }
-//                    queue.erase(it);
-//                    m_global_stats.tx_confirmed_fragments++;
-//                }
-//                else
-//                {
-////                  if (hdr.channel_idx == 20)
-////                  {
-////                      QLOGI("Confirming fragment {} for packet {}: {} / {}", hdr.fragment_idx, hdr.id, q::Clock::now() - datagram->added_tp, q::Clock::now() - datagram->sent_tp);
-////                  }
-//                    queue.erase(it);
-//                    m_global_stats.tx_confirmed_fragments++;
-//                }
-//            }
-//        }
-//    }
+    for (uint8_t const* block: decoder.out_ptrs)
+    {
+        //the padding is not part of it
+        auto const& header = get_header<Header>(block);
+        if (header.type != TYPE_PACKET || header.size < sizeof(Packet_Header) || header.size > block_size)
+        {
+            QLOGW("Bad fec datagram");
+            continue;
+        }
+        auto datagram = acquire_rx_datagram(0, header.size);
+        std::copy(block, block + header.size, datagram->data.begin());
+        decoder.recovered.push_back(std::move(datagram));
+    }
+
+    return true;
+}
+
+void RCP::process_fec_data(uint8_t* data_ptr, size_t data_size)
+{
+    QASSERT(data_ptr && data_size > 0);
+    auto const& header = get_header<Fec_Header>(data_ptr);
+    if (header.k == 0 || header.k > MAX_FEC_K || header.n <= header.k || header.n > MAX_FEC_N ||
+            header.block_idx < header.k || header.block_idx >= header.n ||
+            data_size <= sizeof(Fec_Header))
+    {
+        QLOGW("Bad fec header: k {}, n {}, block {}", header.k, header.n, header.block_idx);
+        return;
+    }
+    size_t block_size = data_size - sizeof(Fec_Header);
+
+    RX::Fec_Decoder& decoder = m_rx.fec_decoders[header.channel_idx];
+    {
+        std::lock_guard<std::mutex> lg(decoder.mutex);
+
+        //from now on the datagrams of this channel are kept
+        decoder.is_active = true;
+
+        auto it = std::find_if(decoder.groups.begin(), decoder.groups.end(), [&header](RX::Fec_Group const& group)
+        {
+            return group.id == header.id && group.fragment_idx == header.fragment_idx;
+        });
+        if (it == decoder.groups.end())
+        {
+            if (decoder.groups.size() >= RX::MAX_FEC_GROUPS)
+            {
+                decoder.groups.pop_front();
+            }
+            RX::Fec_Group group;
+            group.id = header.id;
+            group.fragment_idx = header.fragment_idx;
+            group.packet_starts = header.packet_starts;
+            group.k = header.k;
+            group.n = header.n;
+            group.block_size = block_size;
+            decoder.groups.push_back(std::move(group));
+            it = decoder.groups.end() - 1;
+        }
+
+        RX::Fec_Group& group = *it;
+        if (group.is_done || group.k != header.k || group.n != header.n || group.block_size != block_size)
+        {
+            return;
+        }
+        for (RX::Datagram_ptr const& parity: group.parities)
+        {
+            if (get_header<Fec_Header>(parity->data.data()).block_idx == header.block_idx)
+            {
+                return;
+            }
+        }
+
+        auto datagram = acquire_rx_datagram(0, data_size);
+        std::copy(data_ptr, data_ptr + data_size, datagram->data.begin());
+        group.parities.push_back(std::move(datagram));
+
+        group.is_done = recover_fec_group(decoder, group);
+        if (group.is_done)
+        {
+            group.parities.clear();
+        }
+    }
+
+    //outside the lock as they come back here through process_packet_data
+    std::vector<RX::Datagram_ptr> recovered;
+    {
+        std::lock_guard<std::mutex> lg(decoder.mutex);
+        std::swap(recovered, decoder.recovered);
+    }
+    for (RX::Datagram_ptr const& datagram: recovered)
+    {
+        m_global_stats.rx_recovered_datagrams++;
+        process_incoming_data(datagram->data.data(), datagram->data.size());
+    }
 }
 
 void RCP::process_connect_req_data(uint8_t* data_ptr, size_t data_size)
@@ -1359,31 +2143,25 @@ void RCP::process_connect_res_data(uint8_t* data_ptr, size_t data_size)
 
 void RCP::purge()
 {
-    //purge confirmations
-    {
-        std::lock_guard<std::mutex> lg(m_tx.confirmations_mutex);
-        m_tx.confirmations.clear();
-    }
-
-    {
-        std::lock_guard<std::mutex> lg(m_tx.internal_queues.mutex);
-        m_tx.internal_queues.connection_req.reset();
-        m_tx.internal_queues.connection_res.reset();
-        m_tx.internal_queues.confirmations.clear();
-    }
-
-    {
-        std::lock_guard<std::mutex> lg(m_tx.packet_queue_mutex);
-        m_tx.packet_queue.clear();
-//        m_tx.in_transit_datagram.reset();
-    }
+    //The TX queues belong to other threads. Their consumers drop everything queued before this
+    m_tx.epoch.fetch_add(1, std::memory_order_acq_rel);
 
     for (size_t i = 0; i < MAX_CHANNELS; i++)
     {
         auto& queue = m_rx.packet_queues[i];
 
         std::lock_guard<std::mutex> lg(queue.mutex);
-        queue.packets.clear();
+        for (RX::Packet_ptr& packet: queue.window)
+        {
+            packet.reset();
+        }
+        queue.max_id = 0;
+        queue.received_packet.reset();
+
+        auto& decoder = m_rx.fec_decoders[i];
+        std::lock_guard<std::mutex> fec_lg(decoder.mutex);
+        decoder.sources.clear();
+        decoder.groups.clear();
 
         m_rx.last_packet_ids[i] = 0;
     };
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
 #include <deque>
-#include <map>
 #include <vector>
 #include <boost/intrusive_ptr.hpp>
 #include "ISocket.h"
+#include "utils/MPSC_Queue.h"
+#include "utils/MPMC_Queue.h"
+
+struct fec_t;
 
 namespace util
 {
@@ -19,8 +23,12 @@ namespace detail
         std::atomic_size_t count = {0};
     };
 
+    //The free items are kept in a lock-free queue so acquiring and releasing from the producer threads never blocks.
+    //At most MAX_FREE_ITEMS are kept, the ones released over that are deleted.
     template<class T> struct Pool
     {
+        static constexpr size_t MAX_FREE_ITEMS = 1024;
+
         std::function<void(T&)> release;
         typedef boost::intrusive_ptr<T> Ptr;
         Pool();
@@ -29,10 +37,7 @@ namespace detail
         std::function<void(Pool_Item_Base*)> m_garbage_collector;
         struct Items
         {
-            ////
-            std::mutex mutex;
-            std::vector<std::unique_ptr<T>> items;
-            ////
+            util::MPMC_Queue<std::unique_ptr<T>> items{MAX_FREE_ITEMS};
         };
         std::shared_ptr<Items> m_pool;
     };
@@ -55,6 +60,11 @@ public:
         bool cancel_previous_data = false; //if true, new packets cancel old-unsent packets
         uint8_t unreliable_retransmit_count = 0; //for unreliable channels, retransmit data this many times to increase the chances of arrival. Zero means just the main transmission and no retransmit
         q::Clock::duration cancel_after = q::Clock::duration{0}; //zero means never
+
+        //For unreliable channels, every fec_k datagrams get fec_n - fec_k parity datagrams and any fec_k of the
+        // fec_n rebuild the rest. Costs less than retransmits for the same loss. Zero means no fec
+        uint8_t fec_k = 0; //up to MAX_FEC_K
+        uint8_t fec_n = 0; //up to MAX_FEC_N
     };
     void set_send_params(uint8_t channel_idx, Send_Params const& params);
     auto get_send_params(uint8_t channel_idx) const -> Send_Params const&;
@@ -82,13 +92,21 @@ public:
 
     auto receive(uint8_t channel_idx, std::vector<uint8_t>& data) -> bool;
 
+    //Points in a buffer owned by the RCP, valid until the next receive call on the same channel. No copies
+    struct Received_Data
+    {
+        uint8_t const* data = nullptr;
+        size_t size = 0;
+    };
+    auto receive(uint8_t channel_idx, Received_Data& data) -> bool;
+
     void process();
 
 private:
 
     auto _send_locked(uint8_t channel_idx, Send_Params const& params, void const* data, size_t size) -> bool;
 
-    static const uint8_t VERSION = 1;
+    static const uint8_t VERSION = 2;
     const q::Clock::duration RECONNECT_BEACON_TIMEOUT = std::chrono::milliseconds(1000);
 
     enum Type
@@ -97,10 +115,13 @@ private:
         TYPE_CONFIRMATIONS      =   1,
         TYPE_CONNECT_REQ        =   2,
         TYPE_CONNECT_RES        =   3,
+        TYPE_FEC                =   4,
     };
 
     static const size_t MAX_CHANNELS = 32;
     static const size_t MAX_FRAGMENTS = 65000;
+    static const size_t MAX_FEC_K = 32; //the groups are described by a 32 bit mask
+    static const size_t MAX_FEC_N = 64;
 
     typedef uint16_t crc_t;
 
@@ -132,27 +153,42 @@ private:
     };
     static_assert(sizeof(Packet_Main_Header) == 4 + 6 + 6, "Data too big");
 
+    //Selective acks. Each entry confirms either a whole packet or a run of fragments as a bitmap,
+    // so a fully received burst of fragments costs one bit each instead of a full entry.
     struct Confirmations_Header : public Header
     {
         constexpr static size_t MAX_CONFIRMATIONS = 127u;
-        union Data
+        struct Sack
         {
-            Data() : all(0) {}
-            struct
-            {
-                uint32_t id;
-                uint16_t fragment_idx;
-                uint8_t channel_idx;
-            };
-            uint64_t all = 0;
-            bool operator<(Data const& other) const { return all < other.all; }
-            bool operator==(Data const& other) const { return all == other.all; }
+            uint32_t id : 24;
+            uint32_t channel_idx : 5;
+            uint32_t is_packet : 1; //the whole packet is confirmed and there is no bitmap
+            uint32_t reserved : 2;
+            uint16_t fragment_idx; //the first fragment in the bitmap
+            uint8_t bitmap_size; //bytes following. Bit i confirms fragment_idx + i
         };
-        uint8_t count : 7;
+        uint8_t count : 7; //of Sack entries
         uint8_t is_compressed : 1;
     };
 
-    static_assert(sizeof(Confirmations_Header::Data) == 8, "Data too big");
+    static_assert(sizeof(Confirmations_Header::Sack) == 7, "Data too big");
+
+    //A parity datagram for a group of fec_k datagrams of a channel. They are the consecutive fragments starting
+    // with fragment_idx of packet id, so the group is described by where the packets start.
+    //The parity covers the whole datagrams, headers included, padded to the biggest one.
+    //The channel is where the Packet_Header has it.
+    struct Fec_Header : public Header
+    {
+        uint32_t id : 24; //of the first datagram in the group
+        uint32_t channel_idx : 5;
+        uint32_t reserved : 3;
+        uint16_t fragment_idx; //of the first datagram in the group
+        uint32_t packet_starts; //bit i is set when datagram i is the first fragment of the next packet
+        uint8_t k;
+        uint8_t n;
+        uint8_t block_idx; //k to n-1
+    };
+    static_assert(sizeof(Fec_Header) == 4 + 13, "Data too big");
 
     struct Connect_Req_Header : public Header
     {
@@ -189,6 +225,12 @@ private:
 
     std::vector<Socket_Data> m_sockets;
 
+    struct Fec_Deleter
+    {
+        void operator()(fec_t* fec) const;
+    };
+    typedef std::unique_ptr<fec_t, Fec_Deleter> Fec_ptr;
+
     struct Compression_State
     {
         std::vector<uint8_t> buffer;
@@ -202,7 +244,12 @@ private:
             Send_Params params;
             q::Clock::time_point added_tp = q::Clock::time_point(q::Clock::duration{0});
             q::Clock::time_point sent_tp = q::Clock::time_point(q::Clock::duration{0});
-            uint32_t sent_count = 0; //how many times it was sent - for unreliable only
+            uint32_t sent_count = 0; //how many times it was sent. Only the first send of a reliable datagram gives an rtt sample
+            uint32_t epoch = 0;
+            bool is_done = false; //confirmed, canceled or sent enough times. Only the scheduler touches this
+            uint32_t packet_id = 0; //the packet it belongs to
+            uint16_t fragment_idx = 0; //in the packet fragments. The parity datagrams come after the packet fragments
+            bool is_fec_protected = false; //a source or parity datagram of a fec group
 
             Buffer_t data;
         };
@@ -210,6 +257,34 @@ private:
 
         detail::Pool<Datagram> datagram_pool;
 
+        //All the fragments of a packet. This is what the producers queue
+        struct Packet : public detail::Pool_Item_Base
+        {
+            uint32_t id = 0;
+            uint32_t epoch = 0;
+            Send_Params params;
+            std::vector<Datagram_ptr> fragments;
+            size_t pending_count = 0; //fragments not done yet
+        };
+        typedef detail::Pool<Packet>::Ptr Packet_ptr;
+
+        detail::Pool<Packet> packet_pool;
+
+        //Groups the datagrams of a channel and computes the parity datagrams when a group is complete
+        struct Fec_Encoder
+        {
+            Fec_ptr code;
+            uint32_t epoch = 0;
+            std::vector<Datagram_ptr> sources; //the group so far
+            std::vector<uint8_t> blocks; //the sources padded to the same size
+            std::vector<uint8_t const*> source_ptrs;
+            std::vector<uint8_t*> parity_ptrs;
+            std::vector<unsigned> block_nums;
+        };
+
+        //Bumped by purge. Everything queued before is dropped by its consumer instead of being cleared from another thread
+        std::atomic<uint32_t> epoch = { 0 };
+
         //this is a list of fragment and packet responses
         //they are accumulated in a vector and then sent repeatedly for a number of times
         static const uint8_t MAX_CONFIRMATION_SEND_COUNT = 2;
@@ -219,44 +294,107 @@ private:
             uint16_t fragment_idx = 0;
             uint8_t channel_idx = 0;
             uint8_t sent_count = 0;
+            uint32_t epoch = 0;
         };
+        static_assert(MAX_CHANNELS <= 32, "The schedulers keep the channels in 32 bit masks");
+        //any thread -> send_pending_confirmations
+        util::MPSC_Queue<Confirmation> confirmation_queue{4096};
+
         /////
-        std::mutex confirmations_mutex;
+        //owned by send_pending_confirmations
         std::deque<Confirmation> confirmations;
+        std::vector<Confirmation> sorted_confirmations; //grouped by packet to build the sacks
+        uint32_t confirmations_epoch = 0;
         q::Clock::time_point confirmations_last_time_point = q::Clock::now();
         Compression_State confirmations_comp_state;
         /////
 
         //--------------------------------------------
 
-        typedef std::deque<Datagram_ptr> Send_Queue;
+        //A confirmation received from the other end, on its way to the scheduler of the socket
+        struct Received_Confirmation
+        {
+            uint32_t id = 0;
+            uint16_t fragment_idx = 0; //the first fragment in the mask or FRAGMENT_IDX_ALL for the whole packet
+            uint8_t channel_idx = 0;
+            uint64_t fragments = 0; //bit i confirms fragment_idx + i
+            uint32_t epoch = 0;
+            q::Clock::time_point received_tp;
+        };
 
-        struct Internal_Queues
+        static const size_t PRIORITY_LEVEL_COUNT = 256; //one for each importance value
+
+        //Picks the datagrams for one socket. Only the thread holding the socket lock runs it.
+        //Channels with something to send are active on the priority level of their next datagram. The highest active level
+        // always goes first and the channels on the same level share it with deficit round robin, so the next datagram is found
+        // in constant time.
+        //
+        //Reliable datagrams are resent when no confirmation came for one retransmission timeout. The timeout follows the
+        // measured round trip time (Jacobson/Karels) and backs off on losses. The resends are paced by a token bucket that
+        // gives resend_window bytes per round trip, halved on each timeout and grown by the confirmed data (AIMD),
+        // so a lossy link doesn't drown in retransmits.
+        struct Scheduler
         {
-            Socket_Handle socket_handle = Socket_Handle(-1);
+            Scheduler()
+            {
+                active_levels.fill(0);
+                level_channels.fill(0);
+                level_cursors.fill(0);
+            }
+
+            //producers -> scheduler
+            std::atomic<uint32_t> dirty_channels = { 0 }; //channels with new packets in their queue
+            util::MPSC_Queue<Datagram_ptr> internal_queue; //connection requests/responses and confirmations
+            util::MPSC_Queue<Received_Confirmation> received_confirmations{2048}; //a lost one only costs a resend
 
             /////
-            std::mutex mutex;
-            Datagram_ptr connection_req;
-            Datagram_ptr connection_res;
-            Send_Queue confirmations;
+            //owned by the scheduler
+            uint32_t epoch = 0;
+            std::deque<Datagram_ptr> internal_datagrams;
+            std::deque<Datagram_ptr> in_flight; //reliable, waiting for a confirmation or for a resend, oldest first
+            std::deque<Datagram_ptr> repeats; //unreliable datagrams waiting to be sent again
+
+            q::Clock::duration srtt = q::Clock::duration{0}; //zero until the first sample
+            q::Clock::duration rttvar = q::Clock::duration{0};
+            q::Clock::duration rto = q::Clock::duration{0};
+            q::Clock::time_point backoff_tp; //last time the rto and window were backed off
+
+            size_t resend_window = 0; //in bytes
+            size_t resend_tokens = 0;
+            q::Clock::time_point resend_tokens_tp;
+
+            std::array<uint64_t, PRIORITY_LEVEL_COUNT / 64> active_levels;
+            std::array<uint32_t, PRIORITY_LEVEL_COUNT> level_channels; //bitmask of active channels
+            std::array<uint8_t, PRIORITY_LEVEL_COUNT> level_cursors; //where the round robin continues
             /////
-        } internal_queues;
+        };
+        std::vector<std::unique_ptr<Scheduler>> schedulers; //one per socket
 
-        /////
-        std::mutex packet_queue_mutex;
-        Send_Queue packet_queue;
-        std::vector<Datagram_ptr> reinsert_queue; //a place to store datagrams that need to be reinserted for resend purposes.
-        /////
+        struct Internal_Queues
+        {
+            Socket_Handle socket_handle = Socket_Handle(-1);
+        } internal_queues;
 
         struct Channel_Data
         {
             Socket_Handle socket_handle = Socket_Handle(-1);
 
             /////
+            //producers. This only serializes the producers of the same channel, it's never taken by the scheduler
             std::mutex send_mutex;
             Compression_State comp_state;
-            std::vector<Datagram_ptr> fragments_to_insert;
+            Fec_Encoder fec;
+            /////
+
+            util::MPSC_Queue<Packet_ptr> queue;
+
+            /////
+            //owned by the scheduler of the channel's socket
+            std::deque<Packet_ptr> packets; //not done yet, ascending ids
+            std::deque<Datagram_ptr> fresh; //never sent
+            std::deque<Datagram_ptr> resends; //waited enough for a confirmation
+            int level = -1; //the priority level it's active on. -1 when there is nothing to send
+            size_t deficit = 0;
             /////
         };
         std::array<Channel_Data, MAX_CHANNELS> channel_data;
@@ -277,24 +415,38 @@ private:
         typedef detail::Pool<Datagram>::Ptr Datagram_ptr;
         detail::Pool<Datagram> datagram_pool;
 
+        //The fragments are copied in place as they come so a complete packet is already contiguous.
+        //All fragments except the last are full, so the offset of any fragment follows from the size of the main one.
+        //Fragments that come before the main one are kept aside until it arrives.
         struct Packet : public detail::Pool_Item_Base
         {
+            uint32_t id = 0;
             size_t received_fragment_count = 0;
             q::Clock::time_point added_tp = q::Clock::time_point(q::Clock::duration{0});
+            bool has_main_header = false;
             Packet_Main_Header main_header;
             Packet_Header any_header;
-            std::map<uint16_t, Datagram_ptr> fragments;
+
+            Buffer_t data; //sized from packet_size. Compressed data is always smaller so it fits as well
+            size_t data_size = 0; //bytes received so far
+            size_t main_fragment_size = 0;
+            std::vector<uint64_t> received_fragments; //bitmap
+            std::vector<Datagram_ptr> early_fragments;
         };
         typedef detail::Pool<Packet>::Ptr Packet_ptr;
         detail::Pool<Packet> packet_pool;
         Packet_ptr acquire_packet();
 
+        //Packets are accepted only this far ahead of the last received one so they can be indexed by id
+        static const size_t WINDOW_SIZE = 256;
+
         struct Packet_Queue
         {
-            typedef std::pair<uint32_t, Packet_ptr> Item;
             /////
             std::mutex mutex;
-            std::deque<Item> packets;
+            std::array<Packet_ptr, WINDOW_SIZE> window; //indexed by id % WINDOW_SIZE
+            uint32_t max_id = 0;
+            Packet_ptr received_packet; //keeps alive the data returned by the last receive
             std::vector<uint8_t> decompression_buffer;
             /////
         };
@@ -302,6 +454,38 @@ private:
         //waiting to be received
         std::array<Packet_Queue, MAX_CHANNELS> packet_queues;
         std::array<uint32_t, MAX_CHANNELS> last_packet_ids;
+
+        struct Fec_Group
+        {
+            uint32_t id = 0;
+            uint16_t fragment_idx = 0;
+            uint32_t packet_starts = 0;
+            uint8_t k = 0;
+            uint8_t n = 0;
+            size_t block_size = 0;
+            bool is_done = false;
+            std::vector<Datagram_ptr> parities;
+        };
+
+        //The datagrams of a channel are kept for a while once parity datagrams were seen on it,
+        // so the groups can be rebuilt when their parities come
+        static const size_t MAX_FEC_GROUPS = 8;
+        struct Fec_Decoder
+        {
+            std::atomic_bool is_active = { false };
+            /////
+            std::mutex mutex;
+            Fec_ptr code;
+            std::deque<Datagram_ptr> sources; //the last datagrams, oldest first
+            std::deque<Fec_Group> groups;
+            std::vector<uint8_t> blocks;
+            std::vector<uint8_t const*> in_ptrs;
+            std::vector<uint8_t*> out_ptrs;
+            std::vector<unsigned> indices;
+            std::vector<Datagram_ptr> recovered;
+            /////
+        };
+        std::array<Fec_Decoder, MAX_CHANNELS> fec_decoders;
     } m_rx;
 
     RX::Datagram_ptr acquire_rx_datagram(size_t data_size);
@@ -311,6 +495,8 @@ private:
     {
         size_t tx_datagrams = 0;
         size_t tx_confirmed_fragments = 0;
+        size_t tx_resent_fragments = 0;
+        size_t tx_timeouts = 0;
         size_t tx_packets = 0;
         size_t tx_fragments = 0;
         size_t tx_bytes = 0;
@@ -323,6 +509,7 @@ private:
         size_t rx_duplicated_fragments = 0;
         size_t rx_packets = 0;
         size_t rx_dropped_packets = 0;
+        size_t rx_recovered_datagrams = 0;
         size_t rx_bytes = 0;
     };
 
@@ -347,6 +534,15 @@ private:
 
     const q::Clock::duration MIN_RESEND_DURATION = std::chrono::milliseconds(20);
 
+    //retransmission timeout
+    const q::Clock::duration INITIAL_RTO = std::chrono::milliseconds(100);
+    const q::Clock::duration MIN_RTO = MIN_RESEND_DURATION;
+    const q::Clock::duration MAX_RTO = std::chrono::milliseconds(1000);
+    //resend window, in MTUs
+    static const size_t INITIAL_RESEND_WINDOW = 4;
+    static const size_t MIN_RESEND_WINDOW = 1;
+    static const size_t MAX_RESEND_WINDOW = 64;
+
     std::array<Send_Params, MAX_CHANNELS> m_send_params;
     std::array<Receive_Params, MAX_CHANNELS> m_receive_params;
     Receive_Params m_global_receive_params;
@@ -364,8 +560,24 @@ private:
 
     void prepare_to_send_datagram(TX::Datagram& datagram);
 
-    static auto tx_packet_datagram_predicate(TX::Datagram_ptr const& datagram1, TX::Datagram_ptr const& datagram2) -> bool;
     auto add_datagram_to_send_buffer(Socket_Data& socket_data, TX::Datagram_ptr const& datagram) -> bool;
+
+    void reset_scheduler(TX::Scheduler& scheduler, Socket_Handle socket_handle);
+    void update_channel_level(TX::Scheduler& scheduler, uint8_t channel_idx);
+    auto get_next_channel(TX::Scheduler& scheduler, size_t quantum) -> int;
+    static auto get_next_queue(TX::Channel_Data& channel_data) -> std::deque<TX::Datagram_ptr>*;
+    static auto find_tx_packet(TX::Channel_Data& channel_data, uint32_t id) -> TX::Packet*;
+    static auto set_tx_fragment_done(TX::Packet& packet, size_t fragment_idx) -> bool;
+    auto confirm_tx_fragment(TX::Scheduler& scheduler, TX::Packet& packet, size_t fragment_idx, q::Clock::time_point received_tp) -> size_t;
+    void update_rto(TX::Scheduler& scheduler, q::Clock::duration rtt);
+    void restore_rto(TX::Scheduler& scheduler);
+    void backoff_rto(TX::Scheduler& scheduler, Socket_Data const& socket_data, q::Clock::time_point now);
+    void refill_resend_tokens(TX::Scheduler& scheduler, Socket_Data const& socket_data, q::Clock::time_point now);
+    void set_tx_datagram_done(TX::Channel_Data& channel_data, TX::Datagram const& datagram);
+    void pop_done_tx_packets(TX::Channel_Data& channel_data);
+    void drain_channel_queue(TX::Scheduler& scheduler, uint8_t channel_idx);
+    void apply_received_confirmations(TX::Scheduler& scheduler, Socket_Data const& socket_data);
+
     auto compute_next_transit_datagram(Socket_Handle socket_handle) -> bool;
     void send_datagram(Socket_Handle socket_handle);
 
@@ -380,12 +592,19 @@ private:
     void send_packet_connect_res(Connect_Res_Header::Response response);
     void process_connection();
 
-    //static auto rx_packet_predicate(RX::Packet_Queue::Item const& item1, RX::Packet_Queue::Item const& item2) -> bool;
-    static auto rx_packet_id_predicate(RX::Packet_Queue::Item const& item1, uint32_t id) -> bool;
+    static auto is_rx_packet_complete(RX::Packet const& packet) -> bool;
+    static auto place_rx_fragment(RX::Packet& packet, uint16_t fragment_idx, uint8_t const* data, size_t size) -> bool;
+    auto add_rx_fragment(RX::Packet& packet, uint8_t const* data_ptr, size_t data_size) -> bool;
 
     void process_incoming_data(uint8_t* data_ptr, size_t data_size);
     void process_packet_data(uint8_t* data_ptr, size_t data_size);
     void process_confirmations_data(uint8_t* data_ptr, size_t data_size);
+    void process_fec_data(uint8_t* data_ptr, size_t data_size);
+
+    static auto create_fec(Fec_ptr& code, size_t k, size_t n) -> bool;
+    void encode_fec(TX::Channel_Data& channel_data, Send_Params const& params, TX::Packet& packet);
+    void add_rx_fec_source(uint8_t const* data_ptr, size_t data_size);
+    auto recover_fec_group(RX::Fec_Decoder& decoder, RX::Fec_Group& group) -> bool;
     void process_connect_req_data(uint8_t* data_ptr, size_t data_size);
     void process_connect_res_data(uint8_t* data_ptr, size_t data_size);
 };
@@ -419,6 +638,8 @@ namespace detail
             }
         }
     }
+    template<class T> constexpr size_t Pool<T>::MAX_FREE_ITEMS;
+
     template<class T> Pool<T>::Pool()
     {
         m_pool = std::make_shared<Items>();
@@ -431,8 +652,8 @@ namespace detail
                 release(static_cast<T&>(*t));
             }
 
-            std::lock_guard<std::mutex> lg(items_ref->mutex);
-            items_ref->items.emplace_back(static_cast<T*>(t)); //will create a unique pointer from the raw one
+            std::unique_ptr<T> item(static_cast<T*>(t));
+            items_ref->items.push_back(std::move(item)); //if the queue is full the item stays in the unique ptr and is deleted
 //                QLOGI("{}// new:{} reused:{} returned:{}", m_pool.get(), x_new, x_reused, x_returned);
 //                QLOGI("{}// returned: {} / {}", m_pool.get(), t, x_returned);
         };
@@ -442,12 +663,11 @@ namespace detail
     {
         //this will be called when the last shared_ptr to T dies. We can safetly return the object to pur pool
 
-        std::lock_guard<std::mutex> lg(m_pool->mutex);
         T* item = nullptr;
-        if (!m_pool->items.empty())
+        std::unique_ptr<T> free_item;
+        if (m_pool->items.pop_front(free_item))
         {
-            item = m_pool->items.back().release(); //release the raw ptr from the control of the unique ptr
-            m_pool->items.pop_back();
+            item = free_item.release(); //release the raw ptr from the control of the unique ptr
 //                QLOGI("{}// recycled: {} / {}", m_pool.get(), item, x_reused);
 //                QLOGI("{}// new:{} reused:{} returned:{}", m_pool.get(), x_new, x_reused, x_returned);
         }
@@ -223,14 +223,13 @@ private:
             m_decoded.is_valid = false;
         }
 
-        rcp.receive(m_channel_idx, m_temp_rx_buffer);
-        if (!m_temp_rx_buffer.empty())
+        RCP::Received_Data received;
+        if (rcp.receive(m_channel_idx, received))
         {
-            //q::quick_logf("Received {} bytes", m_temp_rx_buffer.size());
+            //q::quick_logf("Received {} bytes", received.size);
             auto off = m_rx_buffer.size();
-            m_rx_buffer.resize(off + m_temp_rx_buffer.size());
-            std::copy(m_temp_rx_buffer.begin(), m_temp_rx_buffer.end(), m_rx_buffer.begin() + off);
-            m_temp_rx_buffer.clear();
+            m_rx_buffer.resize(off + received.size);
+            std::copy(received.data, received.data + received.size, m_rx_buffer.begin() + off);
         }
 
         return decode_message();
@@ -311,7 +310,6 @@ private:
 
     uint8_t m_channel_idx = 0;
     RX_Buffer_t m_rx_buffer;
-    std::vector<uint8_t> m_temp_rx_buffer;
     TX_Buffer_t m_tx_buffer;
     size_t m_size_off = 0;
     size_t m_data_start_off = 0;
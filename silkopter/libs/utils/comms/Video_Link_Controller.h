@@ -0,0 +1,203 @@
+#pragma once
+
+#include "Video_Streamer.h"
+#include <cmath>
+
+namespace util
+{
+namespace comms
+{
+
+//Picks the video coding and bitrate from the loss statistics the receiver sends back.
+//
+//The datagram loss rate is estimated from the deltas of the cumulative RX_Stats. It follows increases right away and
+// decays slowly so a short clean period doesn't undo the protection.
+//n is the smallest one that keeps the block loss probability (binomial, independent losses) under the target.
+//The airtime is kept constant so the encoder bitrate is scaled by coding_n / n. When even the max n is not enough
+// or the bitrate would drop too much, the low quality stream is used instead. When the max n still loses a lot
+// of blocks only the emergency stream has a chance.
+//Going back to less fec or to the high quality needs the link to be good for a while.
+//When the statistics stop coming the link is assumed to be bad.
+class Video_Link_Controller
+{
+public:
+    struct Descriptor
+    {
+        uint32_t coding_k = 12;
+        uint32_t coding_n = 20; //the minimum n, used on a clean link
+        uint32_t max_coding_n = Video_Streamer::MAX_CODING_N;
+
+        float target_block_loss = 0.01f;
+        float emergency_block_loss = 0.1f; //with the max n
+        float loss_decay = 0.1f; //per report, when the loss goes down
+        float min_bitrate_scale = 0.6f; //below this the low quality stream is better
+
+        q::Clock::duration upgrade_delay = std::chrono::seconds(5);
+        q::Clock::duration stats_timeout = std::chrono::seconds(2);
+    };
+
+    struct Output
+    {
+        uint32_t coding_k = 0;
+        uint32_t coding_n = 0;
+        float bitrate_scale = 1.f;
+        bool use_low_quality = false;
+        bool use_emergency_quality = false;
+    };
+
+    auto init(Descriptor const& descriptor) -> bool
+    {
+        if (descriptor.coding_k == 0 || descriptor.coding_k > Video_Streamer::MAX_CODING_K ||
+                descriptor.coding_n < descriptor.coding_k ||
+                descriptor.max_coding_n < descriptor.coding_n || descriptor.max_coding_n > Video_Streamer::MAX_CODING_N)
+        {
+            QLOGE("Invalid coding params: {} / {} / {}", descriptor.coding_k, descriptor.coding_n, descriptor.max_coding_n);
+            return false;
+        }
+
+        m_descriptor = descriptor;
+        m_output = Output();
+        m_output.coding_k = descriptor.coding_k;
+        m_output.coding_n = descriptor.coding_n;
+        m_has_stats = false;
+        m_has_data = false;
+        m_loss = 0.f;
+        return true;
+    }
+
+    //Call when a report from the receiver arrives
+    void process_rx_stats(Video_Streamer::RX_Stats const& stats)
+    {
+        //the receiver restarted?
+        if (!m_has_stats || stats.datagrams < m_last_stats.datagrams || stats.lost_datagrams < m_last_stats.lost_datagrams)
+        {
+            m_has_stats = true;
+            m_last_stats = stats;
+            return;
+        }
+
+        uint32_t datagrams = stats.datagrams - m_last_stats.datagrams;
+        uint32_t lost_datagrams = stats.lost_datagrams - m_last_stats.lost_datagrams;
+        m_last_stats = stats;
+        if (datagrams == 0)
+        {
+            return; //no video, nothing to learn
+        }
+
+        float loss = std::min(static_cast<float>(lost_datagrams) / static_cast<float>(datagrams), 1.f);
+        m_loss = loss > m_loss ? loss : m_loss + (loss - m_loss) * m_descriptor.loss_decay;
+
+        m_has_data = true;
+        m_last_data_tp = q::Clock::now();
+
+        update(m_loss);
+    }
+
+    //Call periodically
+    void process()
+    {
+        if (m_has_data && q::Clock::now() - m_last_data_tp > m_descriptor.stats_timeout)
+        {
+            //no news is bad news. Protect as much as possible until the receiver reports again
+            m_has_data = false;
+            m_loss = 1.f;
+            update(m_loss);
+        }
+    }
+
+    auto get_output() const -> Output const&
+    {
+        return m_output;
+    }
+
+    auto get_loss() const -> float
+    {
+        return m_loss;
+    }
+
+private:
+    static auto compute_block_loss(uint32_t k, uint32_t n, double p) -> double
+    {
+        //the block is lost when more than n - k datagrams are lost
+        double loss = 0.0;
+        double c = 1.0; //C(n, i)
+        for (uint32_t i = 0; i <= n; i++)
+        {
+            if (i > n - k)
+            {
+                loss += c * std::pow(p, double(i)) * std::pow(1.0 - p, double(n - i));
+            }
+            c = c * double(n - i) / double(i + 1);
+        }
+        return loss;
+    }
+
+    void update(float loss)
+    {
+        Descriptor const& d = m_descriptor;
+        auto now = q::Clock::now();
+
+        uint32_t coding_n = d.max_coding_n;
+        bool is_feasible = false;
+        for (uint32_t n = d.coding_n; n <= d.max_coding_n; n++)
+        {
+            if (compute_block_loss(d.coding_k, n, loss) <= d.target_block_loss)
+            {
+                coding_n = n;
+                is_feasible = true;
+                break;
+            }
+        }
+
+        //more protection right away, less only after a while
+        if (coding_n >= m_output.coding_n)
+        {
+            m_output.coding_n = coding_n;
+            m_downgrade_tp = now;
+        }
+        else if (now - m_downgrade_tp >= d.upgrade_delay)
+        {
+            m_output.coding_n = coding_n;
+        }
+        m_output.bitrate_scale = static_cast<float>(d.coding_n) / static_cast<float>(m_output.coding_n);
+
+        bool use_low_quality = !is_feasible || m_output.bitrate_scale < d.min_bitrate_scale;
+        if (use_low_quality)
+        {
+            m_output.use_low_quality = true;
+            m_low_quality_tp = now;
+        }
+        else if (now - m_low_quality_tp >= d.upgrade_delay)
+        {
+            m_output.use_low_quality = false;
+        }
+
+        bool use_emergency_quality = compute_block_loss(d.coding_k, d.max_coding_n, loss) > d.emergency_block_loss;
+        if (use_emergency_quality)
+        {
+            m_output.use_emergency_quality = true;
+            m_emergency_quality_tp = now;
+        }
+        else if (now - m_emergency_quality_tp >= d.upgrade_delay)
+        {
+            m_output.use_emergency_quality = false;
+        }
+    }
+
+    Descriptor m_descriptor;
+    Output m_output;
+
+    bool m_has_stats = false;
+    Video_Streamer::RX_Stats m_last_stats;
+
+    bool m_has_data = false;
+    q::Clock::time_point m_last_data_tp = q::Clock::now();
+
+    float m_loss = 0.f;
+    q::Clock::time_point m_downgrade_tp = q::Clock::now();
+    q::Clock::time_point m_low_quality_tp = q::Clock::now();
+    q::Clock::time_point m_emergency_quality_tp = q::Clock::now();
+};
+
+}
+}
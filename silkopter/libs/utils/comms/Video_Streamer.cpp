@@ -7,8 +7,20 @@
 #include <atomic>
 #include <boost/intrusive_ptr.hpp>
 #include "utils/Pool.h"
+#include "utils/MPSC_Queue.h"
 #include "fec.h"
 
+#include <sys/socket.h>
+#include <sys/mman.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <linux/filter.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
 #include "QBase.h"
 
 namespace util
@@ -25,6 +37,14 @@ static constexpr size_t MAX_USER_PACKET_SIZE = 1470;
 
 static constexpr size_t DEFAULT_RATE_HZ = 26000000;
 
+static constexpr size_t TX_RING_MIN_FRAME_COUNT = 512;
+
+static constexpr size_t RX_RING_BLOCK_SIZE = 1 << 16;
+static constexpr size_t RX_RING_BLOCK_COUNT = 32;
+static constexpr size_t RX_RING_FRAME_SIZE = 2048;
+static constexpr size_t RX_WINDOW_SIZE = 16;
+static constexpr size_t RX_READY_QUEUE_SIZE = 1024;
+
 static std::vector<uint8_t> RADIOTAP_HEADER;
 
 static constexpr size_t SRC_MAC_LASTBYTE  = 15;
@@ -42,15 +62,6 @@ static uint8_t IEEE_HEADER[] =
 
 #pragma pack(push, 1)
 
-struct Penumbra_Radiotap_Header
-{
-    int32_t channel = 0;
-    int32_t channel_flags = 0;
-    int32_t rate = 0;
-    int32_t antenna = 0;
-    int32_t radiotap_flags = 0;
-};
-
 struct Datagram_Header
 {
 //    uint32_t crc = 0;
@@ -60,6 +71,8 @@ struct Datagram_Header
     uint16_t size : 15;
     uint16_t width;
     uint16_t height;
+    uint8_t coding_k;
+    uint8_t coding_n;
 };
 
 #pragma pack(pop)
@@ -73,6 +86,8 @@ struct Video_Streamer::PCap
     pcap_t* pcap = nullptr;
     char error_buffer[PCAP_ERRBUF_SIZE] = {0};
     int rx_pcap_selectable_fd = 0;
+    std::string filter;
+    bool is_loopback = false;
 
     size_t _80211_header_length = 0;
 };
@@ -103,6 +118,34 @@ struct Video_Streamer::TX
     Datagram_ptr crt_datagram;
 
     uint32_t last_block_index = 1;
+
+    //of the current block
+    uint32_t coding_k = 0;
+    uint32_t coding_n = 0;
+
+    //Memory mapped PACKET_TX_RING.
+    //The radiotap and IEEE headers are written in every frame once at init. The datagrams and the fec output are written
+    // directly in the frames and the tx thread kicks the kernel once per batch with an empty sendto.
+    //Frames are used in order so the datagrams of the current block stay intact until its fec datagrams are encoded.
+    struct Ring
+    {
+        int fd = -1;
+        uint8_t* buffer = nullptr;
+        size_t buffer_size = 0;
+        size_t block_size = 0;
+        size_t frame_size = 0;
+        size_t frames_per_block = 0;
+        size_t frame_count = 0;
+        size_t packet_offset = 0; //where the packet starts in a frame
+
+        size_t head = 0; //next frame to fill, wraps at frame_count
+        size_t block_start = 0; //first frame of the current fec block
+        size_t block_datagram_count = 0;
+        size_t crt_size = 0; //bytes in the head frame, zero if not acquired yet
+
+        std::atomic_bool is_pending = {false};
+    };
+    Ring ring;
 };
 
 
@@ -110,9 +153,22 @@ struct Video_Streamer::RX
 {
     std::unique_ptr<PCap[]> pcaps;
 
+    //Memory mapped PACKET_RX_RING (TPACKET_V3), one per interface.
+    //The kernel fills whole blocks of datagrams that passed the filter so one poll wakeup handles all of them.
+    struct Ring
+    {
+        int fd = -1;
+        uint8_t* buffer = nullptr;
+        size_t buffer_size = 0;
+        size_t block_size = 0;
+        size_t block_count = 0;
+        size_t crt_block = 0;
+    };
+    std::unique_ptr<Ring[]> rings;
+    bool use_rings = false;
+
     struct Datagram : public Pool_Item_Base
     {
-        bool is_processed = false;
         uint32_t index = 0;
         math::vec2u16 resolution;
         std::vector<uint8_t> data;
@@ -121,41 +177,82 @@ struct Video_Streamer::RX
     typedef Pool<Datagram>::Ptr Datagram_ptr;
     Pool<Datagram> datagram_pool;
 
-    struct Block : public Pool_Item_Base
+    //Blocks are stored at block_index % RX_WINDOW_SIZE and their datagrams at datagram_index so nothing is searched.
+    //All the interfaces are read by the rx thread, which is the only one touching the window.
+    struct Block
     {
+        bool is_used = false;
         uint32_t index = 0;
-
-        std::vector<Datagram_ptr> datagrams;
-        std::vector<Datagram_ptr> fec_datagrams;
+        uint32_t coding_k = 0;
+        uint32_t coding_n = 0;
+        uint32_t received = 0; //one bit per datagram index
+        uint32_t delivered_count = 0; //the first datagrams that were already delivered in order
+        std::array<Datagram_ptr, 32> datagrams;
     };
+    std::array<Block, RX_WINDOW_SIZE> blocks;
 
-    typedef Pool<Block>::Ptr Block_ptr;
-    Pool<Block> block_pool;
-
-    std::mutex mutex;
-    std::deque<Block_ptr> block_queue;
+    bool has_next_block_index = false;
+    uint32_t next_block_index = 0;
 
-    q::Clock::time_point last_block_tp = q::Clock::now();
     q::Clock::time_point last_datagram_tp = q::Clock::now();
 
-    uint32_t next_block_index = 0;
+    //written by the rx thread only
+    struct Stats
+    {
+        std::atomic<uint32_t> blocks = {0};
+        std::atomic<uint32_t> recovered_blocks = {0};
+        std::atomic<uint32_t> lost_blocks = {0};
+        std::atomic<uint32_t> datagrams = {0};
+        std::atomic<uint32_t> lost_datagrams = {0};
+    } stats;
+
+    //decoded datagrams in order, from the rx thread to process()
+    MPSC_Queue<Datagram_ptr> ready_queue;
 };
 
 
-static void seal_datagram(Video_Streamer::TX::Datagram& datagram, size_t header_offset, uint32_t block_index, uint8_t datagram_index, math::vec2u16 const& resolution, bool is_fec)
+static void seal_datagram(uint8_t* data, size_t size, uint32_t block_index, uint8_t datagram_index, uint32_t coding_k, uint32_t coding_n, math::vec2u16 const& resolution, bool is_fec)
 {
-    QASSERT(datagram.data.size() >= header_offset + sizeof(Video_Streamer::TX::Datagram));
-
-    Datagram_Header& header = *reinterpret_cast<Datagram_Header*>(datagram.data.data() + header_offset);
+    Datagram_Header& header = *reinterpret_cast<Datagram_Header*>(data);
 //    header.crc = 0;
-    header.size = datagram.data.size() - header_offset;
+    header.size = size;
     header.block_index = block_index;
     header.datagram_index = datagram_index;
     header.is_fec = is_fec ? 1 : 0;
     header.width = resolution.x;
     header.height = resolution.y;
+    header.coding_k = static_cast<uint8_t>(coding_k);
+    header.coding_n = static_cast<uint8_t>(coding_n);
+
+//    header.crc = q::util::murmur_hash(data, header.size, 0);
+}
+
+static void seal_datagram(Video_Streamer::TX::Datagram& datagram, size_t header_offset, uint32_t block_index, uint8_t datagram_index, uint32_t coding_k, uint32_t coding_n, math::vec2u16 const& resolution, bool is_fec)
+{
+    QASSERT(datagram.data.size() >= header_offset + sizeof(Datagram_Header));
+    seal_datagram(datagram.data.data() + header_offset, datagram.data.size() - header_offset, block_index, datagram_index, coding_k, coding_n, resolution, is_fec);
+}
+
+static tpacket2_hdr* get_tx_ring_frame(Video_Streamer::TX::Ring const& ring, size_t frame_idx)
+{
+    //frames don't cross ring blocks so there might be a gap at the end of each block
+    size_t block = frame_idx / ring.frames_per_block;
+    size_t offset = block * ring.block_size + (frame_idx % ring.frames_per_block) * ring.frame_size;
+    return reinterpret_cast<tpacket2_hdr*>(ring.buffer + offset);
+}
 
-//    header.crc = q::util::murmur_hash(datagram.data.data() + header_offset, header.size, 0);
+static void close_rx_ring(Video_Streamer::RX::Ring& ring)
+{
+    if (ring.buffer)
+    {
+        munmap(ring.buffer, ring.buffer_size);
+        ring.buffer = nullptr;
+    }
+    if (ring.fd >= 0)
+    {
+        close(ring.fd);
+        ring.fd = -1;
+    }
 }
 
 struct Video_Streamer::Impl
@@ -207,6 +304,7 @@ std::vector<std::string> Video_Streamer::enumerate_interfaces()
 
 Video_Streamer::Video_Streamer()
 {
+    m_fecs.fill(nullptr);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -215,14 +313,36 @@ Video_Streamer::~Video_Streamer()
 {
     m_exit = true;
 
-    m_impl->tx.datagram_queue_cv.notify_all();
+    if (m_impl)
+    {
+        std::lock_guard<std::mutex> lg(m_impl->tx.datagram_queue_mutex);
+        m_impl->tx.datagram_queue_cv.notify_all();
+    }
 
     if (m_thread.joinable())
     {
         m_thread.join();
     }
 
-    fec_free(m_fec);
+    if (m_impl)
+    {
+        close_tx_ring();
+        if (m_impl->rx.rings)
+        {
+            for (size_t i = 0; i < m_rx_descriptor.interfaces.size(); i++)
+            {
+                close_rx_ring(m_impl->rx.rings[i]);
+            }
+        }
+    }
+
+    for (fec_t* fec: m_fecs)
+    {
+        if (fec)
+        {
+            fec_free(fec);
+        }
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
@@ -248,6 +368,19 @@ bool Video_Streamer::prepare_filter(PCap& pcap)
         sprintf(program_src, "ether[0x0a:4]==0x13223344 && ether[0x0e:2] == 0x5566");
         break;
 
+    case DLT_EN10MB:
+        if (!pcap.is_loopback)
+        {
+            QLOGE("!!! unknown encapsulation");
+            return false;
+        }
+        //A loopback interface stands in for the radio in tests. The frames come back exactly as injected, after our radiotap header
+        QLOGI("Loopback Encap");
+        pcap._80211_header_length = 0x18;
+        sprintf(program_src, "ether[0x%x:4]==0x13223344 && ether[0x%x:2] == 0x5566",
+                static_cast<unsigned>(RADIOTAP_HEADER.size() + 0x0a), static_cast<unsigned>(RADIOTAP_HEADER.size() + 0x0e));
+        break;
+
     default:
         QLOGE("!!! unknown encapsulation");
         return false;
@@ -265,6 +398,7 @@ bool Video_Streamer::prepare_filter(PCap& pcap)
         return false;
     }
     pcap_freecode(&program);
+    pcap.filter = program_src;
 
     if (!m_is_tx)
     {
@@ -366,12 +500,66 @@ void Video_Streamer::prepare_tx_packet_header(uint8_t* buffer)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
+//Only the flags are needed so the fields are not walked with the radiotap iterator.
+//TSFT is the only field that can come before them.
+static bool get_radiotap_flags(uint8_t const* data, size_t header_len, uint8_t& flags)
+{
+    flags = 0;
+    if (header_len < sizeof(ieee80211_radiotap_header))
+    {
+        return false;
+    }
+
+    uint32_t present = 0;
+    memcpy(&present, data + 4, sizeof(present));
+
+    size_t offset = sizeof(ieee80211_radiotap_header);
+    uint32_t crt_present = present;
+    while (crt_present & (1u << IEEE80211_RADIOTAP_EXT))
+    {
+        if (offset + sizeof(crt_present) > header_len)
+        {
+            return false;
+        }
+        memcpy(&crt_present, data + offset, sizeof(crt_present));
+        offset += sizeof(crt_present);
+    }
+
+    if (present & (1u << IEEE80211_RADIOTAP_TSFT))
+    {
+        offset = ((offset + 7) & ~size_t(7)) + 8;
+    }
+    if (present & (1u << IEEE80211_RADIOTAP_FLAGS))
+    {
+        if (offset >= header_len)
+        {
+            return false;
+        }
+        flags = data[offset];
+    }
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static void reset_rx_block(Video_Streamer::RX::Block& block)
+{
+    block.is_used = false;
+    block.received = 0;
+    block.delivered_count = 0;
+    for (Video_Streamer::RX::Datagram_ptr& d: block.datagrams)
+    {
+        d.reset();
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
 bool Video_Streamer::process_rx_packet(PCap& pcap)
 {
     struct pcap_pkthdr* pcap_packet_header = nullptr;
 
-    uint8_t payload_buffer[MAX_PACKET_SIZE];
-    uint8_t* payload = payload_buffer;
+    uint8_t const* payload = nullptr;
 
     while (true)
     {
@@ -389,173 +577,383 @@ bool Video_Streamer::process_rx_packet(PCap& pcap)
             }
         }
 
-        size_t header_len = (payload[2] + (payload[3] << 8));
-        if (pcap_packet_header->len < (header_len + pcap._80211_header_length))
-        {
-            QLOGW("packet too small");
-            return true;
-        }
+        process_rx_frame(payload, pcap_packet_header->len, pcap._80211_header_length);
+    }
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        size_t bytes = pcap_packet_header->len - (header_len + pcap._80211_header_length);
+void Video_Streamer::process_rx_ring(size_t interface_idx)
+{
+    RX::Ring& ring = m_impl->rx.rings[interface_idx];
+    size_t _80211_header_length = m_impl->rx.pcaps[interface_idx]._80211_header_length;
 
-        ieee80211_radiotap_iterator rti;
-        if (ieee80211_radiotap_iterator_init(&rti, (struct ieee80211_radiotap_header *)payload, pcap_packet_header->len) < 0)
+    while (true)
+    {
+        tpacket_block_desc* block = reinterpret_cast<tpacket_block_desc*>(ring.buffer + ring.crt_block * ring.block_size);
+        if ((__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER) == 0)
         {
-            QLOGE("iterator null");
-            return true;
+            break;
         }
 
-        int n = 0;
-        Penumbra_Radiotap_Header prh;
-        while ((n = ieee80211_radiotap_iterator_next(&rti)) == 0)
+        uint32_t count = block->hdr.bh1.num_pkts;
+        uint8_t const* ptr = reinterpret_cast<uint8_t const*>(block) + block->hdr.bh1.offset_to_first_pkt;
+        for (uint32_t i = 0; i < count; i++)
         {
-
-            switch (rti.this_arg_index)
+            tpacket3_hdr const* header = reinterpret_cast<tpacket3_hdr const*>(ptr);
+            sockaddr_ll const* addr = reinterpret_cast<sockaddr_ll const*>(ptr + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+            if (addr->sll_pkttype != PACKET_OUTGOING)
             {
-            case IEEE80211_RADIOTAP_RATE:
-                prh.rate = (*rti.this_arg);
-                break;
+                process_rx_frame(ptr + header->tp_mac, header->tp_snaplen, _80211_header_length);
+            }
+            ptr += header->tp_next_offset;
+        }
 
-            case IEEE80211_RADIOTAP_CHANNEL:
-                prh.channel = (*((uint16_t *)rti.this_arg));
-                prh.channel_flags = (*((uint16_t *)(rti.this_arg + 2)));
-                break;
+        //give it back to the kernel
+        __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+        ring.crt_block = (ring.crt_block + 1) % ring.block_count;
 
-            case IEEE80211_RADIOTAP_ANTENNA:
-                prh.antenna = (*rti.this_arg) + 1;
-                break;
+        deliver_rx_blocks();
+    }
+}
 
-            case IEEE80211_RADIOTAP_FLAGS:
-                prh.radiotap_flags = *rti.this_arg;
-                break;
-            }
-        }
-        payload += header_len + pcap._80211_header_length;
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        if (prh.radiotap_flags & IEEE80211_RADIOTAP_F_FCS)
-        {
-            bytes -= 4;
-        }
+void Video_Streamer::process_rx_frame(uint8_t const* payload, size_t size, size_t _80211_header_length)
+{
+    if (size < 4)
+    {
+        QLOGW("packet too small");
+        return;
+    }
+
+    size_t header_len = (payload[2] + (payload[3] << 8));
+    if (size < (header_len + _80211_header_length))
+    {
+        QLOGW("packet too small");
+        return;
+    }
+
+    size_t bytes = size - (header_len + _80211_header_length);
 
-        bool checksum_correct = (prh.radiotap_flags & 0x40) == 0;
+    uint8_t radiotap_flags = 0;
+    if (!get_radiotap_flags(payload, header_len, radiotap_flags))
+    {
+        QLOGE("bad radiotap header");
+        return;
+    }
+    payload += header_len + _80211_header_length;
 
-        //    block_num = seq_nr / param_retransmission_block_size;//if retr_block_size would be limited to powers of two, this could be replaced by a logical AND operation
+    if (radiotap_flags & IEEE80211_RADIOTAP_F_FCS)
+    {
+        if (bytes < 4)
+        {
+            return;
+        }
+        bytes -= 4;
+    }
 
-        //printf("rec %x bytes %d crc %d\n", seq_nr, bytes, checksum_correct);
+    bool checksum_correct = (radiotap_flags & IEEE80211_RADIOTAP_F_BADFCS) == 0;
 
 #ifdef DEBUG_PCAP
-        std::cout << "PCAP RX>>";
-        std::copy(payload, payload + bytes, std::ostream_iterator<uint8_t>(std::cout));
-        std::cout << "<<PCAP RX";
+    std::cout << "PCAP RX>>";
+    std::copy(payload, payload + bytes, std::ostream_iterator<uint8_t>(std::cout));
+    std::cout << "<<PCAP RX";
 #endif
-        if (!checksum_correct)
+    if (!checksum_correct)
+    {
+        QLOGW("invalid checksum.");
+        return;
+    }
+    if (bytes < sizeof(Datagram_Header))
+    {
+        QLOGW("packet too small");
+        return;
+    }
+
+    add_rx_datagram(payload, bytes);
+
+#ifdef DEBUG_THROUGHPUT
+    {
+        static int xxx_data = 0;
+        static std::chrono::system_clock::time_point xxx_last_tp = std::chrono::system_clock::now();
+        xxx_data += bytes;
+        auto now = std::chrono::system_clock::now();
+        if (now - xxx_last_tp >= std::chrono::seconds(1))
         {
-            QLOGW("invalid checksum.");
-            return true;
+            float r = std::chrono::duration<float>(now - xxx_last_tp).count();
+            QLOGI("Received: {} KB/s", float(xxx_data)/r/1024.f);
+            xxx_data = 0;
+            xxx_last_tp = now;
         }
+    }
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::add_rx_datagram(uint8_t const* payload, size_t size)
+{
+    RX& rx = m_impl->rx;
+
+    Datagram_Header const& header = *reinterpret_cast<Datagram_Header const*>(payload);
+    uint32_t block_index = header.block_index;
+    uint32_t datagram_index = header.datagram_index;
+    uint32_t coding_k = header.coding_k;
+    uint32_t coding_n = header.coding_n;
+    if (coding_k == 0 || coding_k > MAX_CODING_K || coding_n < coding_k || coding_n > MAX_CODING_N)
+    {
+        QLOGE("Invalid coding params: {} / {}" , coding_k, coding_n);
+        return;
+    }
+    if (datagram_index >= coding_n)
+    {
+        QLOGE("datagram index out of range: {} > {}", datagram_index, coding_n);
+        return;
+    }
+    if (size - sizeof(Datagram_Header) != m_payload_size)
+    {
+        QLOGW("unexpected datagram size: {} != {}", size - sizeof(Datagram_Header), m_payload_size);
+        return;
+    }
+
+    //a batch can hold more blocks than the window so make room by finishing the old ones first
+    if (rx.has_next_block_index && block_index >= rx.next_block_index && block_index - rx.next_block_index >= RX_WINDOW_SIZE)
+    {
+        deliver_rx_blocks();
+    }
 
+    if (!rx.has_next_block_index)
+    {
+        //(re)start from whatever comes first
+        for (RX::Block& block: rx.blocks)
         {
-            RX& rx = m_impl->rx;
+            reset_rx_block(block);
+        }
+        rx.next_block_index = block_index;
+        rx.has_next_block_index = true;
+        rx.last_datagram_tp = q::Clock::now();
+    }
 
-            Datagram_Header& header = *reinterpret_cast<Datagram_Header*>(payload);
-            uint32_t block_index = header.block_index;
-            uint32_t datagram_index = header.datagram_index;
-            if (datagram_index >= m_coding_n)
+    if (block_index < rx.next_block_index)
+    {
+        //QLOGW("Old datagram: {} < {}", block_index, rx.next_block_index);
+        return;
+    }
+
+    //too far ahead, drop the blocks that fall out of the window
+    if (block_index - rx.next_block_index >= RX_WINDOW_SIZE)
+    {
+        uint32_t next_block_index = block_index - RX_WINDOW_SIZE + 1;
+        for (RX::Block& block: rx.blocks)
+        {
+            if (block.is_used && block.index < next_block_index)
             {
-                QLOGE("datagram index out of range: {} > {}", datagram_index, m_coding_n);
-                return true;
+                reset_rx_block(block);
             }
+        }
 
-            std::lock_guard<std::mutex> lg(rx.mutex);
+        uint32_t lost_blocks = next_block_index - rx.next_block_index;
+        rx.stats.blocks += lost_blocks;
+        rx.stats.lost_blocks += lost_blocks;
+        rx.stats.datagrams += lost_blocks * coding_k;
+        rx.stats.lost_datagrams += lost_blocks * coding_k;
 
-            if (block_index < rx.next_block_index)
-            {
-                //QLOGW("Old datagram: {} < {}", block_index, rx.next_block_index);
-                return true;
-            }
+        rx.next_block_index = next_block_index;
+    }
+
+    RX::Block& block = rx.blocks[block_index % RX_WINDOW_SIZE];
+    if (!block.is_used)
+    {
+        block.is_used = true;
+        block.index = block_index;
+        block.coding_k = coding_k;
+        block.coding_n = coding_n;
+    }
+    QASSERT(block.index == block_index);
+    if (block.coding_k != coding_k || block.coding_n != coding_n)
+    {
+        QLOGW("Coding params changed within block {}: {} / {}", block_index, coding_k, coding_n);
+        return;
+    }
+
+    uint32_t bit = 1u << datagram_index;
+    if (block.received & bit)
+    {
+        //QLOGW("Duplicated datagram {} from block {} (index {})", datagram_index, block_index, block_index * m_coding_k + datagram_index);
+        return;
+    }
+
+    RX::Datagram_ptr datagram = rx.datagram_pool.acquire();
+    datagram->data.assign(payload + sizeof(Datagram_Header), payload + size);
+    datagram->index = datagram_index;
+    datagram->resolution.set(header.width, header.height);
+
+    block.datagrams[datagram_index] = std::move(datagram);
+    block.received |= bit;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::deliver_rx_blocks()
+{
+    RX& rx = m_impl->rx;
+
+    if (rx.has_next_block_index && q::Clock::now() - rx.last_datagram_tp > m_rx_descriptor.reset_duration)
+    {
+        rx.has_next_block_index = false;
+        return;
+    }
 
-            RX::Block_ptr block;
+    auto deliver = [&rx](RX::Datagram_ptr const& d)
+    {
+        //if process() doesn't keep up the datagram is lost, same as a late one
+        rx.ready_queue.push_back(d);
+        rx.last_datagram_tp = q::Clock::now();
+    };
 
-            //find the block
+    while (rx.has_next_block_index)
+    {
+        //blocks that were lost entirely are not waited for
+        RX::Block* block = nullptr;
+        size_t pending_count = 0;
+        for (RX::Block& b: rx.blocks)
+        {
+            if (b.is_used)
             {
-                auto iter = std::lower_bound(rx.block_queue.begin(), rx.block_queue.end(), block_index, [](RX::Block_ptr const& l, uint32_t index) { return l->index < index; });
-                if (iter != rx.block_queue.end() && (*iter)->index == block_index)
+                pending_count++;
+                if (!block || b.index < block->index)
                 {
-                    block = *iter;
-                }
-                else
-                {
-                    block = rx.block_pool.acquire();
-                    block->index = block_index;
-                    rx.block_queue.insert(iter, block);
+                    block = &b;
                 }
             }
+        }
+        if (!block)
+        {
+            return;
+        }
+        if (block->index > rx.next_block_index)
+        {
+            uint32_t lost_blocks = block->index - rx.next_block_index;
+            rx.stats.blocks += lost_blocks;
+            rx.stats.lost_blocks += lost_blocks;
+            rx.stats.datagrams += lost_blocks * block->coding_k;
+            rx.stats.lost_datagrams += lost_blocks * block->coding_k;
+        }
+        rx.next_block_index = block->index;
 
-            RX::Datagram_ptr datagram = rx.datagram_pool.acquire();
-            datagram->data.resize(bytes - sizeof(Datagram_Header));
-            datagram->index = datagram_index;
-            datagram->resolution.set(header.width, header.height);
-            memcpy(datagram->data.data(), payload + sizeof(Datagram_Header), bytes - sizeof(Datagram_Header));
+        //deliver consecutive datagrams before the block is finished to minimize latency
+        while (block->delivered_count < block->coding_k && (block->received & (1u << block->delivered_count)))
+        {
+            deliver(block->datagrams[block->delivered_count]);
+            block->delivered_count++;
+        }
 
-            //store datagram
-            if (header.is_fec)
+        if (block->delivered_count < block->coding_k)
+        {
+            //can we fec decode?
+            if (static_cast<uint32_t>(__builtin_popcount(block->received)) >= block->coding_k)
             {
-                auto iter = std::lower_bound(block->fec_datagrams.begin(), block->fec_datagrams.end(), datagram_index, [](RX::Datagram_ptr const& l, uint32_t index) { return l->index < index; });
-                if (iter != block->fec_datagrams.end() && (*iter)->index == datagram_index)
-                {
-                    //QLOGW("Duplicated datagram {} from block {} (index {})", datagram_index, block_index, block_index * m_coding_k + datagram_index);
-                    return true;
-                }
-                else
+                auto start = q::Clock::now();
+
+                std::array<unsigned int, 32> indices;
+                math::vec2u16 resolution;
+                size_t fec_index = block->coding_k;
+                for (size_t i = 0; i < block->coding_k; i++)
                 {
-                    block->fec_datagrams.insert(iter, datagram);
+                    if (block->received & (1u << i))
+                    {
+                        m_fec_src_datagram_ptrs[i] = block->datagrams[i]->data.data();
+                        indices[i] = i;
+                        resolution = block->datagrams[i]->resolution;
+                    }
+                    else
+                    {
+                        while ((block->received & (1u << fec_index)) == 0)
+                        {
+                            fec_index++;
+                        }
+                        m_fec_src_datagram_ptrs[i] = block->datagrams[fec_index]->data.data();
+                        indices[i] = fec_index;
+                        resolution = block->datagrams[fec_index]->resolution;
+                        fec_index++;
+                    }
                 }
-            }
-            else
-            {
-                auto iter = std::lower_bound(block->datagrams.begin(), block->datagrams.end(), datagram_index, [](RX::Datagram_ptr const& l, uint32_t index) { return l->index < index; });
-                if (iter != block->datagrams.end() && (*iter)->index == datagram_index)
+
+                //insert the missing datagrams, they will be filled with data by the fec_decode below
+                size_t dst_index = 0;
+                for (size_t i = 0; i < block->coding_k; i++)
                 {
-                    //QLOGW("Duplicated datagram {} from block {} (index {})", datagram_index, block_index, block_index * m_coding_k + datagram_index);
-                    return true;
+                    if ((block->received & (1u << i)) == 0)
+                    {
+                        RX::Datagram_ptr datagram = rx.datagram_pool.acquire();
+                        datagram->data.resize(m_payload_size);
+                        datagram->index = i;
+                        datagram->resolution = resolution;
+                        m_fec_dst_datagram_ptrs[dst_index++] = datagram->data.data();
+                        block->datagrams[i] = std::move(datagram);
+                    }
                 }
-                else
+
+                fec_decode(get_fec(block->coding_k), m_fec_src_datagram_ptrs.data(), m_fec_dst_datagram_ptrs.data(), indices.data(), m_payload_size);
+
+                for (; block->delivered_count < block->coding_k; block->delivered_count++)
                 {
-                    block->datagrams.insert(iter, datagram);
+                    deliver(block->datagrams[block->delivered_count]);
                 }
+
+                //QLOGI("Decoded fec: {}", q::Clock::now() - start);
+            }
+            else if (pending_count <= 3)
+            {
+                //wait for more
+                return;
             }
+            //else skip it, too much buffering
         }
 
-        //m_impl->rx_queue.enqueue(payload, bytes);
-//        if (receive_callback && bytes > 0)
-//        {
-//            receive_callback(payload, bytes);
-//        }
-
-#ifdef DEBUG_THROUGHPUT
+        uint32_t received_data = static_cast<uint32_t>(__builtin_popcount(block->received & ((1u << block->coding_k) - 1)));
+        rx.stats.blocks++;
+        rx.stats.datagrams += block->coding_k;
+        rx.stats.lost_datagrams += block->coding_k - received_data;
+        if (block->delivered_count < block->coding_k)
         {
-            static int xxx_data = 0;
-            static std::chrono::system_clock::time_point xxx_last_tp = std::chrono::system_clock::now();
-            xxx_data += bytes;
-            auto now = std::chrono::system_clock::now();
-            if (now - xxx_last_tp >= std::chrono::seconds(1))
-            {
-                float r = std::chrono::duration<float>(now - xxx_last_tp).count();
-                QLOGI("Received: {} KB/s", float(xxx_data)/r/1024.f);
-                xxx_data = 0;
-                xxx_last_tp = now;
-            }
+            rx.stats.lost_blocks++;
         }
-#endif
+        else if (received_data < block->coding_k)
+        {
+            rx.stats.recovered_blocks++;
+        }
+
+        rx.next_block_index = block->index + 1;
+        reset_rx_block(*block);
     }
+}
 
-    return true;
+////////////////////////////////////////////////////////////////////////////////////////////
+
+static bool is_loopback_interface(std::string const& interface)
+{
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    ifreq request;
+    memset(&request, 0, sizeof(request));
+    strncpy(request.ifr_name, interface.c_str(), IFNAMSIZ - 1);
+    bool is_loopback = ioctl(fd, SIOCGIFFLAGS, &request) == 0 && (request.ifr_flags & IFF_LOOPBACK) != 0;
+    close(fd);
+    return is_loopback;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
 bool Video_Streamer::prepare_pcap(std::string const& interface, PCap& pcap)
 {
+    pcap.is_loopback = is_loopback_interface(interface);
     pcap.pcap = pcap_create(interface.c_str(), pcap.error_buffer);
     if (pcap.pcap == nullptr)
     {
@@ -572,7 +970,7 @@ bool Video_Streamer::prepare_pcap(std::string const& interface, PCap& pcap)
         QLOGE("Error setting pcap_set_promisc: {}", pcap_geterr(pcap.pcap));
         return false;
     }
-    if (pcap_set_rfmon(pcap.pcap, 1) < 0)
+    if (!pcap.is_loopback && pcap_set_rfmon(pcap.pcap, 1) < 0)
     {
         QLOGE("Error setting pcap_set_rfmon: {}", pcap_geterr(pcap.pcap));
         return false;
@@ -634,17 +1032,286 @@ bool Video_Streamer::prepare_pcap(std::string const& interface, PCap& pcap)
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-bool Video_Streamer::init_tx(TX_Descriptor const& descriptor)
+//Only the ring options being refused means there is no ring support, anything else is an error
+auto Video_Streamer::prepare_tx_ring(std::string const& interface) -> Ring_Result
 {
-    if (descriptor.interface.empty())
+    TX::Ring& ring = m_impl->tx.ring;
+
+    unsigned int ifindex = if_nametoindex(interface.c_str());
+    if (ifindex == 0)
     {
-        QLOGE("Invalid interface");
-        return false;
+        QLOGE("Cannot find interface {}: {}", interface, strerror(errno));
+        return Ring_Result::FAILED;
     }
 
-    m_is_tx = true;
-
-    m_tx_descriptor = descriptor;
+    //protocol 0 so this socket never receives anything
+    ring.fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (ring.fd < 0)
+    {
+        QLOGE("Cannot create packet socket: {}", strerror(errno));
+        return Ring_Result::FAILED;
+    }
+
+    int version = TPACKET_V2;
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        QLOGW("Cannot set TPACKET_V2: {}", strerror(errno));
+        return Ring_Result::NOT_SUPPORTED;
+    }
+
+    //malformed frames are skipped instead of blocking the ring
+    int loss = 1;
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_LOSS, &loss, sizeof(loss)) < 0)
+    {
+        QLOGW("Cannot set PACKET_LOSS: {}", strerror(errno));
+        return Ring_Result::NOT_SUPPORTED;
+    }
+
+    //not fatal, older kernels don't have it
+    int bypass = 1;
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_QDISC_BYPASS, &bypass, sizeof(bypass)) < 0)
+    {
+        QLOGI("No qdisc bypass for the TX ring: {}", strerror(errno));
+    }
+
+    ring.packet_offset = TPACKET2_HDRLEN - sizeof(struct sockaddr_ll);
+    ring.frame_size = TPACKET_ALIGN(ring.packet_offset + m_transport_datagram_size);
+    ring.block_size = static_cast<size_t>(getpagesize());
+    while (ring.block_size < ring.frame_size)
+    {
+        ring.block_size <<= 1;
+    }
+    ring.frames_per_block = ring.block_size / ring.frame_size;
+    size_t block_count = (TX_RING_MIN_FRAME_COUNT + ring.frames_per_block - 1) / ring.frames_per_block;
+    ring.frame_count = block_count * ring.frames_per_block;
+
+    tpacket_req req;
+    req.tp_block_size = static_cast<unsigned int>(ring.block_size);
+    req.tp_block_nr = static_cast<unsigned int>(block_count);
+    req.tp_frame_size = static_cast<unsigned int>(ring.frame_size);
+    req.tp_frame_nr = static_cast<unsigned int>(ring.frame_count);
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_TX_RING, &req, sizeof(req)) < 0)
+    {
+        QLOGW("Cannot create the TX ring: {}", strerror(errno));
+        return Ring_Result::NOT_SUPPORTED;
+    }
+
+    ring.buffer_size = ring.block_size * block_count;
+    void* buffer = mmap(nullptr, ring.buffer_size, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd, 0);
+    if (buffer == MAP_FAILED)
+    {
+        QLOGE("Cannot map the TX ring: {}", strerror(errno));
+        return Ring_Result::FAILED;
+    }
+    ring.buffer = reinterpret_cast<uint8_t*>(buffer);
+
+    sockaddr_ll addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = 0;
+    addr.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(ring.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        QLOGE("Cannot bind the TX ring to {}: {}", interface, strerror(errno));
+        return Ring_Result::FAILED;
+    }
+
+    //the headers never change so they are written only once
+    for (size_t i = 0; i < ring.frame_count; i++)
+    {
+        prepare_tx_packet_header(reinterpret_cast<uint8_t*>(get_tx_ring_frame(ring, i)) + ring.packet_offset);
+    }
+
+    QLOGI("TX ring on {}: {} frames of {} bytes", interface, ring.frame_count, ring.frame_size);
+    return Ring_Result::OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::close_tx_ring()
+{
+    TX::Ring& ring = m_impl->tx.ring;
+    if (ring.buffer)
+    {
+        munmap(ring.buffer, ring.buffer_size);
+        ring.buffer = nullptr;
+    }
+    if (ring.fd >= 0)
+    {
+        close(ring.fd);
+        ring.fd = -1;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+uint8_t* Video_Streamer::acquire_tx_ring_packet(size_t frame_idx)
+{
+    TX::Ring& ring = m_impl->tx.ring;
+    tpacket2_hdr* frame = get_tx_ring_frame(ring, frame_idx % ring.frame_count);
+
+    //the ring is full, wait for the kernel to send the old frames.
+    //POLLOUT is raised when the frame at the kernel's head is available again, which is this one when the ring is full.
+    //The timeout is there to notice m_exit and to kick the kernel again if a flush failed with ENOBUFS
+    while (__atomic_load_n(&frame->tp_status, __ATOMIC_ACQUIRE) & (TP_STATUS_SEND_REQUEST | TP_STATUS_SENDING))
+    {
+        if (m_exit)
+        {
+            return nullptr;
+        }
+        flush_tx_ring();
+
+        pollfd fd;
+        fd.fd = ring.fd;
+        fd.events = POLLOUT;
+        fd.revents = 0;
+        if (poll(&fd, 1, 10) < 0 && errno != EINTR)
+        {
+            QLOGW("Trouble waiting for the TX ring: {}", strerror(errno));
+            return nullptr;
+        }
+    }
+
+    return reinterpret_cast<uint8_t*>(frame) + ring.packet_offset;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::commit_tx_ring_packet(size_t frame_idx, size_t size)
+{
+    TX::Ring& ring = m_impl->tx.ring;
+    tpacket2_hdr* frame = get_tx_ring_frame(ring, frame_idx % ring.frame_count);
+    frame->tp_len = static_cast<uint32_t>(size);
+    __atomic_store_n(&frame->tp_status, TP_STATUS_SEND_REQUEST, __ATOMIC_RELEASE);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::flush_tx_ring()
+{
+    TX& tx = m_impl->tx;
+    {
+        std::lock_guard<std::mutex> lg(tx.datagram_queue_mutex);
+        tx.ring.is_pending = true;
+    }
+    tx.datagram_queue_cv.notify_all();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//Same as the TX ring, only the ring options being refused means there is no ring support
+static auto prepare_rx_ring(std::string const& interface, Video_Streamer::PCap& pcap, Video_Streamer::RX::Ring& ring) -> Video_Streamer::Ring_Result
+{
+    typedef Video_Streamer::Ring_Result Ring_Result;
+
+    unsigned int ifindex = if_nametoindex(interface.c_str());
+    if (ifindex == 0)
+    {
+        QLOGE("Cannot find interface {}: {}", interface, strerror(errno));
+        return Ring_Result::FAILED;
+    }
+
+    ring.fd = socket(AF_PACKET, SOCK_RAW, 0);
+    if (ring.fd < 0)
+    {
+        QLOGE("Cannot create packet socket: {}", strerror(errno));
+        return Ring_Result::FAILED;
+    }
+
+    //same program as the pcap one so the kernel drops the foreign packets before they reach the ring
+    {
+        struct bpf_program program;
+        if (pcap_compile(pcap.pcap, &program, pcap.filter.c_str(), 1, 0) == -1)
+        {
+            QLOGE("Failed to compile program: {} : {}", pcap.filter, pcap_geterr(pcap.pcap));
+            return Ring_Result::FAILED;
+        }
+        sock_fprog fprog;
+        fprog.len = static_cast<unsigned short>(program.bf_len);
+        fprog.filter = reinterpret_cast<sock_filter*>(program.bf_insns);
+        int res = setsockopt(ring.fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+        pcap_freecode(&program);
+        if (res < 0)
+        {
+            QLOGW("Cannot attach the filter: {}", strerror(errno));
+            return Ring_Result::NOT_SUPPORTED;
+        }
+    }
+
+    int version = TPACKET_V3;
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+    {
+        QLOGW("Cannot set TPACKET_V3: {}", strerror(errno));
+        return Ring_Result::NOT_SUPPORTED;
+    }
+
+    tpacket_req3 req;
+    memset(&req, 0, sizeof(req));
+    req.tp_block_size = RX_RING_BLOCK_SIZE;
+    req.tp_block_nr = RX_RING_BLOCK_COUNT;
+    req.tp_frame_size = RX_RING_FRAME_SIZE;
+    req.tp_frame_nr = RX_RING_BLOCK_SIZE * RX_RING_BLOCK_COUNT / RX_RING_FRAME_SIZE;
+    req.tp_retire_blk_tov = 1; //ms, a block is handed over when full or after this
+    if (setsockopt(ring.fd, SOL_PACKET, PACKET_RX_RING, &req, sizeof(req)) < 0)
+    {
+        QLOGW("Cannot create the RX ring: {}", strerror(errno));
+        return Ring_Result::NOT_SUPPORTED;
+    }
+
+    ring.block_size = RX_RING_BLOCK_SIZE;
+    ring.block_count = RX_RING_BLOCK_COUNT;
+    ring.buffer_size = ring.block_size * ring.block_count;
+    void* buffer = mmap(nullptr, ring.buffer_size, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd, 0);
+    if (buffer == MAP_FAILED)
+    {
+        QLOGE("Cannot map the RX ring: {}", strerror(errno));
+        return Ring_Result::FAILED;
+    }
+    ring.buffer = reinterpret_cast<uint8_t*>(buffer);
+
+    sockaddr_ll addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family = AF_PACKET;
+    addr.sll_protocol = htons(ETH_P_ALL);
+    addr.sll_ifindex = static_cast<int>(ifindex);
+    if (bind(ring.fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0)
+    {
+        QLOGE("Cannot bind the RX ring to {}: {}", interface, strerror(errno));
+        return Ring_Result::FAILED;
+    }
+
+    QLOGI("RX ring on {}: {} blocks of {} bytes", interface, ring.block_count, ring.block_size);
+    return Ring_Result::OK;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+//The pcap handle is kept only for the monitor mode. Make the kernel drop everything for it so the packets are not copied twice
+static void mute_pcap(std::string const& interface, Video_Streamer::PCap& pcap)
+{
+    sock_filter drop_all = BPF_STMT(BPF_RET | BPF_K, 0);
+    sock_fprog fprog;
+    fprog.len = 1;
+    fprog.filter = &drop_all;
+    if (setsockopt(pcap_fileno(pcap.pcap), SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) < 0)
+    {
+        QLOGW("Cannot mute the pcap socket of {}: {}", interface, strerror(errno));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Video_Streamer::init_tx(TX_Descriptor const& descriptor)
+{
+    if (descriptor.interface.empty())
+    {
+        QLOGE("Invalid interface");
+        return false;
+    }
+
+    m_is_tx = true;
+
+    m_tx_descriptor = descriptor;
 
     m_coding_k = descriptor.coding_k;
     m_coding_n = descriptor.coding_n;
@@ -676,19 +1343,15 @@ bool Video_Streamer::init_rx(RX_Descriptor const& descriptor)
 
 bool Video_Streamer::init()
 {
-    if (m_coding_k == 0 || m_coding_n < m_coding_k || m_coding_k > m_fec_src_datagram_ptrs.size() || m_coding_n > m_fec_dst_datagram_ptrs.size())
+    if (m_coding_k == 0 || m_coding_n < m_coding_k || m_coding_k > MAX_CODING_K || m_coding_n > MAX_CODING_N)
     {
         QLOGE("Invalid coding params: {} / {}" , m_coding_k, m_coding_n);
         return false;
     }
 
-    if (m_fec)
-    {
-        fec_free(m_fec);
-    }
-    m_fec = fec_new(m_coding_k, m_coding_n);
-
     m_impl.reset(new Impl);
+    m_impl->tx.coding_k = m_coding_k;
+    m_impl->tx.coding_n = m_coding_n;
 
 //    IEEE_HEADER[SRC_MAC_LASTBYTE] = 0;
 //    IEEE_HEADER[DST_MAC_LASTBYTE] = 0;
@@ -725,25 +1388,10 @@ bool Video_Streamer::init()
     m_impl->rx.datagram_pool.on_acquire = [this](RX::Datagram& datagram)
     {
         datagram.index = 0;
-        datagram.is_processed = false;
         datagram.data.clear();
         datagram.data.reserve(m_transport_datagram_size);
     };
-    m_impl->rx.block_pool.on_acquire = [this](RX::Block& block)
-    {
-        block.index = 0;
-
-        block.datagrams.clear();
-        block.datagrams.reserve(m_coding_k);
-
-        block.fec_datagrams.clear();
-        block.fec_datagrams.reserve(m_coding_n - m_coding_k);
-    };
-    m_impl->rx.block_pool.on_release = [this](RX::Block& block)
-    {
-        block.datagrams.clear();
-        block.fec_datagrams.clear();
-    };
+    m_impl->rx.ready_queue.set_capacity(RX_READY_QUEUE_SIZE);
 
 
 //    m_impl->pcap = pcap_open_live(m_interface.c_str(), 2048, 1, -1, pcap_error);
@@ -771,6 +1419,22 @@ bool Video_Streamer::init()
         {
             return false;
         }
+        if (m_tx_descriptor.use_tx_ring)
+        {
+            Ring_Result result = prepare_tx_ring(m_tx_descriptor.interface);
+            if (result != Ring_Result::OK)
+            {
+                close_tx_ring();
+            }
+            if (result == Ring_Result::FAILED)
+            {
+                return false;
+            }
+            if (result == Ring_Result::NOT_SUPPORTED)
+            {
+                QLOGW("No TX ring on {}, injecting with pcap", m_tx_descriptor.interface);
+            }
+        }
         m_thread = boost::thread([this]() { tx_thread_proc(); });
     }
     else
@@ -784,6 +1448,39 @@ bool Video_Streamer::init()
             }
         }
 
+        if (m_rx_descriptor.use_rx_ring)
+        {
+            RX& rx = m_impl->rx;
+            rx.rings.reset(new RX::Ring[m_rx_descriptor.interfaces.size()]);
+            Ring_Result result = Ring_Result::OK;
+            for (size_t i = 0; i < m_rx_descriptor.interfaces.size() && result == Ring_Result::OK; i++)
+            {
+                result = prepare_rx_ring(m_rx_descriptor.interfaces[i], rx.pcaps[i], rx.rings[i]);
+            }
+
+            rx.use_rings = result == Ring_Result::OK;
+            if (rx.use_rings)
+            {
+                for (size_t i = 0; i < m_rx_descriptor.interfaces.size(); i++)
+                {
+                    mute_pcap(m_rx_descriptor.interfaces[i], rx.pcaps[i]);
+                }
+            }
+            else
+            {
+                for (size_t i = 0; i < m_rx_descriptor.interfaces.size(); i++)
+                {
+                    close_rx_ring(rx.rings[i]);
+                }
+                rx.rings.reset();
+                if (result == Ring_Result::FAILED)
+                {
+                    return false;
+                }
+                QLOGW("No RX rings, receiving with pcap");
+            }
+        }
+
         m_thread = boost::thread([this]() { rx_thread_proc(); });
     }
 
@@ -811,31 +1508,37 @@ void Video_Streamer::rx_thread_proc()
 {
     RX& rx = m_impl->rx;
 
-    while (!m_exit)
+    size_t interface_count = m_rx_descriptor.interfaces.size();
+    std::vector<pollfd> fds(interface_count);
+    for (size_t i = 0; i < interface_count; i++)
     {
-        fd_set readset;
-        struct timeval to;
-
-        to.tv_sec = 0;
-        to.tv_usec = 1e3;
-
-        FD_ZERO(&readset);
-        for (size_t i = 0; i < m_rx_descriptor.interfaces.size(); i++)
-        {
-            FD_SET(rx.pcaps[i].rx_pcap_selectable_fd, &readset);
-        }
+        fds[i].fd = rx.use_rings ? rx.rings[i].fd : rx.pcaps[i].rx_pcap_selectable_fd;
+        fds[i].events = POLLIN;
+    }
 
-        int n = select(30, &readset, nullptr, nullptr, &to);
-        if (n != 0)
+    while (!m_exit)
+    {
+        int n = poll(fds.data(), fds.size(), 1);
+        if (n > 0)
         {
-            for (size_t i = 0; i < m_rx_descriptor.interfaces.size(); i++)
+            for (size_t i = 0; i < interface_count; i++)
             {
-                if (FD_ISSET(rx.pcaps[i].rx_pcap_selectable_fd, &readset))
+                if (fds[i].revents == 0)
+                {
+                    continue;
+                }
+                if (rx.use_rings)
+                {
+                    process_rx_ring(i);
+                }
+                else
                 {
                     process_rx_packet(rx.pcaps[i]);
                 }
             }
         }
+
+        deliver_rx_blocks();
     }
 }
 
@@ -853,13 +1556,25 @@ void Video_Streamer::tx_thread_proc()
             std::unique_lock<std::mutex> lg(tx.datagram_queue_mutex);
             if (tx.datagram_queue.empty())
             {
-                tx.datagram_queue_cv.wait(lg, [this, &tx]{ return tx.datagram_queue.empty() == false || m_exit == true; });
+                tx.datagram_queue_cv.wait(lg, [this, &tx]{ return tx.datagram_queue.empty() == false || tx.ring.is_pending || m_exit == true; });
             }
             if (m_exit)
             {
                 break;
             }
 
+            if (tx.ring.is_pending.exchange(false))
+            {
+                lg.unlock();
+
+                //one syscall sends all the frames marked so far
+                if (sendto(tx.ring.fd, nullptr, 0, 0, nullptr, 0) < 0 && errno != EAGAIN && errno != ENOBUFS)
+                {
+                    QLOGW("Trouble flushing the TX ring: {}", strerror(errno));
+                }
+                continue;
+            }
+
             //inject packets
             if (!tx.datagram_queue.empty())
             {
@@ -926,6 +1641,12 @@ void Video_Streamer::send(void const* _data, size_t size, math::vec2u16 const& r
 {
     TX& tx = m_impl->tx;
 
+    if (tx.ring.buffer)
+    {
+        send_to_tx_ring(reinterpret_cast<uint8_t const*>(_data), size, resolution);
+        return;
+    }
+
     TX::Datagram_ptr& datagram = tx.crt_datagram;
 
     uint8_t const* data = reinterpret_cast<uint8_t const*>(_data);
@@ -946,7 +1667,11 @@ void Video_Streamer::send(void const* _data, size_t size, math::vec2u16 const& r
 
         if (datagram->data.size() >= m_transport_datagram_size)
         {
-            seal_datagram(*datagram, m_datagram_header_offset, tx.last_block_index, tx.block_datagrams.size(), resolution, false);
+            if (tx.block_datagrams.empty())
+            {
+                update_tx_coding();
+            }
+            seal_datagram(*datagram, m_datagram_header_offset, tx.last_block_index, tx.block_datagrams.size(), tx.coding_k, tx.coding_n, resolution, false);
             tx.block_datagrams.push_back(datagram);
 
             //send the current datagram
@@ -957,19 +1682,19 @@ void Video_Streamer::send(void const* _data, size_t size, math::vec2u16 const& r
             datagram = tx.datagram_pool.acquire();
 
 
-            if (tx.block_datagrams.size() >= m_coding_k)
+            if (tx.block_datagrams.size() >= tx.coding_k)
             {
                 if (1)
                 {
                     auto start = q::Clock::now();
 
                     //init data for the fec_encode
-                    for (size_t i = 0; i < m_coding_k; i++)
+                    for (size_t i = 0; i < tx.coding_k; i++)
                     {
                         m_fec_src_datagram_ptrs[i] = tx.block_datagrams[i]->data.data() + m_payload_offset;
                     }
 
-                    size_t fec_count = m_coding_n - m_coding_k;
+                    size_t fec_count = tx.coding_n - tx.coding_k;
                     tx.block_fec_datagrams.resize(fec_count);
                     for (size_t i = 0; i < fec_count; i++)
                     {
@@ -979,12 +1704,12 @@ void Video_Streamer::send(void const* _data, size_t size, math::vec2u16 const& r
                     }
 
                     //encode
-                    fec_encode(m_fec, m_fec_src_datagram_ptrs.data(), m_fec_dst_datagram_ptrs.data(), BLOCK_NUMS + m_coding_k, m_coding_n - m_coding_k, m_payload_size);
+                    fec_encode(get_fec(tx.coding_k), m_fec_src_datagram_ptrs.data(), m_fec_dst_datagram_ptrs.data(), BLOCK_NUMS + tx.coding_k, tx.coding_n - tx.coding_k, m_payload_size);
 
                     //seal the result
                     for (size_t i = 0; i < fec_count; i++)
                     {
-                        seal_datagram(*tx.block_fec_datagrams[i], m_datagram_header_offset, tx.last_block_index, m_coding_k + i, resolution, true);
+                        seal_datagram(*tx.block_fec_datagrams[i], m_datagram_header_offset, tx.last_block_index, tx.coding_k + i, tx.coding_k, tx.coding_n, resolution, true);
                     }
 
                     //send
@@ -1011,164 +1736,182 @@ void Video_Streamer::send(void const* _data, size_t size, math::vec2u16 const& r
 
 ////////////////////////////////////////////////////////////////////////////////////////////
 
-size_t Video_Streamer::get_mtu() const
-{
-    return std::min(400u, MAX_USER_PACKET_SIZE);
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////
-
-void Video_Streamer::process()
+void Video_Streamer::send_to_tx_ring(uint8_t const* data, size_t size, math::vec2u16 const& resolution)
 {
-    if (!m_impl || m_is_tx)
-    {
-        return;
-    }
+    TX& tx = m_impl->tx;
+    TX::Ring& ring = tx.ring;
 
-    RX& rx = m_impl->rx;
-    std::lock_guard<std::mutex> lg(rx.mutex);
+    bool has_committed = false;
 
-    if (q::Clock::now() - rx.last_datagram_tp > m_rx_descriptor.reset_duration)
+    while (size > 0)
     {
-        rx.next_block_index = 0;
-    }
+        uint8_t* packet = acquire_tx_ring_packet(ring.head);
+        if (!packet)
+        {
+            return;
+        }
+        if (ring.crt_size == 0)
+        {
+            ring.crt_size = m_payload_offset;
+        }
 
-    if (rx.block_queue.empty())
-    {
-        return;
-    }
+        size_t s = std::min(size, m_transport_datagram_size - ring.crt_size);
+        memcpy(packet + ring.crt_size, data, s);
+        ring.crt_size += s;
+        data += s;
+        size -= s;
 
-    RX::Block_ptr block = rx.block_queue.front();
+        if (ring.crt_size < m_transport_datagram_size)
+        {
+            break;
+        }
 
-    //entire block received
-    if (block->datagrams.size() >= m_coding_k)
-    {
-        for (RX::Datagram_ptr const& d: block->datagrams)
+        if (ring.block_datagram_count == 0)
         {
-            uint32_t seq_number = block->index * m_coding_k + d->index;
-            if (!d->is_processed)
+            update_tx_coding();
+        }
+        seal_datagram(packet + m_datagram_header_offset, m_streaming_datagram_size, tx.last_block_index, ring.block_datagram_count, tx.coding_k, tx.coding_n, resolution, false);
+        commit_tx_ring_packet(ring.head, m_transport_datagram_size);
+        has_committed = true;
+        ring.head = (ring.head + 1) % ring.frame_count;
+        ring.crt_size = 0;
+        ring.block_datagram_count++;
+
+        if (ring.block_datagram_count >= tx.coding_k)
+        {
+            //the sources are still in the ring, the kernel doesn't touch the frames it sent
+            for (size_t i = 0; i < tx.coding_k; i++)
+            {
+                m_fec_src_datagram_ptrs[i] = reinterpret_cast<uint8_t const*>(get_tx_ring_frame(ring, (ring.block_start + i) % ring.frame_count)) + ring.packet_offset + m_payload_offset;
+            }
+
+            size_t fec_count = tx.coding_n - tx.coding_k;
+            for (size_t i = 0; i < fec_count; i++)
             {
-                //QLOGI("Datagram {}", seq_number);
-                if (on_data_received)
+                uint8_t* fec_packet = acquire_tx_ring_packet(ring.head + i);
+                if (!fec_packet)
                 {
-                    on_data_received(d->data.data(), d->data.size(), d->resolution);
+                    return;
                 }
-                rx.last_datagram_tp = q::Clock::now();
-                d->is_processed = true;
+                m_fec_dst_datagram_ptrs[i] = fec_packet + m_payload_offset;
+            }
+
+            //encode straight into the ring
+            fec_encode(get_fec(tx.coding_k), m_fec_src_datagram_ptrs.data(), m_fec_dst_datagram_ptrs.data(), BLOCK_NUMS + tx.coding_k, fec_count, m_payload_size);
+
+            for (size_t i = 0; i < fec_count; i++)
+            {
+                seal_datagram(m_fec_dst_datagram_ptrs[i] - sizeof(Datagram_Header), m_streaming_datagram_size, tx.last_block_index, tx.coding_k + i, tx.coding_k, tx.coding_n, resolution, true);
+                commit_tx_ring_packet(ring.head + i, m_transport_datagram_size);
             }
+
+            ring.head = (ring.head + fec_count) % ring.frame_count;
+            ring.block_start = ring.head;
+            ring.block_datagram_count = 0;
+            tx.last_block_index++;
         }
+    }
+
+    if (has_committed)
+    {
+        flush_tx_ring();
+    }
+}
 
-        rx.last_block_tp = q::Clock::now();
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        rx.next_block_index = block->index + 1;
-        rx.block_queue.pop_front();
+void Video_Streamer::set_coding(uint32_t coding_k, uint32_t coding_n)
+{
+    if (coding_k == 0 || coding_n < coding_k || coding_k > MAX_CODING_K || coding_n > MAX_CODING_N)
+    {
+        QLOGE("Invalid coding params: {} / {}" , coding_k, coding_n);
         return;
     }
+    m_requested_coding = (coding_n << 8) | coding_k;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
 
-    //try to process consecutive datagrams before the block is finished to minimize latency
-    for (size_t i = 0; i < block->datagrams.size(); i++)
+void Video_Streamer::update_tx_coding()
+{
+    uint32_t coding = m_requested_coding.exchange(0);
+    if (coding != 0)
     {
-        RX::Datagram_ptr const& d = block->datagrams[i];
-        if (d->index == i)
-        {
-            uint32_t seq_number = block->index * m_coding_k + d->index;
-            if (!d->is_processed)
-            {
-                //QLOGI("Datagram {}", seq_number);
-                if (on_data_received)
-                {
-                    on_data_received(d->data.data(), d->data.size(), d->resolution);
-                }
-                rx.last_datagram_tp = q::Clock::now();
-                d->is_processed = true;
-            }
-        }
-        else
-        {
-            break;
-        }
+        TX& tx = m_impl->tx;
+        tx.coding_k = coding & 0xFF;
+        tx.coding_n = coding >> 8;
     }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
 
-    //can we fec decode?
-    if (block->datagrams.size() + block->fec_datagrams.size() >= m_coding_k)
+fec_t* Video_Streamer::get_fec(uint32_t coding_k)
+{
+    //The rows of the encoding matrix don't depend on n so a codec made for the maximum n works for any smaller one
+    QASSERT(coding_k > 0 && coding_k <= MAX_CODING_K);
+    fec_t*& fec = m_fecs[coding_k];
+    if (!fec)
     {
-        auto start = q::Clock::now();
+        fec = fec_new(coding_k, MAX_CODING_N);
+    }
+    return fec;
+}
 
-        std::array<unsigned int, 32> indices;
-        size_t primary_index = 0;
-        size_t used_fec_index = 0;
-        for (size_t i = 0; i < m_coding_k; i++)
-        {
-            if (primary_index < block->datagrams.size() && i == block->datagrams[primary_index]->index)
-            {
-                m_fec_src_datagram_ptrs[i] = block->datagrams[primary_index]->data.data();
-                indices[i] = block->datagrams[primary_index]->index;
-                primary_index++;
-            }
-            else
-            {
-                m_fec_src_datagram_ptrs[i] = block->fec_datagrams[used_fec_index]->data.data();
-                indices[i] = block->fec_datagrams[used_fec_index]->index;
-                used_fec_index++;
-            }
-        }
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        //insert the missing datagrams, they will be filled with data by the fec_decode below
-        size_t fec_index = 0;
-        for (size_t i = 0; i < m_coding_k; i++)
-        {
-            if (i >= block->datagrams.size() || i != block->datagrams[i]->index)
-            {
-                block->datagrams.insert(block->datagrams.begin() + i, rx.datagram_pool.acquire());
-                block->datagrams[i]->data.resize(m_payload_size);
-                block->datagrams[i]->index = i;
-                m_fec_dst_datagram_ptrs[fec_index++] = block->datagrams[i]->data.data();
-            }
-        }
+auto Video_Streamer::get_rx_stats() const -> RX_Stats
+{
+    RX_Stats stats;
+    memset(&stats, 0, sizeof(stats));
+    if (m_impl)
+    {
+        RX::Stats const& s = m_impl->rx.stats;
+        stats.blocks = s.blocks;
+        stats.recovered_blocks = s.recovered_blocks;
+        stats.lost_blocks = s.lost_blocks;
+        stats.datagrams = s.datagrams;
+        stats.lost_datagrams = s.lost_datagrams;
+    }
+    return stats;
+}
 
-        fec_decode(m_fec, m_fec_src_datagram_ptrs.data(), m_fec_dst_datagram_ptrs.data(), indices.data(), m_payload_size);
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        //now dispatch them
-        for (size_t i = 0; i < block->datagrams.size(); i++)
-        {
-            RX::Datagram_ptr const& d = block->datagrams[i];
-            uint32_t seq_number = block->index * m_coding_k + d->index;
-            if (!d->is_processed)
-            {
-                //QLOGI("Datagram F {}", seq_number);
-                if (on_data_received)
-                {
-                    on_data_received(d->data.data(), d->data.size(), d->resolution);
-                }
-                rx.last_datagram_tp = q::Clock::now();
-                d->is_processed = true;
-            }
-        }
+size_t Video_Streamer::get_mtu() const
+{
+    return std::min<size_t>(400u, MAX_USER_PACKET_SIZE);
+}
 
-        //QLOGI("Decoded fac: {}", q::Clock::now() - start);
+////////////////////////////////////////////////////////////////////////////////////////////
 
-        rx.last_block_tp = q::Clock::now();
-        rx.next_block_index = block->index + 1;
-        rx.block_queue.pop_front();
+bool Video_Streamer::is_using_rings() const
+{
+    if (!m_impl)
+    {
+        return false;
+    }
+    return m_is_tx ? m_impl->tx.ring.buffer != nullptr : m_impl->rx.use_rings;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////
+
+void Video_Streamer::process()
+{
+    if (!m_impl || m_is_tx)
+    {
         return;
     }
 
-    //skip if too much buffering
-    if (rx.block_queue.size() > 3)
+    RX& rx = m_impl->rx;
+
+    RX::Datagram_ptr datagram;
+    while (rx.ready_queue.pop_front(datagram))
     {
-        for (size_t i = 0; i < block->datagrams.size(); i++)
+        if (on_data_received)
         {
-            RX::Datagram_ptr const& d = block->datagrams[i];
-            if (!d->is_processed)
-            {
-                uint32_t seq_number = block->index * m_coding_k + d->index;
-                //QLOGI("Skipping {}", seq_number);
-            }
+            on_data_received(datagram->data.data(), datagram->data.size(), datagram->resolution);
         }
-        rx.next_block_index = block->index + 1;
-        rx.block_queue.pop_front();
     }
-
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////
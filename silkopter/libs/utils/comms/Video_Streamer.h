@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <string>
+#include <array>
+#include <atomic>
 #include <boost/thread.hpp>
 
 struct fec_t;
@@ -18,11 +20,15 @@ public:
     Video_Streamer();
     ~Video_Streamer();
 
+    static constexpr uint32_t MAX_CODING_K = 16;
+    static constexpr uint32_t MAX_CODING_N = 32;
+
     struct TX_Descriptor
     {
         std::string interface;
         uint32_t coding_k = 12;
         uint32_t coding_n = 20;
+        bool use_tx_ring = true; //inject through a PACKET_TX_RING, falls back to pcap_inject if the kernel refuses the ring
     };
 
     struct RX_Descriptor
@@ -32,6 +38,7 @@ public:
         q::Clock::duration reset_duration = std::chrono::milliseconds(1000);
         uint32_t coding_k = 12;
         uint32_t coding_n = 20;
+        bool use_rx_ring = true; //read through PACKET_RX_RINGs, falls back to pcap if the kernel refuses the rings
     };
 
     bool init_tx(TX_Descriptor const& descriptor);
@@ -41,16 +48,41 @@ public:
 
     void send(void const* data, size_t size, math::vec2u16 const& resolution);
 
+    //Used from the next block on, the receiver gets it from the datagram headers. Can be called from any thread
+    void set_coding(uint32_t coding_k, uint32_t coding_n);
+
+    //Cumulative since init_rx so a lost report doesn't lose information.
+    //No member initializers so it stays a pod for the serialization
+    struct RX_Stats
+    {
+        uint32_t blocks; //finished, lost or not
+        uint32_t recovered_blocks; //that needed the fec datagrams
+        uint32_t lost_blocks; //skipped or never seen
+        uint32_t datagrams; //data datagrams of the finished blocks
+        uint32_t lost_datagrams; //data datagrams that didn't arrive
+    };
+    auto get_rx_stats() const -> RX_Stats;
+
     std::function<void(void const* data, size_t size, math::vec2u16 const& resolution)> on_data_received;
 
     size_t get_mtu() const;
 
+    //If the datagrams go through the TX ring or the RX rings, depending on the side. False when they go through pcap
+    bool is_using_rings() const;
+
     static std::vector<std::string> enumerate_interfaces();
 
     struct PCap;
     struct RX;
     struct TX;
 
+    enum class Ring_Result
+    {
+        OK,
+        NOT_SUPPORTED, //the kernel refused the ring options so pcap is used instead
+        FAILED
+    };
+
 private:
 
     bool init();
@@ -61,6 +93,20 @@ private:
     void prepare_radiotap_header(size_t rate_hz);
     void prepare_tx_packet_header(uint8_t* buffer);
     bool process_rx_packet(PCap& pcap);
+    void process_rx_ring(size_t interface_idx);
+    void process_rx_frame(uint8_t const* payload, size_t size, size_t _80211_header_length);
+    void add_rx_datagram(uint8_t const* payload, size_t size);
+    void deliver_rx_blocks();
+
+    Ring_Result prepare_tx_ring(std::string const& interface);
+    void close_tx_ring();
+    uint8_t* acquire_tx_ring_packet(size_t frame_idx);
+    void commit_tx_ring_packet(size_t frame_idx, size_t size);
+    void flush_tx_ring();
+    void send_to_tx_ring(uint8_t const* data, size_t size, math::vec2u16 const& resolution);
+
+    void update_tx_coding();
+    fec_t* get_fec(uint32_t coding_k);
 
     void tx_thread_proc();
     void rx_thread_proc();
@@ -78,9 +124,11 @@ private:
     bool m_exit = false;
     boost::thread m_thread;
 
-    fec_t* m_fec = nullptr;
-    std::array<uint8_t const*, 16> m_fec_src_datagram_ptrs;
-    std::array<uint8_t*, 32> m_fec_dst_datagram_ptrs;
+    std::atomic<uint32_t> m_requested_coding = {0}; //n << 8 | k, 0 when nothing changed
+
+    std::array<fec_t*, MAX_CODING_K + 1> m_fecs; //one per k, for the maximum n
+    std::array<uint8_t const*, MAX_CODING_K> m_fec_src_datagram_ptrs;
+    std::array<uint8_t*, MAX_CODING_N> m_fec_dst_datagram_ptrs;
 
     size_t m_transport_datagram_size = 0;
     size_t m_streaming_datagram_size = 0;
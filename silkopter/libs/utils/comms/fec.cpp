@@ -164,7 +164,7 @@ generate_gf (void) {
  * calls are unfrequent in my typical apps so I did not bother.
  */
 #define addmul(dst, src, c, sz)                 \
-    if (c != 0) _addmul1(dst, src, c, sz)
+    if (c != 0) _addmul_impl(dst, src, c, sz)
 
 #define UNROLL 16               /* 1, 4, 8, 16 */
 static void
@@ -203,6 +203,147 @@ _addmul1(register gf*restrict dst, const register gf*restrict src, gf c, size_t
         GF_ADDMULC (*dst, *src);
 }
 
+/*
+ * SIMD versions of _addmul1. The product is linear over xor so
+ * c*x = c*(x & 0x0f) ^ c*(x & 0xf0): two 16 entry tables per constant,
+ * looked up 16 or 32 bytes at a time with a byte shuffle (pshufb / vtbl).
+ * The best one the cpu has is picked once, in init_fec.
+ */
+#if defined __x86_64__ || defined __i386__
+#include <immintrin.h>
+#define FEC_SIMD_X86
+#elif defined __arm__ || defined __aarch64__
+/*
+ * neon is always there on aarch64. On armv7 it's optional so unless the
+ * build enables it (-mfpu=neon) the kernel is built for neon on its own
+ * and only picked if the kernel reports the cpu has it.
+ */
+#include <arm_neon.h>
+#define FEC_SIMD_NEON
+#if defined __arm__ && !defined __ARM_NEON
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define FEC_NEON_TARGET __attribute__((target("fpu=neon")))
+#define FEC_NEON_RUNTIME
+#else
+#define FEC_NEON_TARGET
+#endif
+#endif
+
+typedef void (*addmul_fn)(gf*restrict dst, const gf*restrict src, gf c, size_t sz);
+static addmul_fn _addmul_impl = _addmul1;
+
+static void
+_init_nibble_tables(gf c, gf* lo, gf* hi) {
+    unsigned i;
+    for (i = 0; i < 16; i++) {
+        lo[i] = gf_mul(c, i);
+        hi[i] = gf_mul(c, i << 4);
+    }
+}
+
+#if defined FEC_SIMD_X86
+__attribute__((target("ssse3"))) static void
+_addmul1_ssse3(gf*restrict dst, const gf*restrict src, gf c, size_t sz) {
+    gf lo_table[16], hi_table[16];
+    size_t i = 0;
+    _init_nibble_tables(c, lo_table, hi_table);
+    const __m128i lo = _mm_loadu_si128((const __m128i*)lo_table);
+    const __m128i hi = _mm_loadu_si128((const __m128i*)hi_table);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+
+    for (; i + 16 <= sz; i += 16) {
+        __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(s, mask));
+        __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(s, 4), mask));
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(d, _mm_xor_si128(l, h)));
+    }
+    _addmul1(dst + i, src + i, c, sz - i);
+}
+
+__attribute__((target("avx2"))) static void
+_addmul1_avx2(gf*restrict dst, const gf*restrict src, gf c, size_t sz) {
+    gf lo_table[16], hi_table[16];
+    size_t i = 0;
+    _init_nibble_tables(c, lo_table, hi_table);
+    /* the shuffle works within 128 bit lanes so both lanes get the tables */
+    const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)lo_table));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)hi_table));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    for (; i + 32 <= sz; i += 32) {
+        __m256i s = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(s, mask));
+        __m256i h = _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi64(s, 4), mask));
+        __m256i d = _mm256_loadu_si256((const __m256i*)(dst + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(d, _mm256_xor_si256(l, h)));
+    }
+    /* the rest of the code is not built for avx and would pay for the dirty upper halves */
+    _mm256_zeroupper();
+    _addmul1(dst + i, src + i, c, sz - i);
+}
+#endif
+
+#if defined FEC_SIMD_NEON
+FEC_NEON_TARGET static void
+_addmul1_neon(gf*restrict dst, const gf*restrict src, gf c, size_t sz) {
+    gf lo_table[16], hi_table[16];
+    size_t i = 0;
+    _init_nibble_tables(c, lo_table, hi_table);
+    const uint8x16_t mask = vdupq_n_u8(0x0f);
+
+#if defined __aarch64__
+    const uint8x16_t lo = vld1q_u8(lo_table);
+    const uint8x16_t hi = vld1q_u8(hi_table);
+    for (; i + 16 <= sz; i += 16) {
+        uint8x16_t s = vld1q_u8(src + i);
+        uint8x16_t p = veorq_u8(vqtbl1q_u8(lo, vandq_u8(s, mask)), vqtbl1q_u8(hi, vshrq_n_u8(s, 4)));
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), p));
+    }
+#else
+    /* armv7 looks up 8 bytes at a time in a pair of d registers */
+    uint8x8x2_t lo, hi;
+    lo.val[0] = vld1_u8(lo_table);
+    lo.val[1] = vld1_u8(lo_table + 8);
+    hi.val[0] = vld1_u8(hi_table);
+    hi.val[1] = vld1_u8(hi_table + 8);
+    for (; i + 16 <= sz; i += 16) {
+        uint8x16_t s = vld1q_u8(src + i);
+        uint8x16_t l = vandq_u8(s, mask);
+        uint8x16_t h = vshrq_n_u8(s, 4);
+        uint8x8_t p0 = veor_u8(vtbl2_u8(lo, vget_low_u8(l)), vtbl2_u8(hi, vget_low_u8(h)));
+        uint8x8_t p1 = veor_u8(vtbl2_u8(lo, vget_high_u8(l)), vtbl2_u8(hi, vget_high_u8(h)));
+        vst1q_u8(dst + i, veorq_u8(vld1q_u8(dst + i), vcombine_u8(p0, p1)));
+    }
+#endif
+    _addmul1(dst + i, src + i, c, sz - i);
+}
+
+static int
+_cpu_has_neon(void) {
+#if defined FEC_NEON_RUNTIME
+    return (getauxval(AT_HWCAP) & HWCAP_NEON) != 0;
+#else
+    return 1;
+#endif
+}
+#endif
+
+static void
+_init_addmul(void) {
+#if defined FEC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        _addmul_impl = _addmul1_avx2;
+    else if (__builtin_cpu_supports("ssse3"))
+        _addmul_impl = _addmul1_ssse3;
+#elif defined FEC_SIMD_NEON
+    if (_cpu_has_neon())
+        _addmul_impl = _addmul1_neon;
+#endif
+}
+
 /*
  * computes C = AB where A is n*k, B is k*m, C is n*m
  */
@@ -394,9 +535,38 @@ static void
 init_fec (void) {
     generate_gf();
     _init_mul_table();
+    _init_addmul();
     fec_initialized = 1;
 }
 
+size_t
+fec_get_addmul_kernels(fec_addmul_fn* kernels, const char** names, size_t max_count) {
+    size_t count = 0;
+    if (fec_initialized == 0)
+        init_fec ();
+
+#define ADD_KERNEL(fn, name)                    \
+    if (count < max_count) {                    \
+        kernels[count] = fn;                    \
+        names[count] = name;                    \
+        count++;                                \
+    }
+
+    ADD_KERNEL(_addmul1, "table");
+#if defined FEC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3"))
+        ADD_KERNEL(_addmul1_ssse3, "ssse3");
+    if (__builtin_cpu_supports("avx2"))
+        ADD_KERNEL(_addmul1_avx2, "avx2");
+#elif defined FEC_SIMD_NEON
+    if (_cpu_has_neon())
+        ADD_KERNEL(_addmul1_neon, "neon");
+#endif
+#undef ADD_KERNEL
+    return count;
+}
+
 /*
  * This section contains the proper FEC encoding/decoding routines.
  * The encoding matrix is computed starting with a Vandermonde matrix,
@@ -44,6 +44,15 @@ void fec_encode(const fec_t* code, const gf*restrict const*restrict const src, g
  */
 void fec_decode(const fec_t* code, const gf*restrict const*restrict const inpkts, gf*restrict const*restrict const outpkts, const unsigned*restrict const index, size_t sz);
 
+/**
+ * The dst[] ^= c * src[] kernels the encoder and decoder can use, for testing and benchmarking.
+ * The first one is the portable table version, followed by the SIMD ones the cpu supports.
+ * @param kernels, names arrays of max_count elements that receive the kernels and their names
+ * @return how many kernels were written
+ */
+typedef void (*fec_addmul_fn)(gf* dst, const gf* src, gf c, size_t sz);
+size_t fec_get_addmul_kernels(fec_addmul_fn* kernels, const char** names, size_t max_count);
+
 #if defined(_MSC_VER)
 #define alloca _alloca
 #else
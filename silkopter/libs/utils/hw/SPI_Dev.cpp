@@ -80,6 +80,42 @@ bool SPI_Dev::transfer(void const* tx_data, void* rx_data, size_t size, uint32_t
     return do_transfer(tx_data, rx_data, size, speed);
 }
 
+bool SPI_Dev::transfer(Transfer const* transfers, size_t count) const
+{
+    QLOG_TOPIC("SPI_Dev::transfer_batch");
+    QASSERT(m_fd >= 0 && count > 0);
+    if (m_fd < 0 || count == 0)
+    {
+        return false;
+    }
+
+    m_ioc_transfers.resize(count * sizeof(spi_ioc_transfer));
+    spi_ioc_transfer* spi_transfers = reinterpret_cast<spi_ioc_transfer*>(m_ioc_transfers.data());
+    memset(spi_transfers, 0, count * sizeof(spi_ioc_transfer));
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Transfer const& t = transfers[i];
+        spi_ioc_transfer& spi_transfer = spi_transfers[i];
+        spi_transfer.tx_buf = (unsigned long)t.tx_data;
+        spi_transfer.rx_buf = (unsigned long)t.rx_data;
+        spi_transfer.len = t.size;
+        spi_transfer.speed_hz = t.speed ? t.speed : m_speed;
+        spi_transfer.bits_per_word = 8;
+        spi_transfer.delay_usecs = 0;
+        spi_transfer.cs_change = t.cs_change ? 1 : 0;
+    }
+
+    int status = ioctl(m_fd, SPI_IOC_MESSAGE(count), spi_transfers);
+    if (status < 0)
+    {
+        QLOGW("batch transfer failed: {}", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
 bool SPI_Dev::transfer_register(uint8_t reg, void const* tx_data, void* rx_data, size_t size, uint32_t speed) const
 {
     QLOG_TOPIC("SPI_Dev::transfer_register");
@@ -16,6 +16,19 @@ public:
     bool transfer(void const* tx_data, void* rx_data, size_t size, uint32_t speed = 0) const;
     bool transfer_register(uint8_t reg, void const* tx_data, void* rx_data, size_t size, uint32_t speed = 0) const;
 
+    struct Transfer
+    {
+        void const* tx_data = nullptr;
+        void* rx_data = nullptr;
+        size_t size = 0;
+        uint32_t speed = 0;
+        bool cs_change = false; //deselect the device after this transfer
+    };
+
+    //Executes all the transfers as a single SPI message - one ioctl call.
+    //The kernel limits the total size of a message (4096 bytes by default) so keep the batches small.
+    bool transfer(Transfer const* transfers, size_t count) const;
+
 private:
     bool do_transfer(void const* tx_data, void* rx_data, size_t size, uint32_t speed) const;
 
@@ -25,6 +38,7 @@ private:
     int m_fd = -1;
     mutable std::vector<uint8_t> m_tx_buffer;
     mutable std::vector<uint8_t> m_rx_buffer;
+    mutable std::vector<uint8_t> m_ioc_transfers; //storage for the spi_ioc_transfer array, the type is not visible in the header
 };
 
 }
@@ -20,6 +20,11 @@ T max(T v, T max)
 {
   return std::max(v, max);
 }
+uint64_t get_schema_hash()
+{
+  return 0x9C878D7DDF2990CAULL;
+}
+
       void Settings::Input::Sticks_Calibration::set_yaw_center(float const& value)
       {
         m_yaw_center = value;
@@ -39,6 +39,8 @@ private:
   template<class U> friend class Poly;
   std::shared_ptr<T> ptr;
 };
+// Returns a hash of the definitions. Both ends of a binary channel have to agree on it
+uint64_t get_schema_hash();
 typedef int8_t int8_t;
 typedef uint8_t uint8_t;
 typedef int16_t int16_t;
@@ -135,6 +135,8 @@ HEADERS += \
     ../../../libs/utils/hw/pigpio.h \
     ../../../libs/utils/comms/Channel.h \
     ../../../libs/utils/comms/RCP.h \
+    ../../../libs/utils/MPSC_Queue.h \
+    ../../../libs/utils/MPMC_Queue.h \
     ../../../libs/utils/comms/ISocket.h \
     ../../../libs/utils/comms/RF4463F30_Socket.h \
     ../../../libs/utils/comms/RFMON_Socket.h \
@@ -70,6 +70,7 @@ bool Comms::start()
 
     //m_rc_phy.set_rate(100);
     m_rc_protocol.add_periodic_packet(std::chrono::milliseconds(30), std::bind(&Comms::compute_multirotor_commands_packet, this, std::placeholders::_1, std::placeholders::_2));
+    m_rc_protocol.add_periodic_packet(std::chrono::milliseconds(250), std::bind(&Comms::compute_video_link_stats_packet, this, std::placeholders::_1, std::placeholders::_2));
 
     m_video_streamer.on_data_received = std::bind(&Comms::handle_video, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 
@@ -130,6 +131,21 @@ size_t Comms::compute_multirotor_commands_packet(uint8_t* data, uint8_t& packet_
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+size_t Comms::compute_video_link_stats_packet(uint8_t* data, uint8_t& packet_type)
+{
+    packet_type = static_cast<uint8_t>(rc_comms::Packet_Type::VIDEO_LINK_STATS);
+
+    //the uav adapts the fec and bitrate to these
+    size_t off = 0;
+    util::serialization::serialize(m_serialization_buffer, m_video_streamer.get_rx_stats(), off);
+
+    memcpy(data, m_serialization_buffer.data(), off);
+
+    return off;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 void Comms::process_rx_packet(util::comms::RC_Protocol::RX_Packet const& packet)
 {
     m_rx_packet.rx_dBm = packet.rx_dBm;
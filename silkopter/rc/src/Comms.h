@@ -82,6 +82,7 @@ private:
     void reset();
 
     size_t compute_multirotor_commands_packet(uint8_t* data, uint8_t& packet_type);
+    size_t compute_video_link_stats_packet(uint8_t* data, uint8_t& packet_type);
     void process_rx_packet(util::comms::RC_Protocol::RX_Packet const& packet);
 
     Remote_Viewer_Server m_remote_viewer_server;